@@ -21,6 +21,8 @@
 
 #include "ODApplication.h"
 
+#include "gamemap/BinaryLevel.h"
+#include "gamemap/LevelInfoCache.h"
 #include "network/ODServer.h"
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
@@ -30,6 +32,7 @@
 #include "render/ODFrameListener.h"
 #include "render/TextRenderer.h"
 #include "utils/ConfigManager.h"
+#include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/LogSinkConsole.h"
 #include "utils/LogSinkFile.h"
@@ -57,10 +60,63 @@
 
 #include <boost/program_options.hpp>
 
+#include <chrono>
 #include <string>
 #include <sstream>
 #include <fstream>
 
+namespace
+{
+//! \brief Measures the time spent in each step of the startup
+class StartupTimer
+{
+public:
+    StartupTimer() :
+        mStart(std::chrono::steady_clock::now()),
+        mStepStart(mStart)
+    {}
+
+    //! \brief Ends the current step. The next one starts now
+    void endStep(const std::string& name)
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        mSteps << name << ": " << toMs(now - mStepStart) << " ms\n";
+        mStepStart = now;
+    }
+
+    std::string getSteps() const
+    { return mSteps.str(); }
+
+    uint32_t getTotalMs() const
+    { return toMs(std::chrono::steady_clock::now() - mStart); }
+
+private:
+    std::chrono::steady_clock::time_point mStart;
+    std::chrono::steady_clock::time_point mStepStart;
+    std::stringstream mSteps;
+
+    static uint32_t toMs(std::chrono::steady_clock::duration duration)
+    { return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()); }
+};
+
+void logStartupTimes(const StartupTimer& timer, const ConfigManager& configManager, bool isProfileStartup)
+{
+    OD_LOG_INF("Startup done in " + Helper::toString(timer.getTotalMs()) + " ms");
+    std::string steps = "Startup steps:\n" + timer.getSteps();
+    std::string configFiles = "Configuration files (read in the background):\n" + configManager.getLoadingTimings();
+    if(isProfileStartup)
+    {
+        OD_LOG_INF(steps);
+        OD_LOG_INF(configFiles);
+    }
+    else
+    {
+        OD_LOG_DBG(steps);
+        OD_LOG_DBG(configFiles);
+    }
+}
+}
+
 void ODApplication::startGame(boost::program_options::variables_map& options)
 {
     ResourceManager resMgr(options);
@@ -71,20 +127,45 @@ void ODApplication::startGame(boost::program_options::variables_map& options)
     logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
     logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkFile(resMgr.getLogFile())));
 
-    if(resMgr.isServerMode())
+    if(resMgr.isLevelConversionMode())
+        convertLevel();
+    else if(resMgr.isServerMode())
         startServer();
     else
         startClient();
 }
 
+void ODApplication::convertLevel()
+{
+    ResourceManager& resMgr = ResourceManager::getSingleton();
+    const std::string& source = resMgr.getLevelConversionSource();
+    const std::string& destination = resMgr.getLevelConversionDestination();
+
+    bool isBinary = BinaryLevel::isBinaryLevel(source);
+    OD_LOG_INF("Converting " + std::string(isBinary ? "binary" : "text") + " level " + source + " to " + destination);
+    bool result = isBinary ? BinaryLevel::convertBinaryToText(source, destination)
+        : BinaryLevel::convertTextToBinary(source, destination);
+    if(!result)
+    {
+        OD_LOG_ERR("Could not convert level " + source);
+        return;
+    }
+
+    OD_LOG_INF("Level converted");
+}
+
 void ODApplication::startServer()
 {
     ResourceManager& resMgr = ResourceManager::getSingleton();
 
     OD_LOG_INF("Initializing");
 
+    StartupTimer timer;
     Random::initialize();
     ConfigManager configManager(resMgr.getConfigPath(), "", resMgr.getSoundPath());
+    configManager.waitLoading();
+    timer.endStep("config");
+    logStartupTimes(timer, configManager, resMgr.isProfileStartup());
     OD_LOG_INF("Launching server");
 
     const std::string& creator = resMgr.getServerModeCreator();
@@ -109,6 +190,7 @@ void ODApplication::startServer()
 void ODApplication::startClient()
 {
     ResourceManager& resMgr = ResourceManager::getSingleton();
+    StartupTimer timer;
 
     {
         //NOTE: This prevents a segmentation fault from OpenGL on exit.
@@ -124,12 +206,15 @@ void ODApplication::startClient()
 
     // N.B: We don't use any ogre.cfg file, hence setting the file path value to "".
     Ogre::Root ogreRoot(resMgr.getPluginsPath(), "");
+    timer.endStep("Ogre root");
 
+    // The configuration files are read in the background while the window and the resources are set up
     ConfigManager configManager(resMgr.getConfigPath(), resMgr.getUserCfgFile(),
         resMgr.getSoundPath());
 
     if (!configManager.initVideoConfig(ogreRoot))
         return;
+    timer.endStep("global and user config");
 
     // Needed for the TextRenderer and the Render Manager
     Ogre::OverlaySystem overlaySystem;
@@ -184,11 +269,12 @@ void ODApplication::startClient()
 #else /* OD_USE_SFML_WINDOW */
     Ogre::RenderWindow* renderWindow = ogreRoot.initialise(true, "OpenDungeons " + VERSION);
 #endif /* OD_USE_SFML_WINDOW */
-
+    timer.endStep("window");
 
     //NOTE: This is currently done here as it has to be done after initialising mRoot,
     // but before running initialiseAllResourceGroups()
     resMgr.setupOgreResources(ogreRoot.getRenderSystem()->getNativeShadingLanguageVersion());
+    timer.endStep("resource locations");
 
     // Setup Icon (On Windows)
     // NOTE: On linux at least, the icon is usually handled through desktop files.
@@ -214,13 +300,20 @@ void ODApplication::startClient()
     }
 
     Ogre::ResourceGroupManager::getSingletonPtr()->initialiseAllResourceGroups();
+    timer.endStep("resource groups");
+
+    configManager.waitLoading();
+    timer.endStep("waiting for config files");
 
     MusicPlayer musicPlayer(resMgr.getMusicPath(), resMgr.listAllMusicFiles());
     SoundEffectsManager soundEffectsManager;
+    timer.endStep("sounds");
 
     ODServer server;
     ODClient client;
 
+    LevelInfoCache levelInfoCache(resMgr.getLevelInfoCacheFile());
+
     Gui gui(&soundEffectsManager, resMgr.getCeguiLogFile(), *renderWindow);
     TextRenderer textRenderer;
     textRenderer.addTextBox("DebugMessages", ODApplication::MOTD.c_str(), 840,
@@ -232,6 +325,8 @@ void ODApplication::startClient()
         renderWindow, &overlaySystem, &gui);
 
     ogreRoot.addFrameListener(&frameListener);
+    timer.endStep("gui and main menu");
+    logStartupTimes(timer, configManager, resMgr.isProfileStartup());
 
 #ifdef OD_USE_SFML_WINDOW
     bool running = true;
@@ -64,6 +64,8 @@ private:
     void startClient();
     //! \brief Server mode. Creates only the needed to launch a level. Note that this is to be used without gui
     void startServer();
+    //! \brief Converts a level between the text and the binary formats (see BinaryLevel) then exits
+    void convertLevel();
 };
 
 #endif // ODAPPLICATION_H
@@ -49,6 +49,14 @@ bool AIManager::doTurn(double timeSinceLastTurn)
     return true;
 }
 
+void AIManager::notifyTileChanged(const Tile& tile)
+{
+    for(BaseAI* ai : mAiList)
+    {
+        ai->notifyTileChanged(tile);
+    }
+}
+
 void AIManager::clearAIList()
 {
     for(BaseAI* ai : mAiList)
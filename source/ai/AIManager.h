@@ -23,6 +23,7 @@
 class BaseAI;
 class GameMap;
 class Player;
+class Tile;
 
 enum class KeeperAIType;
 
@@ -39,6 +40,9 @@ public:
     bool doTurn(double timeSinceLastTurn);
     void clearAIList();
 
+    //! \brief Forwards the tile change to every AI
+    void notifyTileChanged(const Tile& tile);
+
 private:
     GameMap& mGameMap;
     AIList mAiList;
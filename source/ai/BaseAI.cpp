@@ -23,6 +23,7 @@
 #include "entities/Tile.h"
 
 #include "game/Player.h"
+#include "game/Seat.h"
 
 #include "gamemap/GameMap.h"
 
@@ -38,67 +39,20 @@ const int32_t handicapPerTileOffset = 20;
 
 BaseAI::BaseAI(GameMap& gameMap, Player& player):
     mGameMap(gameMap),
-    mPlayer(player)
+    mPlayer(player),
+    mRandom(Random::makeStream(RandomStreamType::seat, static_cast<uint64_t>(player.getSeat()->getId()))),
+    mBuildableAreaMap(gameMap)
 {
 }
 
 Room* BaseAI::getDungeonTemple()
 {
-    std::vector<Room*> dt = mGameMap.getRoomsByTypeAndSeat(RoomType::dungeonTemple, mPlayer.getSeat());
-    if(!dt.empty())
-        return dt.front();
-    else
-        return nullptr;
+    return mGameMap.getRoomsByTypeAndSeat(RoomType::dungeonTemple, mPlayer.getSeat()).front();
 }
 
-bool BaseAI::shouldGroundTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat)
+void BaseAI::notifyTileChanged(const Tile& tile)
 {
-    switch(tile->getType())
-    {
-        case TileType::dirt:
-        case TileType::gold:
-        {
-            // Dirt and gold can always be built (even if digging may be needed depending on fullness)
-            if(!tile->isClaimed())
-                return true;
-
-            // We check if we can build on that tile and if there is no building currently
-            if(!tile->isClaimedForSeat(mPlayerSeat))
-                return false;
-            if(tile->getCoveringBuilding() != nullptr)
-                return false;
-
-            // We don't want to break a wall where there are activespots from another one
-            for(Tile* t : tile->getAllNeighbors())
-            {
-                if(t->isClaimedForSeat(mPlayerSeat) &&
-                    (t->getCoveringRoom() != nullptr))
-                {
-                    return false;
-                }
-            }
-            return true;
-        }
-        default:
-            return false;
-    }
-
-    return false;
-}
-
-bool BaseAI::shouldWallTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* mPlayerSeat)
-{
-    // We only consider wall claimed for the correct seat or dirt (that can be claimed)
-    if(tile->getFullness() <= 0.0)
-        return false;
-
-    if(tile->getType() == TileType::dirt)
-        return true;
-
-    if(tile->isWallClaimedForSeat(mPlayerSeat))
-        return true;
-
-    return false;
+    mBuildableAreaMap.setTileDirty(tile);
 }
 
 //! To find the position, we try every square of the wantedSize width around the given tile for each possible distance
@@ -232,40 +186,24 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
 {
     int tileX = tile->getX();
     int tileY = tile->getY();
-    bool isOk = true;
 
-    // We check if the tile is reachable. No need to compute if the tile is behind rocks
     points = 0;
-    // We start by searching for a place fitting the min size. If we find it,
-    // we increase tile by tile until the max size. If not, no need to continue
-    for(int32_t xx = 0; xx < wantedSize; ++xx)
+    // The square has to be entirely inside the map and every tile has to be buildable
+    int x1 = tileX;
+    int y1 = tileY;
+    int x2 = tileX + wantedSize - 1;
+    int y2 = tileY + wantedSize - 1;
+    if(!bottomLeft2TopRight)
     {
-        for(int32_t yy = 0; yy < wantedSize; ++yy)
-        {
-            Tile* t;
-            if(bottomLeft2TopRight)
-                t  = mGameMap.getTile(tileX + xx, tileY + yy);
-            else
-                t  = mGameMap.getTile(tileX - xx, tileY - yy);
-
-            if(t == nullptr)
-            {
-                isOk = false;
-                break;
-            }
-
-            if(!shouldGroundTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            {
-                isOk = false;
-                break;
-            }
-        }
-
-        if(!isOk)
-            break;
+        x1 = tileX - wantedSize + 1;
+        y1 = tileY - wantedSize + 1;
+        x2 = tileX;
+        y2 = tileY;
     }
+    if((x1 < 0) || (y1 < 0) || (x2 >= mGameMap.getMapSizeX()) || (y2 >= mGameMap.getMapSizeY()))
+        return false;
 
-    if(!isOk)
+    if(mBuildableAreaMap.countBuildableGround(mPlayerSeat, x1, y1, x2, y2) != wantedSize * wantedSize)
         return false;
 
     // If we don't want to consider walls, we stop here (for example for rooms that do not have bonus
@@ -273,123 +211,43 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
     if(!useWalls)
         return true;
 
-    // We search points for first wall. That's not exactly how the activespots will be computed but it will be enough (especially
+    // We search points for each wall. That's not exactly how the activespots will be computed but it will be enough (especially
     // when the room size is even)
-    int nbConsecutiveTiles;
-    int nbActiveWallSpots;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t  = mGameMap.getTile(tileX - 1, tileY + kk);
-        else
-            t  = mGameMap.getTile(tileX + 1, tileY - kk);
-        if(t == nullptr)
-            continue;
-
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
-
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
-    }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for second wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + wantedSize, tileY + kk);
-        else
-            t = mGameMap.getTile(tileX - wantedSize, tileY - kk);
-        if(t == nullptr)
-            continue;
-
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
-
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
-    }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
-    {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY - 1);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY + 1);
-        if(t == nullptr)
-            continue;
+    int dir = bottomLeft2TopRight ? 1 : -1;
+    points += countWallActiveSpots(mPlayerSeat, tileX - dir, tileY, 0, dir, wantedSize) * pointsPerWallSpot;
+    points += countWallActiveSpots(mPlayerSeat, tileX + dir * wantedSize, tileY, 0, dir, wantedSize) * pointsPerWallSpot;
+    points += countWallActiveSpots(mPlayerSeat, tileX, tileY - dir, dir, 0, wantedSize) * pointsPerWallSpot;
+    points += countWallActiveSpots(mPlayerSeat, tileX, tileY + dir * wantedSize, dir, 0, wantedSize) * pointsPerWallSpot;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
-            ++nbConsecutiveTiles;
-        else
-            nbConsecutiveTiles = 0;
+    return true;
+}
 
-        if(nbActiveWallSpots == 0)
-        {
-            if(nbConsecutiveTiles >= 3)
-            {
-                nbConsecutiveTiles = 0;
-                ++nbActiveWallSpots;
-            }
-        }
-        else if(nbConsecutiveTiles >= 2)
-        {
-            nbConsecutiveTiles = 0;
-            ++nbActiveWallSpots;
-        }
-    }
-    points += nbActiveWallSpots * pointsPerWallSpot;
-    // We search points for first wall
-    nbConsecutiveTiles = 0;
-    nbActiveWallSpots = 0;
-    for(int32_t kk = 0; kk < wantedSize; ++kk)
+int32_t BaseAI::countWallActiveSpots(Seat* playerSeat, int x, int y, int dx, int dy, int32_t nbTiles)
+{
+    int xEnd = x + dx * (nbTiles - 1);
+    int yEnd = y + dy * (nbTiles - 1);
+    int32_t nbWalls = mBuildableAreaMap.countClaimableWalls(playerSeat, x, y, xEnd, yEnd);
+
+    // The first active spot needs 3 consecutive walls
+    if(nbWalls < 3)
+        return 0;
+
+    // If the whole wall can be used, the first spot takes 3 tiles and the next ones 2
+    if(nbWalls == nbTiles)
+        return 1 + (nbTiles - 3) / 2;
+
+    // The wall has holes. We count consecutive tiles the same way active spots are searched. Note
+    // that tiles outside the map are ignored
+    int32_t nbConsecutiveTiles = 0;
+    int32_t nbActiveWallSpots = 0;
+    for(int32_t kk = 0; kk < nbTiles; ++kk)
     {
-        Tile* t;
-        if(bottomLeft2TopRight)
-            t = mGameMap.getTile(tileX + kk, tileY + wantedSize);
-        else
-            t = mGameMap.getTile(tileX - kk, tileY - wantedSize);
-        if(t == nullptr)
+        int xx = x + dx * kk;
+        int yy = y + dy * kk;
+        if((xx < 0) || (yy < 0) || (xx >= mGameMap.getMapSizeX()) || (yy >= mGameMap.getMapSizeY()))
             continue;
 
-        if(shouldWallTileBeConsideredForBestPlaceForRoom(t, mPlayerSeat))
+        if(mBuildableAreaMap.isClaimableWall(playerSeat, xx, yy))
             ++nbConsecutiveTiles;
         else
             nbConsecutiveTiles = 0;
@@ -408,9 +266,8 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
             ++nbActiveWallSpots;
         }
     }
-    points += nbActiveWallSpots * pointsPerWallSpot;
 
-    return true;
+    return nbActiveWallSpots;
 }
 
 bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
@@ -18,6 +18,9 @@
 #ifndef BASEAI_H
 #define BASEAI_H
 
+#include "ai/BuildableAreaMap.h"
+#include "utils/Random.h"
+
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -44,6 +47,10 @@ public:
      */
     virtual bool doTurn(double timeSinceLastTurn) = 0;
 
+    //! \brief Called on server side when the claim, fullness or covering building of the
+    //! given tile changed.
+    void notifyTileChanged(const Tile& tile);
+
 protected:
     BaseAI(GameMap& gameMap, Player& player);
 
@@ -63,9 +70,18 @@ protected:
     GameMap& mGameMap;
     Player& mPlayer;
 
+    //! \brief Random stream of the AI seat. Using a dedicated stream makes the AI decisions
+    //! independent from the other random draws of the game
+    RandomStream mRandom;
+
 private:
-    bool shouldGroundTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
-    bool shouldWallTileBeConsideredForBestPlaceForRoom(Tile* tile, Seat* playerSeat);
+    //! \brief Buildable ground and claimable walls for the AI seat. Allows to check if a room
+    //! fits at a given place in constant time
+    BuildableAreaMap mBuildableAreaMap;
+
+    //! \brief Computes the number of active spots a wall of nbTiles tiles starting at (x, y) and going
+    //! in the (dx, dy) direction would give
+    int32_t countWallActiveSpots(Seat* playerSeat, int x, int y, int dx, int dy, int32_t nbTiles);
 };
 
 #endif // BASEAI_H
@@ -0,0 +1,242 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ai/BuildableAreaMap.h"
+
+#include "entities/Tile.h"
+#include "gamemap/GameMap.h"
+
+#include <algorithm>
+
+BuildableAreaMap::BuildableAreaMap(GameMap& gameMap) :
+    mGameMap(gameMap),
+    mSeat(nullptr),
+    mSizeX(0),
+    mSizeY(0),
+    mSumsOutdated(true)
+{
+}
+
+bool BuildableAreaMap::isGroundTileBuildable(const Tile& tile, const Seat* seat)
+{
+    switch(tile.getType())
+    {
+        case TileType::dirt:
+        case TileType::gold:
+        {
+            // Dirt and gold can always be built (even if digging may be needed depending on fullness)
+            if(!tile.isClaimed())
+                return true;
+
+            // We check if we can build on that tile and if there is no building currently
+            if(!tile.isClaimedForSeat(seat))
+                return false;
+            if(tile.getCoveringBuilding() != nullptr)
+                return false;
+
+            // We don't want to break a wall where there are activespots from another one
+            for(Tile* t : tile.getAllNeighbors())
+            {
+                if(t->isClaimedForSeat(seat) &&
+                    (t->getCoveringRoom() != nullptr))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+
+    return false;
+}
+
+bool BuildableAreaMap::isWallTileClaimable(Tile& tile, Seat* seat)
+{
+    // We only consider wall claimed for the correct seat or dirt (that can be claimed)
+    if(tile.getFullness() <= 0.0)
+        return false;
+
+    if(tile.getType() == TileType::dirt)
+        return true;
+
+    if(tile.isWallClaimedForSeat(seat))
+        return true;
+
+    return false;
+}
+
+void BuildableAreaMap::setTileDirty(const Tile& tile)
+{
+    // If the masks have not been computed yet, they will be computed entirely at the next query
+    if(mDirtyFlags.empty())
+        return;
+
+    // The ground state of a tile depends on its neighbors (rooms nearby)
+    setIndexDirty(tile.getX(), tile.getY());
+    for(Tile* t : tile.getAllNeighbors())
+        setIndexDirty(t->getX(), t->getY());
+}
+
+void BuildableAreaMap::setIndexDirty(int x, int y)
+{
+    if((x < 0) || (y < 0) || (x >= mSizeX) || (y >= mSizeY))
+        return;
+
+    int32_t index = x * mSizeY + y;
+    if(mDirtyFlags[index] != 0)
+        return;
+
+    mDirtyFlags[index] = 1;
+    mDirtyTiles.push_back(index);
+}
+
+void BuildableAreaMap::refresh(Seat* seat)
+{
+    if((seat != mSeat) ||
+       (mSizeX != mGameMap.getMapSizeX()) ||
+       (mSizeY != mGameMap.getMapSizeY()))
+    {
+        mSeat = seat;
+        computeAll();
+        return;
+    }
+
+    for(int32_t index : mDirtyTiles)
+    {
+        mDirtyFlags[index] = 0;
+        Tile* tile = mGameMap.getTile(index / mSizeY, index % mSizeY);
+        if(tile == nullptr)
+            continue;
+
+        uint8_t ground = isGroundTileBuildable(*tile, mSeat) ? 1 : 0;
+        uint8_t wall = isWallTileClaimable(*tile, mSeat) ? 1 : 0;
+        if((mGroundMask[index] == ground) && (mWallMask[index] == wall))
+            continue;
+
+        mGroundMask[index] = ground;
+        mWallMask[index] = wall;
+        mSumsOutdated = true;
+    }
+    mDirtyTiles.clear();
+
+    if(mSumsOutdated)
+        computeSums();
+}
+
+void BuildableAreaMap::computeAll()
+{
+    mSizeX = mGameMap.getMapSizeX();
+    mSizeY = mGameMap.getMapSizeY();
+    int32_t nbTiles = mSizeX * mSizeY;
+    mGroundMask.assign(nbTiles, 0);
+    mWallMask.assign(nbTiles, 0);
+    mDirtyFlags.assign(nbTiles, 0);
+    mDirtyTiles.clear();
+
+    for(int xx = 0; xx < mSizeX; ++xx)
+    {
+        for(int yy = 0; yy < mSizeY; ++yy)
+        {
+            Tile* tile = mGameMap.getTile(xx, yy);
+            if(tile == nullptr)
+                continue;
+
+            int32_t index = xx * mSizeY + yy;
+            mGroundMask[index] = isGroundTileBuildable(*tile, mSeat) ? 1 : 0;
+            mWallMask[index] = isWallTileClaimable(*tile, mSeat) ? 1 : 0;
+        }
+    }
+
+    computeSums();
+}
+
+void BuildableAreaMap::computeSums()
+{
+    int sumsSizeY = mSizeY + 1;
+    mGroundSums.assign((mSizeX + 1) * sumsSizeY, 0);
+    mWallSums.assign((mSizeX + 1) * sumsSizeY, 0);
+    for(int xx = 0; xx < mSizeX; ++xx)
+    {
+        int32_t rowGround = 0;
+        int32_t rowWall = 0;
+        for(int yy = 0; yy < mSizeY; ++yy)
+        {
+            int32_t index = xx * mSizeY + yy;
+            rowGround += mGroundMask[index];
+            rowWall += mWallMask[index];
+
+            int32_t indexSum = (xx + 1) * sumsSizeY + yy + 1;
+            mGroundSums[indexSum] = mGroundSums[indexSum - sumsSizeY] + rowGround;
+            mWallSums[indexSum] = mWallSums[indexSum - sumsSizeY] + rowWall;
+        }
+    }
+    mSumsOutdated = false;
+}
+
+int32_t BuildableAreaMap::rectangleSum(const std::vector<int32_t>& sums, int sizeY,
+    int x1, int y1, int x2, int y2)
+{
+    int sumsSizeY = sizeY + 1;
+    return sums[(x2 + 1) * sumsSizeY + y2 + 1]
+        - sums[x1 * sumsSizeY + y2 + 1]
+        - sums[(x2 + 1) * sumsSizeY + y1]
+        + sums[x1 * sumsSizeY + y1];
+}
+
+bool BuildableAreaMap::clip(int& x1, int& y1, int& x2, int& y2) const
+{
+    if(x1 > x2)
+        std::swap(x1, x2);
+    if(y1 > y2)
+        std::swap(y1, y2);
+
+    x1 = std::max(x1, 0);
+    y1 = std::max(y1, 0);
+    x2 = std::min(x2, mSizeX - 1);
+    y2 = std::min(y2, mSizeY - 1);
+
+    return (x1 <= x2) && (y1 <= y2);
+}
+
+int32_t BuildableAreaMap::countBuildableGround(Seat* seat, int x1, int y1, int x2, int y2)
+{
+    refresh(seat);
+    if(!clip(x1, y1, x2, y2))
+        return 0;
+
+    return rectangleSum(mGroundSums, mSizeY, x1, y1, x2, y2);
+}
+
+int32_t BuildableAreaMap::countClaimableWalls(Seat* seat, int x1, int y1, int x2, int y2)
+{
+    refresh(seat);
+    if(!clip(x1, y1, x2, y2))
+        return 0;
+
+    return rectangleSum(mWallSums, mSizeY, x1, y1, x2, y2);
+}
+
+bool BuildableAreaMap::isClaimableWall(Seat* seat, int x, int y)
+{
+    refresh(seat);
+    if((x < 0) || (y < 0) || (x >= mSizeX) || (y >= mSizeY))
+        return false;
+
+    return mWallMask[x * mSizeY + y] != 0;
+}
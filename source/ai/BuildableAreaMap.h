@@ -0,0 +1,101 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUILDABLEAREAMAP_H
+#define BUILDABLEAREAMAP_H
+
+#include <cstdint>
+#include <vector>
+
+class GameMap;
+class Seat;
+class Tile;
+
+/*! \brief Keeps, for a given seat, a mask of the ground tiles where a room could be built and
+ * of the wall tiles that could be used as active spots. Each mask is backed by a summed-area table
+ * so that the number of matching tiles in any rectangle can be retrieved in constant time.
+ * Tiles are re-evaluated only when they are notified as changed (claim, dig, building). The
+ * summed-area tables are rebuilt lazily at the next query if at least one mask value changed.
+ */
+class BuildableAreaMap
+{
+public:
+    BuildableAreaMap(GameMap& gameMap);
+
+    //! \brief Tells that the given tile changed. The tile and its neighbors will be
+    //! re-evaluated at the next query
+    void setTileDirty(const Tile& tile);
+
+    //! \brief Returns the number of tiles in the rectangle [x1;x2]x[y1;y2] where a room could be
+    //! built for the given seat. Tiles outside the map are not counted
+    int32_t countBuildableGround(Seat* seat, int x1, int y1, int x2, int y2);
+
+    //! \brief Returns the number of wall tiles in the rectangle [x1;x2]x[y1;y2] that could be
+    //! used as active spots for the given seat. Tiles outside the map are not counted
+    int32_t countClaimableWalls(Seat* seat, int x1, int y1, int x2, int y2);
+
+    //! \brief Returns true if the wall tile at the given position could be used as active spot
+    //! for the given seat. Returns false if the position is outside the map
+    bool isClaimableWall(Seat* seat, int x, int y);
+
+    //! \brief Returns true if a room could be built on the given tile
+    static bool isGroundTileBuildable(const Tile& tile, const Seat* seat);
+
+    //! \brief Returns true if the given wall tile could be used as active spot
+    static bool isWallTileClaimable(Tile& tile, Seat* seat);
+
+private:
+    GameMap& mGameMap;
+
+    //! \brief Seat the masks have been computed for
+    Seat* mSeat;
+
+    int mSizeX;
+    int mSizeY;
+
+    //! \brief Masks are indexed by x * mSizeY + y
+    std::vector<uint8_t> mGroundMask;
+    std::vector<uint8_t> mWallMask;
+
+    //! \brief Summed-area tables indexed by x * (mSizeY + 1) + y. The first row and column
+    //! are 0 so that rectangle sums do not need any bound check
+    std::vector<int32_t> mGroundSums;
+    std::vector<int32_t> mWallSums;
+
+    //! \brief Tiles waiting to be re-evaluated. mDirtyFlags avoids inserting the same tile twice
+    std::vector<int32_t> mDirtyTiles;
+    std::vector<uint8_t> mDirtyFlags;
+
+    //! \brief true when a mask value changed since the summed-area tables were computed
+    bool mSumsOutdated;
+
+    void setIndexDirty(int x, int y);
+
+    //! \brief Re-evaluates the dirty tiles (or the whole map if the seat or the map size
+    //! changed) and rebuilds the summed-area tables if needed
+    void refresh(Seat* seat);
+    void computeAll();
+    void computeSums();
+
+    static int32_t rectangleSum(const std::vector<int32_t>& sums, int sizeY,
+        int x1, int y1, int x2, int y2);
+
+    //! \brief Clips the given rectangle to the map. Returns false if nothing remains
+    bool clip(int& x1, int& y1, int& x2, int& y2) const;
+};
+
+#endif // BUILDABLEAREAMAP_H
@@ -31,7 +31,7 @@
 #include "spells/SpellSummonWorker.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
-#include "utils/Random.h"
+#include "utils/Profiler.h"
 
 #include <vector>
 
@@ -75,6 +75,7 @@ KeeperAI::KeeperAI(GameMap& gameMap, Player& player, int cooldownDefenseMin, int
 
 bool KeeperAI::doTurn(double timeSinceLastTurn)
 {
+    OD_PROFILE_SCOPE("KeeperAI::doTurn");
     // If we have no dungeon temple, we are dead
     if(getDungeonTemple() == nullptr)
         return false;
@@ -115,6 +116,7 @@ bool KeeperAI::doTurn(double timeSinceLastTurn)
 
 bool KeeperAI::checkTreasury()
 {
+    OD_PROFILE_SCOPE("KeeperAI::checkTreasury");
     // If the treasury gets destroyed, we don't want the AI to build each turn the
     // free treasury
     if(mCooldownCheckTreasury > 0)
@@ -122,18 +124,11 @@ bool KeeperAI::checkTreasury()
         --mCooldownCheckTreasury;
         return false;
     }
-    mCooldownCheckTreasury = Random::Int(10,30);
+    mCooldownCheckTreasury = mRandom.Int(10,30);
 
-    int totalGold = 0;
-    int totalStorage = 0;
-    for(Room* room : mGameMap.getRooms())
-    {
-        if(room->getSeat() != mPlayer.getSeat())
-            continue;
-
-        totalGold += room->getTotalGoldStored();
-        totalStorage += room->getTotalGoldStorage();
-    }
+    // The seat gold is updated every turn from its treasuries
+    int totalGold = mPlayer.getSeat()->getGold();
+    int totalStorage = mPlayer.getSeat()->getGoldMax();
 
     // We want at least to be allowed to store 3000 gold
     if(totalStorage >= 3000)
@@ -152,8 +147,7 @@ bool KeeperAI::checkTreasury()
         return false;
 
     // We try in priority to gold next to an existing treasury
-    std::vector<Room*> treasuriesOwned = mGameMap.getRoomsByTypeAndSeat(RoomType::treasury, mPlayer.getSeat());
-    for(Room* treasury : treasuriesOwned)
+    for(Room* treasury : mGameMap.getRoomsByTypeAndSeat(RoomType::treasury, mPlayer.getSeat()))
     {
         for(Tile* tile : treasury->getCoveredTiles())
         {
@@ -283,13 +277,14 @@ bool KeeperAI::checkTreasury()
 
 bool KeeperAI::handleRooms()
 {
+    OD_PROFILE_SCOPE("KeeperAI::handleRooms");
     if(mCooldownLookingForRooms > 0)
     {
         --mCooldownLookingForRooms;
         return false;
     }
 
-    mCooldownLookingForRooms = Random::Int(mCooldownLookingForRoomsMin, mCooldownLookingForRoomsMax);
+    mCooldownLookingForRooms = mRandom.Int(mCooldownLookingForRoomsMin, mCooldownLookingForRoomsMax);
 
     // We check if the last built room is done
     if(mRoomSize != -1)
@@ -357,6 +352,7 @@ bool KeeperAI::handleRooms()
 
 bool KeeperAI::lookForGold()
 {
+    OD_PROFILE_SCOPE("KeeperAI::lookForGold");
     if (mNoMoreReachableGold)
         return false;
 
@@ -366,112 +362,19 @@ bool KeeperAI::lookForGold()
         return false;
     }
 
-    mCooldownLookingForGold = Random::Int(70,120);
+    mCooldownLookingForGold = mRandom.Int(70,120);
 
     // Do we need gold ?
-    int emptyStorage = 0;
-    for(Room* room : mGameMap.getRooms())
-    {
-        if(room->getSeat() != mPlayer.getSeat())
-            continue;
-
-        emptyStorage += (room->getTotalGoldStorage() - room->getTotalGoldStored());
-    }
+    int emptyStorage = mPlayer.getSeat()->getGoldMax() - mPlayer.getSeat()->getGold();
 
     // No need to search for gold
     if(emptyStorage < 100)
         return false;
 
     Tile* central = getDungeonTemple()->getCentralTile();
-    int widerSide = mGameMap.getMapSizeX() > mGameMap.getMapSizeY() ?
-        mGameMap.getMapSizeX() : mGameMap.getMapSizeY();
 
-    // We search for the closest gold tile
-    Tile* firstGoldTile = nullptr;
-    for(int32_t distance = 1; distance < widerSide; ++distance)
-    {
-        for(int k = 0; k <= distance; ++k)
-        {
-            Tile* t;
-            // North-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() + distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                // If we already have a tile at same distance, we randomly change to
-                // try to not be too predictable
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // North-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() + distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // South-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() - distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // South-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() - distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // East-North
-            t = mGameMap.getTile(central->getX() + distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // East-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() + distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // West-North
-            t = mGameMap.getTile(central->getX() - distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // West-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-
-            if(firstGoldTile != nullptr)
-                break;
-        }
-
-        // If we found a tile, no need to continue
-        if(firstGoldTile != nullptr)
-            break;
-    }
+    // We search for the closest gold tile our workers can dig to
+    Tile* firstGoldTile = mGameMap.getResourceIndex().getNearestGoldTile(*central, *mPlayer.getSeat(), mRandom);
 
     // No more gold
     if (firstGoldTile == nullptr)
@@ -602,12 +505,13 @@ bool KeeperAI::checkNeedRoom(RoomType roomType)
 
 void KeeperAI::saveWoundedCreatures()
 {
+    OD_PROFILE_SCOPE("KeeperAI::saveWoundedCreatures");
     if(mCooldownSaveWoundedCreatures > 0)
     {
         --mCooldownSaveWoundedCreatures;
         return;
     }
-    mCooldownSaveWoundedCreatures = Random::Int(mCooldownSaveWoundedCreaturesMin, mCooldownSaveWoundedCreaturesMax);
+    mCooldownSaveWoundedCreatures = mRandom.Int(mCooldownSaveWoundedCreaturesMin, mCooldownSaveWoundedCreaturesMax);
 
     Tile* dungeonTempleTile = getDungeonTemple()->getCentralTile();
     if(dungeonTempleTile == nullptr)
@@ -645,12 +549,13 @@ void KeeperAI::saveWoundedCreatures()
 
 void KeeperAI::handleDefense()
 {
+    OD_PROFILE_SCOPE("KeeperAI::handleDefense");
     if(mCooldownDefense > 0)
     {
         --mCooldownDefense;
         return;
     }
-    mCooldownDefense = Random::Int(mCooldownDefenseMin, mCooldownDefenseMax);
+    mCooldownDefense = mRandom.Int(mCooldownDefenseMin, mCooldownDefenseMax);
 
     Seat* seat = mPlayer.getSeat();
     // We drop creatures nearby owned or allied attacked creatures
@@ -700,13 +605,14 @@ void KeeperAI::handleDefense()
 
 bool KeeperAI::handleWorkers()
 {
+    OD_PROFILE_SCOPE("KeeperAI::handleWorkers");
     if(mCooldownWorkers > 0)
     {
         --mCooldownWorkers;
         return false;
     }
 
-    mCooldownWorkers = Random::Int(3,10);
+    mCooldownWorkers = mRandom.Int(3,10);
 
     // We want to use the first covered tile because the central might be destroyed and enemy claimed
     // and, if it is the case, we will not be able to spawn a worker.
@@ -719,7 +625,7 @@ bool KeeperAI::handleWorkers()
     // If we have less than 4 workers or we have the chance, we summon
     int nbWorkers = mPlayer.getSeat()->getNumCreaturesWorkers();
     if((nbWorkers < 4) ||
-       (Random::Int(0, nbWorkers * 3) == 0))
+       (mRandom.Int(0, nbWorkers * 3) == 0))
     {
         Tile* tile = getDungeonTemple()->getCoveredTile(0);
         std::vector<Tile*> tiles;
@@ -735,13 +641,14 @@ bool KeeperAI::handleWorkers()
 
 bool KeeperAI::repairRooms()
 {
+    OD_PROFILE_SCOPE("KeeperAI::repairRooms");
     if(mCooldownRepairRooms > 0)
     {
         --mCooldownRepairRooms;
         return false;
     }
 
-    mCooldownRepairRooms = Random::Int(20,60);
+    mCooldownRepairRooms = mRandom.Int(20,60);
 
     Seat* seat = mPlayer.getSeat();
     for(Room* room : mGameMap.getRooms())
@@ -768,6 +675,7 @@ bool KeeperAI::repairRooms()
 
 bool KeeperAI::handleTiredCreatures()
 {
+    OD_PROFILE_SCOPE("KeeperAI::handleTiredCreatures");
     // Handle tired creatures if we have a dormitory
     if(mPlayer.getSeat()->getNbRooms(RoomType::dormitory) <= 0)
         return false;
@@ -838,6 +746,7 @@ bool KeeperAI::handleTiredCreatures()
 
 bool KeeperAI::handleHungryCreatures()
 {
+    OD_PROFILE_SCOPE("KeeperAI::handleHungryCreatures");
     // Handle hungry creatures if we have a hatchery
     if(mPlayer.getSeat()->getNbRooms(RoomType::hatchery) <= 0)
         return false;
@@ -881,6 +790,7 @@ bool KeeperAI::handleHungryCreatures()
 
 void KeeperAI::handleFirstTurn()
 {
+    OD_PROFILE_SCOPE("KeeperAI::handleFirstTurn");
     Seat* seat = mPlayer.getSeat();
     // We set the skills to research. We start with pending skills to not modify research
     // order if it was already set in the level
@@ -18,9 +18,10 @@
 #ifndef CULLINGMANAGER_H_
 #define CULLINGMANAGER_H_
 
-#include "camera/SlopeWalk.h"
+#include "camera/TileSpans.h"
 
-#include "utils/VectorInt64.h"
+#include <cstdint>
+#include <vector>
 
 class GameMap;
 
@@ -43,29 +44,20 @@ namespace CullingType
  *  manage culling methods used in game. So far there is only
  *  one algorithm included : it is supposed to cull the Tiles.
  *  It should be started with the method startTileCulling.
-
- * Currently I try to implement the most general polygon rasterizing algorithm , that is :
- * 1. We choose the max and min points due to their Y value .
- * 2. We sort all the points by the angle value in it's polar representation
- * ( that is going , by visiting them clockwise due to the center of the polygon )
- * 3. Now we have two paths from which we can walk from top to down vertices : call them left and right .
- * 4. Between each following pair of vertices we can establish a >> slope << ,
- * which is just the the "a" in the eq. of linear form y = ax + b
- * 5. Now start drawing our polygon Row by Row From top to bottom .
- * Each Row has given the most left and rightmost tile due to use of both paths prepared before
- * -- Left path for tracing the most Leftmost Tile , Right path the most Rightmost Tile in each .
+ *
+ * The tiles seen by the camera are computed as spans of tiles per row (see TileSpans). Each frame,
+ * the new spans are compared with the previous ones and only the tiles entering or leaving the view
+ * have their culling flag changed. If the camera did not move enough to change the spans, nothing
+ * is done.
  */
 class CullingManager
 {
 public:
-    static const uint32_t HIDE =  1;
-    static const uint32_t SHOW =  2;
-
     CullingManager(GameMap* gameMap, uint32_t cullingMask);
 
     void startTileCulling(Ogre::Camera* camera, const std::vector<Ogre::Vector3>& ogreVectors);
 
-    void stopTileCulling(const std::vector<Ogre::Vector3>& ogreVectors);
+    void stopTileCulling();
 
     void update(Ogre::Camera* camera, const std::vector<Ogre::Vector3>& ogreVectors);
 
@@ -74,22 +66,16 @@ public:
     bool computeIntersectionPoints(Ogre::Camera* camera, std::vector<Ogre::Vector3>& ogreVectors);
 
 private:
-
     void cullTiles(const std::vector<Ogre::Vector3>& ogreVectors);
 
-    void hideAllTiles();
     void showAllTiles();
 
-    // set the new tiles
-    void newBashAndSplashTiles(uint32_t);
-
-    void sort(VectorInt64& p1, VectorInt64& p2, bool sortByX);
+    //! \brief Tiles currently shown
+    TileSpans mSpans;
 
-    // Objects representing past and present walk around the polygon
-    SlopeWalk mWalk;
-    SlopeWalk mOldWalk;
+    //! \brief Spans computed for the current frame. Kept as a member to avoid reallocating them each frame
+    TileSpans mNewSpans;
 
-    bool mFirstIter;
     GameMap* mGameMap;
 
     uint32_t mCullingMask;
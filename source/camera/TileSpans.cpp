@@ -0,0 +1,251 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "camera/TileSpans.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <OgrePlane.h>
+#include <OgreRay.h>
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const Ogre::Plane GROUND_PLANE(0, 0, 1, 0);
+
+//! \brief How much the quad is enlarged around its center. Chosen experimentally: it allows to display
+//! the walls that are not on the ground but are seen by the camera
+const double ZOOM_FACTOR = 1.0565;
+
+struct Point
+{
+    double x;
+    double y;
+};
+
+double cross(const Point& o, const Point& a, const Point& b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+//! \brief Returns the convex hull of the given points (monotone chain). The hull is counter clockwise
+std::vector<Point> convexHull(std::vector<Point> points)
+{
+    std::sort(points.begin(), points.end(), [](const Point& p1, const Point& p2)
+    {
+        return (p1.x < p2.x) || ((p1.x == p2.x) && (p1.y < p2.y));
+    });
+
+    std::vector<Point> hull(2 * points.size());
+    uint32_t nb = 0;
+    for(uint32_t i = 0; i < points.size(); ++i)
+    {
+        while((nb >= 2) && (cross(hull[nb - 2], hull[nb - 1], points[i]) <= 0))
+            --nb;
+        hull[nb++] = points[i];
+    }
+    for(uint32_t i = points.size() - 1, lower = nb + 1; i > 0; --i)
+    {
+        while((nb >= lower) && (cross(hull[nb - 2], hull[nb - 1], points[i - 1]) <= 0))
+            --nb;
+        hull[nb++] = points[i - 1];
+    }
+    // The last point is the same as the first one
+    hull.resize(nb > 1 ? nb - 1 : nb);
+    return hull;
+}
+
+//! \brief Converts a coordinate to a tile index clamped to [0, size - 1]. Clamping is done before
+//! the cast because the coordinates can be huge if the camera looks near the horizon
+int32_t clampToMap(double value, int32_t size)
+{
+    if(value < 0.0)
+        return 0;
+    if(value > static_cast<double>(size - 1))
+        return size - 1;
+    return static_cast<int32_t>(value);
+}
+}
+
+TileSpans::TileSpans() :
+    mYMin(0)
+{
+}
+
+bool TileSpans::computeIntersectionPoints(const Ogre::Vector3* cameraCorners, std::vector<Ogre::Vector3>& groundCorners)
+{
+    if(groundCorners.size() != 4)
+    {
+        OD_LOG_ERR("Unexpected size for groundCorners size=" + Helper::toString(groundCorners.size()));
+        return false;
+    }
+
+    bool isValid = true;
+    for(int ii = 0; ii < 4; ++ii)
+    {
+        Ogre::Ray ray(cameraCorners[ii], cameraCorners[ii + 4] - cameraCorners[ii]);
+        std::pair<bool, Ogre::Real> intersectionResult = ray.intersects(GROUND_PLANE);
+        if(!intersectionResult.first)
+        {
+            OD_LOG_ERR("I didn't find the intersection point for " + Helper::toString(ii) + "th ray ");
+            isValid = false;
+            continue;
+        }
+
+        groundCorners[ii] = ray.getPoint(intersectionResult.second);
+    }
+    return isValid;
+}
+
+void TileSpans::compute(const std::vector<Ogre::Vector3>& groundCorners, int32_t mapSizeX, int32_t mapSizeY)
+{
+    clear();
+    if(groundCorners.empty() || (mapSizeX <= 0) || (mapSizeY <= 0))
+        return;
+
+    Point center = {0.0, 0.0};
+    for(const Ogre::Vector3& corner : groundCorners)
+    {
+        center.x += corner.x;
+        center.y += corner.y;
+    }
+    center.x /= groundCorners.size();
+    center.y /= groundCorners.size();
+
+    std::vector<Point> points;
+    for(const Ogre::Vector3& corner : groundCorners)
+    {
+        Point point = {center.x + (corner.x - center.x) * ZOOM_FACTOR,
+            center.y + (corner.y - center.y) * ZOOM_FACTOR};
+        points.push_back(point);
+    }
+    std::vector<Point> hull = convexHull(points);
+
+    double polygonYMin = hull[0].y;
+    double polygonYMax = hull[0].y;
+    for(const Point& point : hull)
+    {
+        polygonYMin = std::min(polygonYMin, point.y);
+        polygonYMax = std::max(polygonYMax, point.y);
+    }
+
+    // Tile y covers [y - 0.5, y + 0.5]
+    if((polygonYMax < -0.5) || (polygonYMin > mapSizeY - 0.5))
+        return;
+
+    int32_t yMin = clampToMap(std::ceil(polygonYMin - 0.5), mapSizeY);
+    int32_t yMax = clampToMap(std::floor(polygonYMax + 0.5), mapSizeY);
+    for(int32_t y = yMin; y <= yMax; ++y)
+    {
+        // We compute the x extent of the polygon within the row band by clipping each edge to it
+        double bandMin = y - 0.5;
+        double bandMax = y + 0.5;
+        double xMin = std::numeric_limits<double>::max();
+        double xMax = std::numeric_limits<double>::lowest();
+        for(uint32_t i = 0; i < hull.size(); ++i)
+        {
+            const Point& p1 = hull[i];
+            const Point& p2 = hull[(i + 1) % hull.size()];
+            double edgeYMin = std::max(std::min(p1.y, p2.y), bandMin);
+            double edgeYMax = std::min(std::max(p1.y, p2.y), bandMax);
+            if(edgeYMin > edgeYMax)
+                continue;
+
+            if(p1.y == p2.y)
+            {
+                xMin = std::min(xMin, std::min(p1.x, p2.x));
+                xMax = std::max(xMax, std::max(p1.x, p2.x));
+                continue;
+            }
+
+            double slope = (p2.x - p1.x) / (p2.y - p1.y);
+            double x1 = p1.x + (edgeYMin - p1.y) * slope;
+            double x2 = p1.x + (edgeYMax - p1.y) * slope;
+            xMin = std::min(xMin, std::min(x1, x2));
+            xMax = std::max(xMax, std::max(x1, x2));
+        }
+
+        // Tile x covers [x - 0.5, x + 0.5]
+        std::pair<int32_t, int32_t> span(1, 0);
+        if((xMin <= xMax) && (xMax >= -0.5) && (xMin <= mapSizeX - 0.5))
+        {
+            span.first = clampToMap(std::ceil(xMin - 0.5), mapSizeX);
+            span.second = clampToMap(std::floor(xMax + 0.5), mapSizeX);
+        }
+
+        if(mSpans.empty())
+        {
+            // We do not store the empty rows at the beginning
+            if(span.first > span.second)
+                continue;
+
+            mYMin = y;
+        }
+        mSpans.push_back(span);
+    }
+
+    // Nor at the end
+    while(!mSpans.empty() && (mSpans.back().first > mSpans.back().second))
+        mSpans.pop_back();
+
+    if(mSpans.empty())
+        mYMin = 0;
+}
+
+void TileSpans::clear()
+{
+    mYMin = 0;
+    mSpans.clear();
+}
+
+bool TileSpans::contains(int32_t x, int32_t y) const
+{
+    int32_t xMin;
+    int32_t xMax;
+    if(!getSpan(y, xMin, xMax))
+        return false;
+
+    return (x >= xMin) && (x <= xMax);
+}
+
+uint32_t TileSpans::getNbTiles() const
+{
+    uint32_t nbTiles = 0;
+    for(const std::pair<int32_t, int32_t>& span : mSpans)
+    {
+        if(span.second >= span.first)
+            nbTiles += static_cast<uint32_t>(span.second - span.first + 1);
+    }
+    return nbTiles;
+}
+
+bool TileSpans::getSpan(int32_t y, int32_t& xMin, int32_t& xMax) const
+{
+    if((y < mYMin) || (y >= mYMin + static_cast<int32_t>(mSpans.size())))
+        return false;
+
+    const std::pair<int32_t, int32_t>& span = mSpans[y - mYMin];
+    if(span.first > span.second)
+        return false;
+
+    xMin = span.first;
+    xMax = span.second;
+    return true;
+}
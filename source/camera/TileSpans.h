@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TILESPANS_H
+#define TILESPANS_H
+
+#include <OgreVector3.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*! \brief The tiles seen by a camera, stored as one span of tiles per row. The spans are computed
+ * from the intersection of the camera frustum with the ground: a tile is visible if its square
+ * intersects this quad. Between two frames, only the tiles entering or leaving the spans need to be
+ * shown or hidden (see forEachDifference).
+ * This class does not depend on the GameMap or on the rendering so that it can be tested alone.
+ */
+class TileSpans
+{
+public:
+    TileSpans();
+
+    //! \brief Computes the points where the rays going through the corners of the camera frustum
+    //! intersect the ground. cameraCorners should be the 8 corners returned by
+    //! Ogre::Frustum::getWorldSpaceCorners. The 4 points are put in groundCorners. Returns false if
+    //! a ray does not intersect the ground (groundCorners is then not updated for this ray)
+    static bool computeIntersectionPoints(const Ogre::Vector3* cameraCorners, std::vector<Ogre::Vector3>& groundCorners);
+
+    //! \brief Computes the spans from the 4 ground corners of the camera. The quad is slightly
+    //! enlarged to also show the walls that are partially seen. The spans are clipped to the map
+    void compute(const std::vector<Ogre::Vector3>& groundCorners, int32_t mapSizeX, int32_t mapSizeY);
+
+    //! \brief Removes every span
+    void clear();
+
+    bool isEmpty() const
+    { return mSpans.empty(); }
+
+    bool contains(int32_t x, int32_t y) const;
+
+    //! \brief Returns the number of visible tiles
+    uint32_t getNbTiles() const;
+
+    bool operator==(const TileSpans& other) const
+    { return (mYMin == other.mYMin) && (mSpans == other.mSpans); }
+
+    bool operator!=(const TileSpans& other) const
+    { return !(*this == other); }
+
+    //! \brief Calls func(x, y) for each tile in spans
+    template<typename Func>
+    static void forEachTile(const TileSpans& spans, Func func)
+    {
+        for(uint32_t i = 0; i < spans.mSpans.size(); ++i)
+        {
+            for(int32_t x = spans.mSpans[i].first; x <= spans.mSpans[i].second; ++x)
+                func(x, spans.mYMin + static_cast<int32_t>(i));
+        }
+    }
+
+    //! \brief Calls func(x, y) for each tile in spans that is not in excluded. Only the rows of spans
+    //! are walked so that the cost depends on the number of tiles that changed, not on the size of the map
+    template<typename Func>
+    static void forEachDifference(const TileSpans& spans, const TileSpans& excluded, Func func)
+    {
+        for(uint32_t i = 0; i < spans.mSpans.size(); ++i)
+        {
+            int32_t y = spans.mYMin + static_cast<int32_t>(i);
+            int32_t xMin = spans.mSpans[i].first;
+            int32_t xMax = spans.mSpans[i].second;
+            int32_t excludedMin;
+            int32_t excludedMax;
+            if(!excluded.getSpan(y, excludedMin, excludedMax))
+            {
+                for(int32_t x = xMin; x <= xMax; ++x)
+                    func(x, y);
+                continue;
+            }
+
+            // Tiles on the left and on the right of the excluded span
+            for(int32_t x = xMin; x <= std::min(xMax, excludedMin - 1); ++x)
+                func(x, y);
+            for(int32_t x = std::max(xMin, excludedMax + 1); x <= xMax; ++x)
+                func(x, y);
+        }
+    }
+
+private:
+    //! \brief First row with a span
+    int32_t mYMin;
+
+    //! \brief First and last visible tile of each row from mYMin. The first and last rows are never
+    //! empty. An empty row (if the quad goes out of the map and back) has first > second
+    std::vector<std::pair<int32_t, int32_t>> mSpans;
+
+    //! \brief Returns false if there is no span for the given row
+    bool getSpan(int32_t y, int32_t& xMin, int32_t& xMax) const;
+};
+
+#endif // TILESPANS_H
@@ -20,8 +20,27 @@
 #include "entities/Creature.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
+#include "utils/Profiler.h"
 
 #include <istream>
+#include <vector>
+
+static ObjectPool& getCreatureActionPool()
+{
+    static ObjectPool* pool = new ObjectPool("CreatureAction");
+    return *pool;
+}
+
+void* CreatureAction::operator new(std::size_t size)
+{
+    return getCreatureActionPool().allocate(size);
+}
+
+void CreatureAction::operator delete(void* ptr, std::size_t size)
+{
+    getCreatureActionPool().deallocate(ptr, size);
+}
 
 std::string CreatureAction::toString(CreatureActionType actionType)
 {
@@ -103,3 +122,23 @@ std::string CreatureAction::toString(CreatureActionType actionType)
 
     return "unhandledAct=" + Helper::toString(static_cast<uint32_t>(actionType));
 }
+
+const char* CreatureAction::toProfilerName(CreatureActionType actionType)
+{
+    static const std::vector<const char*> names = []()
+    {
+        std::vector<const char*> ret;
+        for(uint32_t i = 0; i < static_cast<uint32_t>(CreatureActionType::nb); ++i)
+        {
+            std::string name = "CreatureAction::" + toString(static_cast<CreatureActionType>(i));
+            ret.push_back(Profiler::internName(name));
+        }
+        return ret;
+    }();
+
+    uint32_t index = static_cast<uint32_t>(actionType);
+    if(index >= names.size())
+        return "CreatureAction::unknown";
+
+    return names[index];
+}
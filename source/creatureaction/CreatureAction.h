@@ -66,6 +66,11 @@ public:
     virtual ~CreatureAction()
     {}
 
+    //! \brief Actions are pushed and popped very often so they are allocated from a pool shared
+    //! by every action type (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     virtual CreatureActionType getType() const = 0;
 
     inline void increaseNbTurn()
@@ -94,6 +99,9 @@ public:
 
     static std::string toString(CreatureActionType actionType);
 
+    //! \brief Returns the name used to profile the given action type
+    static const char* toProfilerName(CreatureActionType actionType);
+
 protected:
     Creature& mCreature;
 
@@ -23,12 +23,17 @@
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
 #include "gamemap/Pathfinding.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
 #include "utils/Random.h"
 
+static RoomConfigParam<double> HatcheryHungerPerChicken("HatcheryHungerPerChicken");
+static RoomConfigParam<uint32_t> HatcheryCooldownChickenMin("HatcheryCooldownChickenMin");
+static RoomConfigParam<uint32_t> HatcheryCooldownChickenMax("HatcheryCooldownChickenMax");
+static RoomConfigParam<double> HatcheryHpRecoveredPerChicken("HatcheryHpRecoveredPerChicken");
+
 CreatureActionEatChicken::CreatureActionEatChicken(Creature& creature, ChickenEntity& chicken) :
     CreatureAction(creature),
     mChicken(&chicken)
@@ -108,10 +113,10 @@ bool CreatureActionEatChicken::handleEatChicken(Creature& creature, ChickenEntit
 
     // We can eat the chicken
     chicken->eatChicken(&creature);
-    creature.foodEaten(ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHungerPerChicken"));
-    creature.setJobCooldown(Random::Int(ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMax")));
-    creature.setHP(creature.getHP() + ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHpRecoveredPerChicken"));
+    creature.foodEaten(HatcheryHungerPerChicken.get());
+    creature.setJobCooldown(Random::Int(HatcheryCooldownChickenMin.get(),
+        HatcheryCooldownChickenMax.get()));
+    creature.setHP(creature.getHP() + HatcheryHpRecoveredPerChicken.get());
     creature.computeCreatureOverlayHealthValue();
     Ogre::Vector3 walkDirection = Ogre::Vector3(chickenTile->getX(), chickenTile->getY(), 0) - creature.getPosition();
     walkDirection.normalise();
@@ -99,9 +99,8 @@ bool CreatureActionFindHome::handleFindHome(Creature& creature, bool forced)
     }
 
     // Check to see if we can walk to a dormitory that does have an open tile.
-    std::vector<Room*> tempRooms = creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::dormitory, creature.getSeat());
     std::vector<Tile*> availableDormitories;
-    for (Room* room : tempRooms)
+    for (Room* room : creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::dormitory, creature.getSeat()))
     {
         if(room->getType() != RoomType::dormitory)
         {
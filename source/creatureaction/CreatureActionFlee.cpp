@@ -54,8 +54,8 @@ bool CreatureActionFlee::handleFlee(Creature& creature, int32_t nbTurns)
     }
 
     // We try to go closer to the dungeon temple. If we are too near or if we cannot go there, we will flee randomly
-    std::vector<Room*> tempRooms = creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::dungeonTemple, creature.getSeat());
-    tempRooms = creature.getGameMap()->getReachableRooms(tempRooms, myTile, &creature);
+    std::vector<Room*> tempRooms = creature.getGameMap()->getReachableRooms(
+        creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::dungeonTemple, creature.getSeat()), myTile, &creature);
     if(!tempRooms.empty())
     {
         // We can go to one dungeon temple
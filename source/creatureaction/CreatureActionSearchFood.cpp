@@ -95,7 +95,7 @@ bool CreatureActionSearchFood::handleSearchFood(Creature& creature, bool forced)
 
     // We couldn't find a wandering chicken. We look for a room where we can eat
     // Get the list of hatchery controlled by our seat and make sure there is at least one.
-    std::vector<Room*> hatcheries = creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::hatchery, creature.getSeat());
+    BuildingView<Room> hatcheries = creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::hatchery, creature.getSeat());
     if (hatcheries.empty())
     {
         if((creature.getSeat()->getPlayer() != nullptr) &&
@@ -19,9 +19,6 @@
 
 #include "creaturemood/CreatureMoodManager.h"
 #include "entities/Creature.h"
-#include "entities/CreatureDefinition.h"
-#include "entities/GameEntityType.h"
-#include "gamemap/GameMap.h"
 #include "utils/LogManager.h"
 
 static const std::string CreatureMoodCreatureName = "Creature";
@@ -50,23 +47,7 @@ const std::string& CreatureMoodCreature::getModifierName() const
 
 int32_t CreatureMoodCreature::computeMood(const Creature& creature) const
 {
-    std::vector<GameEntity*> alliedCreatures = creature.getGameMap()->getVisibleCreatures(creature.getVisibleTiles(),
-        creature.getSeat(), false);
-    int nbCreatures = 0;
-    for(GameEntity* entity : alliedCreatures)
-    {
-        if(entity->getObjectType() != GameEntityType::creature)
-            continue;
-
-        if(&creature == entity)
-            continue;
-
-        Creature* alliedCreature = static_cast<Creature*>(entity);
-        if(alliedCreature->getDefinition()->getClassName() != mCreatureClass)
-            continue;
-
-        ++nbCreatures;
-    }
+    int32_t nbCreatures = static_cast<int32_t>(creature.getNbVisibleAlliedCreatures(mCreatureClass));
     return nbCreatures * mMoodModifier;
 }
 
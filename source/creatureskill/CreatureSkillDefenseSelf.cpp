@@ -24,6 +24,7 @@
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
 #include "spells/Spell.h"
+#include "utils/Symbol.h"
 
 #include <istream>
 
@@ -71,7 +72,8 @@ bool CreatureSkillDefenseSelf::tryUseSupport(GameMap& gameMap, Creature* creatur
 
     for(Tile* tile : creature->getCoveredTiles())
     {
-        Spell::fireSpellSound(*tile, "Defense");
+        static const Symbol soundDefense("Spells/Defense");
+        tile->getGameMap()->fireSpatialSound(*tile, soundDefense);
     }
 
     return true;
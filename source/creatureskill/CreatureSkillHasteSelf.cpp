@@ -23,6 +23,7 @@
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
 #include "spells/Spell.h"
+#include "utils/Symbol.h"
 
 #include <istream>
 
@@ -66,7 +67,8 @@ bool CreatureSkillHasteSelf::tryUseSupport(GameMap& gameMap, Creature* creature)
 
     for(Tile* tile : creature->getCoveredTiles())
     {
-        Spell::fireSpellSound(*tile, "Haste");
+        static const Symbol soundHaste("Spells/Haste");
+        tile->getGameMap()->fireSpatialSound(*tile, soundHaste);
     }
 
     return true;
@@ -23,6 +23,7 @@
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
 #include "spells/Spell.h"
+#include "utils/Symbol.h"
 
 #include <istream>
 
@@ -69,7 +70,8 @@ bool CreatureSkillHealSelf::tryUseSupport(GameMap& gameMap, Creature* creature)
 
     for(Tile* tile : creature->getCoveredTiles())
     {
-        Spell::fireSpellSound(*tile, "Heal");
+        static const Symbol soundHeal("Spells/Heal");
+        tile->getGameMap()->fireSpatialSound(*tile, soundHeal);
     }
 
     return true;
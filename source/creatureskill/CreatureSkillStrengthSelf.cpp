@@ -24,6 +24,7 @@
 #include "entities/Tile.h"
 #include "gamemap/GameMap.h"
 #include "spells/Spell.h"
+#include "utils/Symbol.h"
 
 #include <istream>
 
@@ -71,7 +72,8 @@ bool CreatureSkillStrengthSelf::tryUseSupport(GameMap& gameMap, Creature* creatu
 
     for(Tile* tile : creature->getCoveredTiles())
     {
-        Spell::fireSpellSound(*tile, "Heal");
+        static const Symbol soundHeal("Spells/Heal");
+        tile->getGameMap()->fireSpatialSound(*tile, soundHeal);
     }
 
     return true;
@@ -32,7 +32,7 @@ const double Building::DEFAULT_TILE_HP = 10.0;
 
 Building::~Building()
 {
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
     {
         delete p.second;
     }
@@ -113,7 +113,7 @@ bool Building::canBuildingBeRemoved()
 {
     // We check if a human player still have vision on one of the building tiles
     bool ret = true;
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
     {
         for(Seat* seat : p.second->mSeatsVision)
         {
@@ -133,7 +133,7 @@ bool Building::canBuildingBeRemoved()
     if(mBuildingObjects.empty())
         return ret;
 
-    for (const std::pair<Tile* const, RenderedMovableEntity*>& p : mBuildingObjects)
+    for (const std::pair<Tile*, BuildingObject*>& p : mBuildingObjects)
     {
         RenderedMovableEntity* obj = p.second;
         if(!obj->notifyRemoveAsked())
@@ -246,7 +246,7 @@ double Building::getHP(Tile *tile) const
 {
     if (tile != nullptr)
     {
-        std::map<Tile*, TileData*>::const_iterator tileSearched = mTileData.find(tile);
+        auto tileSearched = mTileData.find(tile);
         if(tileSearched == mTileData.end())
         {
             OD_LOG_ERR("couldn't find requested tile=" + Tile::displayAsString(tile));
@@ -259,7 +259,7 @@ double Building::getHP(Tile *tile) const
     // If the tile given was nullptr, we add the total HP of all the tiles in the room and return that.
     double total = 0.0;
 
-    for(const std::pair<Tile* const, TileData*>& p : mTileData)
+    for(const std::pair<Tile*, TileData*>& p : mTileData)
     {
         total += p.second->mHP;
     }
@@ -293,7 +293,7 @@ double Building::takeDamage(GameEntity* attacker, double absoluteDamage, double
 
     // We check if the building is still alive
     bool isAlive = false;
-    for (std::pair<Tile* const, TileData*>& p : mTileData)
+    for (std::pair<Tile*, TileData*>& p : mTileData)
     {
         if (p.second->mHP <= 0.0)
             continue;
@@ -23,6 +23,7 @@
 #ifndef BUILDING_H_
 #define BUILDING_H_
 
+#include "entities/DenseTileMap.h"
 #include "entities/GameEntity.h"
 
 class BuildingObject;
@@ -198,10 +199,10 @@ protected:
     void fireRemoveEntity(Seat* seat) override
     {}
 
-    std::map<Tile*, BuildingObject*> mBuildingObjects;
+    DenseTileMap<BuildingObject*> mBuildingObjects;
     std::vector<Tile*> mCoveredTiles;
     std::vector<Tile*> mCoveredTilesDestroyed;
-    std::map<Tile*, TileData*> mTileData;
+    DenseTileMap<TileData*> mTileData;
 };
 
 #endif // BUILDING_H_
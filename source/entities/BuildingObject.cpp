@@ -36,7 +36,7 @@
 
 BuildingObject::BuildingObject(GameMap* gameMap, Building& building, const std::string& meshName, Tile* targetTile,
         Ogre::Real x, Ogre::Real y, Ogre::Real z, Ogre::Real rotationAngle, bool hideCoveredTile, float opacity,
-        const std::string& initialAnimationState, bool initialAnimationLoop) :
+        const Symbol& initialAnimationState, bool initialAnimationLoop) :
     RenderedMovableEntity(
         gameMap,
         targetTile == nullptr ? building.getName() : building.getName() + "_" + Tile::displayAsString(targetTile),
@@ -52,7 +52,7 @@ BuildingObject::BuildingObject(GameMap* gameMap, Building& building, const std::
 
 BuildingObject::BuildingObject(GameMap* gameMap, Building& building, const std::string& meshName,
         Tile& targetTile, Ogre::Real rotationAngle, bool hideCoveredTile, float opacity,
-        const std::string& initialAnimationState, bool initialAnimationLoop) :
+        const Symbol& initialAnimationState, bool initialAnimationLoop) :
     RenderedMovableEntity(
         gameMap,
         building.getName() + "_" + Tile::displayAsString(&targetTile),
@@ -35,10 +35,10 @@ class BuildingObject: public RenderedMovableEntity
 public:
     BuildingObject(GameMap* gameMap, Building& building, const std::string& meshName, Tile* targetTile,
         Ogre::Real x, Ogre::Real y, Ogre::Real z, Ogre::Real rotationAngle, bool hideCoveredTile,
-        float opacity = 1.0f, const std::string& initialAnimationState = "", bool initialAnimationLoop = true);
+        float opacity = 1.0f, const Symbol& initialAnimationState = Symbol(), bool initialAnimationLoop = true);
     BuildingObject(GameMap* gameMap, Building& building, const std::string& meshName,
         Tile& targetTile, Ogre::Real rotationAngle, bool hideCoveredTile, float opacity = 1.0f,
-        const std::string& initialAnimationState = "", bool initialAnimationLoop = true);
+        const Symbol& initialAnimationState = Symbol(), bool initialAnimationLoop = true);
     BuildingObject(GameMap* gameMap);
 
     virtual GameEntityType getObjectType() const override;
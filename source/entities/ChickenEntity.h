@@ -35,6 +35,10 @@ public:
     ChickenEntity(GameMap* gameMap, const std::string& hatcheryName);
     ChickenEntity(GameMap* gameMap);
 
+    //! \brief Chickens are allocated from a pool (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     virtual void doUpkeep() override;
 
     virtual double getMoveSpeed() const override
@@ -73,6 +73,7 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
+#include "utils/Profiler.h"
 #include "utils/Random.h"
 
 #include <CEGUI/Event.h>
@@ -751,6 +752,7 @@ void Creature::dropCarriedEquipment()
 
 void Creature::doUpkeep()
 {
+    OD_PROFILE_SCOPE("Creature::doUpkeep");
     // If the creature is in jail, we check if it is still standing on it (if not picked up). If
     // not, it is free
     if((mSeatPrison != nullptr) &&
@@ -995,6 +997,7 @@ void Creature::doUpkeep()
             // We save the action type here because the action may be removed after calling
             // the action function
             CreatureActionType actType = act->getType();
+            OD_PROFILE_SCOPE(CreatureAction::toProfilerName(actType));
             std::function<bool()> func = act->action();
             loopBack = func();
             OD_LOG_DBG("creature=" + getName() + " trying action=" + CreatureAction::toString(actType) + ", result=" + std::string(loopBack?"1":"0"));
@@ -1901,62 +1904,103 @@ void Creature::updateStatsWindow(const std::string& txt)
     textWindow->setText(txt);
 }
 
-std::string Creature::getStatsText()
+void Creature::fillStats(CreatureStats& stats) const
 {
-    // The creatures are not refreshed at each turn so this information is relevant in the server
-    // GameMap only
-    const std::string formatTitleOn = "[font='MedievalSharp-12'][colour='CCBBBBFF']";
-    const std::string formatTitleOff = "[font='MedievalSharp-10'][colour='FFFFFFFF']";
+    stats.mIsWorker = getDefinition()->isWorker();
+    stats.mLevel = getLevel();
+    stats.mExp = mExp;
+    stats.mHp = mHp;
+    stats.mMaxHp = mMaxHP;
+    stats.mGoldCarried = mGoldCarried;
+    stats.mWakefulness = mWakefulness;
+    stats.mHunger = mHunger;
+    stats.mMoveSpeedGround = getMoveSpeedGround();
+    stats.mMoveSpeedWater = getMoveSpeedWater();
+    stats.mMoveSpeedLava = getMoveSpeedLava();
 
-    std::stringstream tempSS;
-    tempSS << formatTitleOn << "Characteristics" << formatTitleOff << std::endl;
-    tempSS << "Level: " << getLevel() << std::endl;
-    tempSS << "Experience: " << mExp << std::endl;
-    tempSS << "HP: " << getHP() << " / " << mMaxHP << std::endl;
-    tempSS << "Gold: " << mGoldCarried << std::endl;
-    if (!getDefinition()->isWorker())
+    stats.mWeaponL = CreatureStats::WeaponStats();
+    if(mWeaponL != nullptr)
     {
-        tempSS << "Wakefulness: " << mWakefulness << std::endl;
-        tempSS << "Hunger: " << mHunger << std::endl;
+        stats.mWeaponL.mHasWeapon = true;
+        stats.mWeaponL.mName = mWeaponL->getName();
+        stats.mWeaponL.mPhysicalDamage = mWeaponL->getPhysicalDamage();
+        stats.mWeaponL.mMagicalDamage = mWeaponL->getMagicalDamage();
+        stats.mWeaponL.mElementDamage = mWeaponL->getElementDamage();
     }
-    tempSS << "Move speed (G/W/L): " << getMoveSpeedGround() << " / "
-        << getMoveSpeedWater() << " / " << getMoveSpeedLava() << std::endl;
-    tempSS << "Weapons:" << std::endl;
-    if(mWeaponL == nullptr)
-        tempSS << " - Left: none" << std::endl;
-    else
-        tempSS << " - Left: " << mWeaponL->getName() << " | Damage (P/M/E): " << mWeaponL->getPhysicalDamage()
-               << " / " << mWeaponL->getMagicalDamage() << " / " << mWeaponL->getElementDamage() << std::endl;
-    if(mWeaponR == nullptr)
-        tempSS << " - Right: none" << std::endl;
-    else
-        tempSS << " - Right: " << mWeaponR->getName() << " | Damage (P/M/E): " << mWeaponR->getPhysicalDamage()
-               << " / " << mWeaponR->getMagicalDamage() << " / " << mWeaponR->getElementDamage() << std::endl;
-    tempSS << "Defense (P/M/E): " << getPhysicalDefense() << " / " << getMagicalDefense() << " / " << getElementDefense() << std::endl;
-    if (getDefinition()->isWorker())
+    stats.mWeaponR = CreatureStats::WeaponStats();
+    if(mWeaponR != nullptr)
     {
-        tempSS << "Dig rate: " << getDigRate() << std::endl;
-        tempSS << "Dance rate: " << mClaimRate << std::endl;
+        stats.mWeaponR.mHasWeapon = true;
+        stats.mWeaponR.mName = mWeaponR->getName();
+        stats.mWeaponR.mPhysicalDamage = mWeaponR->getPhysicalDamage();
+        stats.mWeaponR.mMagicalDamage = mWeaponR->getMagicalDamage();
+        stats.mWeaponR.mElementDamage = mWeaponR->getElementDamage();
     }
 
-    tempSS << formatTitleOn << "\nDebugging information" << formatTitleOff << std::endl;
-    tempSS << "Seat and team IDs: " << getSeat()->getId() << " / " << getSeat()->getTeamId() << std::endl;
-    tempSS << "Position: " << Helper::toString(getPosition()) << std::endl;
-    tempSS << "Actions:";
+    stats.mPhysicalDefense = getPhysicalDefense();
+    stats.mMagicalDefense = getMagicalDefense();
+    stats.mElementDefense = getElementDefense();
+    stats.mDigRate = getDigRate();
+    stats.mClaimRate = mClaimRate;
+    stats.mSeatId = getSeat()->getId();
+    stats.mTeamId = getSeat()->getTeamId();
+    stats.mPosition = getPosition();
+
+    stats.mActions.clear();
     for(const std::unique_ptr<CreatureAction>& ca : mActions)
+        stats.mActions.push_back(ca->getType());
+
+    stats.mDestinations.assign(mWalkQueue.begin(), mWalkQueue.end());
+    stats.mMoodValue = mMoodValue;
+    stats.mMoodPoints = mMoodPoints;
+}
+
+void Creature::addStatsWatcher(Player* player)
+{
+    if(std::find(mStatsWatchers.begin(), mStatsWatchers.end(), player) != mStatsWatchers.end())
+        return;
+
+    mStatsWatchers.push_back(player);
+
+    // The new watcher gets the current stats. We do not update mLastSentStats because the other
+    // watchers may not have received them yet
+    CreatureStats stats;
+    fillStats(stats);
+    ServerNotification *serverNotification = new ServerNotification(
+        ServerNotificationType::notifyCreatureInfo, player);
+    serverNotification->mPacket << getName();
+    stats.exportToPacket(serverNotification->mPacket);
+    ODServer::getSingleton().queueServerNotification(serverNotification);
+}
+
+void Creature::removeStatsWatcher(Player* player)
+{
+    auto it = std::find(mStatsWatchers.begin(), mStatsWatchers.end(), player);
+    if(it == mStatsWatchers.end())
+        return;
+
+    mStatsWatchers.erase(it);
+}
+
+void Creature::notifyStatsWatchers()
+{
+    if(mStatsWatchers.empty())
+        return;
+
+    CreatureStats stats;
+    fillStats(stats);
+    if(stats == mLastSentStats)
+        return;
+
+    mLastSentStats = stats;
+    for(Player* player : mStatsWatchers)
     {
-        tempSS << " " << CreatureAction::toString(ca.get()->getType());
-    }
-    tempSS << std::endl;
-    tempSS << "Destinations:";
-    for(const Ogre::Vector3& dest : mWalkQueue)
-    {
-        tempSS << " " << Helper::toStringWithoutZ(dest);
+        ServerNotification *serverNotification = new ServerNotification(
+            ServerNotificationType::notifyCreatureInfo, player);
+        serverNotification->mPacket << getName();
+        stats.exportToPacket(serverNotification->mPacket);
+        ODServer::getSingleton().queueServerNotification(serverNotification);
     }
-    tempSS << std::endl;
-    tempSS << "Mood: " << CreatureMood::toString(mMoodValue) << std::endl;
-    tempSS << "Mood points: " << Helper::toString(mMoodPoints) << std::endl;
-    return tempSS.str();
 }
 
 double Creature::takeDamage(GameEntity* attacker, double absoluteDamage, double physicalDamage, double magicalDamage, double elementDamage,
@@ -2350,7 +2394,7 @@ bool Creature::setDestination(Tile* tile)
     return true;
 }
 
-bool Creature::wanderRandomly(const std::string& animationState)
+bool Creature::wanderRandomly(const Symbol& animationState)
 {
     // We pick randomly a visible tile far away (at the end of visible tiles)
     if(mTilesWithinSightRadius.empty())
@@ -2770,37 +2814,38 @@ void Creature::setupDefinition(GameMap& gameMap, const CreatureDefinition& defau
 
 void Creature::fireCreatureSound(CreatureSound sound)
 {
+    static const Symbol soundDig("Creatures/Default/Dig");
+
     Tile* posTile = getPositionTile();
     if(posTile == nullptr)
         return;
 
-    std::string soundFamily;
+    Symbol soundFamily;
     switch(sound)
     {
         case CreatureSound::Pickup:
-            soundFamily = getDefinition()->getSoundFamilyPickup();
+            soundFamily = getDefinition()->getSoundPickup();
             break;
         case CreatureSound::Drop:
-            soundFamily = getDefinition()->getSoundFamilyDrop();
+            soundFamily = getDefinition()->getSoundDrop();
             break;
         case CreatureSound::Attack:
-            soundFamily = getDefinition()->getSoundFamilyAttack();
+            soundFamily = getDefinition()->getSoundAttack();
             break;
         case CreatureSound::Die:
-            soundFamily = getDefinition()->getSoundFamilyDie();
+            soundFamily = getDefinition()->getSoundDie();
             break;
         case CreatureSound::Slap:
-            soundFamily = getDefinition()->getSoundFamilySlap();
+            soundFamily = getDefinition()->getSoundSlap();
             break;
         case CreatureSound::Dig:
-            soundFamily = "Default/Dig";
+            soundFamily = soundDig;
             break;
         default:
             OD_LOG_ERR("Wrong CreatureSound value=" + Helper::toString(static_cast<uint32_t>(sound)));
             return;
     }
 
-    std::string soundComplete = "Creatures/" + soundFamily;
     for(Seat* seat : mSeatsWithVisionNotified)
     {
         if(seat->getPlayer() == nullptr)
@@ -2810,7 +2855,7 @@ void Creature::fireCreatureSound(CreatureSound sound)
 
         ServerNotification *serverNotification = new ServerNotification(
             ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << soundComplete << posTile->getX() << posTile->getY();
+        serverNotification->mPacket << soundFamily << posTile->getX() << posTile->getY();
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
 }
@@ -2840,8 +2885,42 @@ void Creature::decreaseWakefulness(double value)
     mWakefulness = std::max(0.0, mWakefulness - value);
 }
 
+uint32_t Creature::getNbVisibleAlliedCreatures(const std::string& className) const
+{
+    uint32_t nbCreatures = 0;
+    for(const std::pair<const CreatureDefinition*, uint32_t>& p : mVisibleAlliedCreaturesByDefinition)
+    {
+        if(p.first->getClassName() == className)
+            nbCreatures += p.second;
+    }
+    return nbCreatures;
+}
+
+void Creature::countVisibleAlliedCreatures()
+{
+    mVisibleAlliedCreaturesByDefinition.clear();
+    for(GameEntity* entity : mVisibleAlliedObjects)
+    {
+        if(entity->getObjectType() != GameEntityType::creature)
+            continue;
+
+        if(entity == this)
+            continue;
+
+        // There are only a few different definitions around a creature so a vector is enough
+        const CreatureDefinition* definition = static_cast<Creature*>(entity)->getDefinition();
+        auto it = std::find_if(mVisibleAlliedCreaturesByDefinition.begin(), mVisibleAlliedCreaturesByDefinition.end(),
+            [definition](const std::pair<const CreatureDefinition*, uint32_t>& p) { return p.first == definition; });
+        if(it != mVisibleAlliedCreaturesByDefinition.end())
+            ++it->second;
+        else
+            mVisibleAlliedCreaturesByDefinition.push_back(std::make_pair(definition, 1));
+    }
+}
+
 void Creature::computeMood()
 {
+    countVisibleAlliedCreatures();
     mMoodPoints = CreatureMoodManager::computeCreatureMoodModifiers(*this);
 
     CreatureMoodLevel oldMoodValue = mMoodValue;
@@ -21,6 +21,7 @@
 #ifndef CREATURE_H
 #define CREATURE_H
 
+#include "entities/CreatureStats.h"
 #include "entities/MovableGameEntity.h"
 
 #include <OgreVector2.h>
@@ -39,6 +40,7 @@ class CreatureOverlayStatus;
 class CreatureSkill;
 class GameMap;
 class ODPacket;
+class Player;
 class Room;
 class Weapon;
 
@@ -130,7 +132,19 @@ public:
     void destroyStatsWindow();
     bool CloseStatsWindow(const CEGUI::EventArgs& /*e*/);
     void updateStatsWindow(const std::string& txt);
-    std::string getStatsText();
+
+    //! \brief Fills the given snapshot with the values displayed in the stats window. The creatures are not
+    //! refreshed at each turn on client side so this should only be called on the server GameMap
+    void fillStats(CreatureStats& stats) const;
+
+    //! \brief Registers/unregisters a player having the stats window of this creature opened. The current
+    //! stats are sent to the player when it starts watching
+    void addStatsWatcher(Player* player);
+    void removeStatsWatcher(Player* player);
+
+    //! \brief Sends the stats to the watching players if they changed since the last time they were sent.
+    //! Does nothing if no player is watching
+    void notifyStatsWatchers();
 
     //! \brief Get the level of the object
     inline unsigned int getLevel() const
@@ -207,7 +221,7 @@ public:
     //! \brief Picks a destination far away in the visible tiles and goes there
     //! Returns true if a valid Tile was found. The creature will go there
     //! Returns false if no reachable Tile was found
-    bool wanderRandomly(const std::string& animationState);
+    bool wanderRandomly(const Symbol& animationState);
 
     void setHP(double nHP);
 
@@ -410,6 +424,10 @@ public:
     inline const std::vector<GameEntity*>& getReachableAlliedObjects() const
     { return mReachableAlliedObjects; }
 
+    //! \brief Returns the number of allied creatures of the given class (this creature excluded) seen
+    //! when the mood was last computed. Used by the mood modifiers
+    uint32_t getNbVisibleAlliedCreatures(const std::string& className) const;
+
     inline const std::vector<std::unique_ptr<CreatureAction>>& getActions() const
     { return mActions; }
 
@@ -687,6 +705,10 @@ private:
     std::vector<GameEntity*>        mVisibleEnemyObjects;
     std::vector<GameEntity*>        mVisibleAlliedObjects;
     std::vector<GameEntity*>        mReachableAlliedObjects;
+
+    //! \brief Number of visible allied creatures by definition. Counted from mVisibleAlliedObjects once
+    //! before computing the mood so that each mood modifier does not have to look at the visible tiles
+    std::vector<std::pair<const CreatureDefinition*, uint32_t>> mVisibleAlliedCreaturesByDefinition;
     std::vector<std::unique_ptr<CreatureAction>>    mActions;
     std::vector<Tile*>              mVisualDebugEntityTiles;
 
@@ -706,6 +728,12 @@ private:
     //! should not be used to check mood. If the mood is to be tested, mMoodValue should be used
     int32_t                         mMoodPoints;
 
+    //! \brief Players having the stats window of this creature opened (server side only)
+    std::vector<Player*>            mStatsWatchers;
+
+    //! \brief Last stats sent to mStatsWatchers
+    CreatureStats                   mLastSentStats;
+
     //! \brief Counts turns the creature is furious. If it stays like this for too long, it will become rogue
     int32_t                         mNbTurnFurious;
 
@@ -778,6 +806,9 @@ private:
 
     void computeMood();
 
+    //! \brief Fills mVisibleAlliedCreaturesByDefinition from mVisibleAlliedObjects
+    void countVisibleAlliedCreatures();
+
     void computeCreatureOverlayMoodValue();
 };
 
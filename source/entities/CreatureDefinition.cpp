@@ -117,6 +117,7 @@ CreatureDefinition::CreatureDefinition(
         mSoundFamilySlap    ("Default/Slap")
 {
     mXPTable.assign(MAX_LEVEL - 1, 100.0);
+    internSounds();
 }
 
 CreatureDefinition::CreatureDefinition(const CreatureDefinition& def) :
@@ -165,7 +166,12 @@ CreatureDefinition::CreatureDefinition(const CreatureDefinition& def) :
         mSoundFamilyDrop(def.mSoundFamilyDrop),
         mSoundFamilyAttack(def.mSoundFamilyAttack),
         mSoundFamilyDie(def.mSoundFamilyDie),
-        mSoundFamilySlap(def.mSoundFamilySlap)
+        mSoundFamilySlap(def.mSoundFamilySlap),
+        mSoundPickup(def.mSoundPickup),
+        mSoundDrop(def.mSoundDrop),
+        mSoundAttack(def.mSoundAttack),
+        mSoundDie(def.mSoundDie),
+        mSoundSlap(def.mSoundSlap)
 {
     for(const double& xp : def.mXPTable)
     {
@@ -338,6 +344,7 @@ ODPacket& operator>>(ODPacket& is, CreatureDefinition* c)
     is >> c->mSoundFamilyAttack;
     is >> c->mSoundFamilyDie;
     is >> c->mSoundFamilySlap;
+    c->internSounds();
 
     for (unsigned int i = 0; i < c->mXPTable.size(); ++i)
     {
@@ -349,7 +356,7 @@ ODPacket& operator>>(ODPacket& is, CreatureDefinition* c)
     return is;
 }
 
-CreatureDefinition* CreatureDefinition::load(std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
+CreatureDefinition* CreatureDefinition::load(std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
 {
     if (!defFile.good())
         return nullptr;
@@ -365,7 +372,7 @@ CreatureDefinition* CreatureDefinition::load(std::stringstream& defFile, const s
 
 }
 
-bool CreatureDefinition::update(CreatureDefinition* creatureDef, std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
+bool CreatureDefinition::update(CreatureDefinition* creatureDef, std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap)
 {
     std::string nextParam;
     bool exit = false;
@@ -716,10 +723,20 @@ bool CreatureDefinition::update(CreatureDefinition* creatureDef, std::stringstre
     }
     creatureDef->mClassName = name;
     creatureDef->mBaseDefinition = baseDefinition;
+    creatureDef->internSounds();
 
     return true;
 }
 
+void CreatureDefinition::internSounds()
+{
+    mSoundPickup = Symbol("Creatures/" + mSoundFamilyPickup);
+    mSoundDrop = Symbol("Creatures/" + mSoundFamilyDrop);
+    mSoundAttack = Symbol("Creatures/" + mSoundFamilyAttack);
+    mSoundDie = Symbol("Creatures/" + mSoundFamilyDie);
+    mSoundSlap = Symbol("Creatures/" + mSoundFamilySlap);
+}
+
 void CreatureDefinition::writeCreatureDefinitionDiff(
     const CreatureDefinition* def1, const CreatureDefinition* def2,
     std::ostream& file, const std::map<std::string, CreatureDefinition*>& defMap)
@@ -1002,7 +1019,7 @@ void CreatureDefinition::writeCreatureDefinitionDiff(
     file << "[/Creature]" << std::endl;
 }
 
-void CreatureDefinition::loadXPTable(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadXPTable(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1042,7 +1059,7 @@ void CreatureDefinition::loadXPTable(std::stringstream& defFile, CreatureDefinit
     }
 }
 
-void CreatureDefinition::loadCreatureSkills(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadCreatureSkills(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1082,7 +1099,7 @@ void CreatureDefinition::loadCreatureSkills(std::stringstream& defFile, Creature
     }
 }
 
-void CreatureDefinition::loadCreatureBehaviours(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadCreatureBehaviours(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1122,7 +1139,7 @@ void CreatureDefinition::loadCreatureBehaviours(std::stringstream& defFile, Crea
     }
 }
 
-void CreatureDefinition::loadCreatureMoods(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadCreatureMoods(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     if (creatureDef == nullptr)
     {
@@ -1162,7 +1179,7 @@ void CreatureDefinition::loadCreatureMoods(std::stringstream& defFile, CreatureD
     }
 }
 
-void CreatureDefinition::loadRoomAffinity(std::stringstream& defFile, CreatureDefinition* creatureDef)
+void CreatureDefinition::loadRoomAffinity(std::istream& defFile, CreatureDefinition* creatureDef)
 {
     OD_ASSERT_TRUE(creatureDef != nullptr);
     if (creatureDef == nullptr)
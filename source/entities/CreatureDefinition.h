@@ -18,6 +18,8 @@
 #ifndef CREATUREDEFINITION_H
 #define CREATUREDEFINITION_H
 
+#include "utils/Symbol.h"
+
 #include <OgreVector3.h>
 
 #include <string>
@@ -139,8 +141,8 @@ public:
 
     //! \brief Loads a definition from the creature definition file sub [Creature][/Creature] part
     //! \returns A creature definition if valid, nullptr otherwise.
-    static CreatureDefinition* load(std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
-    static bool update(CreatureDefinition* creatureDef, std::stringstream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
+    static CreatureDefinition* load(std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
+    static bool update(CreatureDefinition* creatureDef, std::istream& defFile, const std::map<std::string, CreatureDefinition*>& defMap);
 
     inline CreatureJob          getCreatureJob  () const    { return mCreatureJob; }
     inline const std::string&   getClassName    () const    { return mClassName; }
@@ -228,6 +230,19 @@ public:
     inline const std::string& getSoundFamilySlap() const
     { return mSoundFamilySlap; }
 
+    //! \brief Interned sound families (including the Creatures/ directory) used when the creature
+    //! plays a sound
+    inline const Symbol& getSoundPickup() const
+    { return mSoundPickup; }
+    inline const Symbol& getSoundDrop() const
+    { return mSoundDrop; }
+    inline const Symbol& getSoundAttack() const
+    { return mSoundAttack; }
+    inline const Symbol& getSoundDie() const
+    { return mSoundDie; }
+    inline const Symbol& getSoundSlap() const
+    { return mSoundSlap; }
+
 private:
     //! \brief The job of the creature (e.g. worker, fighter, ...)
     CreatureJob mCreatureJob;
@@ -351,20 +366,30 @@ private:
     std::string mSoundFamilyDie;
     std::string mSoundFamilySlap;
 
+    //! \brief Sound families interned by internSounds
+    Symbol mSoundPickup;
+    Symbol mSoundDrop;
+    Symbol mSoundAttack;
+    Symbol mSoundDie;
+    Symbol mSoundSlap;
+
+    //! \brief Interns the sound families. Should be called each time they are changed
+    void internSounds();
+
     //! \brief Loads the creature XP values for the given definition.
-    static void loadXPTable(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadXPTable(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature skills for the given definition.
-    static void loadCreatureSkills(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadCreatureSkills(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature specific behaviours for the given definition.
-    static void loadCreatureBehaviours(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadCreatureBehaviours(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature specific mood modifiers for the given definition.
-    static void loadCreatureMoods(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadCreatureMoods(std::istream& defFile, CreatureDefinition* creatureDef);
 
     //! \brief Loads the creature room affinity for the given definition.
-    static void loadRoomAffinity(std::stringstream& defFile, CreatureDefinition* creatureDef);
+    static void loadRoomAffinity(std::istream& defFile, CreatureDefinition* creatureDef);
 };
 
 #endif // CREATUREDEFINITION_H
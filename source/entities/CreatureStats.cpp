@@ -0,0 +1,254 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "entities/CreatureStats.h"
+
+#include "creatureaction/CreatureAction.h"
+#include "creaturemood/CreatureMood.h"
+#include "network/ODPacket.h"
+#include "utils/Helper.h"
+
+#include <sstream>
+
+static void exportWeaponToPacket(ODPacket& os, const CreatureStats::WeaponStats& weapon)
+{
+    os << weapon.mHasWeapon;
+    if(!weapon.mHasWeapon)
+        return;
+
+    os << weapon.mName << weapon.mPhysicalDamage << weapon.mMagicalDamage << weapon.mElementDamage;
+}
+
+static bool importWeaponFromPacket(ODPacket& is, CreatureStats::WeaponStats& weapon)
+{
+    if(!(is >> weapon.mHasWeapon))
+        return false;
+
+    if(!weapon.mHasWeapon)
+    {
+        weapon = CreatureStats::WeaponStats();
+        return true;
+    }
+
+    return static_cast<bool>(is >> weapon.mName >> weapon.mPhysicalDamage >> weapon.mMagicalDamage >> weapon.mElementDamage);
+}
+
+static void writeWeapon(std::stringstream& ss, const std::string& side, const CreatureStats::WeaponStats& weapon)
+{
+    if(!weapon.mHasWeapon)
+    {
+        ss << " - " << side << ": none" << std::endl;
+        return;
+    }
+
+    ss << " - " << side << ": " << weapon.mName << " | Damage (P/M/E): " << weapon.mPhysicalDamage
+       << " / " << weapon.mMagicalDamage << " / " << weapon.mElementDamage << std::endl;
+}
+
+CreatureStats::CreatureStats() :
+    mIsWorker(false),
+    mLevel(0),
+    mExp(0.0),
+    mHp(0.0),
+    mMaxHp(0.0),
+    mGoldCarried(0),
+    mWakefulness(0.0),
+    mHunger(0.0),
+    mMoveSpeedGround(0.0),
+    mMoveSpeedWater(0.0),
+    mMoveSpeedLava(0.0),
+    mPhysicalDefense(0.0),
+    mMagicalDefense(0.0),
+    mElementDefense(0.0),
+    mDigRate(0.0),
+    mClaimRate(0.0),
+    mSeatId(-1),
+    mTeamId(-1),
+    mPosition(Ogre::Vector3::ZERO),
+    mMoodValue(CreatureMoodLevel::Neutral),
+    mMoodPoints(0)
+{
+}
+
+bool CreatureStats::WeaponStats::operator==(const WeaponStats& other) const
+{
+    return (mHasWeapon == other.mHasWeapon) &&
+        (mName == other.mName) &&
+        (mPhysicalDamage == other.mPhysicalDamage) &&
+        (mMagicalDamage == other.mMagicalDamage) &&
+        (mElementDamage == other.mElementDamage);
+}
+
+bool CreatureStats::operator==(const CreatureStats& other) const
+{
+    return (mIsWorker == other.mIsWorker) &&
+        (mLevel == other.mLevel) &&
+        (mExp == other.mExp) &&
+        (mHp == other.mHp) &&
+        (mMaxHp == other.mMaxHp) &&
+        (mGoldCarried == other.mGoldCarried) &&
+        (mWakefulness == other.mWakefulness) &&
+        (mHunger == other.mHunger) &&
+        (mMoveSpeedGround == other.mMoveSpeedGround) &&
+        (mMoveSpeedWater == other.mMoveSpeedWater) &&
+        (mMoveSpeedLava == other.mMoveSpeedLava) &&
+        (mWeaponL == other.mWeaponL) &&
+        (mWeaponR == other.mWeaponR) &&
+        (mPhysicalDefense == other.mPhysicalDefense) &&
+        (mMagicalDefense == other.mMagicalDefense) &&
+        (mElementDefense == other.mElementDefense) &&
+        (mDigRate == other.mDigRate) &&
+        (mClaimRate == other.mClaimRate) &&
+        (mSeatId == other.mSeatId) &&
+        (mTeamId == other.mTeamId) &&
+        (mPosition == other.mPosition) &&
+        (mActions == other.mActions) &&
+        (mDestinations == other.mDestinations) &&
+        (mMoodValue == other.mMoodValue) &&
+        (mMoodPoints == other.mMoodPoints);
+}
+
+void CreatureStats::exportToPacket(ODPacket& os) const
+{
+    os << mIsWorker << static_cast<uint32_t>(mLevel) << mExp << mHp << mMaxHp;
+    os << static_cast<int32_t>(mGoldCarried) << mWakefulness << mHunger;
+    os << mMoveSpeedGround << mMoveSpeedWater << mMoveSpeedLava;
+    exportWeaponToPacket(os, mWeaponL);
+    exportWeaponToPacket(os, mWeaponR);
+    os << mPhysicalDefense << mMagicalDefense << mElementDefense;
+    os << mDigRate << mClaimRate;
+    os << static_cast<int32_t>(mSeatId) << static_cast<int32_t>(mTeamId) << mPosition;
+
+    uint32_t nbActions = static_cast<uint32_t>(mActions.size());
+    os << nbActions;
+    for(CreatureActionType actionType : mActions)
+        os << static_cast<int32_t>(actionType);
+
+    uint32_t nbDestinations = static_cast<uint32_t>(mDestinations.size());
+    os << nbDestinations;
+    for(const Ogre::Vector3& dest : mDestinations)
+        os << dest;
+
+    os << static_cast<int32_t>(mMoodValue) << mMoodPoints;
+}
+
+bool CreatureStats::importFromPacket(ODPacket& is)
+{
+    uint32_t level;
+    int32_t goldCarried;
+    if(!(is >> mIsWorker >> level >> mExp >> mHp >> mMaxHp >> goldCarried >> mWakefulness >> mHunger))
+        return false;
+    mLevel = level;
+    mGoldCarried = goldCarried;
+
+    if(!(is >> mMoveSpeedGround >> mMoveSpeedWater >> mMoveSpeedLava))
+        return false;
+
+    if(!importWeaponFromPacket(is, mWeaponL))
+        return false;
+    if(!importWeaponFromPacket(is, mWeaponR))
+        return false;
+
+    int32_t seatId;
+    int32_t teamId;
+    if(!(is >> mPhysicalDefense >> mMagicalDefense >> mElementDefense >> mDigRate >> mClaimRate
+        >> seatId >> teamId >> mPosition))
+    {
+        return false;
+    }
+    mSeatId = seatId;
+    mTeamId = teamId;
+
+    uint32_t nbActions;
+    if(!(is >> nbActions))
+        return false;
+    mActions.clear();
+    for(uint32_t i = 0; i < nbActions; ++i)
+    {
+        int32_t actionType;
+        if(!(is >> actionType))
+            return false;
+        mActions.push_back(static_cast<CreatureActionType>(actionType));
+    }
+
+    uint32_t nbDestinations;
+    if(!(is >> nbDestinations))
+        return false;
+    mDestinations.clear();
+    for(uint32_t i = 0; i < nbDestinations; ++i)
+    {
+        Ogre::Vector3 dest;
+        if(!(is >> dest))
+            return false;
+        mDestinations.push_back(dest);
+    }
+
+    int32_t moodValue;
+    if(!(is >> moodValue >> mMoodPoints))
+        return false;
+    mMoodValue = static_cast<CreatureMoodLevel>(moodValue);
+
+    return true;
+}
+
+std::string CreatureStats::getStatsText() const
+{
+    const std::string formatTitleOn = "[font='MedievalSharp-12'][colour='CCBBBBFF']";
+    const std::string formatTitleOff = "[font='MedievalSharp-10'][colour='FFFFFFFF']";
+
+    std::stringstream tempSS;
+    tempSS << formatTitleOn << "Characteristics" << formatTitleOff << std::endl;
+    tempSS << "Level: " << mLevel << std::endl;
+    tempSS << "Experience: " << mExp << std::endl;
+    tempSS << "HP: " << mHp << " / " << mMaxHp << std::endl;
+    tempSS << "Gold: " << mGoldCarried << std::endl;
+    if (!mIsWorker)
+    {
+        tempSS << "Wakefulness: " << mWakefulness << std::endl;
+        tempSS << "Hunger: " << mHunger << std::endl;
+    }
+    tempSS << "Move speed (G/W/L): " << mMoveSpeedGround << " / "
+        << mMoveSpeedWater << " / " << mMoveSpeedLava << std::endl;
+    tempSS << "Weapons:" << std::endl;
+    writeWeapon(tempSS, "Left", mWeaponL);
+    writeWeapon(tempSS, "Right", mWeaponR);
+    tempSS << "Defense (P/M/E): " << mPhysicalDefense << " / " << mMagicalDefense << " / " << mElementDefense << std::endl;
+    if (mIsWorker)
+    {
+        tempSS << "Dig rate: " << mDigRate << std::endl;
+        tempSS << "Dance rate: " << mClaimRate << std::endl;
+    }
+
+    tempSS << formatTitleOn << "\nDebugging information" << formatTitleOff << std::endl;
+    tempSS << "Seat and team IDs: " << mSeatId << " / " << mTeamId << std::endl;
+    tempSS << "Position: " << Helper::toString(mPosition) << std::endl;
+    tempSS << "Actions:";
+    for(CreatureActionType actionType : mActions)
+    {
+        tempSS << " " << CreatureAction::toString(actionType);
+    }
+    tempSS << std::endl;
+    tempSS << "Destinations:";
+    for(const Ogre::Vector3& dest : mDestinations)
+    {
+        tempSS << " " << Helper::toStringWithoutZ(dest);
+    }
+    tempSS << std::endl;
+    tempSS << "Mood: " << CreatureMood::toString(mMoodValue) << std::endl;
+    tempSS << "Mood points: " << Helper::toString(mMoodPoints) << std::endl;
+    return tempSS.str();
+}
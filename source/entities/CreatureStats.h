@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CREATURESTATS_H
+#define CREATURESTATS_H
+
+#include <OgreVector3.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ODPacket;
+
+enum class CreatureActionType;
+enum class CreatureMoodLevel;
+
+/*! \brief Snapshot of the values displayed in the creature stats window. It is filled by the server
+ * and sent to the clients having the window opened only when it differs from the last sent one. The
+ * text is formatted by the client.
+ */
+class CreatureStats
+{
+public:
+    CreatureStats();
+
+    struct WeaponStats
+    {
+        WeaponStats() :
+            mHasWeapon(false),
+            mPhysicalDamage(0.0),
+            mMagicalDamage(0.0),
+            mElementDamage(0.0)
+        {}
+
+        bool operator==(const WeaponStats& other) const;
+
+        bool mHasWeapon;
+        std::string mName;
+        double mPhysicalDamage;
+        double mMagicalDamage;
+        double mElementDamage;
+    };
+
+    bool operator==(const CreatureStats& other) const;
+
+    inline bool operator!=(const CreatureStats& other) const
+    { return !(*this == other); }
+
+    void exportToPacket(ODPacket& os) const;
+    bool importFromPacket(ODPacket& is);
+
+    //! \brief Returns the formatted text displayed in the stats window
+    std::string getStatsText() const;
+
+    bool mIsWorker;
+    unsigned int mLevel;
+    double mExp;
+    double mHp;
+    double mMaxHp;
+    int mGoldCarried;
+    double mWakefulness;
+    double mHunger;
+    double mMoveSpeedGround;
+    double mMoveSpeedWater;
+    double mMoveSpeedLava;
+    WeaponStats mWeaponL;
+    WeaponStats mWeaponR;
+    double mPhysicalDefense;
+    double mMagicalDefense;
+    double mElementDefense;
+    double mDigRate;
+    double mClaimRate;
+    int mSeatId;
+    int mTeamId;
+    Ogre::Vector3 mPosition;
+    std::vector<CreatureActionType> mActions;
+    std::vector<Ogre::Vector3> mDestinations;
+    CreatureMoodLevel mMoodValue;
+    int32_t mMoodPoints;
+};
+
+#endif // CREATURESTATS_H
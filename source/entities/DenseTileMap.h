@@ -0,0 +1,224 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DENSETILEMAP_H
+#define DENSETILEMAP_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+class Tile;
+
+/*! \brief Map from tiles to values used by the buildings for their per tile data. The entries are stored
+ * contiguously (in insertion order, erasing moves the last entry in the hole) and a small open addressing
+ * table (linear probing) gives the index of the entry of a tile. Looking for a tile does not walk a tree and
+ * inserting does not allocate a node.
+ * The interface follows std::map for the parts used by the buildings. Unlike std::map, iterators and
+ * references are invalidated by insertions and erasures.
+ */
+template <typename T>
+class DenseTileMap
+{
+public:
+    typedef std::pair<Tile*, T> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+    DenseTileMap() :
+        mMask(0)
+    {}
+
+    inline iterator begin()
+    { return mEntries.begin(); }
+
+    inline iterator end()
+    { return mEntries.end(); }
+
+    inline const_iterator begin() const
+    { return mEntries.begin(); }
+
+    inline const_iterator end() const
+    { return mEntries.end(); }
+
+    inline bool empty() const
+    { return mEntries.empty(); }
+
+    inline std::size_t size() const
+    { return mEntries.size(); }
+
+    void clear()
+    {
+        mEntries.clear();
+        mSlots.assign(mSlots.size(), EMPTY_SLOT);
+    }
+
+    iterator find(const Tile* tile)
+    {
+        uint32_t index = findIndex(tile);
+        return (index == EMPTY_SLOT) ? end() : begin() + index;
+    }
+
+    const_iterator find(const Tile* tile) const
+    {
+        uint32_t index = findIndex(tile);
+        return (index == EMPTY_SLOT) ? end() : begin() + index;
+    }
+
+    inline std::size_t count(const Tile* tile) const
+    { return (findIndex(tile) == EMPTY_SLOT) ? 0 : 1; }
+
+    //! \brief Returns the value of the given tile. Throws std::out_of_range if the tile is not in the map
+    T& at(const Tile* tile)
+    {
+        uint32_t index = findIndex(tile);
+        if(index == EMPTY_SLOT)
+            throw std::out_of_range("DenseTileMap::at");
+        return mEntries[index].second;
+    }
+
+    const T& at(const Tile* tile) const
+    {
+        uint32_t index = findIndex(tile);
+        if(index == EMPTY_SLOT)
+            throw std::out_of_range("DenseTileMap::at");
+        return mEntries[index].second;
+    }
+
+    //! \brief Returns the value of the given tile. Like std::map, inserts a value initialized one if needed
+    T& operator[](Tile* tile)
+    { return insert(value_type(tile, T())).first->second; }
+
+    //! \brief Inserts the value if its tile is not in the map yet. Returns the entry of the tile and
+    //! whether the value was inserted
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        if((mEntries.size() + 1) * 2 > mSlots.size())
+            rehash(mEntries.size() + 1);
+
+        uint32_t slot = probe(value.first);
+        if(mSlots[slot] != EMPTY_SLOT)
+            return std::make_pair(begin() + mSlots[slot], false);
+
+        mSlots[slot] = static_cast<uint32_t>(mEntries.size());
+        mEntries.push_back(value);
+        return std::make_pair(end() - 1, true);
+    }
+
+    //! \brief Erases the given entry. The last entry is moved to its place. Returns an iterator to
+    //! the entry now at the same place (end() if the erased entry was the last one)
+    iterator erase(iterator it)
+    {
+        uint32_t index = static_cast<uint32_t>(it - begin());
+        uint32_t lastIndex = static_cast<uint32_t>(mEntries.size() - 1);
+        removeSlot(probe(it->first));
+        if(index != lastIndex)
+        {
+            mSlots[probe(mEntries[lastIndex].first)] = index;
+            mEntries[index] = std::move(mEntries[lastIndex]);
+        }
+        mEntries.pop_back();
+        return begin() + index;
+    }
+
+    std::size_t erase(const Tile* tile)
+    {
+        iterator it = find(tile);
+        if(it == end())
+            return 0;
+
+        erase(it);
+        return 1;
+    }
+
+private:
+    static const uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+    std::vector<value_type> mEntries;
+
+    //! \brief Index in mEntries of the entry in each slot (EMPTY_SLOT if none). The size is a power of 2
+    //! at least twice the number of entries
+    std::vector<uint32_t> mSlots;
+    uint32_t mMask;
+
+    static uint32_t hash(const Tile* tile)
+    {
+        // Fibonacci hashing. The high bits are the well mixed ones
+        uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(tile));
+        return static_cast<uint32_t>((value * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    //! \brief Returns the slot holding the given tile or the empty slot where it should be inserted.
+    //! mSlots should not be empty
+    uint32_t probe(const Tile* tile) const
+    {
+        uint32_t slot = hash(tile) & mMask;
+        while((mSlots[slot] != EMPTY_SLOT) && (mEntries[mSlots[slot]].first != tile))
+            slot = (slot + 1) & mMask;
+
+        return slot;
+    }
+
+    uint32_t findIndex(const Tile* tile) const
+    {
+        if(mSlots.empty())
+            return EMPTY_SLOT;
+
+        return mSlots[probe(tile)];
+    }
+
+    //! \brief Empties the given slot and moves back the following entries of the probe sequence
+    //! so that they can still be found without leaving tombstones
+    void removeSlot(uint32_t slot)
+    {
+        uint32_t next = slot;
+        while(true)
+        {
+            next = (next + 1) & mMask;
+            if(mSlots[next] == EMPTY_SLOT)
+                break;
+
+            // If the ideal slot of the next entry is cyclically in ]slot, next], it can stay
+            uint32_t ideal = hash(mEntries[mSlots[next]].first) & mMask;
+            bool canStay = (slot <= next) ? ((slot < ideal) && (ideal <= next)) : ((slot < ideal) || (ideal <= next));
+            if(canStay)
+                continue;
+
+            mSlots[slot] = mSlots[next];
+            slot = next;
+        }
+        mSlots[slot] = EMPTY_SLOT;
+    }
+
+    void rehash(std::size_t nbEntries)
+    {
+        std::size_t nbSlots = 16;
+        while(nbSlots < nbEntries * 2)
+            nbSlots *= 2;
+
+        mSlots.assign(nbSlots, EMPTY_SLOT);
+        mMask = static_cast<uint32_t>(nbSlots - 1);
+        for(uint32_t index = 0; index < mEntries.size(); ++index)
+            mSlots[probe(mEntries[index].first)] = index;
+    }
+};
+
+template <typename T>
+const uint32_t DenseTileMap<T>::EMPTY_SLOT;
+
+#endif // DENSETILEMAP_H
@@ -31,7 +31,7 @@ class DoorEntity: public TrapEntity, public GameEntityListener
 public:
     DoorEntity(GameMap* gameMap, Building& building, const std::string& meshName,
         Tile* tile, Ogre::Real rotationAngle, bool hideCoveredTile, float opacity,
-        const std::string& initialAnimationState, bool initialAnimationLoop);
+        const Symbol& initialAnimationState, bool initialAnimationLoop);
     DoorEntity(GameMap* gameMap);
 
     virtual ~DoorEntity();
@@ -33,9 +33,26 @@
 #include "render/RenderManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 
 #include <cassert>
 
+static ObjectPool& getEntityParticleEffectPool()
+{
+    static ObjectPool* pool = new ObjectPool("EntityParticleEffect");
+    return *pool;
+}
+
+void* EntityParticleEffect::operator new(std::size_t size)
+{
+    return getEntityParticleEffectPool().allocate(size);
+}
+
+void EntityParticleEffect::operator delete(void* ptr, std::size_t size)
+{
+    getEntityParticleEffectPool().deallocate(ptr, size);
+}
+
 void EntityParticleEffect::exportParticleEffectToPacket(const EntityParticleEffect& effect, ODPacket& os)
 {
     os << effect.mName;
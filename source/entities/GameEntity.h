@@ -84,6 +84,10 @@ public:
     virtual ~EntityParticleEffect()
     {}
 
+    //! \brief Effects are allocated from a pool shared with the subclasses (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     //! \brief This function is to be used by Entities that would have more advanced
     //! effects to know the type (and, thus, allow to cast the effect without using
     //! dynamic cast
@@ -276,6 +280,9 @@ class GameEntity
 
     bool getIsOnServerMap() const;
 
+    inline const std::vector<EntityParticleEffect*>& getEntityParticleEffects() const
+    { return mEntityParticleEffects; }
+
     //! \brief Function that schedules the object destruction. This function should not be called twice
     void deleteYourself();
 
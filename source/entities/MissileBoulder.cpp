@@ -20,10 +20,27 @@
 #include "gamemap/GameMap.h"
 #include "network/ODPacket.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 #include "utils/Random.h"
 
 #include <iostream>
 
+static ObjectPool& getMissileBoulderPool()
+{
+    static ObjectPool* pool = new ObjectPool("MissileBoulder");
+    return *pool;
+}
+
+void* MissileBoulder::operator new(std::size_t size)
+{
+    return getMissileBoulderPool().allocate(size);
+}
+
+void MissileBoulder::operator delete(void* ptr, std::size_t size)
+{
+    getMissileBoulderPool().deallocate(ptr, size);
+}
+
 MissileBoulder::MissileBoulder(GameMap* gameMap, Seat* seat, const std::string& senderName, const std::string& meshName,
         const Ogre::Vector3& direction, double speed, double damage, GameEntity* entityTarget, bool notifyPlayerIfHit) :
     MissileObject(gameMap, seat, senderName, meshName, direction, speed, entityTarget, true, false),
@@ -18,6 +18,7 @@
 #include "entities/MissileObject.h"
 
 #include "entities/Building.h"
+#include "entities/Creature.h"
 #include "entities/GameEntityType.h"
 #include "entities/MissileBoulder.h"
 #include "entities/MissileOneHit.h"
@@ -115,7 +116,7 @@ void MissileObject::doUpkeep()
         if(tmpTile->getFullness() > 0.0)
         {
             Ogre::Vector3 nextDirection;
-            OD_LOG_INF("missile name=" + getName() + ", hit wall on tile=" + Tile::displayAsString(tmpTile));
+            OD_LOG_DBG("missile name=" + getName() + ", hit wall on tile=" + Tile::displayAsString(tmpTile));
             mIsMissileAlive = wallHitNextDirection(mDirection, lastTile, nextDirection);
             if(!mIsMissileAlive)
             {
@@ -165,35 +166,20 @@ void MissileObject::doUpkeep()
             }
         }
 
-        std::vector<Tile*> tileVector;
-        tileVector.push_back(tmpTile);
-        std::vector<GameEntity*> enemyCreatures = getGameMap()->getVisibleCreatures(tileVector, getSeat(), true);
-        for(std::vector<GameEntity*>::iterator it = enemyCreatures.begin(); it != enemyCreatures.end(); ++it)
+        if(!hitCreaturesOnTile(tmpTile, true))
         {
-            GameEntity* creature = *it;
-            OD_LOG_INF("missile=" + getName() + " hit creature=" + creature->getName() + ", on tile=" + Tile::displayAsString(tmpTile));
-            if(!hitCreature(tmpTile, creature))
-            {
-                destination -= moveDist * mDirection;
-                mIsMissileAlive = false;
-                break;
-            }
+            destination -= moveDist * mDirection;
+            mIsMissileAlive = false;
+            continue;
         }
 
         if(!mDamageAllies || !mIsMissileAlive)
             continue;
 
-        std::vector<GameEntity*> alliedCreatures = getGameMap()->getVisibleCreatures(tileVector, getSeat(), false);
-        for(std::vector<GameEntity*>::iterator it = alliedCreatures.begin(); it != alliedCreatures.end(); ++it)
+        if(!hitCreaturesOnTile(tmpTile, false))
         {
-            GameEntity* creature = *it;
-            OD_LOG_INF("missile=" + getName() + " hit creature=" + creature->getName() + ", on tile=" + Tile::displayAsString(tmpTile));
-            if(!hitCreature(tmpTile, creature))
-            {
-                destination -= moveDist * mDirection;
-                mIsMissileAlive = false;
-                break;
-            }
+            destination -= moveDist * mDirection;
+            mIsMissileAlive = false;
         }
     }
 
@@ -231,6 +217,32 @@ bool MissileObject::computeDestination(const Ogre::Vector3& position, double mov
     return true;
 }
 
+bool MissileObject::hitCreaturesOnTile(Tile* tile, bool enemyCreatures)
+{
+    // The creatures are taken from the grid built for this turn. We check they are still alive and on
+    // the tile because they might have been killed or picked up since the grid was built
+    Seat* seat = getSeat();
+    for(Creature* creature : getGameMap()->getCreatureGrid().getCell(tile->getX(), tile->getY()))
+    {
+        if(!creature->getIsOnMap() || !creature->isAlive())
+            continue;
+        if(creature->getPositionTile() != tile)
+            continue;
+        if(creature->getSeat() == nullptr)
+            continue;
+        if(seat->isAlliedSeat(creature->getSeat()) == enemyCreatures)
+            continue;
+        if(enemyCreatures && !creature->isAttackable(tile, seat))
+            continue;
+
+        OD_LOG_DBG("missile=" + getName() + " hit creature=" + creature->getName() + ", on tile=" + Tile::displayAsString(tile));
+        if(!hitCreature(tile, creature))
+            return false;
+    }
+
+    return true;
+}
+
 bool MissileObject::notifyDead(GameEntity* entity)
 {
     if(entity == mEntityTarget)
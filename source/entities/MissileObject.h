@@ -105,6 +105,11 @@ protected:
 private:
     bool computeDestination(const Ogre::Vector3& position, double moveDist, const Ogre::Vector3& direction,
         Ogre::Vector3& destination, std::list<Tile*>& tiles);
+
+    //! \brief Hits the enemy (or allied) creatures standing on the given tile. Returns false if the missile
+    //! has been stopped by one of them
+    bool hitCreaturesOnTile(Tile* tile, bool enemyCreatures);
+
     Ogre::Vector3 mDirection;
     bool mIsMissileAlive;
     GameEntity* mEntityTarget;
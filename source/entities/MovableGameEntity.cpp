@@ -64,7 +64,7 @@ void MovableGameEntity::tileToVector3(const std::list<Tile*>& tiles, std::vector
     }
 }
 
-void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::string& endAnim, bool loopEndAnim,
+void MovableGameEntity::setWalkPath(const Symbol& walkAnim, const Symbol& endAnim, bool loopEndAnim,
         bool playIdleWhenAnimationEnds, const std::vector<Ogre::Vector3>& path)
 {
     mWalkQueue.clear();
@@ -110,7 +110,7 @@ void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::stri
     }
 }
 
-void MovableGameEntity::clearDestinations(const std::string& animation, bool loopAnim, bool playIdleWhenAnimationEnds)
+void MovableGameEntity::clearDestinations(const Symbol& animation, bool loopAnim, bool playIdleWhenAnimationEnds)
 {
     mWalkQueue.clear();
     stopWalking();
@@ -123,11 +123,11 @@ void MovableGameEntity::clearDestinations(const std::string& animation, bool loo
             continue;
 
         const std::string& name = getName();
-        const std::string emptyString;
+        const Symbol emptySymbol;
         uint32_t nbDest = 0;
         ServerNotification *serverNotification = new ServerNotification(
             ServerNotificationType::animatedObjectSetWalkPath, seat->getPlayer());
-        serverNotification->mPacket << name << emptyString << animation
+        serverNotification->mPacket << name << emptySymbol << animation
             << loopAnim << playIdleWhenAnimationEnds << nbDest;
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
@@ -145,7 +145,7 @@ void MovableGameEntity::stopWalking()
     setAnimationState(mDestinationAnimationState, mDestinationAnimationLoop, mDestinationAnimationDirection, mDestinationPlayIdleWhenAnimationEnds);
 
     // We reset the destination state
-    mDestinationAnimationState.clear();
+    mDestinationAnimationState = Symbol();
     mDestinationAnimationLoop = false;
     mDestinationAnimationDirection = Ogre::Vector3::ZERO;
 }
@@ -159,11 +159,11 @@ void MovableGameEntity::setWalkDirection(const Ogre::Vector3& direction)
     RenderManager::getSingleton().rrOrientEntityToward(this, direction);
 }
 
-void MovableGameEntity::setAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
+void MovableGameEntity::setAnimationState(const Symbol& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
 {
     // Ignore the command if the command is exactly the same and looped. Otherwise, we accept
     // the command because it may be a trap/building object that is triggered several times
-    if (state.compare(mPrevAnimationState) == 0 &&
+    if (state == mPrevAnimationState &&
         loop &&
         mPrevAnimationStateLoop &&
         (direction == Ogre::Vector3::ZERO || direction == mWalkDirection))
@@ -298,7 +298,7 @@ void MovableGameEntity::setPosition(const Ogre::Vector3& v)
         addEntityToPositionTile();
 }
 
-void MovableGameEntity::fireObjectAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
+void MovableGameEntity::fireObjectAnimationState(const Symbol& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds)
 {
     for(Seat* seat : mSeatsWithVisionNotified)
     {
@@ -19,6 +19,7 @@
 #define MOVABLEGAMEENTITY_H
 
 #include "entities/GameEntity.h"
+#include "utils/Symbol.h"
 
 #include <OgreVector3.h>
 
@@ -29,14 +30,17 @@ class Tile;
 
 namespace EntityAnimation
 {
-    static const std::string idle_anim = "Idle";
-    static const std::string flee_anim = "Flee";
-    static const std::string die_anim = "Die";
-    static const std::string dig_anim = "Dig";
-    static const std::string attack_anim = "Attack1";
-    static const std::string claim_anim = "Claim";
-    static const std::string walk_anim = "Walk";
-    static const std::string sleep_anim = "Sleep";
+    static const Symbol idle_anim("Idle");
+    static const Symbol flee_anim("Flee");
+    static const Symbol die_anim("Die");
+    static const Symbol dig_anim("Dig");
+    static const Symbol attack_anim("Attack1");
+    static const Symbol claim_anim("Claim");
+    static const Symbol walk_anim("Walk");
+    static const Symbol sleep_anim("Sleep");
+    static const Symbol pick_anim("Pick");
+    static const Symbol triggered_anim("Triggered");
+    static const Symbol loop_anim("Loop");
 };
 
 class MovableGameEntity : public GameEntity
@@ -55,7 +59,7 @@ public:
      * walk, the entity will play walkAnim (looped). When it gets to the wanted position,
      * it will play endAnim (looped or not depending on loopEndAnim).
      */
-    void setWalkPath(const std::string& walkAnim, const std::string& endAnim, bool loopEndAnim,
+    void setWalkPath(const Symbol& walkAnim, const Symbol& endAnim, bool loopEndAnim,
         bool playIdleWhenAnimationEnds, const std::vector<Ogre::Vector3>& path);
 
     /*! \brief Converts a tile list to a vector of Ogre::Vector3
@@ -66,7 +70,7 @@ public:
 
     //! \brief Clears all future destinations from the walk queue, stops the object where it is, and sets its animation state.
     //! This is a server side function
-    void clearDestinations(const std::string& animation, bool loopAnim, bool playIdleWhenAnimationEnds);
+    void clearDestinations(const Symbol& animation, bool loopAnim, bool playIdleWhenAnimationEnds);
 
     //! \brief Stops the object where it is, and sets its animation state.
     virtual void stopWalking();
@@ -81,7 +85,7 @@ public:
     virtual double getMoveSpeed() const
     { return 1.0; }
 
-    virtual void setAnimationState(const std::string& state, bool loop = true, const Ogre::Vector3& direction = Ogre::Vector3::ZERO, bool playIdleWhenAnimationEnds = true);
+    virtual void setAnimationState(const Symbol& state, bool loop = true, const Ogre::Vector3& direction = Ogre::Vector3::ZERO, bool playIdleWhenAnimationEnds = true);
 
     virtual double getAnimationSpeedFactor() const
     { return 1.0; }
@@ -114,13 +118,13 @@ protected:
     virtual void importFromPacket(ODPacket& is) override;
 
     std::deque<Ogre::Vector3> mWalkQueue;
-    std::string mPrevAnimationState;
+    Symbol mPrevAnimationState;
     bool mPrevAnimationStateLoop;
 
 private:
-    void fireObjectAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds);
+    void fireObjectAnimationState(const Symbol& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds);
     Ogre::AnimationState* mAnimationState;
-    std::string mDestinationAnimationState;
+    Symbol mDestinationAnimationState;
     bool mDestinationAnimationLoop;
     bool mDestinationPlayIdleWhenAnimationEnds;
     Ogre::Vector3 mDestinationAnimationDirection;
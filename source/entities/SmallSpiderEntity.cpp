@@ -23,6 +23,7 @@
 #include "gamemap/GameMap.h"
 #include "rooms/Room.h"
 #include "rooms/RoomType.h"
+#include "utils/ObjectPool.h"
 #include "utils/Random.h"
 #include "utils/LogManager.h"
 
@@ -31,6 +32,22 @@
 
 const int32_t NB_TURNS_DIE_BEFORE_REMOVE = 0;
 
+static ObjectPool& getSmallSpiderEntityPool()
+{
+    static ObjectPool* pool = new ObjectPool("SmallSpiderEntity");
+    return *pool;
+}
+
+void* SmallSpiderEntity::operator new(std::size_t size)
+{
+    return getSmallSpiderEntityPool().allocate(size);
+}
+
+void SmallSpiderEntity::operator delete(void* ptr, std::size_t size)
+{
+    getSmallSpiderEntityPool().deallocate(ptr, size);
+}
+
 SmallSpiderEntity::SmallSpiderEntity(GameMap* gameMap, const std::string& cryptName, int32_t nbTurnLife) :
     RenderedMovableEntity(gameMap, cryptName, "SmallSpider", 0.0f, false),
     mNbTurnLife(nbTurnLife),
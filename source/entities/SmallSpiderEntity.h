@@ -35,6 +35,10 @@ public:
     SmallSpiderEntity(GameMap* gameMap, const std::string& cryptName, int32_t nbTurnLife);
     SmallSpiderEntity(GameMap* gameMap);
 
+    //! \brief Spiders are allocated from a pool (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     virtual void doUpkeep() override;
 
     virtual GameEntityType getObjectType() const override;
@@ -26,6 +26,7 @@
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "network/ODPacket.h"
+#include "network/StateHash.h"
 #include "render/RenderManager.h"
 #include "rooms/Room.h"
 #include "sound/SoundEffectsManager.h"
@@ -33,6 +34,7 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Symbol.h"
 
 #include <cstddef>
 #include <bitset>
@@ -66,6 +68,7 @@ Tile::Tile(GameMap* gameMap, int x, int y, TileType type, double fullness) :
     mColorCustomMesh    (true),
     mHasBridge          (false),
     mLocalPlayerHasVision   (false),
+    mStateHash          (0),
     mTileCulling        (CullingType::HIDE),
     mNbWorkersClaiming(0)
 {
@@ -920,6 +923,9 @@ void Tile::setFullness(double f)
                 getGameMap()->refreshFloodFill(seat, this);
         }
     }
+
+    if((oldFullness > 0.0) != (mFullness > 0.0))
+        getGameMap()->notifyTileChanged(*this);
 }
 
 void Tile::createMeshLocal()
@@ -1000,6 +1006,8 @@ void Tile::setCoveringBuilding(Building *building)
         setSeat(mCoveringBuilding->getSeat());
         mClaimedPercentage = 1.0;
     }
+
+    getGameMap()->notifyTileChanged(*this);
 }
 
 bool Tile::isGroundClaimable(Seat* seat) const
@@ -1077,6 +1085,32 @@ void Tile::updateFromPacket(ODPacket& is)
 
     }
 
+    stateUpdated();
+}
+
+void Tile::copyStateFrom(const Tile& tile)
+{
+    mIsRoom = tile.mIsRoom;
+    mIsTrap = tile.mIsTrap;
+    mRefundPriceRoom = tile.mRefundPriceRoom;
+    mRefundPriceTrap = tile.mRefundPriceTrap;
+    mDisplayTileMesh = tile.mDisplayTileMesh;
+    mColorCustomMesh = tile.mColorCustomMesh;
+    mHasBridge = tile.mHasBridge;
+    setMeshName(tile.getMeshName());
+    mTileVisual = tile.mTileVisual;
+    setSeat(tile.getSeat());
+
+    stateUpdated();
+}
+
+void Tile::stateUpdated()
+{
+    // The hash is computed from the applied state so that it differs from the server one if the
+    // tile could not be updated as expected
+    mStateHash = computeStateHash(mIsRoom, mIsTrap, mRefundPriceRoom, mRefundPriceTrap, mDisplayTileMesh,
+        mColorCustomMesh, mHasBridge, (getSeat() == nullptr) ? -1 : getSeat()->getId(), getMeshName(), mTileVisual);
+
     // We need to check if the tile is unmarked after reading the needed information.
     if(getMarkedForDigging(getGameMap()->getLocalPlayer()) &&
         !isDiggable(getGameMap()->getLocalPlayer()->getSeat()))
@@ -1090,26 +1124,24 @@ void Tile::updateFromPacket(ODPacket& is)
     fireTileStateChanged();
 }
 
+uint64_t Tile::computeStateHash(bool isRoom, bool isTrap, uint32_t refundPriceRoom, uint32_t refundPriceTrap,
+    bool displayTileMesh, bool colorCustomMesh, bool hasBridge, int seatId, const std::string& meshName,
+    TileVisual tileVisual)
+{
+    StateHash::Hasher hasher;
+    hasher << isRoom << isTrap << refundPriceRoom << refundPriceTrap;
+    hasher << displayTileMesh << colorCustomMesh << hasBridge;
+    hasher << static_cast<int32_t>(seatId) << meshName << static_cast<int32_t>(tileVisual);
+    return hasher.getHash();
+}
+
 void Tile::loadFromLine(const std::string& line, Tile *t)
 {
     std::vector<std::string> elems = Helper::split(line, '\t');
 
     int xLocation = Helper::toInt(elems[0]);
     int yLocation = Helper::toInt(elems[1]);
-
-    std::stringstream tileName("");
-    tileName << TILE_PREFIX;
-    tileName << xLocation;
-    tileName << "_";
-    tileName << yLocation;
-
-    t->setName(tileName.str());
-    t->mX = xLocation;
-    t->mY = yLocation;
-    t->mPosition = Ogre::Vector3(static_cast<Ogre::Real>(t->mX), static_cast<Ogre::Real>(t->mY), 0.0f);
-
     TileType tileType = static_cast<TileType>(Helper::toInt(elems[2]));
-    t->setType(tileType);
 
     // If the tile type is lava or water, we ignore fullness
     double fullness;
@@ -1124,11 +1156,31 @@ void Tile::loadFromLine(const std::string& line, Tile *t)
             fullness = Helper::toDouble(elems[3]);
             break;
     }
+
+    bool hasSeat = (elems.size() >= 5);
+    int seatId = hasSeat ? Helper::toInt(elems[4]) : 0;
+    loadFromValues(t, xLocation, yLocation, tileType, fullness, hasSeat, seatId);
+}
+
+void Tile::loadFromValues(Tile* t, int xLocation, int yLocation, TileType tileType, double fullness,
+    bool hasSeat, int seatId)
+{
+    t->setName(buildName(xLocation, yLocation));
+    t->mX = xLocation;
+    t->mY = yLocation;
+    t->mPosition = Ogre::Vector3(static_cast<Ogre::Real>(t->mX), static_cast<Ogre::Real>(t->mY), 0.0f);
+
+    t->setType(tileType);
+
+    // If the tile type is lava or water, we ignore fullness
+    if((tileType == TileType::water) || (tileType == TileType::lava))
+        fullness = 0.0;
+
     t->setFullnessValue(fullness);
 
     bool shouldSetSeat = false;
     // We allow to set seat if the tile is dirt (full or not) or if it is gold (ground only)
-    if(elems.size() >= 5)
+    if(hasSeat)
     {
         if(tileType == TileType::dirt)
         {
@@ -1147,7 +1199,6 @@ void Tile::loadFromLine(const std::string& line, Tile *t)
         return;
     }
 
-    int seatId = Helper::toInt(elems[4]);
     Seat* seat = t->getGameMap()->getSeatById(seatId);
     if(seat == nullptr)
         return;
@@ -1195,7 +1246,13 @@ bool Tile::addEntity(GameEntity *entity)
     }
 
     mEntitiesInTile.push_back(entity);
-    if(!getGameMap()->isServerGameMap())
+    if(getGameMap()->isServerGameMap())
+    {
+        // Wakes up the traps that can target creatures on this tile
+        if(entity->getObjectType() == GameEntityType::creature)
+            getGameMap()->getTrapTriggerIndex().notifyCreatureEntered(*this);
+    }
+    else
     {
         // On client side, we cull any movable entity that walks over a
         // culled tile (or show it if it was previously culled and walks
@@ -1217,6 +1274,9 @@ void Tile::removeEntity(GameEntity *entity)
     }
 
     mEntitiesInTile.erase(it);
+    if(getGameMap()->isServerGameMap() && (entity->getObjectType() == GameEntityType::creature))
+        getGameMap()->getTrapTriggerIndex().notifyCreatureLeft(*this);
+
     fireTileStateChanged();
 }
 
@@ -1235,6 +1295,8 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
     if(getFullness() > 0)
         nDanceRate *= ConfigManager::getSingleton().getClaimingWallPenalty();
 
+    bool wasClaimed = isClaimed();
+
     // If the seat is allied, we add to it. If it is an enemy seat, we subtract from it.
     if (getSeat() != nullptr && getSeat()->isAlliedSeat(seat))
     {
@@ -1261,7 +1323,12 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
         (getSeat()->isAlliedSeat(seat)))
     {
         claimTile(seat);
+        return;
     }
+
+    // An enemy dancing on a claimed tile unclaims it
+    if(wasClaimed != isClaimed())
+        getGameMap()->notifyTileChanged(*this);
 }
 
 void Tile::claimTile(Seat* seat)
@@ -1297,6 +1364,34 @@ void Tile::claimTile(Seat* seat)
         }
     }
 
+    getGameMap()->notifyTileChanged(*this);
+    fireTileStateChanged();
+}
+
+void Tile::setEditorState(TileType type, double fullness, Seat* seat)
+{
+    setType(type);
+
+    // Like setFullness, a dug out tile is not marked anymore
+    mFullness = fullness;
+    if((mFullness == 0.0) && isMarkedForDiggingByAnySeat())
+        setMarkedForDiggingForAllPlayersExcept(false, nullptr);
+
+    // Like claimTile/unclaimTile
+    setSeat(seat);
+    if(seat != nullptr)
+    {
+        mClaimedPercentage = 1.0;
+        setMarkedForDiggingForAllPlayersExcept(false, seat);
+    }
+    else
+    {
+        mClaimedPercentage = 0.0;
+    }
+
+    computeTileVisual();
+    setDirtyForAllSeats();
+    getGameMap()->notifyTileChanged(*this);
     fireTileStateChanged();
 }
 
@@ -1324,6 +1419,7 @@ void Tile::unclaimTile()
         }
     }
 
+    getGameMap()->notifyTileChanged(*this);
     fireTileStateChanged();
 }
 
@@ -1783,30 +1879,30 @@ bool Tile::permitsVision()
 
 void Tile::fireTileSound(TileSound sound)
 {
-    std::string soundFamily;
+    static const Symbol soundClaimTile("Game/ClaimTile");
+    static const Symbol soundRocksFalling("Game/RocksFalling");
+    static const Symbol soundBuildRoom("Game/BuildRoom");
+    static const Symbol soundBuildTrap("Game/BuildTrap");
+
     switch(sound)
     {
         case TileSound::ClaimGround:
-            soundFamily = "ClaimTile";
-            break;
         case TileSound::ClaimWall:
-            soundFamily = "ClaimTile";
+            getGameMap()->fireSpatialSound(*this, soundClaimTile);
             break;
         case TileSound::Digged:
-            soundFamily = "RocksFalling";
+            getGameMap()->fireSpatialSound(*this, soundRocksFalling);
             break;
         case TileSound::BuildRoom:
-            soundFamily = "BuildRoom";
+            getGameMap()->fireSpatialSound(*this, soundBuildRoom);
             break;
         case TileSound::BuildTrap:
-            soundFamily = "BuildTrap";
+            getGameMap()->fireSpatialSound(*this, soundBuildTrap);
             break;
         default:
             OD_LOG_ERR("Wrong TileSound value=" + Helper::toString(static_cast<uint32_t>(sound)));
-            return;
+            break;
     }
-
-    getGameMap()->fireGameSound(*this, soundFamily);
 }
 
 double Tile::getCreatureSpeedDefault(const Creature* creature) const
@@ -330,6 +330,10 @@ public:
     //! \brief Loads the tile data from a level line.
     static void loadFromLine(const std::string& line, Tile *t);
 
+    //! \brief Sets up the tile from already parsed level values. seatId is only used if hasSeat is true.
+    static void loadFromValues(Tile* t, int xLocation, int yLocation, TileType tileType, double fullness,
+        bool hasSeat, int seatId);
+
     /*! \brief This is a helper function which just converts the tile type enum into a string.
      *
      * This function is used primarily in forming the mesh names to load from disk
@@ -462,6 +466,25 @@ public:
     virtual void updateFromPacket(ODPacket& is) override;
     void exportToPacketForUpdate(ODPacket& os, const Seat* seat, bool hideSeatId) const;
 
+    //! \brief Used on client side. Sets the state received by the given tile in updateFromPacket
+    //! to this tile. Used when several tiles receive the same state (see refreshTilesRegion)
+    void copyStateFrom(const Tile& tile);
+
+    //! \brief Used on server side by the editor to change the tile as part of a region edit (see
+    //! GameMap::editorChangeTiles). The tile is changed like with setFullness and claimTile/unclaimTile
+    //! but no sound is played and the neighbors are not refreshed: it is done once for the whole region
+    void setEditorState(TileType type, double fullness, Seat* seat);
+
+    //! \brief Returns the hash of a tile state as sent by Seat::exportTileToPacket (see StateHash)
+    static uint64_t computeStateHash(bool isRoom, bool isTrap, uint32_t refundPriceRoom, uint32_t refundPriceTrap,
+        bool displayTileMesh, bool colorCustomMesh, bool hasBridge, int seatId, const std::string& meshName,
+        TileVisual tileVisual);
+
+    //! \brief Used on client side. Hash of the state applied by the last updateFromPacket (0 if the
+    //! state of the tile was never received)
+    inline uint64_t getStateHash() const
+    { return mStateHash; }
+
     bool addTileStateListener(TileStateListener& listener);
     bool removeTileStateListener(TileStateListener& listener);
 
@@ -534,6 +557,9 @@ private:
     //! \brief Used on client side. true if the local player has vision, false otherwise.
     bool mLocalPlayerHasVision;
 
+    //! \brief Used on client side. See getStateHash
+    uint64_t mStateHash;
+
     uint32_t mTileCulling;
 
     /*! \brief Set the fullness value for the tile.
@@ -552,6 +578,9 @@ private:
     std::vector<TileStateListener*> mStateListeners;
 
     void fireTileStateChanged();
+
+    //! \brief Called on client side when the state of the tile has been received
+    void stateUpdated();
 };
 
 #endif // TILE_H
@@ -25,10 +25,27 @@
 #include "rooms/Room.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/ObjectPool.h"
 
 #include <istream>
 #include <ostream>
 
+static ObjectPool& getTreasuryObjectPool()
+{
+    static ObjectPool* pool = new ObjectPool("TreasuryObject");
+    return *pool;
+}
+
+void* TreasuryObject::operator new(std::size_t size)
+{
+    return getTreasuryObjectPool().allocate(size);
+}
+
+void TreasuryObject::operator delete(void* ptr, std::size_t size)
+{
+    getTreasuryObjectPool().deallocate(ptr, size);
+}
+
 TreasuryObject::TreasuryObject(GameMap* gameMap, int goldValue) :
     RenderedMovableEntity(gameMap, "Treasury_", getMeshNameForGold(goldValue), 0.0f, false),
     mGoldValue(goldValue),
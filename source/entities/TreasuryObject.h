@@ -34,6 +34,10 @@ public:
     TreasuryObject(GameMap* gameMap, int goldValue);
     TreasuryObject(GameMap* gameMap);
 
+    //! \brief Treasuries are allocated from a pool (see ObjectPool)
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     virtual void doUpkeep() override;
 
     virtual GameEntityType getObjectType() const override;
@@ -26,7 +26,7 @@
 #include <sstream>
 #include <fstream>
 
-Weapon* Weapon::load(std::stringstream& defFile)
+Weapon* Weapon::load(std::istream& defFile)
 {
     if (!defFile.good())
         return nullptr;
@@ -39,7 +39,7 @@ Weapon* Weapon::load(std::stringstream& defFile)
     }
     return weapon;
 }
-bool Weapon::update(Weapon* weapon, std::stringstream& defFile)
+bool Weapon::update(Weapon* weapon, std::istream& defFile)
 {
     std::string nextParam;
     bool exit = false;
@@ -162,7 +162,7 @@ bool Weapon::update(Weapon* weapon, std::stringstream& defFile)
     return true;
 }
 
-void Weapon::writeWeaponDiff(const Weapon* def1, const Weapon* def2, std::ofstream& file)
+void Weapon::writeWeaponDiff(const Weapon* def1, const Weapon* def2, std::ostream& file)
 {
     file << "[Equipment]" << std::endl;
     file << "    Name\t" << def2->mName << std::endl;
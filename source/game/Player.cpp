@@ -372,7 +372,7 @@ void Player::notifyNoMoreDungeonTemple()
 
     // We check if there is still a player in the team with a dungeon temple. If yes, we notify the player he lost his dungeon
     // if no, we notify the team they lost
-    std::vector<Room*> dungeonTemples = mGameMap->getRoomsByType(RoomType::dungeonTemple);
+    BuildingView<Room> dungeonTemples = mGameMap->getRoomsByType(RoomType::dungeonTemple);
     bool hasTeamLost = true;
     for(Room* dungeonTemple : dungeonTemples)
     {
@@ -62,7 +62,8 @@ TileStateNotified::TileStateNotified():
     mMarkedForDigging(false),
     mVisionTurnLast(false),
     mVisionTurnCurrent(false),
-    mBuilding(nullptr)
+    mBuilding(nullptr),
+    mStateHashSent(0)
 {
 }
 
@@ -1630,34 +1631,33 @@ void Seat::setVisibleBuildingOnTile(Building* building, Tile* tile)
     tileState.mSeatIdOwner = building->getSeat()->getId();
 }
 
-void Seat::exportTileToPacket(ODPacket& os, const Tile* tile,
-        bool hideSeatId) const
+bool Seat::computeTileStateExported(const Tile* tile, bool hideSeatId, TileStateExported& state) const
 {
     if(getPlayer() == nullptr)
     {
         OD_LOG_ERR("SeatId=" + Helper::toString(getId()));
-        return;
+        return false;
     }
     if(!getPlayer()->getIsHuman())
     {
         OD_LOG_ERR("SeatId=" + Helper::toString(getId()));
-        return;
+        return false;
     }
 
     if(tile->getX() >= static_cast<int>(mTilesStates.size()))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
+        return false;
     }
     if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
+        return false;
     }
 
     const TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
 
-    int tileSeatId = -1;
+    state.mTileSeatId = -1;
     // We only pass the tile seat to the client if the tile is fully claimed
     if(!hideSeatId)
     {
@@ -1665,70 +1665,103 @@ void Seat::exportTileToPacket(ODPacket& os, const Tile* tile,
         {
             case TileVisual::claimedGround:
             case TileVisual::claimedFull:
-                tileSeatId = tileState.mSeatIdOwner;
+                state.mTileSeatId = tileState.mSeatIdOwner;
                 break;
             case TileVisual::waterGround:
             case TileVisual::lavaGround:
                 if(tileState.mBuilding != nullptr)
-                    tileSeatId = tileState.mSeatIdOwner;
+                    state.mTileSeatId = tileState.mSeatIdOwner;
                 break;
             default:
                 break;
         }
     }
 
-    std::string meshName;
-
     if((tileState.mBuilding != nullptr) &&
        !tileState.mBuilding->getMeshName().empty())
     {
-        meshName = tileState.mBuilding->getMeshName() + ".mesh";
+        state.mMeshName = tileState.mBuilding->getMeshName() + ".mesh";
     }
     else
     {
         // We set an empty mesh so that the client can compute the tile itself
-        meshName.clear();
+        state.mMeshName.clear();
     }
-    bool isRoom = false;
-    bool isTrap = false;
-    bool displayTileMesh = true;
-    bool colorCustomMesh = false;
-    bool hasBridge = false;
+    state.mIsRoom = false;
+    state.mIsTrap = false;
+    state.mDisplayTileMesh = true;
+    state.mColorCustomMesh = false;
+    state.mHasBridge = false;
 
-    uint32_t refundPriceRoom = 0;
-    uint32_t refundPriceTrap = 0;
+    state.mRefundPriceRoom = 0;
+    state.mRefundPriceTrap = 0;
     if(tileState.mBuilding != nullptr)
     {
-        displayTileMesh = tileState.mBuilding->displayTileMesh();
-        colorCustomMesh = tileState.mBuilding->colorCustomMesh();
+        state.mDisplayTileMesh = tileState.mBuilding->displayTileMesh();
+        state.mColorCustomMesh = tileState.mBuilding->colorCustomMesh();
 
         if(tileState.mBuilding->getObjectType() == GameEntityType::room)
         {
-            isRoom = true;
+            state.mIsRoom = true;
             Room* room = static_cast<Room*>(tileState.mBuilding);
             if(room->getSeat() == this)
-                refundPriceRoom = (RoomManager::costPerTile(room->getType()) / 2);
+                state.mRefundPriceRoom = (RoomManager::costPerTile(room->getType()) / 2);
 
-            hasBridge = room->isBridge();
+            state.mHasBridge = room->isBridge();
         }
         else if(tileState.mBuilding->getObjectType() == GameEntityType::trap)
         {
-            isTrap = true;
+            state.mIsTrap = true;
             Trap* trap = static_cast<Trap*>(tileState.mBuilding);
             if(trap->getSeat() == this)
-                refundPriceTrap = (TrapManager::costPerTile(trap->getType()) / 2);
+                state.mRefundPriceTrap = (TrapManager::costPerTile(trap->getType()) / 2);
         }
     }
-    os << isRoom;
-    os << isTrap;
-    os << refundPriceRoom;
-    os << refundPriceTrap;
-    os << displayTileMesh;
-    os << colorCustomMesh;
-    os << hasBridge;
-    os << tileSeatId;
-    os << meshName;
-    os << tileState.mTileVisual;
+    state.mTileVisual = tileState.mTileVisual;
+    state.mStateHash = Tile::computeStateHash(state.mIsRoom, state.mIsTrap, state.mRefundPriceRoom,
+        state.mRefundPriceTrap, state.mDisplayTileMesh, state.mColorCustomMesh, state.mHasBridge,
+        state.mTileSeatId, state.mMeshName, state.mTileVisual);
+    // The client will compute the same hash when it applies the state
+    tileState.mStateHashSent = state.mStateHash;
+    return true;
+}
+
+void Seat::exportTileToPacket(ODPacket& os, const Tile* tile,
+        bool hideSeatId) const
+{
+    TileStateExported state;
+    if(!computeTileStateExported(tile, hideSeatId, state))
+        return;
+
+    os << state.mIsRoom;
+    os << state.mIsTrap;
+    os << state.mRefundPriceRoom;
+    os << state.mRefundPriceTrap;
+    os << state.mDisplayTileMesh;
+    os << state.mColorCustomMesh;
+    os << state.mHasBridge;
+    os << state.mTileSeatId;
+    os << state.mMeshName;
+    os << state.mTileVisual;
+}
+
+uint64_t Seat::notifyTileStateSent(const Tile* tile, bool hideSeatId) const
+{
+    TileStateExported state;
+    if(!computeTileStateExported(tile, hideSeatId, state))
+        return 0;
+
+    return state.mStateHash;
+}
+
+uint64_t Seat::getTileStateHashSent(const Tile* tile) const
+{
+    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
+        return 0;
+    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+        return 0;
+
+    return mTilesStates[tile->getX()][tile->getY()].mStateHashSent;
 }
 
 void Seat::notifyBuildingRemovedFromGameMap(Building* building, Tile* tile)
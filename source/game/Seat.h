@@ -57,6 +57,9 @@ public:
     bool mVisionTurnLast;
     bool mVisionTurnCurrent;
     Building* mBuilding;
+    //! \brief Hash of the last state sent to the client (0 if never sent). It is set when the
+    //! state is exported, hence mutable. See StateHash
+    mutable uint64_t mStateHashSent;
 };
 
 class Seat : public SeatData
@@ -300,6 +303,16 @@ public:
     void exportTileToPacket(ODPacket& os, const Tile* tile,
         bool hideSeatId) const;
 
+    //! \brief Returns the hash of the last state of the given tile sent to the client (0 if none was sent).
+    //! Used on server side only
+    uint64_t getTileStateHashSent(const Tile* tile) const;
+
+    /*! \brief Records the state exportTileToPacket would send for the given tile as sent and returns its hash.
+     * Used when several tiles are sent with the state of one of them (see ODServer::sendTilesRegion).
+     * Returns 0 if the tile cannot be sent to this seat
+     */
+    uint64_t notifyTileStateSent(const Tile* tile, bool hideSeatId) const;
+
     static bool sortForMapSave(Seat* s1, Seat* s2);
 
     static Seat* createRogueSeat(GameMap* gameMap);
@@ -406,6 +419,26 @@ private:
 
     //! exports the tiles of the corresponding TileVisual this seat have seen
     void exportTilesVisualInitialStates(TileVisual tileVisual, std::ostream& os) const;
+
+    //! \brief Values sent by exportTileToPacket for a tile
+    struct TileStateExported
+    {
+        bool mIsRoom;
+        bool mIsTrap;
+        uint32_t mRefundPriceRoom;
+        uint32_t mRefundPriceTrap;
+        bool mDisplayTileMesh;
+        bool mColorCustomMesh;
+        bool mHasBridge;
+        int mTileSeatId;
+        std::string mMeshName;
+        TileVisual mTileVisual;
+        uint64_t mStateHash;
+    };
+
+    //! \brief Computes the state of the given tile as notified to this seat and records its hash as sent.
+    //! Returns false if the tile cannot be sent to this seat
+    bool computeTileStateExported(const Tile* tile, bool hideSeatId, TileStateExported& state) const;
 };
 
 #endif // SEAT_H
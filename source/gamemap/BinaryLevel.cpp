@@ -0,0 +1,744 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/BinaryLevel.h"
+
+#include "entities/Tile.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+const char MAGIC[8] = { 'O', 'D', 'L', 'E', 'V', 'B', 'I', 'N' };
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const uint64_t SECTION_ALIGNMENT = 8;
+
+struct FileHeader
+{
+    char mMagic[8];
+    uint32_t mFormatVersion;
+    uint32_t mByteOrderMark;
+    uint64_t mFileSize;
+    uint32_t mNbSections;
+    uint32_t mReserved;
+};
+static_assert(sizeof(FileHeader) == 32, "Unexpected padding in the binary level header");
+
+struct SectionEntry
+{
+    uint32_t mId;
+    uint32_t mChecksum;
+    uint64_t mOffset;
+    uint64_t mSize;
+};
+static_assert(sizeof(SectionEntry) == 24, "Unexpected padding in the binary level section table");
+
+struct TilesHeader
+{
+    int32_t mMapSizeX;
+    int32_t mMapSizeY;
+    uint32_t mNbTiles;
+    uint32_t mReserved;
+};
+static_assert(sizeof(TilesHeader) == 16, "Unexpected padding in the binary level tiles header");
+
+//! \brief Size of one tile in the packed arrays: fullness, posX, posY, seatId, type and hasSeat
+const uint64_t PACKED_TILE_SIZE = sizeof(double) + 3 * sizeof(int32_t) + 2 * sizeof(uint8_t);
+
+//! \brief FNV-1a hash. It is only used to detect truncated or corrupted files
+uint32_t computeChecksum(const char* data, uint64_t size)
+{
+    uint32_t hash = 2166136261u;
+    for(uint64_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint64_t alignSection(uint64_t offset)
+{
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+template<typename T>
+void appendValue(std::string& buffer, const T& value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//! \brief Reads the next line and removes its comment, if any
+bool readLineWithoutComment(std::istream& is, std::string& line)
+{
+    if(!std::getline(is, line))
+        return false;
+
+    line = line.substr(0, line.find('#'));
+    return true;
+}
+
+std::string trimmed(const std::string& line)
+{
+    std::string ret = line;
+    Helper::trim(ret);
+    return ret;
+}
+
+//! \brief Parses the content of the [Tiles] section the same way MapHandler does for the text format
+bool parseTiles(const std::string& tilesText, int32_t& mapSizeX, int32_t& mapSizeY, std::vector<BinaryLevel::TileRecord>& tiles)
+{
+    std::stringstream ss(tilesText);
+    if(!(ss >> mapSizeX >> mapSizeY) || (mapSizeX <= 0) || (mapSizeY <= 0))
+    {
+        OD_LOG_WRN("Invalid map size in tiles section");
+        return false;
+    }
+
+    std::string nextParam;
+    while(ss >> nextParam)
+    {
+        std::string line = nextParam;
+        std::getline(ss, nextParam);
+        line += nextParam;
+
+        std::vector<std::string> elems = Helper::split(line, '\t');
+        if(elems.size() < 3)
+        {
+            OD_LOG_WRN("Invalid tile line=" + line);
+            return false;
+        }
+
+        BinaryLevel::TileRecord tile;
+        tile.mPosX = Helper::toInt(elems[0]);
+        tile.mPosY = Helper::toInt(elems[1]);
+        int type = Helper::toInt(elems[2]);
+        if((type < 0) || (type >= static_cast<int>(TileType::countTileType)))
+        {
+            OD_LOG_WRN("Invalid tile type line=" + line);
+            return false;
+        }
+        tile.mType = static_cast<uint8_t>(type);
+        // Water and lava tiles do not need a fullness
+        tile.mFullness = (elems.size() >= 4) ? Helper::toDouble(elems[3]) : 0.0;
+        if(!std::isfinite(tile.mFullness) || (tile.mFullness < 0.0))
+        {
+            OD_LOG_WRN("Invalid tile fullness line=" + line);
+            return false;
+        }
+        tile.mHasSeat = (elems.size() >= 5);
+        tile.mSeatId = tile.mHasSeat ? Helper::toInt(elems[4]) : 0;
+        tiles.push_back(tile);
+    }
+
+    return true;
+}
+
+void packTiles(int32_t mapSizeX, int32_t mapSizeY, const std::vector<BinaryLevel::TileRecord>& tiles, std::string& buffer)
+{
+    buffer.reserve(sizeof(TilesHeader) + tiles.size() * PACKED_TILE_SIZE);
+
+    TilesHeader header;
+    header.mMapSizeX = mapSizeX;
+    header.mMapSizeY = mapSizeY;
+    header.mNbTiles = static_cast<uint32_t>(tiles.size());
+    header.mReserved = 0;
+    appendValue(buffer, header);
+
+    // The arrays are written from the biggest type to the smallest to keep them aligned
+    for(const BinaryLevel::TileRecord& tile : tiles)
+        appendValue(buffer, tile.mFullness);
+    for(const BinaryLevel::TileRecord& tile : tiles)
+        appendValue(buffer, tile.mPosX);
+    for(const BinaryLevel::TileRecord& tile : tiles)
+        appendValue(buffer, tile.mPosY);
+    for(const BinaryLevel::TileRecord& tile : tiles)
+        appendValue(buffer, tile.mSeatId);
+    for(const BinaryLevel::TileRecord& tile : tiles)
+        appendValue(buffer, tile.mType);
+    for(const BinaryLevel::TileRecord& tile : tiles)
+        appendValue(buffer, static_cast<uint8_t>(tile.mHasSeat ? 1 : 0));
+}
+
+//! \brief Writes the fullness with as few digits as possible while still reading back the same value
+void writeFullness(std::ostream& os, double fullness)
+{
+    std::stringstream ss;
+    ss << fullness;
+    if(Helper::toDouble(ss.str()) == fullness)
+    {
+        os << ss.str();
+        return;
+    }
+
+    std::streamsize oldPrecision = os.precision(std::numeric_limits<double>::max_digits10);
+    os << fullness;
+    os.precision(oldPrecision);
+}
+}
+
+namespace BinaryLevel
+{
+
+const std::string& getSectionTag(Section section)
+{
+    static const std::string TAGS[] =
+    {
+        "",
+        "[Info]",
+        "[Seats]",
+        "[Goals]",
+        "[Tiles]",
+        "[Rooms]",
+        "[Traps]",
+        "[Lights]",
+        "[CreatureDefinitions]",
+        "[EquipmentDefinitions]",
+        "[Creatures]",
+        "[Spells]",
+        "[CraftedTraps]",
+        "[SkillEntity]",
+        "[GiftBoxEntity]",
+        "[Missiles]",
+        "[TreasuryObject]",
+        "[Chickens]"
+    };
+    static_assert(sizeof(TAGS) / sizeof(TAGS[0]) == static_cast<std::size_t>(Section::nbSections),
+        "Every binary level section should have a tag");
+
+    static const std::string EMPTY;
+    uint32_t index = static_cast<uint32_t>(section);
+    if(index >= static_cast<uint32_t>(Section::nbSections))
+        return EMPTY;
+
+    return TAGS[index];
+}
+
+bool isBinaryLevel(const std::string& fileName)
+{
+    std::ifstream file(fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+    char magic[sizeof(MAGIC)];
+    if(!file.read(magic, sizeof(magic)))
+        return false;
+
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+MappedLevel::MappedLevel() :
+    mSectionOffsets(static_cast<uint32_t>(Section::nbSections), 0),
+    mSectionSizes(static_cast<uint32_t>(Section::nbSections), 0)
+{
+}
+
+MappedLevel::~MappedLevel()
+{
+}
+
+bool MappedLevel::open(const std::string& fileName)
+{
+    try
+    {
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        mRegion.reset(new boost::interprocess::mapped_region(file, boost::interprocess::read_only));
+    }
+    catch(const boost::interprocess::interprocess_exception& e)
+    {
+        OD_LOG_WRN("Couldn't map binary level file=" + fileName + ", error=" + e.what());
+        mRegion.reset();
+        return false;
+    }
+
+    const char* data = static_cast<const char*>(mRegion->get_address());
+    uint64_t fileSize = mRegion->get_size();
+
+    FileHeader header;
+    if(fileSize < sizeof(header))
+    {
+        OD_LOG_WRN("Binary level file too small=" + fileName);
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if(std::memcmp(header.mMagic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        OD_LOG_WRN("Not a binary level file=" + fileName);
+        return false;
+    }
+
+    if(header.mByteOrderMark != BYTE_ORDER_MARK)
+    {
+        OD_LOG_WRN("Binary level written with a different byte order file=" + fileName);
+        return false;
+    }
+
+    if(header.mFormatVersion != FORMAT_VERSION)
+    {
+        OD_LOG_WRN("Unsupported binary level version file=" + fileName
+            + ", version=" + Helper::toString(header.mFormatVersion)
+            + ", expected=" + Helper::toString(FORMAT_VERSION));
+        return false;
+    }
+
+    if(header.mFileSize != fileSize)
+    {
+        OD_LOG_WRN("Truncated binary level file=" + fileName
+            + ", size=" + Helper::toString(fileSize)
+            + ", expected=" + Helper::toString(header.mFileSize));
+        return false;
+    }
+
+    uint64_t tableEnd = sizeof(header) + static_cast<uint64_t>(header.mNbSections) * sizeof(SectionEntry);
+    if(tableEnd > fileSize)
+    {
+        OD_LOG_WRN("Invalid section table in binary level file=" + fileName);
+        return false;
+    }
+
+    std::vector<bool> isSectionSet(static_cast<uint32_t>(Section::nbSections), false);
+    for(uint32_t i = 0; i < header.mNbSections; ++i)
+    {
+        SectionEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(SectionEntry), sizeof(entry));
+        if(entry.mId >= static_cast<uint32_t>(Section::nbSections))
+        {
+            // Sections unknown to this version are ignored so that sections can be added without
+            // breaking older readers
+            OD_LOG_INF("Ignoring unknown section id=" + Helper::toString(entry.mId) + " in file=" + fileName);
+            continue;
+        }
+
+        if(isSectionSet[entry.mId])
+        {
+            OD_LOG_WRN("Duplicated section id=" + Helper::toString(entry.mId) + " in file=" + fileName);
+            return false;
+        }
+
+        if((entry.mOffset < tableEnd) ||
+           (entry.mOffset % SECTION_ALIGNMENT != 0) ||
+           (entry.mOffset > fileSize) ||
+           (entry.mSize > fileSize - entry.mOffset))
+        {
+            OD_LOG_WRN("Invalid bounds for section id=" + Helper::toString(entry.mId) + " in file=" + fileName);
+            return false;
+        }
+
+        if(computeChecksum(data + entry.mOffset, entry.mSize) != entry.mChecksum)
+        {
+            OD_LOG_WRN("Corrupted section id=" + Helper::toString(entry.mId) + " in file=" + fileName);
+            return false;
+        }
+
+        isSectionSet[entry.mId] = true;
+        mSectionOffsets[entry.mId] = entry.mOffset;
+        mSectionSizes[entry.mId] = entry.mSize;
+    }
+
+    static const Section MANDATORY_SECTIONS[] =
+    {
+        Section::version, Section::info, Section::seats, Section::goals,
+        Section::tiles, Section::rooms, Section::traps, Section::lights, Section::creatures
+    };
+    for(Section section : MANDATORY_SECTIONS)
+    {
+        if(!isSectionSet[static_cast<uint32_t>(section)])
+        {
+            OD_LOG_WRN("Missing section " + getSectionTag(section) + " id="
+                + Helper::toString(static_cast<uint32_t>(section)) + " in file=" + fileName);
+            return false;
+        }
+    }
+
+    uint32_t tilesIndex = static_cast<uint32_t>(Section::tiles);
+    if(!validateTiles(data + mSectionOffsets[tilesIndex], mSectionSizes[tilesIndex]))
+    {
+        OD_LOG_WRN("Invalid tiles section in file=" + fileName);
+        return false;
+    }
+
+    return true;
+}
+
+bool MappedLevel::validateTiles(const char* data, uint64_t size)
+{
+    TilesHeader header;
+    if(size < sizeof(header))
+        return false;
+
+    std::memcpy(&header, data, sizeof(header));
+    if((header.mMapSizeX <= 0) || (header.mMapSizeY <= 0))
+        return false;
+
+    uint64_t nbTiles = header.mNbTiles;
+    if(size != sizeof(header) + nbTiles * PACKED_TILE_SIZE)
+        return false;
+
+    // The section is aligned on 8 bytes and the arrays are written from the biggest type to the
+    // smallest so every array is aligned
+    const char* arrays = data + sizeof(header);
+    mTiles.mMapSizeX = header.mMapSizeX;
+    mTiles.mMapSizeY = header.mMapSizeY;
+    mTiles.mNbTiles = header.mNbTiles;
+    mTiles.mFullness = reinterpret_cast<const double*>(arrays);
+    mTiles.mPosX = reinterpret_cast<const int32_t*>(arrays + nbTiles * sizeof(double));
+    mTiles.mPosY = mTiles.mPosX + nbTiles;
+    mTiles.mSeatId = mTiles.mPosY + nbTiles;
+    mTiles.mType = reinterpret_cast<const uint8_t*>(mTiles.mSeatId + nbTiles);
+    mTiles.mHasSeat = mTiles.mType + nbTiles;
+
+    // The tiles are used without further checks when the level is loaded so every value that could
+    // give an invalid tile is checked here
+    for(uint32_t i = 0; i < mTiles.mNbTiles; ++i)
+    {
+        if((mTiles.mPosX[i] < 0) || (mTiles.mPosX[i] >= mTiles.mMapSizeX) ||
+           (mTiles.mPosY[i] < 0) || (mTiles.mPosY[i] >= mTiles.mMapSizeY) ||
+           (mTiles.mType[i] >= static_cast<uint8_t>(TileType::countTileType)) ||
+           !std::isfinite(mTiles.mFullness[i]) || (mTiles.mFullness[i] < 0.0) ||
+           (mTiles.mHasSeat[i] > 1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MappedLevel::hasSection(Section section) const
+{
+    uint32_t index = static_cast<uint32_t>(section);
+    return (mRegion != nullptr) && (index < mSectionSizes.size()) && (mSectionSizes[index] > 0);
+}
+
+const char* MappedLevel::getSectionText(Section section, uint64_t& size) const
+{
+    if(!hasSection(section))
+    {
+        size = 0;
+        return nullptr;
+    }
+
+    uint32_t index = static_cast<uint32_t>(section);
+    size = mSectionSizes[index];
+    return static_cast<const char*>(mRegion->get_address()) + mSectionOffsets[index];
+}
+
+std::string MappedLevel::getVersion() const
+{
+    uint64_t size;
+    const char* data = getSectionText(Section::version, size);
+    if(data == nullptr)
+        return std::string();
+
+    return std::string(data, size);
+}
+
+MemoryInputStream::MemoryBuffer::MemoryBuffer(const char* data, uint64_t size)
+{
+    // The buffer is only used for reading so the const_cast is safe
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+}
+
+MemoryInputStream::MemoryInputStream(const char* data, uint64_t size) :
+    std::istream(nullptr),
+    mBuffer(data, size)
+{
+    rdbuf(&mBuffer);
+}
+
+LevelSnapshot::LevelSnapshot() :
+    mSectionTexts(static_cast<uint32_t>(Section::nbSections)),
+    mMapSizeX(0),
+    mMapSizeY(0)
+{
+}
+
+bool parseText(std::istream& levelText, LevelSnapshot& snapshot)
+{
+    const uint32_t nbSections = static_cast<uint32_t>(Section::nbSections);
+    std::vector<bool> isSectionSet(nbSections, false);
+
+    // The version is the first word of the file
+    std::string line;
+    snapshot.mVersion.clear();
+    while(snapshot.mVersion.empty() && readLineWithoutComment(levelText, line))
+    {
+        std::stringstream ss(line);
+        ss >> snapshot.mVersion;
+    }
+    if(snapshot.mVersion.empty())
+    {
+        OD_LOG_WRN("Empty level");
+        return false;
+    }
+
+    while(readLineWithoutComment(levelText, line))
+    {
+        std::string tag = trimmed(line);
+        if(tag.empty())
+            continue;
+
+        uint32_t index = 0;
+        while((index < nbSections) && (getSectionTag(static_cast<Section>(index)) != tag))
+            ++index;
+
+        if((index == static_cast<uint32_t>(Section::version)) || (index >= nbSections))
+        {
+            OD_LOG_WRN("Unexpected line in level=" + line);
+            return false;
+        }
+
+        if(isSectionSet[index])
+        {
+            OD_LOG_WRN("Duplicated section in level=" + tag);
+            return false;
+        }
+        isSectionSet[index] = true;
+
+        // Text sections are stored with their tags so that they can be read by the text parser
+        const std::string endTag = "[/" + tag.substr(1);
+        std::string content = tag + "\n";
+        bool isClosed = false;
+        while(readLineWithoutComment(levelText, line))
+        {
+            if(trimmed(line) == endTag)
+            {
+                isClosed = true;
+                break;
+            }
+            content += line + "\n";
+        }
+
+        if(!isClosed)
+        {
+            OD_LOG_WRN("Unexpected EOF reached in section=" + tag);
+            return false;
+        }
+
+        if(index != static_cast<uint32_t>(Section::tiles))
+        {
+            snapshot.mSectionTexts[index] = content + endTag + "\n";
+            continue;
+        }
+
+        snapshot.mTiles.clear();
+        if(!parseTiles(content.substr(tag.size()), snapshot.mMapSizeX, snapshot.mMapSizeY, snapshot.mTiles))
+            return false;
+    }
+
+    return true;
+}
+
+void serializeBinary(const LevelSnapshot& snapshot, std::string& buffer)
+{
+    const uint32_t nbSections = static_cast<uint32_t>(Section::nbSections);
+    std::vector<std::string> sections(nbSections);
+    sections[static_cast<uint32_t>(Section::version)] = snapshot.mVersion;
+    for(uint32_t index = static_cast<uint32_t>(Section::info); index < nbSections; ++index)
+    {
+        if(index == static_cast<uint32_t>(Section::tiles))
+        {
+            if(snapshot.mMapSizeX > 0)
+                packTiles(snapshot.mMapSizeX, snapshot.mMapSizeY, snapshot.mTiles, sections[index]);
+            continue;
+        }
+
+        // The text parser does not handle comments
+        std::stringstream ss(snapshot.mSectionTexts[index]);
+        std::string line;
+        while(readLineWithoutComment(ss, line))
+            sections[index] += line + "\n";
+    }
+
+    std::vector<SectionEntry> entries;
+    for(uint32_t index = 0; index < nbSections; ++index)
+    {
+        if(sections[index].empty())
+            continue;
+
+        SectionEntry entry;
+        entry.mId = index;
+        entry.mChecksum = computeChecksum(sections[index].data(), sections[index].size());
+        entry.mOffset = 0;
+        entry.mSize = sections[index].size();
+        entries.push_back(entry);
+    }
+
+    uint64_t offset = sizeof(FileHeader) + entries.size() * sizeof(SectionEntry);
+    for(SectionEntry& entry : entries)
+    {
+        entry.mOffset = alignSection(offset);
+        offset = entry.mOffset + entry.mSize;
+    }
+
+    FileHeader header;
+    std::memcpy(header.mMagic, MAGIC, sizeof(MAGIC));
+    header.mFormatVersion = FORMAT_VERSION;
+    header.mByteOrderMark = BYTE_ORDER_MARK;
+    header.mFileSize = offset;
+    header.mNbSections = static_cast<uint32_t>(entries.size());
+    header.mReserved = 0;
+
+    buffer.clear();
+    buffer.reserve(offset);
+    appendValue(buffer, header);
+    for(const SectionEntry& entry : entries)
+        appendValue(buffer, entry);
+
+    for(const SectionEntry& entry : entries)
+    {
+        buffer.resize(entry.mOffset, '\0');
+        buffer += sections[entry.mId];
+    }
+}
+
+void writeText(const LevelSnapshot& snapshot, std::ostream& os)
+{
+    os << snapshot.mVersion
+        << "  # The version of OpenDungeons which created this file (for compatibility reasons).\n";
+
+    for(uint32_t index = static_cast<uint32_t>(Section::info); index < static_cast<uint32_t>(Section::nbSections); ++index)
+    {
+        if(index != static_cast<uint32_t>(Section::tiles))
+        {
+            const std::string& text = snapshot.mSectionTexts[index];
+            if(!text.empty())
+                os << "\n" << text;
+            continue;
+        }
+
+        os << "\n[Tiles]\n";
+        os << "# Map Size" << std::endl;
+        os << snapshot.mMapSizeX << " # MapSizeX" << std::endl;
+        os << snapshot.mMapSizeY << " # MapSizeY" << std::endl;
+        if(!snapshot.mTileFormat.empty())
+            os << "# " << snapshot.mTileFormat << "\n";
+
+        for(const TileRecord& tile : snapshot.mTiles)
+        {
+            os << tile.mPosX << "\t" << tile.mPosY << "\t" << static_cast<uint32_t>(tile.mType) << "\t";
+            writeFullness(os, tile.mFullness);
+            if(tile.mHasSeat)
+                os << "\t" << tile.mSeatId;
+            os << "\n";
+        }
+        os << "[/Tiles]\n";
+    }
+}
+
+void readSnapshot(const MappedLevel& level, LevelSnapshot& snapshot)
+{
+    snapshot.mVersion = level.getVersion();
+    for(uint32_t index = static_cast<uint32_t>(Section::info); index < static_cast<uint32_t>(Section::nbSections); ++index)
+    {
+        uint64_t size;
+        const char* data = level.getSectionText(static_cast<Section>(index), size);
+        if((index == static_cast<uint32_t>(Section::tiles)) || (data == nullptr))
+            continue;
+
+        snapshot.mSectionTexts[index].assign(data, size);
+    }
+
+    const TileArrays& tiles = level.getTiles();
+    snapshot.mMapSizeX = tiles.mMapSizeX;
+    snapshot.mMapSizeY = tiles.mMapSizeY;
+    snapshot.mTiles.resize(tiles.mNbTiles);
+    for(uint32_t i = 0; i < tiles.mNbTiles; ++i)
+    {
+        TileRecord& tile = snapshot.mTiles[i];
+        tile.mPosX = tiles.mPosX[i];
+        tile.mPosY = tiles.mPosY[i];
+        tile.mType = tiles.mType[i];
+        tile.mFullness = tiles.mFullness[i];
+        tile.mHasSeat = (tiles.mHasSeat[i] != 0);
+        tile.mSeatId = tiles.mSeatId[i];
+    }
+}
+
+bool writeBinaryFromText(std::istream& levelText, const std::string& binaryFile)
+{
+    LevelSnapshot snapshot;
+    if(!parseText(levelText, snapshot))
+        return false;
+
+    std::string buffer;
+    serializeBinary(snapshot, buffer);
+
+    std::ofstream file(binaryFile.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if(!file.good())
+    {
+        OD_LOG_WRN("Couldn't open file for writing: " + binaryFile);
+        return false;
+    }
+
+    file.write(buffer.data(), buffer.size());
+    if(!file.good())
+    {
+        OD_LOG_WRN("Unexpected failure on file: " + binaryFile);
+        return false;
+    }
+
+    return true;
+}
+
+bool convertTextToBinary(const std::string& textFile, const std::string& binaryFile)
+{
+    std::ifstream levelText(textFile.c_str(), std::ifstream::in);
+    if(!levelText.good())
+    {
+        OD_LOG_WRN("File not found=" + textFile);
+        return false;
+    }
+
+    return writeBinaryFromText(levelText, binaryFile);
+}
+
+bool convertBinaryToText(const std::string& binaryFile, const std::string& textFile)
+{
+    MappedLevel level;
+    if(!level.open(binaryFile))
+        return false;
+
+    std::ofstream file(textFile.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if(!file.good())
+    {
+        OD_LOG_WRN("Couldn't open file for writing: " + textFile);
+        return false;
+    }
+
+    LevelSnapshot snapshot;
+    readSnapshot(level, snapshot);
+    writeText(snapshot, file);
+    if(!file.good())
+    {
+        OD_LOG_WRN("Unexpected failure on file: " + textFile);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace BinaryLevel
@@ -0,0 +1,213 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINARYLEVEL_H
+#define BINARYLEVEL_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace boost
+{
+namespace interprocess
+{
+class mapped_region;
+}
+}
+
+/*! \brief Binary container for levels and savegames. It can be used instead of the text .level format
+ * and is detected by its magic number, whatever the file extension.
+ * The file starts with a header followed by a section table. Each entry gives the offset, the size and
+ * a checksum of a section. The tiles are stored as packed arrays that are read directly from the
+ * memory mapped file. The other sections (seats, goals, rooms, traps, creatures, ...) are stored as
+ * the comment-free text of the corresponding .level section so that they are parsed by the same code
+ * as the text format, without copying the file in a stringstream first.
+ * Every section starts on an 8 bytes boundary. Integers are stored in the byte order of the machine
+ * that wrote the file. Files written on a machine with another byte order are rejected.
+ */
+namespace BinaryLevel
+{
+    //! \brief Version of the container. It should be increased when the layout of the header,
+    //! the section table or the packed tiles changes
+    const uint32_t FORMAT_VERSION = 1;
+
+    //! \brief The sections of a level, in the order they are written in the text format
+    enum class Section : uint32_t
+    {
+        version,
+        info,
+        seats,
+        goals,
+        tiles,
+        rooms,
+        traps,
+        lights,
+        creatureDefinitions,
+        equipmentDefinitions,
+        creatures,
+        spells,
+        craftedTraps,
+        skillEntity,
+        giftBoxEntity,
+        missiles,
+        treasuryObject,
+        chickens,
+        nbSections
+    };
+
+    //! \brief Returns the tag of the given section in the text format (for example "[Seats]").
+    //! Returns an empty string for the version section that has no tag
+    const std::string& getSectionTag(Section section);
+
+    //! \brief Tiles as they are stored in the tiles section. Only the tiles that differ from a full
+    //! dirt tile are stored, like in the text format. The arrays point in the mapped file
+    struct TileArrays
+    {
+        TileArrays() :
+            mMapSizeX(0),
+            mMapSizeY(0),
+            mNbTiles(0),
+            mFullness(nullptr),
+            mPosX(nullptr),
+            mPosY(nullptr),
+            mSeatId(nullptr),
+            mType(nullptr),
+            mHasSeat(nullptr)
+        {}
+
+        int32_t mMapSizeX;
+        int32_t mMapSizeY;
+        uint32_t mNbTiles;
+        const double* mFullness;
+        const int32_t* mPosX;
+        const int32_t* mPosY;
+        const int32_t* mSeatId;
+        const uint8_t* mType;
+        //! \brief 1 if a seat id was given for the tile, 0 otherwise
+        const uint8_t* mHasSeat;
+    };
+
+    //! \brief Returns true if the given file starts with the magic number of the binary format
+    bool isBinaryLevel(const std::string& fileName);
+
+    //! \brief A binary level mapped in memory. open() validates the whole file once (header, section
+    //! table, checksums and tiles) so that the sections can then be read without further checks
+    class MappedLevel
+    {
+    public:
+        MappedLevel();
+        ~MappedLevel();
+
+        //! \brief Maps and validates the given file. Returns false if the file is not a valid binary level
+        bool open(const std::string& fileName);
+
+        bool hasSection(Section section) const;
+
+        //! \brief Returns the content of a text section. size is set to 0 if the section is missing
+        const char* getSectionText(Section section, uint64_t& size) const;
+
+        //! \brief Returns the version string of the game that wrote the level
+        std::string getVersion() const;
+
+        const TileArrays& getTiles() const
+        { return mTiles; }
+
+    private:
+        std::unique_ptr<boost::interprocess::mapped_region> mRegion;
+        std::vector<uint64_t> mSectionOffsets;
+        std::vector<uint64_t> mSectionSizes;
+        TileArrays mTiles;
+
+        bool validateTiles(const char* data, uint64_t size);
+    };
+
+    //! \brief Read only stream over a memory area (usually a section of a mapped level). The memory is not copied
+    //! and must outlive the stream
+    class MemoryInputStream : public std::istream
+    {
+    public:
+        MemoryInputStream(const char* data, uint64_t size);
+
+    private:
+        class MemoryBuffer : public std::streambuf
+        {
+        public:
+            MemoryBuffer(const char* data, uint64_t size);
+        };
+
+        MemoryBuffer mBuffer;
+    };
+
+    //! \brief A tile as stored in a LevelSnapshot
+    struct TileRecord
+    {
+        int32_t mPosX;
+        int32_t mPosY;
+        uint8_t mType;
+        double mFullness;
+        bool mHasSeat;
+        int32_t mSeatId;
+    };
+
+    //! \brief A level held in memory, independently from any GameMap. It is used to convert levels between
+    //! both formats and to write savegames from another thread than the one updating the GameMap.
+    struct LevelSnapshot
+    {
+        LevelSnapshot();
+
+        std::string mVersion;
+        //! \brief Text of each section with its tags. It may contain comments. Empty if the section is
+        //! missing. The entry of the tiles section is not used
+        std::vector<std::string> mSectionTexts;
+        //! \brief Sections captured from a game map that are not formatted yet (see MapHandler::captureGameMap
+        //! and MapHandler::formatCapturedSections). Empty once they are formatted in mSectionTexts
+        std::vector<std::string> mSectionRecords;
+        int32_t mMapSizeX;
+        int32_t mMapSizeY;
+        //! \brief Format of the tile lines, written as a comment in the text format
+        std::string mTileFormat;
+        std::vector<TileRecord> mTiles;
+    };
+
+    //! \brief Reads a text level. Returns false if the text is not a valid level
+    bool parseText(std::istream& levelText, LevelSnapshot& snapshot);
+
+    //! \brief Copies the content of a mapped level
+    void readSnapshot(const MappedLevel& level, LevelSnapshot& snapshot);
+
+    //! \brief Builds the binary level corresponding to the given snapshot in buffer
+    void serializeBinary(const LevelSnapshot& snapshot, std::string& buffer);
+
+    //! \brief Writes the given snapshot in the text format
+    void writeText(const LevelSnapshot& snapshot, std::ostream& os);
+
+    //! \brief Writes a binary level from the content of a text level. Returns false if the text is not
+    //! a valid level or if the file could not be written
+    bool writeBinaryFromText(std::istream& levelText, const std::string& binaryFile);
+
+    //! \brief Converts the given text level to the binary format and conversely. The conversion is lossless
+    //! except for the comments of the text file
+    bool convertTextToBinary(const std::string& textFile, const std::string& binaryFile);
+    bool convertBinaryToText(const std::string& binaryFile, const std::string& textFile);
+}
+
+#endif // BINARYLEVEL_H
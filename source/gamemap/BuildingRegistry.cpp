@@ -0,0 +1,322 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/BuildingRegistry.h"
+
+#include "rooms/Room.h"
+#include "rooms/RoomType.h"
+#include "traps/Trap.h"
+#include "traps/TrapType.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+
+static const std::vector<Room*> EMPTY_ROOMS;
+static const std::vector<Trap*> EMPTY_TRAPS;
+
+//! \brief Removes the given value from the vector. The order is kept because buildings are
+//! processed in the order they were added. Returns false if the value was not found
+template<typename T>
+static bool removeFromVector(std::vector<T*>& vec, T* value)
+{
+    auto it = std::find(vec.begin(), vec.end(), value);
+    if(it == vec.end())
+        return false;
+
+    vec.erase(it);
+    return true;
+}
+
+BuildingRegistry::SeatBuildings::SeatBuildings() :
+    mRoomsByType(static_cast<uint32_t>(RoomType::nbRooms)),
+    mTrapsByType(static_cast<uint32_t>(TrapType::nbTraps)),
+    mGoldStored(0),
+    mGoldStorage(0)
+{
+}
+
+BuildingRegistry::BuildingRegistry() :
+    mRoomsByType(static_cast<uint32_t>(RoomType::nbRooms))
+{
+}
+
+void BuildingRegistry::clearRooms()
+{
+    for(std::pair<const Seat* const, SeatBuildings>& p : mSeatBuildings)
+    {
+        for(std::vector<Room*>& rooms : p.second.mRoomsByType)
+            rooms.clear();
+        p.second.mRooms.clear();
+        p.second.mGoldStored = 0;
+        p.second.mGoldStorage = 0;
+    }
+    for(std::vector<Room*>& rooms : mRoomsByType)
+        rooms.clear();
+    mRoomsByName.clear();
+    mTreasuries.clear();
+}
+
+void BuildingRegistry::clearTraps()
+{
+    for(std::pair<const Seat* const, SeatBuildings>& p : mSeatBuildings)
+    {
+        for(std::vector<Trap*>& traps : p.second.mTrapsByType)
+            traps.clear();
+        p.second.mTraps.clear();
+    }
+    mTrapsByName.clear();
+}
+
+void BuildingRegistry::addRoom(Room* room)
+{
+    uint32_t index = static_cast<uint32_t>(room->getType());
+    if(index >= mRoomsByType.size())
+    {
+        OD_LOG_ERR("room=" + room->getName() + ", wrong type index=" + Helper::toString(index));
+        return;
+    }
+
+    mRoomsByType[index].push_back(room);
+    mRoomsByName[room->getName()] = room;
+    addRoomForSeat(room, room->getSeat());
+}
+
+void BuildingRegistry::removeRoom(Room* room)
+{
+    uint32_t index = static_cast<uint32_t>(room->getType());
+    if(index >= mRoomsByType.size())
+    {
+        OD_LOG_ERR("room=" + room->getName() + ", wrong type index=" + Helper::toString(index));
+        return;
+    }
+
+    removeFromVector(mRoomsByType[index], room);
+    auto it = mRoomsByName.find(room->getName());
+    if((it != mRoomsByName.end()) && (it->second == room))
+        mRoomsByName.erase(it);
+
+    removeRoomForSeat(room, room->getSeat());
+}
+
+void BuildingRegistry::addTrap(Trap* trap)
+{
+    uint32_t index = static_cast<uint32_t>(trap->getType());
+    if(index >= static_cast<uint32_t>(TrapType::nbTraps))
+    {
+        OD_LOG_ERR("trap=" + trap->getName() + ", wrong type index=" + Helper::toString(index));
+        return;
+    }
+
+    mTrapsByName[trap->getName()] = trap;
+    SeatBuildings& seatBuildings = mSeatBuildings[trap->getSeat()];
+    seatBuildings.mTrapsByType[index].push_back(trap);
+    seatBuildings.mTraps.push_back(trap);
+}
+
+void BuildingRegistry::removeTrap(Trap* trap)
+{
+    uint32_t index = static_cast<uint32_t>(trap->getType());
+    if(index >= static_cast<uint32_t>(TrapType::nbTraps))
+    {
+        OD_LOG_ERR("trap=" + trap->getName() + ", wrong type index=" + Helper::toString(index));
+        return;
+    }
+
+    auto itName = mTrapsByName.find(trap->getName());
+    if((itName != mTrapsByName.end()) && (itName->second == trap))
+        mTrapsByName.erase(itName);
+
+    auto it = mSeatBuildings.find(trap->getSeat());
+    if(it == mSeatBuildings.end())
+        return;
+
+    removeFromVector(it->second.mTrapsByType[index], trap);
+    removeFromVector(it->second.mTraps, trap);
+}
+
+void BuildingRegistry::roomSeatChanged(Room* room, const Seat* oldSeat)
+{
+    if(room->getSeat() == oldSeat)
+        return;
+
+    removeRoomForSeat(room, oldSeat);
+    addRoomForSeat(room, room->getSeat());
+}
+
+void BuildingRegistry::addRoomForSeat(Room* room, const Seat* seat)
+{
+    uint32_t index = static_cast<uint32_t>(room->getType());
+    SeatBuildings& seatBuildings = mSeatBuildings[seat];
+    seatBuildings.mRoomsByType[index].push_back(room);
+    seatBuildings.mRooms.push_back(room);
+
+    if(room->getType() != RoomType::treasury)
+        return;
+
+    TreasuryGold& treasuryGold = mTreasuries[room];
+    treasuryGold.mGoldStored = room->getTotalGoldStored();
+    treasuryGold.mGoldStorage = room->getTotalGoldStorage();
+    seatBuildings.mGoldStored += treasuryGold.mGoldStored;
+    seatBuildings.mGoldStorage += treasuryGold.mGoldStorage;
+}
+
+void BuildingRegistry::removeRoomForSeat(Room* room, const Seat* seat)
+{
+    auto it = mSeatBuildings.find(seat);
+    if(it == mSeatBuildings.end())
+        return;
+
+    uint32_t index = static_cast<uint32_t>(room->getType());
+    removeFromVector(it->second.mRoomsByType[index], room);
+    removeFromVector(it->second.mRooms, room);
+
+    auto itTreasury = mTreasuries.find(room);
+    if(itTreasury == mTreasuries.end())
+        return;
+
+    it->second.mGoldStored -= itTreasury->second.mGoldStored;
+    it->second.mGoldStorage -= itTreasury->second.mGoldStorage;
+    mTreasuries.erase(itTreasury);
+}
+
+const std::vector<Room*>& BuildingRegistry::getRoomsByType(RoomType type) const
+{
+    uint32_t index = static_cast<uint32_t>(type);
+    if(index >= mRoomsByType.size())
+        return EMPTY_ROOMS;
+
+    return mRoomsByType[index];
+}
+
+const std::vector<Room*>& BuildingRegistry::getRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
+{
+    uint32_t index = static_cast<uint32_t>(type);
+    if(index >= static_cast<uint32_t>(RoomType::nbRooms))
+        return EMPTY_ROOMS;
+
+    auto it = mSeatBuildings.find(seat);
+    if(it == mSeatBuildings.end())
+        return EMPTY_ROOMS;
+
+    return it->second.mRoomsByType[index];
+}
+
+const std::vector<Room*>& BuildingRegistry::getRoomsBySeat(const Seat* seat) const
+{
+    auto it = mSeatBuildings.find(seat);
+    if(it == mSeatBuildings.end())
+        return EMPTY_ROOMS;
+
+    return it->second.mRooms;
+}
+
+const std::vector<Trap*>& BuildingRegistry::getTrapsByTypeAndSeat(TrapType type, const Seat* seat) const
+{
+    uint32_t index = static_cast<uint32_t>(type);
+    if(index >= static_cast<uint32_t>(TrapType::nbTraps))
+        return EMPTY_TRAPS;
+
+    auto it = mSeatBuildings.find(seat);
+    if(it == mSeatBuildings.end())
+        return EMPTY_TRAPS;
+
+    return it->second.mTrapsByType[index];
+}
+
+const std::vector<Trap*>& BuildingRegistry::getTrapsBySeat(const Seat* seat) const
+{
+    auto it = mSeatBuildings.find(seat);
+    if(it == mSeatBuildings.end())
+        return EMPTY_TRAPS;
+
+    return it->second.mTraps;
+}
+
+Room* BuildingRegistry::getRoomByName(const std::string& name) const
+{
+    auto it = mRoomsByName.find(name);
+    if(it == mRoomsByName.end())
+        return nullptr;
+
+    return it->second;
+}
+
+Trap* BuildingRegistry::getTrapByName(const std::string& name) const
+{
+    auto it = mTrapsByName.find(name);
+    if(it == mTrapsByName.end())
+        return nullptr;
+
+    return it->second;
+}
+
+void BuildingRegistry::treasuryGoldChanged(const Room* room, int goldDelta)
+{
+    auto itTreasury = mTreasuries.find(room);
+    if(itTreasury == mTreasuries.end())
+        return;
+
+    itTreasury->second.mGoldStored += goldDelta;
+    auto it = mSeatBuildings.find(room->getSeat());
+    if(it == mSeatBuildings.end())
+    {
+        OD_LOG_ERR("room=" + room->getName() + " not registered for its seat");
+        return;
+    }
+
+    it->second.mGoldStored += goldDelta;
+}
+
+void BuildingRegistry::treasuryTilesChanged(const Room* room)
+{
+    auto itTreasury = mTreasuries.find(room);
+    if(itTreasury == mTreasuries.end())
+        return;
+
+    auto it = mSeatBuildings.find(room->getSeat());
+    if(it == mSeatBuildings.end())
+    {
+        OD_LOG_ERR("room=" + room->getName() + " not registered for its seat");
+        return;
+    }
+
+    TreasuryGold& treasuryGold = itTreasury->second;
+    int goldStored = room->getTotalGoldStored();
+    int goldStorage = room->getTotalGoldStorage();
+    it->second.mGoldStored += goldStored - treasuryGold.mGoldStored;
+    it->second.mGoldStorage += goldStorage - treasuryGold.mGoldStorage;
+    treasuryGold.mGoldStored = goldStored;
+    treasuryGold.mGoldStorage = goldStorage;
+}
+
+int BuildingRegistry::getTotalGoldStored(const Seat* seat) const
+{
+    auto it = mSeatBuildings.find(seat);
+    if(it == mSeatBuildings.end())
+        return 0;
+
+    return it->second.mGoldStored;
+}
+
+int BuildingRegistry::getTotalGoldStorage(const Seat* seat) const
+{
+    auto it = mSeatBuildings.find(seat);
+    if(it == mSeatBuildings.end())
+        return 0;
+
+    return it->second.mGoldStorage;
+}
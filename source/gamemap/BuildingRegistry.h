@@ -0,0 +1,191 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUILDINGREGISTRY_H
+#define BUILDINGREGISTRY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Room;
+class Seat;
+class Trap;
+
+enum class RoomType;
+enum class TrapType;
+
+/*! \brief Read only view over a list of buildings from the BuildingRegistry. Buildings
+ * without HP left (destroyed but not yet removed from the game map) are skipped while iterating.
+ * The view does not copy the list so it should not be kept once the game map is changed.
+ */
+template<typename T>
+class BuildingView
+{
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(typename std::vector<T*>::const_iterator it,
+                typename std::vector<T*>::const_iterator end) :
+            mIt(it),
+            mEnd(end)
+        { skipDead(); }
+
+        inline T* operator*() const
+        { return *mIt; }
+
+        inline const_iterator& operator++()
+        {
+            ++mIt;
+            skipDead();
+            return *this;
+        }
+
+        inline bool operator==(const const_iterator& other) const
+        { return mIt == other.mIt; }
+
+        inline bool operator!=(const const_iterator& other) const
+        { return mIt != other.mIt; }
+
+    private:
+        typename std::vector<T*>::const_iterator mIt;
+        typename std::vector<T*>::const_iterator mEnd;
+
+        void skipDead()
+        {
+            while((mIt != mEnd) && ((*mIt)->getHP(nullptr) <= 0.0))
+                ++mIt;
+        }
+    };
+
+    BuildingView(const std::vector<T*>& buildings) :
+        mBuildings(buildings)
+    {}
+
+    inline const_iterator begin() const
+    { return const_iterator(mBuildings.begin(), mBuildings.end()); }
+
+    inline const_iterator end() const
+    { return const_iterator(mBuildings.end(), mBuildings.end()); }
+
+    inline bool empty() const
+    { return begin() == end(); }
+
+    //! \brief Returns the first building or nullptr if the view is empty
+    inline T* front() const
+    { return empty() ? nullptr : *begin(); }
+
+    uint32_t size() const
+    {
+        uint32_t nb = 0;
+        for(const_iterator it = begin(); it != end(); ++it)
+            ++nb;
+        return nb;
+    }
+
+    //! \brief Copies the view in a vector. To be used only when the caller needs to modify the list
+    std::vector<T*> toVector() const
+    {
+        std::vector<T*> ret;
+        for(T* building : *this)
+            ret.push_back(building);
+        return ret;
+    }
+
+private:
+    const std::vector<T*>& mBuildings;
+};
+
+/*! \brief Indexes the rooms and traps of a game map by seat and type and by name so that
+ * the game map can answer the common queries without going through every building.
+ * It is kept up to date by GameMap::addRoom/removeRoom/addTrap/removeTrap.
+ */
+class BuildingRegistry
+{
+public:
+    BuildingRegistry();
+
+    void clearRooms();
+    void clearTraps();
+
+    void addRoom(Room* room);
+    void removeRoom(Room* room);
+    void addTrap(Trap* trap);
+    void removeTrap(Trap* trap);
+
+    //! \brief Moves the given room from oldSeat lists to the room current seat lists
+    void roomSeatChanged(Room* room, const Seat* oldSeat);
+
+    const std::vector<Room*>& getRoomsByType(RoomType type) const;
+    const std::vector<Room*>& getRoomsByTypeAndSeat(RoomType type, const Seat* seat) const;
+    const std::vector<Room*>& getRoomsBySeat(const Seat* seat) const;
+    const std::vector<Trap*>& getTrapsByTypeAndSeat(TrapType type, const Seat* seat) const;
+    const std::vector<Trap*>& getTrapsBySeat(const Seat* seat) const;
+
+    Room* getRoomByName(const std::string& name) const;
+    Trap* getTrapByName(const std::string& name) const;
+
+    //! \brief Updates the cached gold stored in the given treasury (and its seat) after gold has been deposited
+    //! (goldDelta > 0) or withdrawn (goldDelta < 0)
+    void treasuryGoldChanged(const Room* room, int goldDelta);
+
+    //! \brief Recomputes the gold stored and the storage of the given treasury after its tiles changed
+    void treasuryTilesChanged(const Room* room);
+
+    //! \brief Returns the gold stored and the gold that can be stored in the given seat treasuries. The totals
+    //! are cached and kept up to date when treasuries change
+    int getTotalGoldStored(const Seat* seat) const;
+    int getTotalGoldStorage(const Seat* seat) const;
+
+private:
+    struct SeatBuildings
+    {
+        SeatBuildings();
+
+        std::vector<std::vector<Room*>> mRoomsByType;
+        std::vector<std::vector<Trap*>> mTrapsByType;
+        std::vector<Room*> mRooms;
+        std::vector<Trap*> mTraps;
+        int mGoldStored;
+        int mGoldStorage;
+    };
+
+    //! \brief Gold counted for a treasury in its seat totals
+    struct TreasuryGold
+    {
+        TreasuryGold() :
+            mGoldStored(0),
+            mGoldStorage(0)
+        {}
+
+        int mGoldStored;
+        int mGoldStorage;
+    };
+
+    std::unordered_map<const Seat*, SeatBuildings> mSeatBuildings;
+    std::vector<std::vector<Room*>> mRoomsByType;
+    std::unordered_map<std::string, Room*> mRoomsByName;
+    std::unordered_map<std::string, Trap*> mTrapsByName;
+    std::unordered_map<const Room*, TreasuryGold> mTreasuries;
+
+    void addRoomForSeat(Room* room, const Seat* seat);
+    void removeRoomForSeat(Room* room, const Seat* seat);
+};
+
+#endif // BUILDINGREGISTRY_H
@@ -0,0 +1,236 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gamemap/DeferredTextStream.h"
+
+#include <cstring>
+#include <locale>
+#include <sstream>
+
+//! \brief Byte starting a recorded value. If it is written in the stream, it is escaped
+static const char MARKER = '\0';
+
+enum RecordType : char
+{
+    escapedMarker = 'e',
+    boolValue = 'b',
+    longValue = 'l',
+    ulongValue = 'u',
+    longLongValue = 'L',
+    ulongLongValue = 'U',
+    doubleValue = 'd',
+    longDoubleValue = 'D',
+    pointerValue = 'p'
+};
+
+class DeferredTextStream::RecordBuffer : public std::streambuf
+{
+public:
+    std::string mData;
+
+    template<typename T>
+    void appendValue(RecordType type, const std::ios_base& io, char fill, T value)
+    {
+        mData.push_back(MARKER);
+        mData.push_back(type);
+        appendRaw(io.flags());
+        appendRaw(io.precision());
+        appendRaw(io.width());
+        mData.push_back(fill);
+        appendRaw(value);
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if(traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+
+        append(traits_type::to_char_type(c));
+        return c;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        const char* end = s + n;
+        while(s < end)
+        {
+            const char* marker = static_cast<const char*>(std::memchr(s, MARKER, end - s));
+            if(marker == nullptr)
+            {
+                mData.append(s, end - s);
+                break;
+            }
+
+            mData.append(s, marker - s);
+            append(MARKER);
+            s = marker + 1;
+        }
+        return n;
+    }
+
+private:
+    inline void append(char c)
+    {
+        mData.push_back(c);
+        if(c == MARKER)
+            mData.push_back(escapedMarker);
+    }
+
+    template<typename T>
+    inline void appendRaw(const T& value)
+    {
+        mData.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+};
+
+//! \brief Facet used by DeferredTextStream to record the numbers instead of formatting them
+class DeferredNumPut : public std::num_put<char>
+{
+protected:
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, bool v) const override
+    { return record(out, io, fill, boolValue, v); }
+
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, long v) const override
+    { return record(out, io, fill, longValue, v); }
+
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, unsigned long v) const override
+    { return record(out, io, fill, ulongValue, v); }
+
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, long long v) const override
+    { return record(out, io, fill, longLongValue, v); }
+
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, unsigned long long v) const override
+    { return record(out, io, fill, ulongLongValue, v); }
+
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, double v) const override
+    { return record(out, io, fill, doubleValue, v); }
+
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, long double v) const override
+    { return record(out, io, fill, longDoubleValue, v); }
+
+    iter_type do_put(iter_type out, std::ios_base& io, char_type fill, const void* v) const override
+    { return record(out, io, fill, pointerValue, v); }
+
+private:
+    template<typename T>
+    iter_type record(iter_type out, std::ios_base& io, char_type fill, RecordType type, T v) const
+    {
+        DeferredTextStream* stream = dynamic_cast<DeferredTextStream*>(&io);
+        if(stream == nullptr)
+            return std::num_put<char>::do_put(out, io, fill, v);
+
+        stream->mBuffer->appendValue(type, io, fill, v);
+        // Like the standard facet, the width only applies to the next value
+        io.width(0);
+        return out;
+    }
+};
+
+template<typename T>
+static T readRaw(const std::string& record, size_t& pos)
+{
+    T value;
+    std::memcpy(&value, record.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+DeferredTextStream::DeferredTextStream() :
+    std::ostream(nullptr),
+    mBuffer(new RecordBuffer)
+{
+    rdbuf(mBuffer.get());
+    imbue(std::locale(getloc(), new DeferredNumPut));
+}
+
+DeferredTextStream::~DeferredTextStream()
+{
+}
+
+std::string DeferredTextStream::takeRecord()
+{
+    std::string record;
+    record.swap(mBuffer->mData);
+    return record;
+}
+
+void DeferredTextStream::format(const std::string& record, std::ostream& os)
+{
+    std::ostringstream number;
+    size_t start = 0;
+    while(true)
+    {
+        size_t pos = record.find(MARKER, start);
+        if(pos == std::string::npos)
+        {
+            os.write(record.data() + start, record.size() - start);
+            return;
+        }
+
+        os.write(record.data() + start, pos - start);
+        char type = record[pos + 1];
+        pos += 2;
+        if(type == escapedMarker)
+        {
+            os.put(MARKER);
+            start = pos;
+            continue;
+        }
+
+        number.str(std::string());
+        number.flags(readRaw<std::ios_base::fmtflags>(record, pos));
+        number.precision(readRaw<std::streamsize>(record, pos));
+        number.width(readRaw<std::streamsize>(record, pos));
+        number.fill(record[pos]);
+        ++pos;
+        switch(type)
+        {
+            case boolValue:
+                number << readRaw<bool>(record, pos);
+                break;
+            case longValue:
+                number << readRaw<long>(record, pos);
+                break;
+            case ulongValue:
+                number << readRaw<unsigned long>(record, pos);
+                break;
+            case longLongValue:
+                number << readRaw<long long>(record, pos);
+                break;
+            case ulongLongValue:
+                number << readRaw<unsigned long long>(record, pos);
+                break;
+            case doubleValue:
+                number << readRaw<double>(record, pos);
+                break;
+            case longDoubleValue:
+                number << readRaw<long double>(record, pos);
+                break;
+            case pointerValue:
+                number << readRaw<const void*>(record, pos);
+                break;
+            default:
+                // Cannot happen since the record is built by DeferredTextStream
+                return;
+        }
+        const std::string& text = number.str();
+        os.write(text.data(), text.size());
+        start = pos;
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DEFERREDTEXTSTREAM_H
+#define DEFERREDTEXTSTREAM_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+/*! \brief Output stream recording the numbers written to it instead of formatting them. Characters and
+ * strings are copied as they are while numbers are stored in binary form with the stream formatting
+ * state. format() then produces the text that would have been written in a regular stream.
+ * It is used to capture the entities of a game map in a savegame: the server thread only copies the
+ * values and the formatting is done by the SaveGameWriter thread.
+ */
+class DeferredTextStream : public std::ostream
+{
+    friend class DeferredNumPut;
+public:
+    DeferredTextStream();
+    ~DeferredTextStream();
+
+    //! \brief Returns what was recorded since the last call and clears the stream
+    std::string takeRecord();
+
+    //! \brief Writes the text corresponding to the given record. It does not depend on the stream
+    //! that recorded it and can be called from any thread
+    static void format(const std::string& record, std::ostream& os);
+
+private:
+    class RecordBuffer;
+    std::unique_ptr<RecordBuffer> mBuffer;
+};
+
+#endif // DEFERREDTEXTSTREAM_H
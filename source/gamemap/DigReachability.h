@@ -0,0 +1,120 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef DIGREACHABILITY_H
+#define DIGREACHABILITY_H
+
+#include <cstdint>
+#include <vector>
+
+/*! \brief Tiles that the workers of a seat can reach from a start tile, walking or digging their way
+ * like BaseAI::digWayToTile. The area is computed by a flood fill through the walkable and diggable tiles.
+ * A diggable tile is reachable if it is next to a reachable tile. Workers only dig the 4 adjacent tiles
+ * so diagonals are not followed.
+ * The memory is kept between computations so that computing the area again does not allocate.
+ */
+class DigReachability
+{
+public:
+    enum class Passability : uint8_t
+    {
+        blocked,
+        walkable,
+        diggable
+    };
+
+    DigReachability() :
+        mMapSizeX(0),
+        mMapSizeY(0)
+    {}
+
+    void clear()
+    {
+        mMapSizeX = 0;
+        mMapSizeY = 0;
+        mIsReachable.clear();
+    }
+
+    /*! \brief Computes the tiles reachable from (startX, startY). getPassability(x, y) is called at most
+     * once per tile and should return the Passability of the given tile. The start tile is considered
+     * as walkable
+     */
+    template <typename Func>
+    void compute(int mapSizeX, int mapSizeY, int startX, int startY, Func getPassability)
+    {
+        mMapSizeX = mapSizeX;
+        mMapSizeY = mapSizeY;
+        mIsReachable.assign(mMapSizeX * mMapSizeY, 0);
+        mToProcess.clear();
+        if((startX < 0) || (startX >= mMapSizeX) || (startY < 0) || (startY >= mMapSizeY))
+            return;
+
+        // Tiles are marked when they are added to mToProcess so that getPassability is only called once
+        // per tile. Reachable tiles are set to 1 and blocked ones to 2
+        mIsReachable[startX + startY * mMapSizeX] = 1;
+        mToProcess.push_back(startX + startY * mMapSizeX);
+        const int neighbors[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        while(!mToProcess.empty())
+        {
+            uint32_t index = mToProcess.back();
+            mToProcess.pop_back();
+            int x = static_cast<int>(index % mMapSizeX);
+            int y = static_cast<int>(index / mMapSizeX);
+            for(const int* neighbor : neighbors)
+            {
+                int xx = x + neighbor[0];
+                int yy = y + neighbor[1];
+                if((xx < 0) || (xx >= mMapSizeX) || (yy < 0) || (yy >= mMapSizeY))
+                    continue;
+
+                uint32_t neighIndex = static_cast<uint32_t>(xx + yy * mMapSizeX);
+                if(mIsReachable[neighIndex] != 0)
+                    continue;
+
+                if(getPassability(xx, yy) == Passability::blocked)
+                {
+                    mIsReachable[neighIndex] = 2;
+                    continue;
+                }
+
+                mIsReachable[neighIndex] = 1;
+                mToProcess.push_back(neighIndex);
+            }
+        }
+    }
+
+    //! \brief Returns true if the given tile was reached by the last computation
+    inline bool isReachable(int x, int y) const
+    {
+        if((x < 0) || (x >= mMapSizeX) || (y < 0) || (y >= mMapSizeY))
+            return false;
+
+        return mIsReachable[x + y * mMapSizeX] == 1;
+    }
+
+private:
+    int mMapSizeX;
+    int mMapSizeY;
+
+    //! \brief 0 for the tiles not reached, 1 for the reachable ones and 2 for the blocked ones next to them
+    std::vector<uint8_t> mIsReachable;
+
+    std::vector<uint32_t> mToProcess;
+};
+
+#endif // DIGREACHABILITY_H
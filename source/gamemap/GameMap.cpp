@@ -59,7 +59,9 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Profiler.h"
 #include "utils/ResourceManager.h"
+#include "utils/Symbol.h"
 
 #include <OgreTimer.h>
 
@@ -156,6 +158,7 @@ GameMap::GameMap(bool isServerGameMap) :
         mLocalPlayer(nullptr),
         mLocalPlayerNick(DEFAULT_NICK),
         mTurnNumber(-1),
+        mMatchSeed(0),
         mIsPaused(false),
         mTimePayDay(0),
         mFloodFillEnabled(false),
@@ -253,6 +256,12 @@ void GameMap::setAllFullnessAndNeighbors()
             setTileNeighbors(tile);
         }
     }
+
+    if(isServerGameMap())
+    {
+        mResourceIndex.build(*this);
+        mTrapTriggerIndex.build(*this);
+    }
 }
 
 void GameMap::clearAll()
@@ -271,6 +280,8 @@ void GameMap::clearAll()
     processDeletionQueues();
 
     clearTiles();
+    mResourceIndex.clear();
+    mTrapTriggerIndex.clear();
     processDeletionQueues();
 
     clearGoalsForAllSeats();
@@ -473,7 +484,7 @@ uint32_t GameMap::numWeapons()
     return mWeapons.size();
 }
 
-void GameMap::saveLevelEquipments(std::ofstream& levelFile)
+void GameMap::saveLevelEquipments(std::ostream& levelFile)
 {
     for (std::pair<const Weapon*,Weapon*>& def : mWeapons)
     {
@@ -889,7 +900,7 @@ unsigned int GameMap::numClassDescriptions()
     return mClassDescriptions.size();
 }
 
-void GameMap::saveLevelClassDescriptions(std::ofstream& levelFile)
+void GameMap::saveLevelClassDescriptions(std::ostream& levelFile)
 {
     for (std::pair<const CreatureDefinition*,CreatureDefinition*>& def : mClassDescriptions)
     {
@@ -1074,6 +1085,7 @@ Creature* GameMap::getCreature(const std::string& cName) const
 
 void GameMap::doTurn(double timeSinceLastTurn)
 {
+    OD_PROFILE_SCOPE("GameMap::doTurn");
     OD_LOG_INF("Computing turn " + Helper::toString(mTurnNumber) + ", timeSinceLastTurn=" + Helper::toString(timeSinceLastTurn));
     unsigned int numCallsTo_path_atStart = mNumCallsTo_path;
 
@@ -1093,11 +1105,13 @@ void GameMap::doTurn(double timeSinceLastTurn)
 
 void GameMap::doPlayerAITurn(double timeSinceLastTurn)
 {
+    OD_PROFILE_SCOPE("GameMap::doPlayerAITurn");
     mAiManager.doTurn(timeSinceLastTurn);
 }
 
 unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
 {
+    OD_PROFILE_SCOPE("GameMap::doMiscUpkeep");
     Tile *tempTile;
     Ogre::Timer stopwatch;
     unsigned long int timeTaken;
@@ -1231,9 +1245,16 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
     // Carry out the upkeep round of all the active objects in the game.
     // Here, we work on a copy of the active objects list because they might
     // try to remove themselves which would break the iterator
-    std::vector<GameEntity*> activeObjects = mActiveObjects;
-    for(GameEntity* ge : activeObjects)
-        ge->doUpkeep();
+    {
+        OD_PROFILE_SCOPE("GameMap::upkeepActiveObjects");
+        buildCreatureGrid();
+        std::vector<GameEntity*> activeObjects = mActiveObjects;
+        for(GameEntity* ge : activeObjects)
+            ge->doUpkeep();
+
+        // Creatures may be deleted after the upkeep. We don't want to keep them
+        mCreatureGrid.clear();
+    }
 
     // Carry out the upkeep round for each seat. This means recomputing how much gold is
     // available in their treasuries, how much mana they gain/lose during this turn, etc.
@@ -1260,16 +1281,9 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
         }
 
         // Update the count on how much gold is available in all of the treasuries claimed by the given seat.
-        seat->mGold = 0;
-        seat->mGoldMax = 0;
-        for (Room* room : getRooms())
-        {
-            if(room->getSeat() != seat)
-                continue;
-
-            seat->mGold += room->getTotalGoldStored();
-            seat->mGoldMax += room->getTotalGoldStorage();
-        }
+        // Only treasuries can store gold
+        seat->mGold = mBuildingRegistry.getTotalGoldStored(seat);
+        seat->mGoldMax = mBuildingRegistry.getTotalGoldStorage(seat);
     }
 
     // Determine the number of tiles claimed by each seat.
@@ -1297,6 +1311,25 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
     return timeTaken;
 }
 
+void GameMap::buildCreatureGrid()
+{
+    mCreatureGrid.beginBuild(getMapSizeX(), getMapSizeY());
+    for(Creature* creature : mCreatures)
+    {
+        if(!creature->getIsOnMap())
+            continue;
+        if(!creature->isAlive())
+            continue;
+
+        Tile* tile = creature->getPositionTile();
+        if(tile == nullptr)
+            continue;
+
+        mCreatureGrid.add(tile->getX(), tile->getY(), creature);
+    }
+    mCreatureGrid.endBuild();
+}
+
 void GameMap::updateAnimations(Ogre::Real timeSinceLastFrame)
 {
     if(mIsPaused)
@@ -1799,6 +1832,7 @@ void GameMap::clearRooms()
     }
 
     mRooms.clear();
+    mBuildingRegistry.clearRooms();
 }
 
 void GameMap::addRoom(Room *r)
@@ -1812,6 +1846,7 @@ void GameMap::addRoom(Room *r)
     }
 
     mRooms.push_back(r);
+    mBuildingRegistry.addRoom(r);
 }
 
 void GameMap::removeRoom(Room *r)
@@ -1827,64 +1862,32 @@ void GameMap::removeRoom(Room *r)
     }
 
     mRooms.erase(it);
+    mBuildingRegistry.removeRoom(r);
 }
 
-std::vector<Room*> GameMap::getRoomsByType(RoomType type) const
-{
-    std::vector<Room*> returnList;
-    for (Room* room : mRooms)
-    {
-        if (room->getType() == type  && room->getHP(nullptr) > 0.0)
-            returnList.push_back(room);
-    }
-
-    return returnList;
-}
-
-std::vector<Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* seat)
+BuildingView<Room> GameMap::getRoomsByType(RoomType type) const
 {
-    std::vector<Room*> returnList;
-    for (Room* room : mRooms)
-    {
-        if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
-            returnList.push_back(room);
-    }
-
-    return returnList;
+    return BuildingView<Room>(mBuildingRegistry.getRoomsByType(type));
 }
 
-std::vector<const Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
+BuildingView<Room> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
 {
-    std::vector<const Room*> returnList;
-    for (const Room* room : mRooms)
-    {
-        if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
-            returnList.push_back(room);
-    }
-
-    return returnList;
+    return BuildingView<Room>(mBuildingRegistry.getRoomsByTypeAndSeat(type, seat));
 }
 
 unsigned int GameMap::numRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
 {
-    int cptRooms = 0;
-    for (Room* room : mRooms)
-    {
-        if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
-            ++cptRooms;
-    }
-    return cptRooms;
+    return getRoomsByTypeAndSeat(type, seat).size();
 }
 
-std::vector<Room*> GameMap::getReachableRooms(const std::vector<Room*>& vec,
+std::vector<Room*> GameMap::getReachableRooms(const BuildingView<Room>& rooms,
                                               Tile* startTile,
                                               const Creature* creature)
 {
     std::vector<Room*> returnVector;
 
-    for (unsigned int i = 0; i < vec.size(); ++i)
+    for (Room* room : rooms)
     {
-        Room* room = vec[i];
         Tile* coveredTile = room->getCoveredTile(0);
         if (pathExists(creature, startTile, coveredTile))
         {
@@ -1899,28 +1902,16 @@ std::vector<Building*> GameMap::getReachableBuildingsPerSeat(Seat* seat,
        Tile *startTile, const Creature* creature)
 {
     std::vector<Building*> returnList;
-    for (Room* room : mRooms)
+    for (Room* room : BuildingView<Room>(mBuildingRegistry.getRoomsBySeat(seat)))
     {
-        if (room->getSeat() != seat)
-            continue;
-
-        if (room->getHP(nullptr) <= 0.0)
-            continue;
-
         if(!pathExists(creature, startTile, room->getCoveredTile(0)))
             continue;
 
         returnList.push_back(room);
     }
 
-    for (Trap* trap : mTraps)
+    for (Trap* trap : BuildingView<Trap>(mBuildingRegistry.getTrapsBySeat(seat)))
     {
-        if (trap->getSeat() != seat)
-            continue;
-
-        if (trap->getHP(nullptr) <= 0.0)
-            continue;
-
         if(!pathExists(creature, startTile, trap->getCoveredTile(0)))
             continue;
 
@@ -1932,24 +1923,27 @@ std::vector<Building*> GameMap::getReachableBuildingsPerSeat(Seat* seat,
 
 Room* GameMap::getRoomByName(const std::string& name)
 {
-    for (Room* room : mRooms)
-    {
-        if(room->getName().compare(name) == 0)
-            return room;
-    }
-
-    return nullptr;
+    return mBuildingRegistry.getRoomByName(name);
 }
 
 Trap* GameMap::getTrapByName(const std::string& name)
 {
-    for (Trap* trap : mTraps)
-    {
-        if(trap->getName().compare(name) == 0)
-            return trap;
-    }
+    return mBuildingRegistry.getTrapByName(name);
+}
 
-    return nullptr;
+void GameMap::notifyRoomSeatChanged(Room* room, Seat* oldSeat)
+{
+    mBuildingRegistry.roomSeatChanged(room, oldSeat);
+}
+
+void GameMap::notifyTreasuryGoldChanged(Room* room, int goldDelta)
+{
+    mBuildingRegistry.treasuryGoldChanged(room, goldDelta);
+}
+
+void GameMap::notifyTreasuryTilesChanged(Room* room)
+{
+    mBuildingRegistry.treasuryTilesChanged(room);
 }
 
 void GameMap::clearTraps()
@@ -1963,6 +1957,7 @@ void GameMap::clearTraps()
     }
 
     mTraps.clear();
+    mBuildingRegistry.clearTraps();
 }
 
 void GameMap::addTrap(Trap *trap)
@@ -1972,6 +1967,7 @@ void GameMap::addTrap(Trap *trap)
         + Helper::toString(nbTiles) + ", seatId=" + Helper::toString(trap->getSeat()->getId()));
 
     mTraps.push_back(trap);
+    mBuildingRegistry.addTrap(trap);
 }
 
 void GameMap::removeTrap(Trap *t)
@@ -1985,6 +1981,7 @@ void GameMap::removeTrap(Trap *t)
     }
 
     mTraps.erase(it);
+    mBuildingRegistry.removeTrap(t);
 }
 
 bool GameMap::withdrawFromTreasuries(int gold, Seat* seat)
@@ -1995,11 +1992,8 @@ bool GameMap::withdrawFromTreasuries(int gold, Seat* seat)
 
     // Loop over the treasuries withdrawing gold until the full amount has been withdrawn.
     int goldStillNeeded = gold;
-    for (Room* room : getRooms())
+    for (Room* room : mBuildingRegistry.getRoomsByTypeAndSeat(RoomType::treasury, seat))
     {
-        if(room->getSeat() != seat)
-            continue;
-
         int goldTaken = room->withdrawGold(goldStillNeeded);
         goldStillNeeded -= goldTaken;
         if(goldStillNeeded <= 0)
@@ -2203,6 +2197,7 @@ bool GameMap::doFloodFill(Seat* seat, Tile* tile)
 
 void GameMap::replaceFloodFill(Seat* seat, FloodFillType floodFillType, uint32_t colorOld, uint32_t colorNew)
 {
+    OD_PROFILE_SCOPE("GameMap::replaceFloodFill");
     for (int jj = 0; jj < getMapSizeY(); ++jj)
     {
         for (int ii = 0; ii < getMapSizeX(); ++ii)
@@ -2218,6 +2213,7 @@ void GameMap::replaceFloodFill(Seat* seat, FloodFillType floodFillType, uint32_t
 
 void GameMap::refreshFloodFill(Seat* seat, Tile* tile)
 {
+    OD_PROFILE_SCOPE("GameMap::refreshFloodFill");
     std::vector<uint32_t> colors(static_cast<uint32_t>(FloodFillType::nbValues), Tile::NO_FLOODFILL);
 
     // If the tile has opened a new place, we use the same floodfillcolor for all the areas
@@ -2276,6 +2272,7 @@ void GameMap::refreshFloodFill(Seat* seat, Tile* tile)
 
 void GameMap::enableFloodFill()
 {
+    OD_PROFILE_SCOPE("GameMap::enableFloodFill");
     // Carry out a flood fill of the whole level to make sure everything is good.
     // Start by setting the flood fill color for every tile on the map to -1.
     for (int jj = 0; jj < getMapSizeY(); ++jj)
@@ -2476,17 +2473,84 @@ void GameMap::processDeletionQueues()
 
 void GameMap::refreshBorderingTilesOf(const std::vector<Tile*>& affectedTiles)
 {
-    // Add the tiles which border the affected region to the affectedTiles vector since they may need to have their meshes changed.
+    // The tiles which border the affected region may need to have their meshes changed. tilesBorderedByRegion
+    // returns them with the affected tiles (each tile only once)
     std::vector<Tile*> borderTiles = tilesBorderedByRegion(affectedTiles);
 
-    borderTiles.insert(borderTiles.end(), affectedTiles.begin(), affectedTiles.end());
-
     // Loop over all the affected tiles and force them to examine their neighbors.  This allows
     // them to switch to a mesh with fewer polygons if some are hidden by the neighbors, etc.
     for (Tile* tile : borderTiles)
         tile->refreshMesh();
 }
 
+std::vector<Tile*> GameMap::editorChangeTiles(int x1, int y1, int x2, int y2, TileType tileType,
+    double tileFullness, Seat* seat)
+{
+    OD_PROFILE_SCOPE("GameMap::editorChangeTiles");
+
+    std::vector<Tile*> affectedTiles;
+    Tile* tileDigged = nullptr;
+    for(Tile* tile : rectangularRegion(x1, y1, x2, y2))
+    {
+        // We do not change tiles where there is something
+        if((tile->numEntitiesInTile() > 0) &&
+           ((tileFullness > 0.0) || (tileType == TileType::lava) || (tileType == TileType::water)))
+            continue;
+        if(tile->getCoveringBuilding() != nullptr)
+            continue;
+
+        if((tileDigged == nullptr) && (tile->getFullness() > 0.0) && (tileFullness == 0.0))
+            tileDigged = tile;
+
+        affectedTiles.push_back(tile);
+        tile->setEditorState(tileType, tileFullness, seat);
+    }
+
+    if(affectedTiles.empty())
+        return affectedTiles;
+
+    // The buildings next to the region may have their active spots changed. We refresh each of
+    // them once (the region cannot contain a building)
+    std::vector<Building*> buildings;
+    for(Tile* tile : tilesBorderedByRegion(affectedTiles))
+    {
+        Building* building = tile->getCoveringBuilding();
+        if(building == nullptr)
+            continue;
+        if(std::find(buildings.begin(), buildings.end(), building) != buildings.end())
+            continue;
+
+        buildings.push_back(building);
+        building->updateActiveSpots();
+        building->createMesh();
+    }
+
+    if(tileDigged != nullptr)
+        tileDigged->fireTileSound(TileSound::Digged);
+    if(seat != nullptr)
+    {
+        Tile* tile = affectedTiles.front();
+        tile->fireTileSound(tile->isFullTile() ? TileSound::ClaimWall : TileSound::ClaimGround);
+    }
+
+    OD_LOG_INF(serverStr() + Helper::toString(affectedTiles.size()) + " tiles changed in area from "
+        + Tile::displayAsString(affectedTiles.front()) + " to " + Tile::displayAsString(affectedTiles.back())
+        + " seat=" + Seat::displayAsString(seat));
+
+    return affectedTiles;
+}
+
+void GameMap::notifyTileChanged(Tile& tile)
+{
+    if(!isServerGameMap())
+        return;
+
+    notifyTileOpacityChanged(tile);
+    mResourceIndex.updateTile(tile);
+    mTrapTriggerIndex.notifyTileChanged(tile);
+    mAiManager.notifyTileChanged(tile);
+}
+
 std::vector<Tile*> GameMap::getBuildableTilesForPlayerInArea(int x1, int y1, int x2, int y2,
     Player* player)
 {
@@ -2935,8 +2999,7 @@ uint32_t GameMap::getMaxNumberCreatures(Seat* seat) const
 {
     uint32_t nbCreatures = ConfigManager::getSingleton().getMaxCreaturesPerSeatDefault();
 
-    std::vector<const Room*> portals = getRoomsByTypeAndSeat(RoomType::portal, seat);
-    for(const Room* room : portals)
+    for(const Room* room : getRoomsByTypeAndSeat(RoomType::portal, seat))
     {
         const RoomPortal* roomPortal = static_cast<const RoomPortal*>(room);
         nbCreatures += roomPortal->getNbCreatureMaxIncrease();
@@ -3058,6 +3121,10 @@ void GameMap::clientUpKeep(int64_t turnNumber)
 
 void GameMap::doorLock(Tile* tileDoor, Seat* seat, bool locked)
 {
+    // Locked doors block vision
+    notifyTileOpacityChanged(*tileDoor);
+    mTrapTriggerIndex.notifyTileChanged(*tileDoor);
+
     if(!locked)
     {
         // When a door is unlocked, we check all its neighboors to find a floodfill value for each possible
@@ -3160,6 +3227,7 @@ void GameMap::doorLock(Tile* tileDoor, Seat* seat, bool locked)
 void GameMap::changeFloodFillConnectedTiles(Tile* startTile, Seat* seat, const std::vector<uint32_t>& oldColors,
     const std::vector<uint32_t>& newColors, Tile* tileIgnored)
 {
+    OD_PROFILE_SCOPE("GameMap::changeFloodFillConnectedTiles");
     std::vector<Tile*> tiles;
     tiles.push_back(startTile);
     while(!tiles.empty())
@@ -3249,9 +3317,8 @@ void GameMap::notifySeatsConfigured()
     enableFloodFill();
 }
 
-void GameMap::fireGameSound(Tile& tile, const std::string& soundFamily)
+void GameMap::fireSpatialSound(Tile& tile, const Symbol& sound)
 {
-    std::string sound = "Game/" + soundFamily;
     for(Seat* seat : tile.getSeatsWithVision())
     {
         if(seat->getPlayer() == nullptr)
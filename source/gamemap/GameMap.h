@@ -18,6 +18,10 @@
 #ifndef GAMEMAP_H
 #define GAMEMAP_H
 
+#include "gamemap/BuildingRegistry.h"
+#include "gamemap/OccupancyGrid.h"
+#include "gamemap/ResourceIndex.h"
+#include "gamemap/TrapTriggerIndex.h"
 #include "gamemap/TileContainer.h"
 
 #include "ai/AIManager.h"
@@ -51,6 +55,7 @@ class CreatureMood;
 class RenderedMovableEntity;
 class Room;
 class Spell;
+class Symbol;
 class TileSet;
 class TileSetValue;
 
@@ -203,14 +208,14 @@ public:
     //! \brief Returns the total number of class descriptions stored in this game map.
     unsigned int numClassDescriptions();
 
-    void saveLevelClassDescriptions(std::ofstream& levelFile);
+    void saveLevelClassDescriptions(std::ostream& levelFile);
 
     void addWeapon(const Weapon* weapon);
     const Weapon* getWeapon(int index);
     const Weapon* getWeapon(const std::string& name);
     Weapon* getWeaponForTuning(const std::string& name);
     uint32_t numWeapons();
-    void saveLevelEquipments(std::ofstream& levelFile);
+    void saveLevelEquipments(std::ostream& levelFile);
 
     //! \brief Calls the deleteYourself() method on each of the rooms in the game map as well as clearing the vector of stored rooms.
     void clearRooms();
@@ -226,20 +231,29 @@ public:
     inline const std::vector<Room*>& getRooms() const
     { return mRooms; }
 
-    std::vector<Room*> getRoomsByType(RoomType type) const;
-    std::vector<Room*> getRoomsByTypeAndSeat(RoomType type,
-                        const Seat* seat);
-    std::vector<const Room*> getRoomsByTypeAndSeat(RoomType type,
-                          const Seat* seat) const;
+    //! \brief Returns the rooms with HP left matching the given criteria. The returned views do not
+    //! copy anything and should not be kept after a room is added or removed
+    BuildingView<Room> getRoomsByType(RoomType type) const;
+    BuildingView<Room> getRoomsByTypeAndSeat(RoomType type,
+                        const Seat* seat) const;
     unsigned int numRoomsByTypeAndSeat(RoomType type,
                       const Seat* seat) const;
-    std::vector<Room*> getReachableRooms(const std::vector<Room*> &vec,
+    std::vector<Room*> getReachableRooms(const BuildingView<Room>& rooms,
                        Tile *startTile, const Creature* creature);
     std::vector<Building*> getReachableBuildingsPerSeat(Seat* seat,
         Tile *startTile, const Creature* creature);
     Room* getRoomByName(const std::string& name);
     Trap* getTrapByName(const std::string& name);
 
+    //! \brief Has to be called when a room on the gamemap is claimed by another seat
+    //! so that the room is indexed with its new seat
+    void notifyRoomSeatChanged(Room* room, Seat* oldSeat);
+
+    //! \brief Have to be called when gold is deposited/withdrawn from a treasury or when its tiles change
+    //! so that the gold totals of its seat are kept up to date
+    void notifyTreasuryGoldChanged(Room* room, int goldDelta);
+    void notifyTreasuryTilesChanged(Room* room);
+
     //! \brief Traps related functions.
     void clearTraps();
     void addTrap(Trap *t);
@@ -255,6 +269,20 @@ public:
     inline const std::vector<MapLight*>& getMapLights() const
     { return mMapLights; }
 
+    //! \brief Index of the remaining gold and gem tiles. Used on server side only
+    inline const ResourceIndex& getResourceIndex() const
+    { return mResourceIndex; }
+
+    //! \brief Trigger zones of the armed trap tiles. Used on server side only
+    inline TrapTriggerIndex& getTrapTriggerIndex()
+    { return mTrapTriggerIndex; }
+
+    //! \brief Alive creatures standing on each tile. It is built before the active objects upkeep
+    //! and cleared after. Creatures added to the map during the upkeep are not in the grid. Used on
+    //! server side only
+    inline const OccupancyGrid<Creature*>& getCreatureGrid() const
+    { return mCreatureGrid; }
+
     //! \brief Deletes the data structure for all the players in the GameMap.
     void clearPlayers();
 
@@ -425,6 +453,14 @@ public:
     inline void setTurnNumber(int64_t turnNumber)
     { mTurnNumber = turnNumber; }
 
+    //! \brief Seed every random stream of the match is derived from. It is sent by the server
+    //! when the client is accepted so that it is kept in the replays
+    inline uint64_t getMatchSeed() const
+    { return mMatchSeed; }
+
+    inline void setMatchSeed(uint64_t matchSeed)
+    { mMatchSeed = matchSeed; }
+
     inline bool isServerGameMap() const
     { return mIsServerGameMap; }
 
@@ -437,6 +473,17 @@ public:
     //! \brief Refresh the tiles borders based a recent change on the map
     void refreshBorderingTilesOf(const std::vector<Tile*>& affectedTiles);
 
+    //! \brief Used on server side by the editor. Changes the tiles in the given rectangle to the given type,
+    //! fullness and seat (nullptr to unclaim). Tiles with a building or, if the new type is not walkable ground,
+    //! with entities are not changed. The buildings next to the region are refreshed once and only one sound
+    //! is played for the whole region. Returns the changed tiles
+    std::vector<Tile*> editorChangeTiles(int x1, int y1, int x2, int y2, TileType tileType,
+        double tileFullness, Seat* seat);
+
+    //! \brief Called on server side when the claim state, the fullness or the covering building
+    //! of the given tile changed. Used to keep incremental tile indexes up to date.
+    void notifyTileChanged(Tile& tile);
+
     std::vector<Tile*> getBuildableTilesForPlayerInArea(int x1, int y1, int x2, int y2,
         Player* player);
 
@@ -533,8 +580,9 @@ public:
     const std::vector<int>& getTeamIds() const
     { return mTeamIds; }
 
-    //! \brief Fires to the human seats in the given tile the game sound corresponding to the family
-    void fireGameSound(Tile& tile, const std::string& soundFamily);
+    //! \brief Fires to the human seats having vision on the given tile the given sound family (including
+    //! its directory, like "Game/ClaimTile")
+    void fireSpatialSound(Tile& tile, const Symbol& sound);
 
     //! \brief Convenience function to send a relative sound to the human seats in the given list
     void fireRelativeSound(const std::vector<Seat*>& seats, const std::string& soundFamily);
@@ -553,6 +601,8 @@ private:
     //! \brief The current server turn number.
     int64_t mTurnNumber;
 
+    uint64_t mMatchSeed;
+
     //! \brief Unique numbers to ensure names are unique
     int mUniqueNumberCreature;
     int mUniqueNumberMissileObj;
@@ -591,6 +641,8 @@ private:
     //! \brief Map Entities
     std::vector<Room*> mRooms;
     std::vector<Trap*> mTraps;
+    //! \brief Index of mRooms and mTraps by seat, type and name
+    BuildingRegistry mBuildingRegistry;
     std::vector<MapLight*> mMapLights;
 
     //! \brief Players and available game player slots (Seats)
@@ -627,6 +679,15 @@ private:
     //! AI Handling manager
     AIManager mAiManager;
 
+    //! \brief Remaining gold and gem tiles
+    ResourceIndex mResourceIndex;
+
+    //! \brief Trigger zones of the armed trap tiles
+    TrapTriggerIndex mTrapTriggerIndex;
+
+    //! \brief Creatures by tile during the active objects upkeep
+    OccupancyGrid<Creature*> mCreatureGrid;
+
     //! Map tileset
     const TileSet* mTileSet;
     std::string mTileSetName;
@@ -635,6 +696,9 @@ private:
     //! Updates active objects (creatures, rooms, ...), goals, count each team Workers, gold, mana and claimed tiles.
     unsigned long int doMiscUpkeep(double timeSinceLastTurn);
 
+    //! \brief Fills mCreatureGrid with the alive creatures on map
+    void buildCreatureGrid();
+
     //! \brief Resets the unique numbers
     void resetUniqueNumbers();
 };
@@ -0,0 +1,273 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/LevelInfoCache.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+template<> LevelInfoCache* Ogre::Singleton<LevelInfoCache>::msSingleton = nullptr;
+
+//! \brief Should be increased when the layout of the index file changes. Older index files are ignored
+static const std::string INDEX_HEADER = "ODLevelInfoCache 1";
+
+namespace
+{
+//! \brief The level infos can contain tabs and new lines. They are escaped so that each entry
+//! of the index fits on one line
+std::string escape(const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for(char c : text)
+    {
+        switch(c)
+        {
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '\t':
+                escaped += "\\t";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            default:
+                escaped += c;
+                break;
+        }
+    }
+    return escaped;
+}
+
+std::string unescape(const std::string& text)
+{
+    std::string unescaped;
+    unescaped.reserve(text.size());
+    for(size_t i = 0; i < text.size(); ++i)
+    {
+        if((text[i] != '\\') || (i + 1 >= text.size()))
+        {
+            unescaped += text[i];
+            continue;
+        }
+
+        ++i;
+        switch(text[i])
+        {
+            case 't':
+                unescaped += '\t';
+                break;
+            case 'n':
+                unescaped += '\n';
+                break;
+            default:
+                unescaped += text[i];
+                break;
+        }
+    }
+    return unescaped;
+}
+}
+
+LevelInfoCache::LevelInfoCache(const std::string& cacheFile) :
+    mCacheFile(cacheFile),
+    mIsDirty(false),
+    mIsStopping(false),
+    mRevision(0)
+{
+    loadIndex();
+    mThread = std::thread(&LevelInfoCache::indexerThread, this);
+}
+
+LevelInfoCache::~LevelInfoCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mCondition.notify_all();
+    mThread.join();
+
+    if(mIsDirty)
+        saveIndex();
+}
+
+LevelInfoCache::Status LevelInfoCache::getLevelInfo(const std::string& fileName, LevelInfo& levelInfo)
+{
+    int64_t modificationTime;
+    uint64_t fileSize;
+    if(!getFileStamp(fileName, modificationTime, fileSize))
+        return Status::invalid;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mEntries.find(fileName);
+    if(it != mEntries.end())
+    {
+        const Entry& entry = it->second;
+        levelInfo = entry.mLevelInfo;
+        if((entry.mModificationTime == modificationTime) && (entry.mFileSize == fileSize))
+            return entry.mIsValid ? Status::upToDate : Status::invalid;
+    }
+
+    if(mQueuedFiles.insert(fileName).second)
+    {
+        mQueue.push_back(fileName);
+        mCondition.notify_all();
+    }
+    return Status::pending;
+}
+
+void LevelInfoCache::indexerThread()
+{
+    while(true)
+    {
+        std::string fileName;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mIsStopping || !mQueue.empty(); });
+            if(mIsStopping)
+                return;
+
+            fileName = mQueue.front();
+            mQueue.pop_front();
+        }
+
+        // The stamp is read before the file so that a level modified while it is read will be
+        // read again the next time it is asked
+        Entry entry;
+        if(getFileStamp(fileName, entry.mModificationTime, entry.mFileSize))
+            entry.mIsValid = MapHandler::getMapInfo(fileName, entry.mLevelInfo);
+        else
+            entry.mIsValid = false;
+
+        bool isQueueEmpty;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mEntries[fileName] = entry;
+            mQueuedFiles.erase(fileName);
+            mIsDirty = true;
+            isQueueEmpty = mQueue.empty();
+        }
+        ++mRevision;
+
+        // We save the index once every queued level is read
+        if(isQueueEmpty)
+            saveIndex();
+    }
+}
+
+bool LevelInfoCache::getFileStamp(const std::string& fileName, int64_t& modificationTime, uint64_t& fileSize)
+{
+    boost::system::error_code ec;
+    modificationTime = static_cast<int64_t>(boost::filesystem::last_write_time(fileName, ec));
+    if(ec)
+        return false;
+
+    fileSize = static_cast<uint64_t>(boost::filesystem::file_size(fileName, ec));
+    return !ec;
+}
+
+void LevelInfoCache::loadIndex()
+{
+    std::ifstream file(mCacheFile.c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!file.good())
+        return;
+
+    std::string line;
+    if(!std::getline(file, line) || (line != INDEX_HEADER))
+    {
+        OD_LOG_INF("Ignoring level info cache with unknown format: " + mCacheFile);
+        return;
+    }
+
+    // Each line contains: path, modification time, size, valid flag, name and description
+    while(std::getline(file, line))
+    {
+        std::vector<std::string> elems = Helper::split(line, '\t');
+        // An empty description is not returned by split
+        if(elems.size() == 5)
+            elems.push_back(std::string());
+
+        if(elems.size() != 6)
+        {
+            OD_LOG_WRN("Invalid line in level info cache: " + line);
+            continue;
+        }
+
+        Entry entry;
+        std::stringstream ss(elems[1] + " " + elems[2]);
+        if(!(ss >> entry.mModificationTime >> entry.mFileSize))
+        {
+            OD_LOG_WRN("Invalid line in level info cache: " + line);
+            continue;
+        }
+        entry.mIsValid = (elems[3] == "1");
+        entry.mLevelInfo.mLevelName = unescape(elems[4]);
+        entry.mLevelInfo.mLevelDescription = unescape(elems[5]);
+
+        // Entries of deleted levels are dropped
+        std::string fileName = unescape(elems[0]);
+        boost::system::error_code ec;
+        if(!boost::filesystem::exists(fileName, ec))
+        {
+            mIsDirty = true;
+            continue;
+        }
+        mEntries[fileName] = entry;
+    }
+
+    OD_LOG_INF("Level info cache loaded: " + Helper::toString(static_cast<uint32_t>(mEntries.size())) + " levels");
+}
+
+void LevelInfoCache::saveIndex()
+{
+    std::stringstream ss;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ss << INDEX_HEADER << "\n";
+        for(const std::pair<const std::string, Entry>& p : mEntries)
+        {
+            const Entry& entry = p.second;
+            ss << escape(p.first) << "\t" << entry.mModificationTime << "\t" << entry.mFileSize << "\t"
+                << (entry.mIsValid ? "1" : "0") << "\t" << escape(entry.mLevelInfo.mLevelName) << "\t"
+                << escape(entry.mLevelInfo.mLevelDescription) << "\n";
+        }
+        mIsDirty = false;
+    }
+
+    // We write a temporary file to not lose the index if the game stops while writing
+    const std::string tmpFile = mCacheFile + ".tmp";
+    {
+        std::ofstream file(tmpFile.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if(!file.good() || !(file << ss.rdbuf()))
+        {
+            OD_LOG_WRN("Couldn't write level info cache: " + tmpFile);
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmpFile, mCacheFile, ec);
+    if(ec)
+        OD_LOG_WRN("Couldn't write level info cache: " + mCacheFile + ", error=" + ec.message());
+}
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEVELINFOCACHE_H
+#define LEVELINFOCACHE_H
+
+#include "gamemap/MapHandler.h"
+
+#include <OgreSingleton.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+/*! \brief Index of the level infos (name, description, seats) shown by the level browsers. Reading
+ * a level info means reading the beginning of the level file, which takes a while for big libraries of
+ * levels. The index is saved on disk and each entry is keyed by the level path, its modification
+ * time and its size so that only the levels that changed are read again.
+ * Levels that are not indexed (or that changed) are read by a background thread. The menus can then
+ * be displayed immediately and refreshed when getRevision changes.
+ */
+class LevelInfoCache : public Ogre::Singleton<LevelInfoCache>
+{
+public:
+    enum class Status
+    {
+        //! The level info is up to date
+        upToDate,
+        //! The level is being read. The level info is filled if an older version of the level was indexed
+        pending,
+        //! The file is not a valid level
+        invalid
+    };
+
+    //! \brief Loads the index from the given file. The file is created if it does not exist
+    LevelInfoCache(const std::string& cacheFile);
+
+    //! \brief Stops the background thread and saves the index
+    ~LevelInfoCache();
+
+    //! \brief Gets the info of the given level from the index. If the level is not indexed or if it
+    //! changed since it was indexed, it is queued to be read in the background
+    Status getLevelInfo(const std::string& fileName, LevelInfo& levelInfo);
+
+    //! \brief Incremented each time a level is indexed in the background. The menus showing pending
+    //! levels can compare it to know when they should refresh
+    uint32_t getRevision() const
+    { return mRevision; }
+
+private:
+    struct Entry
+    {
+        int64_t mModificationTime;
+        uint64_t mFileSize;
+        bool mIsValid;
+        LevelInfo mLevelInfo;
+    };
+
+    std::string mCacheFile;
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::map<std::string, Entry> mEntries;
+    //! \brief Files waiting to be read. mQueuedFiles is used to not queue the same file twice
+    std::deque<std::string> mQueue;
+    std::set<std::string> mQueuedFiles;
+    bool mIsDirty;
+    bool mIsStopping;
+    std::atomic<uint32_t> mRevision;
+    std::thread mThread;
+
+    void indexerThread();
+
+    //! \brief Reads the modification time and the size of the given file. Returns false if the
+    //! file cannot be accessed
+    static bool getFileStamp(const std::string& fileName, int64_t& modificationTime, uint64_t& fileSize);
+
+    //! \brief Loads the index. Should be called before the background thread is started
+    void loadIndex();
+
+    //! \brief Saves the index. The file is written without locking mMutex
+    void saveIndex();
+};
+
+#endif // LEVELINFOCACHE_H
@@ -18,6 +18,8 @@
 #include "gamemap/MapHandler.h"
 
 #include "creaturemood/CreatureMoodManager.h"
+#include "gamemap/BinaryLevel.h"
+#include "gamemap/DeferredTextStream.h"
 #include "gamemap/GameMap.h"
 #include "game/Seat.h"
 #include "goals/Goal.h"
@@ -44,42 +46,57 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Profiler.h"
 #include "utils/ResourceManager.h"
 
 #include "ODApplication.h"
 
+#include <chrono>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
-namespace MapHandler {
-
-bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
+namespace
 {
-    std::stringstream levelFile;
-    if(!Helper::readFileWithoutComments(fileName, levelFile))
-        return false;
+//! \brief Entity sections read with MapHandler::readGameEntity, in the order of the level file
+struct EntitySection
+{
+    const char* mItem;
+    GameEntityType mType;
+    BinaryLevel::Section mSection;
+};
 
+const EntitySection ENTITY_SECTIONS[] =
+{
+    { "Spells", GameEntityType::spell, BinaryLevel::Section::spells },
+    { "CraftedTraps", GameEntityType::craftedTrap, BinaryLevel::Section::craftedTraps },
+    { "SkillEntity", GameEntityType::skillEntity, BinaryLevel::Section::skillEntity },
+    { "GiftBoxEntity", GameEntityType::giftBoxEntity, BinaryLevel::Section::giftBoxEntity },
+    { "Missiles", GameEntityType::missileObject, BinaryLevel::Section::missiles },
+    { "TreasuryObject", GameEntityType::treasuryObject, BinaryLevel::Section::treasuryObject },
+    { "Chickens", GameEntityType::chickenEntity, BinaryLevel::Section::chickens }
+};
+
+//! \brief Reads the next word and checks it is the given tag
+bool readTag(std::istream& levelFile, const std::string& tag)
+{
     std::string nextParam;
-    // Read in the version number from the level file
     levelFile >> nextParam;
-    if (nextParam.compare(ODApplication::VERSIONSTRING) != 0)
+    if (nextParam != tag)
     {
-        OD_LOG_WRN("Attempting to load a file produced by a different version of OpenDungeons, filename="
-            + fileName + ", file version=" + nextParam + ", odversion=" + ODApplication::VERSION);
-        return false;
-    }
-
-    levelFile >> nextParam;
-    if (nextParam != "[Info]")
-    {
-        OD_LOG_WRN("Invalid info start format: " + nextParam);
+        OD_LOG_WRN("Invalid " + tag + " start format:" + nextParam);
         return false;
     }
+    return true;
+}
 
+// The functions below read the content of a section. The opening tag is expected to be already read.
+bool readInfo(std::istream& levelFile, GameMap& gameMap)
+{
     // By default, we use the default tileSet
     gameMap.setTileSetName("");
 
-    // Read in the seats from the level file
+    std::string nextParam;
     while (true)
     {
         if(!levelFile.good())
@@ -134,14 +151,12 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
         }
     }
 
-    levelFile >> nextParam;
-    if (nextParam != "[Seats]")
-    {
-        OD_LOG_WRN("Invalid seats start format=" + nextParam);
-        return false;
-    }
+    return true;
+}
 
-    // Read in the seats from the level file
+bool readSeats(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
     while (true)
     {
         if(!levelFile.good())
@@ -172,14 +187,12 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
         }
     }
 
-    // Read in the goals that are shared by all players, the first player to complete all these goals is the winner.
-    levelFile >> nextParam;
-    if (nextParam != "[Goals]")
-    {
-        OD_LOG_WRN("Invalid Goals start format=" + nextParam);
-        return false;
-    }
+    return true;
+}
 
+bool readGoals(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
     while(true)
     {
         if(!levelFile.good())
@@ -195,13 +208,11 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
             gameMap.addGoalForAllSeats(std::move(tempGoal));
     }
 
-    levelFile >> nextParam;
-    if (nextParam != "[Tiles]")
-    {
-        OD_LOG_WRN("Invalid tile start format:" + nextParam);
-        return false;
-    }
+    return true;
+}
 
+bool readTiles(std::istream& levelFile, GameMap& gameMap)
+{
     // Load the map size on next two lines
     int mapSizeX;
     int mapSizeY;
@@ -214,6 +225,7 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     // Read in the map tiles from disk
     gameMap.disableFloodFill();
 
+    std::string nextParam;
     while (true)
     {
         if(!levelFile.good())
@@ -240,15 +252,40 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     }
 
     gameMap.setAllFullnessAndNeighbors();
+    return true;
+}
 
-    // Read in the rooms
-    levelFile >> nextParam;
-    if (nextParam != "[Rooms]")
-    {
-        OD_LOG_WRN("Invalid Rooms start format:" + nextParam);
+//! \brief Reads the tiles from the packed arrays of a binary level. They have been validated when the level was opened
+bool readPackedTiles(const BinaryLevel::TileArrays& tiles, GameMap& gameMap)
+{
+    if (!gameMap.createNewMap(tiles.mMapSizeX, tiles.mMapSizeY))
         return false;
+
+    gameMap.disableFloodFill();
+
+    for(uint32_t i = 0; i < tiles.mNbTiles; ++i)
+    {
+        if(tiles.mType[i] >= static_cast<uint8_t>(TileType::countTileType))
+        {
+            OD_LOG_WRN("Invalid tile type=" + Helper::toString(static_cast<uint32_t>(tiles.mType[i])));
+            return false;
+        }
+
+        Tile* tile = new Tile(&gameMap, true);
+        Tile::loadFromValues(tile, tiles.mPosX[i], tiles.mPosY[i], static_cast<TileType>(tiles.mType[i]),
+            tiles.mFullness[i], tiles.mHasSeat[i] != 0, tiles.mSeatId[i]);
+        tile->computeTileVisual();
+
+        gameMap.addTile(tile);
     }
 
+    gameMap.setAllFullnessAndNeighbors();
+    return true;
+}
+
+bool readRooms(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
     while(true)
     {
         if(!levelFile.good())
@@ -287,14 +324,12 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
         }
     }
 
-    // Read in the traps
-    levelFile >> nextParam;
-    if (nextParam != "[Traps]")
-    {
-        OD_LOG_WRN("Invalid Traps start format:" + nextParam);
-        return false;
-    }
+    return true;
+}
 
+bool readTraps(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
     while(true)
     {
         if(!levelFile.good())
@@ -330,14 +365,12 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
         }
     }
 
-    // Read in the lights
-    levelFile >> nextParam;
-    if (nextParam != "[Lights]")
-    {
-        OD_LOG_WRN("Invalid Lights start format:" + nextParam);
-        return false;
-    }
+    return true;
+}
 
+bool readLights(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
     while(true)
     {
         if(!levelFile.good())
@@ -362,85 +395,85 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
         tempLight->addToGameMap();
     }
 
-    levelFile >> nextParam;
-    if (nextParam == "[CreatureDefinitions]")
+    return true;
+}
+
+bool readCreatureDefinitions(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
+    while(levelFile.good())
     {
-        while(levelFile.good())
-        {
-            levelFile >> nextParam;
-            if (nextParam == "[/CreatureDefinitions]")
-                break;
+        levelFile >> nextParam;
+        if (nextParam == "[/CreatureDefinitions]")
+            break;
 
-            if (nextParam == "[/Creature]")
-                continue;
+        if (nextParam == "[/Creature]")
+            continue;
 
-            // Seek the [Creature] tag
-            if (nextParam != "[Creature]")
-            {
-                OD_LOG_WRN("Invalid Creature start format:" + nextParam);
-                return false;
-            }
+        // Seek the [Creature] tag
+        if (nextParam != "[Creature]")
+        {
+            OD_LOG_WRN("Invalid Creature start format:" + nextParam);
+            return false;
+        }
 
+        levelFile >> nextParam;
+        if (nextParam == "Name")
+        {
             levelFile >> nextParam;
-            if (nextParam == "Name")
+            CreatureDefinition* def = gameMap.getClassDescriptionForTuning(nextParam);
+            if (def == nullptr)
             {
-                levelFile >> nextParam;
-                CreatureDefinition* def = gameMap.getClassDescriptionForTuning(nextParam);
-                if (def == nullptr)
-                {
-                    OD_LOG_WRN("Invalid Creature definition format for " + nextParam);
-                    return false;
-                }
-                if(!CreatureDefinition::update(def, levelFile, ConfigManager::getSingleton().getCreatureDefinitions()))
-                    return false;
+                OD_LOG_WRN("Invalid Creature definition format for " + nextParam);
+                return false;
             }
+            if(!CreatureDefinition::update(def, levelFile, ConfigManager::getSingleton().getCreatureDefinitions()))
+                return false;
         }
-
-        levelFile >> nextParam;
     }
 
-    if (nextParam == "[EquipmentDefinitions]")
+    return true;
+}
+
+bool readEquipmentDefinitions(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
+    while(levelFile.good())
     {
-        while(levelFile.good())
-        {
-            levelFile >> nextParam;
-            if (nextParam == "[/EquipmentDefinitions]")
-                break;
+        levelFile >> nextParam;
+        if (nextParam == "[/EquipmentDefinitions]")
+            break;
 
-            if (nextParam == "[/Equipment]")
-                continue;
+        if (nextParam == "[/Equipment]")
+            continue;
 
-            if (nextParam != "[Equipment]")
-            {
-                OD_LOG_WRN("Invalid Weapon start format:" + nextParam);
-                return false;
-            }
+        if (nextParam != "[Equipment]")
+        {
+            OD_LOG_WRN("Invalid Weapon start format:" + nextParam);
+            return false;
+        }
 
+        levelFile >> nextParam;
+        if (nextParam == "Name")
+        {
             levelFile >> nextParam;
-            if (nextParam == "Name")
+            Weapon* def = gameMap.getWeaponForTuning(nextParam);
+            if (def == nullptr)
             {
-                levelFile >> nextParam;
-                Weapon* def = gameMap.getWeaponForTuning(nextParam);
-                if (def == nullptr)
-                {
-                    OD_LOG_WRN("Invalid Weapon definition format for " + nextParam);
-                    return false;
-                }
-                if(!Weapon::update(def, levelFile))
-                    return false;
+                OD_LOG_WRN("Invalid Weapon definition format for " + nextParam);
+                return false;
             }
+            if(!Weapon::update(def, levelFile))
+                return false;
         }
-
-        levelFile >> nextParam;
     }
 
-    // Read in the actual creatures themselves
-    if (nextParam != "[Creatures]")
-    {
-        OD_LOG_WRN("Invalid Creatures start format:" + nextParam);
-        return false;
-    }
+    return true;
+}
 
+bool readCreatures(std::istream& levelFile, GameMap& gameMap)
+{
+    std::string nextParam;
     uint32_t nbCreatures = 0;
     while(true)
     {
@@ -468,52 +501,239 @@ bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
     }
     OD_LOG_INF("Loaded " + Helper::toString(nbCreatures) + " creatures in level");
 
-    if(!readGameEntity(gameMap, "Spells", GameEntityType::spell, levelFile))
+    return true;
+}
+
+//! \brief Writes the section containing the rendered entities of the given type
+void writeRenderedEntities(std::ostream& levelFile, GameMap& gameMap, const std::string& item,
+    const std::string& format, GameEntityType type)
+{
+    levelFile << "[" << item << "]\n";
+    levelFile << "# " << format << "\n";
+    for (RenderedMovableEntity* rendered : gameMap.getRenderedMovableEntities())
     {
-        OD_LOG_WRN("Invalid Spells section");
-        return false;
+        if(rendered->getObjectType() != type)
+            continue;
+
+        GameEntity::exportToStream(rendered, levelFile);
+        levelFile << std::endl;
     }
+    levelFile << "[/" << item << "]" << std::endl;
+}
+
+typedef bool (*SectionReader)(std::istream& levelFile, GameMap& gameMap);
+
+//! \brief Reads the given text section of a binary level
+bool readBinarySection(const BinaryLevel::MappedLevel& level, BinaryLevel::Section section,
+    SectionReader reader, GameMap& gameMap)
+{
+    uint64_t size;
+    const char* data = level.getSectionText(section, size);
+    BinaryLevel::MemoryInputStream levelFile(data, size);
+    if(!readTag(levelFile, BinaryLevel::getSectionTag(section)))
+        return false;
+
+    return reader(levelFile, gameMap);
+}
+
+bool readGameMapFromTextFile(const std::string& fileName, GameMap& gameMap)
+{
+    std::stringstream levelFile;
+    if(!Helper::readFileWithoutComments(fileName, levelFile))
+        return false;
 
-    if(!readGameEntity(gameMap, "CraftedTraps", GameEntityType::craftedTrap, levelFile))
+    std::string nextParam;
+    // Read in the version number from the level file
+    levelFile >> nextParam;
+    if (nextParam.compare(ODApplication::VERSIONSTRING) != 0)
     {
-        OD_LOG_WRN("Invalid CraftedTraps section");
+        OD_LOG_WRN("Attempting to load a file produced by a different version of OpenDungeons, filename="
+            + fileName + ", file version=" + nextParam + ", odversion=" + ODApplication::VERSION);
+        return false;
+    }
+
+    if(!readTag(levelFile, "[Info]") || !readInfo(levelFile, gameMap))
+        return false;
+
+    if(!readTag(levelFile, "[Seats]") || !readSeats(levelFile, gameMap))
         return false;
+
+    // Read in the goals that are shared by all players, the first player to complete all these goals is the winner.
+    if(!readTag(levelFile, "[Goals]") || !readGoals(levelFile, gameMap))
+        return false;
+
+    if(!readTag(levelFile, "[Tiles]") || !readTiles(levelFile, gameMap))
+        return false;
+
+    if(!readTag(levelFile, "[Rooms]") || !readRooms(levelFile, gameMap))
+        return false;
+
+    if(!readTag(levelFile, "[Traps]") || !readTraps(levelFile, gameMap))
+        return false;
+
+    if(!readTag(levelFile, "[Lights]") || !readLights(levelFile, gameMap))
+        return false;
+
+    levelFile >> nextParam;
+    if (nextParam == "[CreatureDefinitions]")
+    {
+        if(!readCreatureDefinitions(levelFile, gameMap))
+            return false;
+
+        levelFile >> nextParam;
     }
 
-    if(!readGameEntity(gameMap, "SkillEntity", GameEntityType::skillEntity, levelFile))
+    if (nextParam == "[EquipmentDefinitions]")
+    {
+        if(!readEquipmentDefinitions(levelFile, gameMap))
+            return false;
+
+        levelFile >> nextParam;
+    }
+
+    // Read in the actual creatures themselves
+    if (nextParam != "[Creatures]")
     {
-        OD_LOG_WRN("Invalid SkillEntity section");
+        OD_LOG_WRN("Invalid Creatures start format:" + nextParam);
         return false;
     }
 
-    if(!readGameEntity(gameMap, "GiftBoxEntity", GameEntityType::giftBoxEntity, levelFile))
+    if(!readCreatures(levelFile, gameMap))
+        return false;
+
+    for(const EntitySection& entitySection : ENTITY_SECTIONS)
     {
-        OD_LOG_WRN("Invalid GiftBoxEntity section");
+        if(!MapHandler::readGameEntity(gameMap, entitySection.mItem, entitySection.mType, levelFile))
+        {
+            OD_LOG_WRN("Invalid " + std::string(entitySection.mItem) + " section");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool readGameMapFromBinaryFile(const std::string& fileName, GameMap& gameMap)
+{
+    // The whole file is validated when opened
+    BinaryLevel::MappedLevel level;
+    if(!level.open(fileName))
+        return false;
+
+    std::string version = level.getVersion();
+    if (version.compare(ODApplication::VERSIONSTRING) != 0)
+    {
+        OD_LOG_WRN("Attempting to load a file produced by a different version of OpenDungeons, filename="
+            + fileName + ", file version=" + version + ", odversion=" + ODApplication::VERSION);
         return false;
     }
 
-    if(!readGameEntity(gameMap, "Missiles", GameEntityType::missileObject, levelFile))
+    if(!readBinarySection(level, BinaryLevel::Section::info, readInfo, gameMap))
+        return false;
+
+    if(!readBinarySection(level, BinaryLevel::Section::seats, readSeats, gameMap))
+        return false;
+
+    if(!readBinarySection(level, BinaryLevel::Section::goals, readGoals, gameMap))
+        return false;
+
+    if(!readPackedTiles(level.getTiles(), gameMap))
+        return false;
+
+    // Rooms are only needed on the server
+    if(gameMap.isServerGameMap() && !readBinarySection(level, BinaryLevel::Section::rooms, readRooms, gameMap))
+        return false;
+
+    if(!readBinarySection(level, BinaryLevel::Section::traps, readTraps, gameMap))
+        return false;
+
+    if(!readBinarySection(level, BinaryLevel::Section::lights, readLights, gameMap))
+        return false;
+
+    if(level.hasSection(BinaryLevel::Section::creatureDefinitions) &&
+       !readBinarySection(level, BinaryLevel::Section::creatureDefinitions, readCreatureDefinitions, gameMap))
     {
-        OD_LOG_WRN("Invalid Missiles section");
         return false;
     }
 
-    if(!readGameEntity(gameMap, "TreasuryObject", GameEntityType::treasuryObject, levelFile))
+    if(level.hasSection(BinaryLevel::Section::equipmentDefinitions) &&
+       !readBinarySection(level, BinaryLevel::Section::equipmentDefinitions, readEquipmentDefinitions, gameMap))
     {
-        OD_LOG_WRN("Invalid TreasuryObject section");
         return false;
     }
 
-    if(!readGameEntity(gameMap, "Chickens", GameEntityType::chickenEntity, levelFile))
+    if(!readBinarySection(level, BinaryLevel::Section::creatures, readCreatures, gameMap))
+        return false;
+
+    for(const EntitySection& entitySection : ENTITY_SECTIONS)
+    {
+        uint64_t size;
+        const char* data = level.getSectionText(entitySection.mSection, size);
+        BinaryLevel::MemoryInputStream levelFile(data, size);
+        if(!MapHandler::readGameEntity(gameMap, entitySection.mItem, entitySection.mType, levelFile))
+        {
+            OD_LOG_WRN("Invalid " + std::string(entitySection.mItem) + " section");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//! \brief Copies the beginning of the given text level without comments, up to the map size. The level
+//! info does not need the tiles nor the entities that come after
+bool readLevelHeaderWithoutComments(const std::string& fileName, std::stringstream& stream)
+{
+    std::ifstream levelFile(fileName.c_str(), std::ifstream::in);
+    if(!levelFile.good())
     {
-        OD_LOG_WRN("Invalid Chickens section");
+        OD_LOG_WRN("File not found=" + fileName);
         return false;
     }
 
+    // Once [Tiles] is found, we only need the 2 lines with the map size
+    int nbLinesLeft = -1;
+    std::string line;
+    while(std::getline(levelFile, line))
+    {
+        line = line.substr(0, line.find('#'));
+        stream << line << "\n";
+        Helper::trim(line);
+        if(line.empty())
+            continue;
+
+        if(nbLinesLeft > 0)
+            --nbLinesLeft;
+        else if(line == "[Tiles]")
+            nbLinesLeft = 2;
+
+        if(nbLinesLeft == 0)
+            break;
+    }
+
+    return true;
+}
+}
+
+namespace MapHandler {
+
+bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool isBinary = BinaryLevel::isBinaryLevel(fileName);
+    bool result = isBinary ? readGameMapFromBinaryFile(fileName, gameMap)
+        : readGameMapFromTextFile(fileName, gameMap);
+    if(!result)
+        return false;
+
+    int64_t durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    OD_LOG_INF("Loaded " + std::string(isBinary ? "binary" : "text") + " level " + fileName
+        + " in " + Helper::toString(durationMs) + " ms");
     return true;
 }
 
-bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::stringstream& levelFile)
+bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::istream& levelFile)
 {
     std::string nextParam;
     levelFile >> nextParam;
@@ -560,61 +780,74 @@ bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
         return false;
     }
 
-    // Write the identifier string and the version number
-    levelFile << ODApplication::VERSIONSTRING
-            << "  # The version of OpenDungeons which created this file (for compatibility reasons).\n";
+    writeGameMapToStream(levelFile, gameMap);
 
-    // Write map info
-    levelFile << "\n[Info]\n";
-    levelFile << "Name\t" << (gameMap.getLevelName().empty() ? "No name" : gameMap.getLevelName()) << std::endl;
-    if (!gameMap.getLevelDescription().empty())
-        levelFile << "Description\t" << gameMap.getLevelDescription() << std::endl;
-    if (!gameMap.getLevelMusicFile().empty())
-        levelFile << "Music\t" << gameMap.getLevelMusicFile() << std::endl;
-    if (!gameMap.getLevelFightMusicFile().empty())
-        levelFile << "FightMusic\t" << gameMap.getLevelFightMusicFile() << std::endl;
-    if(!gameMap.getTileSetName().empty())
-        levelFile << "TileSet\t" << gameMap.getTileSetName() << std::endl;
+    if (!levelFile.good()) {
+        OD_LOG_WRN("Unexpected failure on file: " + fileName);
+        return false;
+    }
 
-    levelFile << "[/Info]" << std::endl;
+    levelFile.close();
+    return true;
+}
 
-    // Write out the seats to the file
-    levelFile << "\n[Seats]\n";
-    const std::vector<Seat*> seats = gameMap.getSeats();
-    for (Seat* seat : seats)
-    {
-        // We don't save rogue seat
-        if(seat->isRogueSeat())
-            continue;
+bool writeGameMapToBinaryFile(const std::string& fileName, GameMap& gameMap)
+{
+    BinaryLevel::LevelSnapshot snapshot;
+    captureGameMap(gameMap, snapshot);
+    formatCapturedSections(snapshot);
+    std::string buffer;
+    BinaryLevel::serializeBinary(snapshot, buffer);
 
-        levelFile << "[Seat]" << std::endl;
-        seat->exportSeatToStream(levelFile);
-        levelFile << "[/Seat]" << std::endl;
+    std::ofstream levelFile(fileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!levelFile.good()) {
+        OD_LOG_WRN("Couldn't open file for writing: " + fileName);
+        return false;
     }
-    levelFile << "[/Seats]" << std::endl;
 
-    // Write out the goals shared by all players to the file.
-    levelFile << "\n[Goals]\n";
-    levelFile << "# " << Goal::getFormat() << "\n";
-    for (auto& goal : gameMap.getGoalsForAllSeats())
-    {
-        levelFile << *goal.get();
+    levelFile.write(buffer.data(), buffer.size());
+    if (!levelFile.good()) {
+        OD_LOG_WRN("Unexpected failure on file: " + fileName);
+        return false;
     }
-    levelFile << "[/Goals]" << std::endl;
 
-    levelFile << "\n[Tiles]\n";
-    int mapSizeX = gameMap.getMapSizeX();
-    int mapSizeY = gameMap.getMapSizeY();
-    levelFile << "# Map Size" << std::endl;
-    levelFile << mapSizeX << " # MapSizeX" << std::endl;
-    levelFile << mapSizeY << " # MapSizeY" << std::endl;
+    return true;
+}
 
-    // Write out the tiles to the file
-    levelFile << "# " << Tile::getFormat() << "\n";
+void writeGameMapToStream(std::ostream& levelFile, GameMap& gameMap)
+{
+    BinaryLevel::LevelSnapshot snapshot;
+    captureGameMap(gameMap, snapshot);
+    formatCapturedSections(snapshot);
+    BinaryLevel::writeText(snapshot, levelFile);
+}
+
+void captureGameMap(GameMap& gameMap, BinaryLevel::LevelSnapshot& snapshot)
+{
+    OD_PROFILE_SCOPE("MapHandler::captureGameMap");
+    snapshot.mVersion = ODApplication::VERSIONSTRING;
+    // The numbers written by the entities are only recorded. They will be formatted by formatCapturedSections
+    // (usually from the savegame writer thread)
+    snapshot.mSectionRecords.assign(static_cast<uint32_t>(BinaryLevel::Section::nbSections), std::string());
+    DeferredTextStream levelFile;
+    for(uint32_t index = static_cast<uint32_t>(BinaryLevel::Section::info);
+        index < static_cast<uint32_t>(BinaryLevel::Section::nbSections); ++index)
+    {
+        BinaryLevel::Section section = static_cast<BinaryLevel::Section>(index);
+        if(section == BinaryLevel::Section::tiles)
+            continue;
+
+        writeSection(levelFile, gameMap, section);
+        snapshot.mSectionRecords[index] = levelFile.takeRecord();
+    }
 
-    for(int ii = 0; ii < mapSizeX; ++ii)
+    snapshot.mMapSizeX = gameMap.getMapSizeX();
+    snapshot.mMapSizeY = gameMap.getMapSizeY();
+    snapshot.mTileFormat = Tile::getFormat();
+    snapshot.mTiles.clear();
+    for(int ii = 0; ii < snapshot.mMapSizeX; ++ii)
     {
-        for(int jj = 0; jj < mapSizeY; ++jj)
+        for(int jj = 0; jj < snapshot.mMapSizeY; ++jj)
         {
             Tile* tile = gameMap.getTile(ii, jj);
             if (tile == nullptr)
@@ -624,177 +857,236 @@ bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap)
             if (!tile->isClaimed() && tile->getType() == TileType::dirt && tile->getFullness() >= 100.0)
                 continue;
 
-            Tile::exportToStream(tile, levelFile);
-            levelFile << std::endl;
+            BinaryLevel::TileRecord record;
+            record.mPosX = tile->getX();
+            record.mPosY = tile->getY();
+            record.mType = static_cast<uint8_t>(tile->getType());
+            record.mFullness = tile->getFullness();
+            record.mHasSeat = (tile->getSeat() != nullptr);
+            record.mSeatId = record.mHasSeat ? tile->getSeat()->getId() : 0;
+            snapshot.mTiles.push_back(record);
         }
     }
-    levelFile << "[/Tiles]" << std::endl;
-
-    std::vector<Room*> rooms = gameMap.getRooms();
-    std::sort(rooms.begin(), rooms.end(), Room::sortForMapSave);
-
-    // Write out the rooms to the file
-    levelFile << "\n[Rooms]\n";
-    levelFile << "# " << Room::getRoomStreamFormat() << "\n";
-    for (Room* room : rooms)
-    {
-        // Rooms with 0 tiles are removed during upkeep. In editor mode, we don't use upkeep so there might be some rooms with
-        // 0 tiles (if a room has been erased for example). For this reason, we don't save rooms with 0 tiles
-        if((gameMap.isInEditorMode()) && (room->numCoveredTiles() <= 0))
-            continue;
-
-        levelFile << "[Room]" << std::endl;
-        GameEntity::exportToStream(room, levelFile);
-        levelFile << "[/Room]" << std::endl;
-    }
-    levelFile << "[/Rooms]" << std::endl;
-
-    std::vector<Trap*> traps = gameMap.getTraps();
-    std::sort(traps.begin(), traps.end(), Trap::sortForMapSave);
-
-    // Write out the traps to the file
-    levelFile << "\n[Traps]\n";
-    levelFile << "# " << Trap::getTrapStreamFormat() << "\n";
-    for (Trap* trap : traps)
-    {
-        // In editor mode, we don't use upkeep so there might be some traps with
-        // 0 tiles (if a trap has been erased for example). For this reason, we don't save traps with 0 tiles
-        if(gameMap.isInEditorMode() && trap->numCoveredTiles() <= 0)
-            continue;
-
-        levelFile << "[Trap]" << std::endl;
-        GameEntity::exportToStream(trap, levelFile);
-        levelFile << "[/Trap]" << std::endl;
-    }
-    levelFile << "[/Traps]" << std::endl;
-
-    // Write out the lights to the file.
-    levelFile << "\n[Lights]\n";
-    levelFile << "# " << MapLight::getMapLightStreamFormat() << "\n";
-    for (MapLight* mapLight : gameMap.getMapLights())
-    {
-        GameEntity::exportToStream(mapLight, levelFile);
-        levelFile << std::endl;
-    }
-    levelFile << "[/Lights]" << std::endl;
-
-    levelFile << std::endl << "[CreatureDefinitions]" << std::endl;
-    gameMap.saveLevelClassDescriptions(levelFile);
-    levelFile << "[/CreatureDefinitions]" << std::endl;
-
-    levelFile << std::endl << "[EquipmentDefinitions]" << std::endl;
-    gameMap.saveLevelEquipments(levelFile);
-    levelFile << "[/EquipmentDefinitions]" << std::endl;
-
-    // Write out the individual creatures to the file
-    levelFile << "\n[Creatures]\n";
-    levelFile << "# " << Creature::getCreatureStreamFormat() << "\n";
-    for (Creature* creature : gameMap.getCreatures())
-    {
-        GameEntity::exportToStream(creature, levelFile);
-        levelFile << std::endl;
-    }
-    levelFile << "[/Creatures]" << std::endl;
-
-    // Write out the RenderedMovableEntities that need to
-    const std::vector<RenderedMovableEntity*>& rendereds = gameMap.getRenderedMovableEntities();
-    levelFile << "\n[Spells]\n";
-    levelFile << "# " << Spell::getSpellStreamFormat() << "\n";
-    for (Spell* spell : gameMap.getSpells())
-    {
-        GameEntity::exportToStream(spell, levelFile);
-        levelFile << std::endl;
-    }
-    levelFile << "[/Spells]" << std::endl;
+}
 
-    levelFile << "\n[CraftedTraps]\n";
-    levelFile << "# " << CraftedTrap::getCraftedTrapStreamFormat() << "\n";
-    for (RenderedMovableEntity* rendered : rendereds)
+void formatCapturedSections(BinaryLevel::LevelSnapshot& snapshot)
+{
+    OD_PROFILE_SCOPE("MapHandler::formatCapturedSections");
+    for(uint32_t index = 0; index < snapshot.mSectionRecords.size(); ++index)
     {
-        if(rendered->getObjectType() != GameEntityType::craftedTrap)
+        const std::string& record = snapshot.mSectionRecords[index];
+        if(record.empty())
             continue;
 
-        GameEntity::exportToStream(rendered, levelFile);
-        levelFile << std::endl;
+        std::stringstream levelFile;
+        DeferredTextStream::format(record, levelFile);
+        snapshot.mSectionTexts[index] = levelFile.str();
     }
-    levelFile << "[/CraftedTraps]" << std::endl;
+    snapshot.mSectionRecords.clear();
+}
 
-    levelFile << "\n[SkillEntity]\n";
-    levelFile << "# " << SkillEntity::getSkillEntityStreamFormat() << "\n";
-    for (RenderedMovableEntity* rendered : rendereds)
+void writeSection(std::ostream& levelFile, GameMap& gameMap, BinaryLevel::Section section)
+{
+    switch(section)
     {
-        if(rendered->getObjectType() != GameEntityType::skillEntity)
-            continue;
+        case BinaryLevel::Section::info:
+        {
+            levelFile << "[Info]\n";
+            levelFile << "Name\t" << (gameMap.getLevelName().empty() ? "No name" : gameMap.getLevelName()) << std::endl;
+            if (!gameMap.getLevelDescription().empty())
+                levelFile << "Description\t" << gameMap.getLevelDescription() << std::endl;
+            if (!gameMap.getLevelMusicFile().empty())
+                levelFile << "Music\t" << gameMap.getLevelMusicFile() << std::endl;
+            if (!gameMap.getLevelFightMusicFile().empty())
+                levelFile << "FightMusic\t" << gameMap.getLevelFightMusicFile() << std::endl;
+            if(!gameMap.getTileSetName().empty())
+                levelFile << "TileSet\t" << gameMap.getTileSetName() << std::endl;
+
+            levelFile << "[/Info]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::seats:
+        {
+            levelFile << "[Seats]\n";
+            const std::vector<Seat*> seats = gameMap.getSeats();
+            for (Seat* seat : seats)
+            {
+                // We don't save rogue seat
+                if(seat->isRogueSeat())
+                    continue;
 
-        GameEntity::exportToStream(rendered, levelFile);
-        levelFile << std::endl;
-    }
-    levelFile << "[/SkillEntity]" << std::endl;
+                levelFile << "[Seat]" << std::endl;
+                seat->exportSeatToStream(levelFile);
+                levelFile << "[/Seat]" << std::endl;
+            }
+            levelFile << "[/Seats]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::goals:
+        {
+            // Write out the goals shared by all players to the file.
+            levelFile << "[Goals]\n";
+            levelFile << "# " << Goal::getFormat() << "\n";
+            for (auto& goal : gameMap.getGoalsForAllSeats())
+            {
+                levelFile << *goal.get();
+            }
+            levelFile << "[/Goals]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::rooms:
+        {
+            std::vector<Room*> rooms = gameMap.getRooms();
+            std::sort(rooms.begin(), rooms.end(), Room::sortForMapSave);
 
-    levelFile << "\n[GiftBoxEntity]\n";
-    levelFile << "# " << GiftBoxEntity::getGiftBoxEntityStreamFormat() << "\n";
-    for (RenderedMovableEntity* rendered : rendereds)
-    {
-        if(rendered->getObjectType() != GameEntityType::giftBoxEntity)
-            continue;
+            levelFile << "[Rooms]\n";
+            levelFile << "# " << Room::getRoomStreamFormat() << "\n";
+            for (Room* room : rooms)
+            {
+                // Rooms with 0 tiles are removed during upkeep. In editor mode, we don't use upkeep so there might be some rooms with
+                // 0 tiles (if a room has been erased for example). For this reason, we don't save rooms with 0 tiles
+                if((gameMap.isInEditorMode()) && (room->numCoveredTiles() <= 0))
+                    continue;
+
+                levelFile << "[Room]" << std::endl;
+                GameEntity::exportToStream(room, levelFile);
+                levelFile << "[/Room]" << std::endl;
+            }
+            levelFile << "[/Rooms]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::traps:
+        {
+            std::vector<Trap*> traps = gameMap.getTraps();
+            std::sort(traps.begin(), traps.end(), Trap::sortForMapSave);
 
-        GameEntity::exportToStream(rendered, levelFile);
-        levelFile << std::endl;
+            levelFile << "[Traps]\n";
+            levelFile << "# " << Trap::getTrapStreamFormat() << "\n";
+            for (Trap* trap : traps)
+            {
+                // In editor mode, we don't use upkeep so there might be some traps with
+                // 0 tiles (if a trap has been erased for example). For this reason, we don't save traps with 0 tiles
+                if(gameMap.isInEditorMode() && trap->numCoveredTiles() <= 0)
+                    continue;
+
+                levelFile << "[Trap]" << std::endl;
+                GameEntity::exportToStream(trap, levelFile);
+                levelFile << "[/Trap]" << std::endl;
+            }
+            levelFile << "[/Traps]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::lights:
+        {
+            levelFile << "[Lights]\n";
+            levelFile << "# " << MapLight::getMapLightStreamFormat() << "\n";
+            for (MapLight* mapLight : gameMap.getMapLights())
+            {
+                GameEntity::exportToStream(mapLight, levelFile);
+                levelFile << std::endl;
+            }
+            levelFile << "[/Lights]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::creatureDefinitions:
+        {
+            levelFile << "[CreatureDefinitions]" << std::endl;
+            gameMap.saveLevelClassDescriptions(levelFile);
+            levelFile << "[/CreatureDefinitions]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::equipmentDefinitions:
+        {
+            levelFile << "[EquipmentDefinitions]" << std::endl;
+            gameMap.saveLevelEquipments(levelFile);
+            levelFile << "[/EquipmentDefinitions]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::creatures:
+        {
+            levelFile << "[Creatures]\n";
+            levelFile << "# " << Creature::getCreatureStreamFormat() << "\n";
+            for (Creature* creature : gameMap.getCreatures())
+            {
+                GameEntity::exportToStream(creature, levelFile);
+                levelFile << std::endl;
+            }
+            levelFile << "[/Creatures]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::spells:
+        {
+            levelFile << "[Spells]\n";
+            levelFile << "# " << Spell::getSpellStreamFormat() << "\n";
+            for (Spell* spell : gameMap.getSpells())
+            {
+                GameEntity::exportToStream(spell, levelFile);
+                levelFile << std::endl;
+            }
+            levelFile << "[/Spells]" << std::endl;
+            break;
+        }
+        case BinaryLevel::Section::craftedTraps:
+            writeRenderedEntities(levelFile, gameMap, "CraftedTraps", CraftedTrap::getCraftedTrapStreamFormat(),
+                GameEntityType::craftedTrap);
+            break;
+        case BinaryLevel::Section::skillEntity:
+            writeRenderedEntities(levelFile, gameMap, "SkillEntity", SkillEntity::getSkillEntityStreamFormat(),
+                GameEntityType::skillEntity);
+            break;
+        case BinaryLevel::Section::giftBoxEntity:
+            writeRenderedEntities(levelFile, gameMap, "GiftBoxEntity", GiftBoxEntity::getGiftBoxEntityStreamFormat(),
+                GameEntityType::giftBoxEntity);
+            break;
+        case BinaryLevel::Section::missiles:
+            writeRenderedEntities(levelFile, gameMap, "Missiles", MissileObject::getMissileObjectStreamFormat(),
+                GameEntityType::missileObject);
+            break;
+        case BinaryLevel::Section::treasuryObject:
+            writeRenderedEntities(levelFile, gameMap, "TreasuryObject", TreasuryObject::getTreasuryObjectStreamFormat(),
+                GameEntityType::treasuryObject);
+            break;
+        case BinaryLevel::Section::chickens:
+            writeRenderedEntities(levelFile, gameMap, "Chickens", ChickenEntity::getChickenEntityStreamFormat(),
+                GameEntityType::chickenEntity);
+            break;
+        default:
+            OD_LOG_ERR("Unexpected section=" + Helper::toString(static_cast<uint32_t>(section)));
+            break;
     }
-    levelFile << "[/GiftBoxEntity]" << std::endl;
+}
 
-    levelFile << "\n[Missiles]\n";
-    levelFile << "# " << MissileObject::getMissileObjectStreamFormat() << "\n";
-    for (RenderedMovableEntity* rendered : rendereds)
+bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
+{
+    // Prepare an invalid level reference
+    std::stringstream levelFile;
+    if(!BinaryLevel::isBinaryLevel(fileName))
     {
-        if(rendered->getObjectType() != GameEntityType::missileObject)
-            continue;
+        if(!readLevelHeaderWithoutComments(fileName, levelFile))
+            return false;
 
-        GameEntity::exportToStream(rendered, levelFile);
-        levelFile << std::endl;
+        return getMapInfoFromStream(levelFile, levelInfo);
     }
-    levelFile << "[/Missiles]" << std::endl;
 
-    levelFile << "\n[TreasuryObject]\n";
-    levelFile << "# " << TreasuryObject::getTreasuryObjectStreamFormat() << "\n";
-    for (RenderedMovableEntity* rendered : rendereds)
-    {
-        if(rendered->getObjectType() != GameEntityType::treasuryObject)
-            continue;
-
-        GameEntity::exportToStream(rendered, levelFile);
-        levelFile << std::endl;
-    }
-    levelFile << "[/TreasuryObject]" << std::endl;
+    // For binary levels, we only need the first sections and the map size
+    BinaryLevel::MappedLevel level;
+    if(!level.open(fileName))
+        return false;
 
-    levelFile << "\n[Chickens]\n";
-    levelFile << "# " << ChickenEntity::getChickenEntityStreamFormat() << "\n";
-    for (RenderedMovableEntity* rendered : rendereds)
+    levelFile << level.getVersion() << "\n";
+    for(BinaryLevel::Section section : { BinaryLevel::Section::info, BinaryLevel::Section::seats, BinaryLevel::Section::goals })
     {
-        if(rendered->getObjectType() != GameEntityType::chickenEntity)
-            continue;
-
-        GameEntity::exportToStream(rendered, levelFile);
-        levelFile << std::endl;
+        uint64_t size;
+        const char* data = level.getSectionText(section, size);
+        levelFile.write(data, size);
     }
-    levelFile << "[/Chickens]" << std::endl;
+    levelFile << "[Tiles]\n" << level.getTiles().mMapSizeX << "\n" << level.getTiles().mMapSizeY << "\n";
 
-    if (!levelFile.good()) {
-        OD_LOG_WRN("Unexpected failure on file: " + fileName);
-        return false;
-    }
-
-    levelFile.close();
-    return true;
+    return getMapInfoFromStream(levelFile, levelInfo);
 }
 
-bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo)
+bool getMapInfoFromStream(std::istream& levelFile, LevelInfo& levelInfo)
 {
-    // Prepare an invalid level reference
-    std::stringstream levelFile;
-    if(!Helper::readFileWithoutComments(fileName, levelFile))
-        return false;
-
     std::string nextParam;
     // Read in the version number from the level file
     levelFile >> nextParam;
@@ -19,10 +19,19 @@
 #ifndef MAPHANDLER_H
 #define MAPHANDLER_H
 
+#include <cstdint>
+#include <istream>
+#include <ostream>
 #include <string>
 
 class GameMap;
 
+namespace BinaryLevel
+{
+    enum class Section : uint32_t;
+    struct LevelSnapshot;
+}
+
 enum class GameEntityType;
 
 //! \brief A small structure storing level info for the player
@@ -40,20 +49,43 @@ struct LevelInfo
 
 namespace MapHandler
 {
+    //! \brief Reads the given level. The file can either be a text level or a binary level (see BinaryLevel)
     bool readGameMapFromFile(const std::string& fileName, GameMap& gameMap);
 
     bool writeGameMapToFile(const std::string& fileName, GameMap& gameMap);
 
-    bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::stringstream& levelFile);
+    //! \brief Writes the given game map in the binary level format
+    bool writeGameMapToBinaryFile(const std::string& fileName, GameMap& gameMap);
+
+    //! \brief Writes the given game map in the text level format
+    void writeGameMapToStream(std::ostream& levelFile, GameMap& gameMap);
+
+    //! \brief Copies the state of the game map that is saved in levels. The snapshot does not reference
+    //! the game map so it can be written from another thread. Only the values are copied: the sections
+    //! have to be formatted with formatCapturedSections before the snapshot is written
+    void captureGameMap(GameMap& gameMap, BinaryLevel::LevelSnapshot& snapshot);
+
+    //! \brief Formats the sections recorded by captureGameMap in the snapshot texts. It does not use
+    //! the game map and can be called from any thread
+    void formatCapturedSections(BinaryLevel::LevelSnapshot& snapshot);
+
+    //! \brief Writes the given section in the text level format
+    void writeSection(std::ostream& levelFile, GameMap& gameMap, BinaryLevel::Section section);
+
+    bool readGameEntity(GameMap& gameMap, const std::string& item, GameEntityType type, std::istream& levelFile);
 
     bool loadEquipments(const std::string& fileName, GameMap& gameMap);
 
     bool loadCreatureDefinition(const std::string& fileName, GameMap& gameMap);
 
     //! \brief Reads the main user map info. Returns true if the level could be read and levelInfo is set to
-    //! corresponding info. Returns false otherwise.
+    //! corresponding info. Returns false otherwise. Only the beginning of the file is read.
+    //! The level browsers should use LevelInfoCache instead
     bool getMapInfo(const std::string& fileName, LevelInfo& levelInfo);
 
+    //! \brief Reads the level info from a comment-free text level
+    bool getMapInfoFromStream(std::istream& levelFile, LevelInfo& levelInfo);
+
     //! \brief Level extension constant, used in different GUI modes.
     static const std::string LEVEL_EXTENSION = ".level";
 };
@@ -39,73 +39,6 @@
 #include <CEGUI/Window.h>
 #include <CEGUI/WindowManager.h>
 
-class MiniMapDrawnFullTileStateListener : public TileStateListener
-{
-public:
-    MiniMapDrawnFullTileStateListener(MiniMapDrawnFull& minimap,
-            uint32_t minimapXMin, uint32_t minimapXMax, uint32_t minimapYMin,
-            uint32_t minimapYMax, uint32_t tileXMin, uint32_t tileXMax,
-            uint32_t tileYMin, uint32_t tileYMax) :
-        mMinimapXMin(minimapXMin),
-        mMinimapXMax(minimapXMax),
-        mMinimapYMin(minimapYMin),
-        mMinimapYMax(minimapYMax),
-        mTileXMin(tileXMin),
-        mTileXMax(tileXMax),
-        mTileYMin(tileYMin),
-        mTileYMax(tileYMax),
-        mMinimap(minimap)
-    {}
-
-    virtual ~MiniMapDrawnFullTileStateListener()
-    {}
-
-    void tileStateChanged(Tile& tile) override
-    {
-        fireTileStateChanged();
-    }
-
-    void fireTileStateChanged()
-    {
-        mMinimap.updateTileState(mMinimapXMin, mMinimapXMax, mMinimapYMin,
-            mMinimapYMax, mTileXMin, mTileXMax, mTileYMin, mTileYMax);
-    }
-
-    const uint32_t mMinimapXMin;
-    const uint32_t mMinimapXMax;
-    const uint32_t mMinimapYMin;
-    const uint32_t mMinimapYMax;
-    const uint32_t mTileXMin;
-    const uint32_t mTileXMax;
-    const uint32_t mTileYMin;
-    const uint32_t mTileYMax;
-
-private:
-    MiniMapDrawnFull& mMinimap;
-};
-
-//! \brief This enum represents the possible values a pixel can have in the minimap.
-//! If a pixel corresponds to several game tiles, the highest value will be used
-//! to display the pixel
-enum class MiniMapDrawnFullPixel
-{
-    dirtFull,
-    dirtGround,
-    rockFull,
-    rockGround,
-    claimedFull,
-    claimedGround,
-    lava,
-    water,
-    goldFull,
-    goldGround,
-    gemFull,
-    gemGround,
-    pickupEntity,
-    alliedCreature,
-    enemyCreature
-};
-
 namespace
 {
 MiniMapDrawnFullPixel getPixelValueFromTile(Seat& playerSeat, Tile& tile)
@@ -183,147 +116,6 @@ MiniMapDrawnFullPixel getPixelValueFromTile(Seat& playerSeat, Tile& tile)
 
     return value;
 }
-
-void colourFromPixelValue(MiniMapDrawnFullPixel pixelValue, Seat* seatIfClaimed,
-        Ogre::HardwarePixelBufferSharedPtr& pixelBuffer, Ogre::PixelBox pixelBox,
-        uint32_t minimapWidth, uint32_t minimapHeight, uint32_t minimapXMin,
-        uint32_t minimapXMax, uint32_t minimapYMin, uint32_t minimapYMax)
-{
-    Ogre::uint8 RR = 0x00;
-    Ogre::uint8 GG = 0x00;
-    Ogre::uint8 BB = 0x00;
-    switch(pixelValue)
-    {
-        case MiniMapDrawnFullPixel::enemyCreature:
-        {
-            RR = 0xFF;
-            GG = 0x00;
-            BB = 0x00;
-            break;
-        }
-        case MiniMapDrawnFullPixel::claimedFull:
-        {
-            if(seatIfClaimed == nullptr)
-            {
-                RR = 0x86;
-                GG = 0x50;
-                BB = 0x28;
-            }
-            else
-            {
-                const Ogre::ColourValue& color = seatIfClaimed->getColorValue();
-                RR = color.r * 255.0;
-                GG = color.g * 255.0;
-                BB = color.b * 255.0;
-            }
-            break;
-        }
-        case MiniMapDrawnFullPixel::claimedGround:
-        {
-            if(seatIfClaimed == nullptr)
-            {
-                RR = 0x5C;
-                GG = 0x37;
-                BB = 0x1B;
-            }
-            else
-            {
-                const Ogre::ColourValue& color = seatIfClaimed->getColorValue();
-                RR = color.r * 200.0;
-                GG = color.g * 200.0;
-                BB = color.b * 200.0;
-            }
-            break;
-        }
-        case MiniMapDrawnFullPixel::goldFull:
-        {
-            RR = 0xB5;
-            GG = 0xB3;
-            BB = 0x2F;
-            break;
-        }
-        case MiniMapDrawnFullPixel::goldGround:
-        {
-            RR = 0x3B;
-            GG = 0x1D;
-            BB = 0x08;
-            break;
-        }
-        case MiniMapDrawnFullPixel::water:
-        {
-            RR = 0x21;
-            GG = 0x36;
-            BB = 0x7A;
-            break;
-        }
-        case MiniMapDrawnFullPixel::lava:
-        {
-            RR = 0xB2;
-            GG = 0x22;
-            BB = 0x22;
-            break;
-        }
-        case MiniMapDrawnFullPixel::dirtGround:
-        {
-            RR = 0x3B;
-            GG = 0x1D;
-            BB = 0x08;
-            break;
-        }
-        case MiniMapDrawnFullPixel::dirtFull:
-        {
-            RR = 0x5B;
-            GG = 0x2D;
-            BB = 0x0C;
-            break;
-        }
-        case MiniMapDrawnFullPixel::rockGround:
-        {
-            RR = 0x30;
-            GG = 0x30;
-            BB = 0x30;
-            break;
-        }
-        case MiniMapDrawnFullPixel::rockFull:
-        {
-            RR = 0x41;
-            GG = 0x41;
-            BB = 0x41;
-            break;
-        }
-        default:
-        {
-            RR = 0x00;
-            GG = 0x00;
-            BB = 0xFF;
-            break;
-        }
-        case MiniMapDrawnFullPixel::pickupEntity:
-        {
-            RR = 0xDD;
-            GG = 0xDD;
-            BB = 0x12;
-            break;
-        }
-    }
-
-    auto output = pixelBuffer->lock(pixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
-
-    assert(minimapXMax <= output.getWidth());
-    assert(minimapYMax <= output.getHeight());
-
-    for(size_t xx = minimapXMin; xx < minimapXMax; ++xx)
-    {
-        for(size_t yy = minimapYMin; yy < minimapYMax; ++yy)
-        {
-            // TODO: This is probably a bit inefficient at the moment.
-            output.setColourAt(Ogre::ColourValue(RR/255.0, GG/255.0, BB/255.0), xx, output.getHeight() - yy, 0);
-
-        }
-    }
-
-    pixelBuffer->unlock();
-}
 }
 
 MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
@@ -334,75 +126,30 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
     mTopLeftCornerY(0),
     mWidth(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_width)),
     mHeight(static_cast<unsigned int>(mMiniMapWindow->getPixelSize().d_height)),
-    mPixelBox(mWidth, mHeight, 1, Ogre::PF_R8G8B8),
+    mRaster(mWidth, mHeight, mGameMap.getMapSizeX(), mGameMap.getMapSizeY()),
     mMiniMapOgreTexture(Ogre::TextureManager::getSingletonPtr()->createManual(
             "miniMapOgreTexture",
             Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
             Ogre::TEX_TYPE_2D,
-            mWidth, mHeight, 0, Ogre::PF_R8G8B8,
+            mWidth, mHeight, 0, Ogre::PF_X8R8G8B8,
             Ogre::TU_DYNAMIC_WRITE_ONLY)),
     mPixelBuffer(mMiniMapOgreTexture->getBuffer())
 {
-    uint32_t tileXMax = mGameMap.getMapSizeX();
-    uint32_t tileYMax = mGameMap.getMapSizeY();
-    uint32_t tileX = 0;
-    uint32_t tileY = 0;
-    uint32_t mapX = 0;
-    uint32_t mapY = 0;
-
-    Ogre::Real gainX = static_cast<Ogre::Real>(mWidth) / static_cast<Ogre::Real>(tileXMax);
-    Ogre::Real gainY = static_cast<Ogre::Real>(mHeight) / static_cast<Ogre::Real>(tileYMax);
-
-    while((mapX < mWidth) && (mapY < mHeight) && (tileX < tileXMax) && (tileY < tileYMax))
+    // We listen to every tile and initialize the minimap with their current state
+    for(int yy = 0; yy < mGameMap.getMapSizeY(); ++yy)
     {
-        uint32_t tileXNext = static_cast<uint32_t>(round(static_cast<Ogre::Real>(mapX + 1) / gainX));
-        uint32_t tileYNext = static_cast<uint32_t>(round(static_cast<Ogre::Real>(mapY + 1) / gainY));
-        uint32_t mapXNext = static_cast<uint32_t>(round(static_cast<Ogre::Real>(tileX + 1) * gainX));
-        uint32_t mapYNext = static_cast<uint32_t>(round(static_cast<Ogre::Real>(tileY + 1) * gainY));
-
-        if(tileXNext == tileX)
-            ++tileXNext;
-        if(tileYNext == tileY)
-            ++tileYNext;
-        if(mapXNext == mapX)
-            ++mapXNext;
-        if(mapYNext == mapY)
-            ++mapYNext;
-
-        MiniMapDrawnFullTileStateListener* listener = new MiniMapDrawnFullTileStateListener(*this,
-            mapX, mapXNext, mapY, mapYNext, tileX, tileXNext, tileY, tileYNext);
-
-        mTileStateListeners.push_back(listener);
-
-        mapX = mapXNext;
-        tileX = tileXNext;
-        if(tileXNext >= tileXMax)
+        for(int xx = 0; xx < mGameMap.getMapSizeX(); ++xx)
         {
-            mapY = mapYNext;
-            tileY = tileYNext;
-            mapX = 0;
-            tileX = 0;
-        }
-    }
-
-    // It  start, we fire the tile state changed event to make sure every pixel is
-    // correctly initialized. We also set the listeners on the tiles
-    for(MiniMapDrawnFullTileStateListener* listener : mTileStateListeners)
-    {
-        for(uint32_t xxx = listener->mTileXMin; xxx < listener->mTileXMax; ++xxx)
-        {
-            for(uint32_t yyy = listener->mTileYMin; yyy < listener->mTileYMax; ++yyy)
-            {
-                Tile* tile = mGameMap.getTile(xxx, yyy);
-                if(tile == nullptr)
-                    continue;
+            Tile* tile = mGameMap.getTile(xx, yy);
+            if(tile == nullptr)
+                continue;
 
-                tile->addTileStateListener(*listener);
-            }
+            tile->addTileStateListener(*this);
+            tileStateChanged(*tile);
         }
-
-        listener->fireTileStateChanged();
     }
+    mRaster.flush();
+    uploadDirtyRects();
 
     CEGUI::Texture& miniMapTextureGui = static_cast<CEGUI::OgreRenderer*>(CEGUI::System::getSingletonPtr()
                                             ->getRenderer())->createTexture("miniMapTextureGui", mMiniMapOgreTexture);
@@ -426,22 +173,17 @@ MiniMapDrawnFull::MiniMapDrawnFull(CEGUI::Window* miniMapWindow) :
 
 MiniMapDrawnFull::~MiniMapDrawnFull()
 {
-    for(MiniMapDrawnFullTileStateListener* listener : mTileStateListeners)
+    for(int yy = 0; yy < mGameMap.getMapSizeY(); ++yy)
     {
-        for(uint32_t xxx = listener->mTileXMin; xxx < listener->mTileXMax; ++xxx)
+        for(int xx = 0; xx < mGameMap.getMapSizeX(); ++xx)
         {
-            for(uint32_t yyy = listener->mTileYMin; yyy < listener->mTileYMax; ++yyy)
-            {
-                Tile* tile = mGameMap.getTile(xxx, yyy);
-                if(tile == nullptr)
-                    continue;
+            Tile* tile = mGameMap.getTile(xx, yy);
+            if(tile == nullptr)
+                continue;
 
-                tile->removeTileStateListener(*listener);
-            }
+            tile->removeTileStateListener(*this);
         }
-        delete listener;
     }
-    mTileStateListeners.clear();
 
     mMiniMapWindow->setProperty("Image", "");
     Ogre::TextureManager::getSingletonPtr()->remove("miniMapOgreTexture");
@@ -463,173 +205,41 @@ Ogre::Vector2 MiniMapDrawnFull::camera_2dPositionFromClick(int xx, int yy)
     return v;
 }
 
-void MiniMapDrawnFull::updateTileState(uint32_t minimapXMin, uint32_t minimapXMax,
-        uint32_t minimapYMin, uint32_t minimapYMax, uint32_t tileXMin,
-        uint32_t tileXMax, uint32_t tileYMin, uint32_t tileYMax)
+void MiniMapDrawnFull::tileStateChanged(Tile& tile)
 {
     Seat& localPlayerSeat = *(mGameMap.getLocalPlayer()->getSeat());
-    // We compute the tile representation
-    MiniMapDrawnFullPixel curValue = MiniMapDrawnFullPixel::dirtFull;
-    Seat* seatIfClaimed = nullptr;
-    for(uint32_t xxx = tileXMin; xxx < tileXMax; ++xxx)
+    MiniMapDrawnFullPixel value = getPixelValueFromTile(localPlayerSeat, tile);
+    const Ogre::ColourValue* seatColour = nullptr;
+    switch(value)
     {
-        for(uint32_t yyy = tileYMin; yyy < tileYMax; ++yyy)
-        {
-            Tile* tile = mGameMap.getTile(xxx, yyy);
-            if(tile == nullptr)
-                continue;
-
-            MiniMapDrawnFullPixel value = getPixelValueFromTile(localPlayerSeat,
-                *tile);
-            if(value > curValue)
-            {
-                curValue = value;
-                switch(value)
-                {
-                    case MiniMapDrawnFullPixel::claimedGround:
-                    case MiniMapDrawnFullPixel::claimedFull:
-                        seatIfClaimed = tile->getSeat();
-                        break;
-                    default:
-                        break;
-                }
-            }
-        }
+        case MiniMapDrawnFullPixel::claimedGround:
+        case MiniMapDrawnFullPixel::claimedFull:
+            if(tile.getSeat() != nullptr)
+                seatColour = &tile.getSeat()->getColorValue();
+            break;
+        default:
+            break;
     }
 
-    // We paint corresponding pixels
-    colourFromPixelValue(curValue, seatIfClaimed, mPixelBuffer, mPixelBox,
-        mWidth, mHeight, minimapXMin, minimapXMax, minimapYMin, minimapYMax);
+    // The pixels will be painted during the next update
+    mRaster.setTile(static_cast<uint32_t>(tile.getX()), static_cast<uint32_t>(tile.getY()),
+        value, MiniMapRaster::getPixelColour(value, seatColour));
 }
 
-bool MiniMapDrawnFull::crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax)
+void MiniMapDrawnFull::uploadDirtyRects()
 {
-    if((p1.x < static_cast<Ogre::Real>(xMin)) &&
-       (p2.x < static_cast<Ogre::Real>(xMin)))
-    {
-        return false;
-    }
-    if((p1.x > static_cast<Ogre::Real>(xMax)) &&
-       (p2.x > static_cast<Ogre::Real>(xMax)))
-    {
-        return false;
-    }
-
-    if((p1.y < static_cast<Ogre::Real>(yMin)) &&
-       (p2.y < static_cast<Ogre::Real>(yMin)))
-    {
-        return false;
-    }
-    if((p1.y > static_cast<Ogre::Real>(yMax)) &&
-       (p2.y > static_cast<Ogre::Real>(yMax)))
-    {
-        return false;
-    }
-
-    Ogre::Real diffYPoints = p2.y - p1.y;
-    Ogre::Real diffXPoints = p2.x - p1.x;
-    Ogre::Real diffYMin = p2.y - static_cast<Ogre::Real>(yMin);
-    Ogre::Real diffXMin = p2.x - static_cast<Ogre::Real>(xMin);
-    Ogre::Real diffYMax = p2.y - static_cast<Ogre::Real>(yMax);
-    Ogre::Real diffXMax = p2.x - static_cast<Ogre::Real>(xMax);
-
-    // Magic number to change the size of the line
-    static const Ogre::Real DIFF_MIN = 5;
-    if(
-       (
-        (diffYMin * diffXPoints - diffYPoints * diffXMin - DIFF_MIN< 0) &&
-        (diffYMax * diffXPoints - diffYPoints * diffXMax + DIFF_MIN >= 0)
-       ) ||
-       (
-        (diffYMax * diffXPoints - diffYPoints * diffXMax - DIFF_MIN< 0) &&
-        (diffYMin * diffXPoints - diffYPoints * diffXMin + DIFF_MIN >= 0)
-       )
-      )
+    Ogre::PixelBox image(mRaster.getWidth(), mRaster.getHeight(), 1, Ogre::PF_X8R8G8B8,
+        const_cast<uint32_t*>(mRaster.getPixels().data()));
+    for(const MiniMapRect& rect : mRaster.getDirtyRects())
     {
-        return true;
+        Ogre::Box box(rect.mXMin, rect.mYMin, rect.mXMax, rect.mYMax);
+        mPixelBuffer->blitFromMemory(image.getSubVolume(box), box);
     }
-
-    return false;
 }
 
 void MiniMapDrawnFull::update(Ogre::Real timeSinceLastFrame, const std::vector<Ogre::Vector3>& cornerTiles)
 {
-    const Ogre::Vector3& topRight = cornerTiles[0];
-    const Ogre::Vector3& topLeft = cornerTiles[1];
-    const Ogre::Vector3& bottomLeft = cornerTiles[2];
-    const Ogre::Vector3& bottomRight = cornerTiles[3];
-
-    bool isSame = (mLastCornerTiles.size() == cornerTiles.size());
-    static const Ogre::Real squareDiffMin = 0.5;
-    for(uint32_t iii = 0; isSame && iii < mLastCornerTiles.size(); ++iii)
-    {
-        Ogre::Real val = (mLastCornerTiles[iii] - cornerTiles[iii]).squaredLength();
-        isSame &= (val <= squareDiffMin);
-    }
-
-    if(isSame)
-        return;
-
-    // We save corner tiles
-    mLastCornerTiles = cornerTiles;
-
-    // We refresh the old rectangle
-    for(MiniMapDrawnFullTileStateListener* listener : mVisibleRectangle)
-    {
-        listener->fireTileStateChanged();
-    }
-    mVisibleRectangle.clear();
-
-    // And we paint the new visible rectangle
-    auto output = mPixelBuffer->lock(mPixelBox, Ogre::HardwareBuffer::HBL_NORMAL);
-
-    // we look for the tiles at the border of vision to paint them black
-    for(MiniMapDrawnFullTileStateListener* listener : mTileStateListeners)
-    {
-        bool isInBorder = false;
-
-        // We check if the listener tiles are on the top line
-        if(!isInBorder &&
-            crossSegment(topRight, topLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(topLeft, bottomLeft, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(bottomLeft, bottomRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder &&
-            crossSegment(bottomRight, topRight, listener->mTileXMin, listener->mTileXMax,
-                listener->mTileYMin, listener->mTileYMax))
-        {
-            isInBorder = true;
-        }
-
-        if(!isInBorder)
-            continue;
-
-        mVisibleRectangle.push_back(listener);
-        for(uint32_t xxx = listener->mMinimapXMin; xxx < listener->mMinimapXMax; ++xxx)
-        {
-            for(uint32_t yyy = listener->mMinimapYMin; yyy < listener->mMinimapYMax; ++yyy)
-            {
-                output.setColourAt(Ogre::ColourValue(0.0f, 0.0f, 0.0f), xxx,
-                                   output.getHeight() - yyy, 0);
-            }
-        }
-    }
-    mPixelBuffer->unlock();
+    mRaster.setOutline(cornerTiles);
+    if(mRaster.flush())
+        uploadDirtyRects();
 }
@@ -18,10 +18,11 @@
 #ifndef MINIMAPDRAWNFULL_H_
 #define MINIMAPDRAWNFULL_H_
 
+#include "entities/Tile.h"
 #include "gamemap/MiniMap.h"
+#include "gamemap/MiniMapRaster.h"
 
 #include <OgreHardwarePixelBuffer.h>
-#include <OgrePixelFormat.h>
 #include <OgreTexture.h>
 #include <OgreVector2.h>
 #include <OgreVector3.h>
@@ -35,11 +36,11 @@ namespace CEGUI
 
 class CameraManager;
 class GameMap;
-class MiniMapDrawnFullTileStateListener;
-class Seat;
-class Tile;
 
-class MiniMapDrawnFull : public MiniMap
+/*! \brief Minimap drawing every tile. The image is built on the CPU by a MiniMapRaster updated when
+ * a tile state changes. Each frame, only the parts of the image that changed are uploaded to the texture.
+ */
+class MiniMapDrawnFull : public MiniMap, public TileStateListener
 {
 public:
     MiniMapDrawnFull(CEGUI::Window* miniMapWindow);
@@ -53,29 +54,19 @@ public:
 
     void update(Ogre::Real timeSinceLastFrame, const std::vector<Ogre::Vector3>& cornerTiles) override;
 
-    void updateTileState(uint32_t minimapXMin, uint32_t xMinimapMax,
-        uint32_t minimapYMin, uint32_t minimapYMax, uint32_t tileXMin,
-        uint32_t tileXMax, uint32_t tileYMin, uint32_t tileYMax);
+    void tileStateChanged(Tile& tile) override;
 
     Ogre::Vector2 camera_2dPositionFromClick(int xx, int yy) override;
 
 private:
-    //! \brief Returns true is the segment between p1 and p2 (using x and y only)
-    //! crosses the values within xMin, xMax, yMin and yMax
-    bool crossSegment(const Ogre::Vector3& p1, const Ogre::Vector3& p2,
-        uint32_t xMin, uint32_t xMax, uint32_t yMin, uint32_t yMax);
+    //! \brief Uploads the rectangles painted by the last MiniMapRaster::flush to the texture
+    void uploadDirtyRects();
 
     CEGUI::Window* mMiniMapWindow;
 
     GameMap& mGameMap;
     CameraManager& mCameraManager;
 
-    std::vector<MiniMapDrawnFullTileStateListener*> mTileStateListeners;
-
-    std::vector<MiniMapDrawnFullTileStateListener*> mVisibleRectangle;
-
-    std::vector<Ogre::Vector3> mLastCornerTiles;
-
     int mTopLeftCornerX;
     int mTopLeftCornerY;
     Ogre::uint mWidth;
@@ -83,7 +74,8 @@ private:
 
     Ogre::Vector2 mCamera_2dPosition;
 
-    Ogre::PixelBox mPixelBox;
+    MiniMapRaster mRaster;
+
     Ogre::TexturePtr mMiniMapOgreTexture;
     Ogre::HardwarePixelBufferSharedPtr mPixelBuffer;
 };
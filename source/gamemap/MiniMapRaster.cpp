@@ -0,0 +1,342 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/MiniMapRaster.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+//! \brief If there are more dirty rectangles than this after merging, we upload their bounding box
+const uint32_t MAX_DIRTY_RECTS = 32;
+
+uint32_t packColour(uint32_t rr, uint32_t gg, uint32_t bb)
+{
+    return ((rr & 0xFF) << 16) | ((gg & 0xFF) << 8) | (bb & 0xFF);
+}
+
+uint32_t packSeatColour(const Ogre::ColourValue& colour, double factor)
+{
+    return packColour(static_cast<uint32_t>(colour.r * factor),
+        static_cast<uint32_t>(colour.g * factor),
+        static_cast<uint32_t>(colour.b * factor));
+}
+
+//! \brief Clips the segment p1-p2 to the given box (Liang-Barsky). Returns false if the segment
+//! is outside. We clip before walking the segment because the camera corners can be very far
+//! from the map when looking at the horizon
+bool clipSegment(double& x1, double& y1, double& x2, double& y2, double min, double maxX, double maxY)
+{
+    double t0 = 0.0;
+    double t1 = 1.0;
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    const double p[4] = {-dx, dx, -dy, dy};
+    const double q[4] = {x1 - min, maxX - x1, y1 - min, maxY - y1};
+    for(int i = 0; i < 4; ++i)
+    {
+        if(p[i] == 0.0)
+        {
+            if(q[i] < 0.0)
+                return false;
+            continue;
+        }
+
+        double t = q[i] / p[i];
+        if(p[i] < 0.0)
+            t0 = std::max(t0, t);
+        else
+            t1 = std::min(t1, t);
+
+        if(t0 > t1)
+            return false;
+    }
+
+    x2 = x1 + t1 * dx;
+    y2 = y1 + t1 * dy;
+    x1 = x1 + t0 * dx;
+    y1 = y1 + t0 * dy;
+    return true;
+}
+}
+
+const uint32_t MiniMapRaster::OUTLINE_COLOUR = 0x000000;
+
+MiniMapRaster::MiniMapRaster(uint32_t width, uint32_t height, uint32_t mapSizeX, uint32_t mapSizeY) :
+    mWidth(width),
+    mHeight(height),
+    mMapSizeX(mapSizeX),
+    mMapSizeY(mapSizeY),
+    mTileValues(mapSizeX * mapSizeY, MiniMapDrawnFullPixel::dirtFull),
+    mTileColours(mapSizeX * mapSizeY, getPixelColour(MiniMapDrawnFullPixel::dirtFull, nullptr)),
+    mPixels(width * height, 0)
+{
+    uint32_t tileX = 0;
+    uint32_t tileY = 0;
+    uint32_t mapX = 0;
+    uint32_t mapY = 0;
+
+    float gainX = static_cast<float>(mWidth) / static_cast<float>(mMapSizeX);
+    float gainY = static_cast<float>(mHeight) / static_cast<float>(mMapSizeY);
+
+    while((mapX < mWidth) && (mapY < mHeight) && (tileX < mMapSizeX) && (tileY < mMapSizeY))
+    {
+        uint32_t tileXNext = static_cast<uint32_t>(std::round(static_cast<float>(mapX + 1) / gainX));
+        uint32_t tileYNext = static_cast<uint32_t>(std::round(static_cast<float>(mapY + 1) / gainY));
+        uint32_t mapXNext = static_cast<uint32_t>(std::round(static_cast<float>(tileX + 1) * gainX));
+        uint32_t mapYNext = static_cast<uint32_t>(std::round(static_cast<float>(tileY + 1) * gainY));
+
+        if(tileXNext == tileX)
+            ++tileXNext;
+        if(tileYNext == tileY)
+            ++tileYNext;
+        if(mapXNext == mapX)
+            ++mapXNext;
+        if(mapYNext == mapY)
+            ++mapYNext;
+
+        // Rounding can go past the map or the image on the last cell
+        Cell cell = {mapX, std::min(mapXNext, mWidth), mapY, std::min(mapYNext, mHeight),
+            tileX, std::min(tileXNext, mMapSizeX), tileY, std::min(tileYNext, mMapSizeY)};
+        mCells.push_back(cell);
+
+        mapX = mapXNext;
+        tileX = tileXNext;
+        if(tileXNext >= mMapSizeX)
+        {
+            mapY = mapYNext;
+            tileY = tileYNext;
+            mapX = 0;
+            tileX = 0;
+        }
+    }
+
+    uint32_t nbCells = static_cast<uint32_t>(mCells.size());
+    mTileCells.assign(mMapSizeX * mMapSizeY, nbCells);
+    for(uint32_t i = 0; i < nbCells; ++i)
+    {
+        const Cell& cell = mCells[i];
+        for(uint32_t yy = cell.mTileYMin; yy < cell.mTileYMax; ++yy)
+        {
+            for(uint32_t xx = cell.mTileXMin; xx < cell.mTileXMax; ++xx)
+                mTileCells[xx + yy * mMapSizeX] = i;
+        }
+    }
+
+    // Every cell is painted at the first flush
+    mIsCellDirty.assign(nbCells, 0);
+    mIsCellOutline.assign(nbCells, 0);
+    for(uint32_t i = 0; i < nbCells; ++i)
+        markCellDirty(i);
+}
+
+void MiniMapRaster::setTile(uint32_t tileX, uint32_t tileY, MiniMapDrawnFullPixel value, uint32_t colour)
+{
+    if((tileX >= mMapSizeX) || (tileY >= mMapSizeY))
+        return;
+
+    uint32_t index = tileX + tileY * mMapSizeX;
+    if((mTileValues[index] == value) && (mTileColours[index] == colour))
+        return;
+
+    mTileValues[index] = value;
+    mTileColours[index] = colour;
+    if(mTileCells[index] < mCells.size())
+        markCellDirty(mTileCells[index]);
+}
+
+void MiniMapRaster::setOutline(const std::vector<Ogre::Vector3>& cornerTiles)
+{
+    // We look for the cells containing the points of the outline by walking each side with steps
+    // smaller than a tile
+    std::vector<uint32_t> outlineCells;
+    for(uint32_t i = 0; i < cornerTiles.size(); ++i)
+    {
+        const Ogre::Vector3& p1 = cornerTiles[i];
+        const Ogre::Vector3& p2 = cornerTiles[(i + 1) % cornerTiles.size()];
+        double x1 = p1.x;
+        double y1 = p1.y;
+        double x2 = p2.x;
+        double y2 = p2.y;
+        // Tile x covers [x - 0.5, x + 0.5]
+        if(!clipSegment(x1, y1, x2, y2, -0.5, mMapSizeX - 0.5, mMapSizeY - 0.5))
+            continue;
+
+        uint32_t nbSteps = static_cast<uint32_t>(std::ceil(std::max(std::abs(x2 - x1), std::abs(y2 - y1)) * 2.0)) + 1;
+        for(uint32_t step = 0; step <= nbSteps; ++step)
+        {
+            double ratio = static_cast<double>(step) / static_cast<double>(nbSteps);
+            double xx = std::round(x1 + (x2 - x1) * ratio);
+            double yy = std::round(y1 + (y2 - y1) * ratio);
+            if((xx < 0.0) || (yy < 0.0) || (xx >= mMapSizeX) || (yy >= mMapSizeY))
+                continue;
+
+            uint32_t cellIndex = mTileCells[static_cast<uint32_t>(xx) + static_cast<uint32_t>(yy) * mMapSizeX];
+            if(cellIndex < mCells.size())
+                outlineCells.push_back(cellIndex);
+        }
+    }
+    std::sort(outlineCells.begin(), outlineCells.end());
+    outlineCells.erase(std::unique(outlineCells.begin(), outlineCells.end()), outlineCells.end());
+
+    if(outlineCells == mOutlineCells)
+        return;
+
+    // Only the cells entering or leaving the outline need to be painted again
+    for(uint32_t cellIndex : mOutlineCells)
+    {
+        if(!std::binary_search(outlineCells.begin(), outlineCells.end(), cellIndex))
+        {
+            mIsCellOutline[cellIndex] = 0;
+            markCellDirty(cellIndex);
+        }
+    }
+    for(uint32_t cellIndex : outlineCells)
+    {
+        if(mIsCellOutline[cellIndex] == 0)
+        {
+            mIsCellOutline[cellIndex] = 1;
+            markCellDirty(cellIndex);
+        }
+    }
+    mOutlineCells.swap(outlineCells);
+}
+
+bool MiniMapRaster::flush()
+{
+    mDirtyRects.clear();
+    if(mDirtyCells.empty())
+        return false;
+
+    std::vector<MiniMapRect> rects;
+    for(uint32_t cellIndex : mDirtyCells)
+    {
+        const Cell& cell = mCells[cellIndex];
+        mIsCellDirty[cellIndex] = 0;
+        uint32_t colour = (mIsCellOutline[cellIndex] != 0) ? OUTLINE_COLOUR : computeCellColour(cell);
+        MiniMapRect rect = getImageRect(cell);
+        for(uint32_t yy = rect.mYMin; yy < rect.mYMax; ++yy)
+            std::fill(mPixels.begin() + yy * mWidth + rect.mXMin, mPixels.begin() + yy * mWidth + rect.mXMax, colour);
+
+        rects.push_back(rect);
+    }
+    mDirtyCells.clear();
+
+    // We merge the cells next to each other on the same row
+    std::sort(rects.begin(), rects.end(), [](const MiniMapRect& r1, const MiniMapRect& r2)
+    {
+        return (r1.mYMin < r2.mYMin) || ((r1.mYMin == r2.mYMin) && (r1.mXMin < r2.mXMin));
+    });
+    for(const MiniMapRect& rect : rects)
+    {
+        if(!mDirtyRects.empty())
+        {
+            MiniMapRect& last = mDirtyRects.back();
+            if((last.mYMin == rect.mYMin) && (last.mYMax == rect.mYMax) && (last.mXMax == rect.mXMin))
+            {
+                last.mXMax = rect.mXMax;
+                continue;
+            }
+        }
+        mDirtyRects.push_back(rect);
+    }
+
+    if(mDirtyRects.size() > MAX_DIRTY_RECTS)
+    {
+        MiniMapRect bounds = mDirtyRects[0];
+        for(const MiniMapRect& rect : mDirtyRects)
+        {
+            bounds.mXMin = std::min(bounds.mXMin, rect.mXMin);
+            bounds.mXMax = std::max(bounds.mXMax, rect.mXMax);
+            bounds.mYMin = std::min(bounds.mYMin, rect.mYMin);
+            bounds.mYMax = std::max(bounds.mYMax, rect.mYMax);
+        }
+        mDirtyRects.assign(1, bounds);
+    }
+
+    return true;
+}
+
+uint32_t MiniMapRaster::getPixelColour(MiniMapDrawnFullPixel value, const Ogre::ColourValue* seatColour)
+{
+    switch(value)
+    {
+        case MiniMapDrawnFullPixel::enemyCreature:
+            return packColour(0xFF, 0x00, 0x00);
+        case MiniMapDrawnFullPixel::claimedFull:
+            if(seatColour == nullptr)
+                return packColour(0x86, 0x50, 0x28);
+            return packSeatColour(*seatColour, 255.0);
+        case MiniMapDrawnFullPixel::claimedGround:
+            if(seatColour == nullptr)
+                return packColour(0x5C, 0x37, 0x1B);
+            return packSeatColour(*seatColour, 200.0);
+        case MiniMapDrawnFullPixel::goldFull:
+            return packColour(0xB5, 0xB3, 0x2F);
+        case MiniMapDrawnFullPixel::goldGround:
+            return packColour(0x3B, 0x1D, 0x08);
+        case MiniMapDrawnFullPixel::water:
+            return packColour(0x21, 0x36, 0x7A);
+        case MiniMapDrawnFullPixel::lava:
+            return packColour(0xB2, 0x22, 0x22);
+        case MiniMapDrawnFullPixel::dirtGround:
+            return packColour(0x3B, 0x1D, 0x08);
+        case MiniMapDrawnFullPixel::dirtFull:
+            return packColour(0x5B, 0x2D, 0x0C);
+        case MiniMapDrawnFullPixel::rockGround:
+            return packColour(0x30, 0x30, 0x30);
+        case MiniMapDrawnFullPixel::rockFull:
+            return packColour(0x41, 0x41, 0x41);
+        case MiniMapDrawnFullPixel::pickupEntity:
+            return packColour(0xDD, 0xDD, 0x12);
+        default:
+            return packColour(0x00, 0x00, 0xFF);
+    }
+}
+
+void MiniMapRaster::markCellDirty(uint32_t cellIndex)
+{
+    if(mIsCellDirty[cellIndex] != 0)
+        return;
+
+    mIsCellDirty[cellIndex] = 1;
+    mDirtyCells.push_back(cellIndex);
+}
+
+uint32_t MiniMapRaster::computeCellColour(const Cell& cell) const
+{
+    // If several tiles have the same value, the first one is used
+    uint32_t bestIndex = cell.mTileXMin + cell.mTileYMin * mMapSizeX;
+    for(uint32_t xx = cell.mTileXMin; xx < cell.mTileXMax; ++xx)
+    {
+        for(uint32_t yy = cell.mTileYMin; yy < cell.mTileYMax; ++yy)
+        {
+            uint32_t index = xx + yy * mMapSizeX;
+            if(mTileValues[index] > mTileValues[bestIndex])
+                bestIndex = index;
+        }
+    }
+    return mTileColours[bestIndex];
+}
+
+MiniMapRect MiniMapRaster::getImageRect(const Cell& cell) const
+{
+    MiniMapRect rect = {cell.mMinimapXMin, cell.mMinimapXMax,
+        mHeight - cell.mMinimapYMax, mHeight - cell.mMinimapYMin};
+    return rect;
+}
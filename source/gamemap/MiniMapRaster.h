@@ -0,0 +1,150 @@
+/*!
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MINIMAPRASTER_H_
+#define MINIMAPRASTER_H_
+
+#include <OgreColourValue.h>
+#include <OgreVector3.h>
+
+#include <cstdint>
+#include <vector>
+
+//! \brief This enum represents the possible values a pixel can have in the minimap.
+//! If a pixel corresponds to several game tiles, the highest value will be used
+//! to display the pixel
+enum class MiniMapDrawnFullPixel : uint8_t
+{
+    dirtFull,
+    dirtGround,
+    rockFull,
+    rockGround,
+    claimedFull,
+    claimedGround,
+    lava,
+    water,
+    goldFull,
+    goldGround,
+    gemFull,
+    gemGround,
+    pickupEntity,
+    alliedCreature,
+    enemyCreature
+};
+
+//! \brief Rectangle of the minimap image. Max values are excluded
+struct MiniMapRect
+{
+    uint32_t mXMin;
+    uint32_t mXMax;
+    uint32_t mYMin;
+    uint32_t mYMax;
+};
+
+/*! \brief CPU side image of the minimap used by MiniMapDrawnFull. The map is split in cells: each cell
+ * is a rectangle of tiles drawn as a rectangle of pixels (several tiles can share a pixel if the map is
+ * bigger than the minimap and the other way around). The value and colour of each tile are kept in
+ * packed arrays and the cells whose tiles changed are marked as dirty. The outline of the area seen by
+ * the camera is drawn as an overlay on top of the cells it crosses.
+ * When flush is called, the dirty cells are painted and the pixel rectangles that changed are returned so
+ * that only them are uploaded to the texture.
+ * The image is stored top row first with 1 packed pixel per uint32_t (0x00RRGGBB).
+ * It does not depend on the GameMap or on the rendering so that it can be tested alone.
+ */
+class MiniMapRaster
+{
+public:
+    MiniMapRaster(uint32_t width, uint32_t height, uint32_t mapSizeX, uint32_t mapSizeY);
+
+    uint32_t getWidth() const
+    { return mWidth; }
+
+    uint32_t getHeight() const
+    { return mHeight; }
+
+    const std::vector<uint32_t>& getPixels() const
+    { return mPixels; }
+
+    //! \brief Returns the rectangles painted by the last call to flush
+    const std::vector<MiniMapRect>& getDirtyRects() const
+    { return mDirtyRects; }
+
+    //! \brief Sets the value of the given tile. colour should be computed with getPixelColour
+    void setTile(uint32_t tileX, uint32_t tileY, MiniMapDrawnFullPixel value, uint32_t colour);
+
+    //! \brief Sets the outline of the area seen by the camera. cornerTiles are the 4 corners, in order
+    void setOutline(const std::vector<Ogre::Vector3>& cornerTiles);
+
+    //! \brief Paints the dirty cells. Returns false if nothing changed since the last call
+    bool flush();
+
+    //! \brief Returns the packed colour for the given value. seatColour should be the colour of the
+    //! seat owning the tile if it is claimed and nullptr otherwise
+    static uint32_t getPixelColour(MiniMapDrawnFullPixel value, const Ogre::ColourValue* seatColour);
+
+    //! \brief Colour of the outline of the area seen by the camera
+    static const uint32_t OUTLINE_COLOUR;
+
+private:
+    struct Cell
+    {
+        uint32_t mMinimapXMin;
+        uint32_t mMinimapXMax;
+        uint32_t mMinimapYMin;
+        uint32_t mMinimapYMax;
+        uint32_t mTileXMin;
+        uint32_t mTileXMax;
+        uint32_t mTileYMin;
+        uint32_t mTileYMax;
+    };
+
+    uint32_t mWidth;
+    uint32_t mHeight;
+    uint32_t mMapSizeX;
+    uint32_t mMapSizeY;
+
+    std::vector<Cell> mCells;
+
+    //! \brief Cell index of each tile (tileX + tileY * mMapSizeX). Tiles not drawn have an index
+    //! equal to mCells.size()
+    std::vector<uint32_t> mTileCells;
+
+    //! \brief Value and colour of each tile
+    std::vector<MiniMapDrawnFullPixel> mTileValues;
+    std::vector<uint32_t> mTileColours;
+
+    //! \brief Cells to paint at the next flush. mIsCellDirty avoids adding a cell twice
+    std::vector<uint32_t> mDirtyCells;
+    std::vector<uint8_t> mIsCellDirty;
+
+    //! \brief Cells crossed by the camera outline (sorted)
+    std::vector<uint32_t> mOutlineCells;
+    std::vector<uint8_t> mIsCellOutline;
+
+    std::vector<uint32_t> mPixels;
+    std::vector<MiniMapRect> mDirtyRects;
+
+    void markCellDirty(uint32_t cellIndex);
+
+    //! \brief Returns the colour of the tile with the highest value within the cell
+    uint32_t computeCellColour(const Cell& cell) const;
+
+    //! \brief Converts the minimap rectangle of the cell (y going up) to the image one (y going down)
+    MiniMapRect getImageRect(const Cell& cell) const;
+};
+
+#endif // MINIMAPRASTER_H_
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include <cstdint>
+#include <vector>
+
+/*! \brief Read only snapshot of the values standing on each tile of a map. The values of all the tiles
+ * are packed in a single array sorted by tile so that getting the values on a tile is only an index
+ * lookup and does not need any temporary container.
+ * The grid is filled by calling add for each value between beginBuild and endBuild. The memory is kept
+ * between builds so that rebuilding the grid each turn does not allocate once it has reached its size.
+ */
+template <typename T>
+class OccupancyGrid
+{
+public:
+    //! \brief Values standing on a tile. Can be used in a range based for loop
+    class Range
+    {
+    public:
+        Range(const T* begin, const T* end) :
+            mBegin(begin),
+            mEnd(end)
+        {}
+
+        inline const T* begin() const
+        { return mBegin; }
+
+        inline const T* end() const
+        { return mEnd; }
+
+        inline bool empty() const
+        { return mBegin == mEnd; }
+
+        inline uint32_t size() const
+        { return static_cast<uint32_t>(mEnd - mBegin); }
+
+    private:
+        const T* mBegin;
+        const T* mEnd;
+    };
+
+    OccupancyGrid() :
+        mSizeX(0),
+        mSizeY(0)
+    {}
+
+    //! \brief Removes every value from the grid
+    void clear()
+    {
+        mPending.clear();
+        mValues.clear();
+        mCellEnds.assign(mCellEnds.size(), 0);
+    }
+
+    //! \brief Starts filling the grid for a map of the given size. The previous values are removed
+    void beginBuild(int sizeX, int sizeY)
+    {
+        mSizeX = sizeX;
+        mSizeY = sizeY;
+        mPending.clear();
+        mCellEnds.assign(mSizeX * mSizeY, 0);
+    }
+
+    //! \brief Adds a value on the given tile. Values outside of the map are ignored
+    void add(int x, int y, const T& value)
+    {
+        if((x < 0) || (x >= mSizeX) || (y < 0) || (y >= mSizeY))
+            return;
+
+        uint32_t cell = static_cast<uint32_t>(x + y * mSizeX);
+        mPending.push_back(PendingValue(cell, value));
+        ++mCellEnds[cell];
+    }
+
+    //! \brief Sorts the added values by tile. Values of a same tile are kept in the order they were added
+    void endBuild()
+    {
+        // mCellEnds holds the number of values by cell. We convert it to the start of each cell, use it
+        // as an insertion cursor while placing the values and it ends up holding the end of each cell
+        uint32_t start = 0;
+        for(uint32_t& cellEnd : mCellEnds)
+        {
+            uint32_t nbValues = cellEnd;
+            cellEnd = start;
+            start += nbValues;
+        }
+
+        mValues.resize(mPending.size());
+        for(const PendingValue& pending : mPending)
+        {
+            mValues[mCellEnds[pending.mCell]] = pending.mValue;
+            ++mCellEnds[pending.mCell];
+        }
+        mPending.clear();
+    }
+
+    //! \brief Returns the values standing on the given tile
+    Range getCell(int x, int y) const
+    {
+        if((x < 0) || (x >= mSizeX) || (y < 0) || (y >= mSizeY) || mValues.empty())
+            return Range(nullptr, nullptr);
+
+        uint32_t cell = static_cast<uint32_t>(x + y * mSizeX);
+        uint32_t begin = (cell == 0) ? 0 : mCellEnds[cell - 1];
+        const T* values = mValues.data();
+        return Range(values + begin, values + mCellEnds[cell]);
+    }
+
+    inline uint32_t getNbValues() const
+    { return static_cast<uint32_t>(mValues.size()); }
+
+private:
+    struct PendingValue
+    {
+        PendingValue(uint32_t cell, const T& value) :
+            mCell(cell),
+            mValue(value)
+        {}
+
+        uint32_t mCell;
+        T mValue;
+    };
+
+    int mSizeX;
+    int mSizeY;
+
+    //! \brief Values added since beginBuild
+    std::vector<PendingValue> mPending;
+
+    //! \brief Values sorted by cell
+    std::vector<T> mValues;
+
+    //! \brief Index in mValues of the end of each cell. The start of a cell is the end of the previous one
+    std::vector<uint32_t> mCellEnds;
+};
+
+#endif // OCCUPANCYGRID_H
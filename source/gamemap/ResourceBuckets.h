@@ -0,0 +1,210 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RESOURCEBUCKETS_H
+#define RESOURCEBUCKETS_H
+
+#include "utils/Random.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+/*! \brief Objects of a map (like gold tiles) stored in buckets covering squares of the map so that the
+ * nearest object from a given tile can be found by looking only at the buckets around it.
+ * T should define getX() and getY(). The objects are not owned.
+ */
+template <typename T>
+class ResourceBuckets
+{
+public:
+    //! \brief Size (in tiles) of the side of the square covered by a bucket
+    static const int BUCKET_SIZE = 8;
+
+    ResourceBuckets() :
+        mNbBucketsX(0),
+        mNbBucketsY(0),
+        mNbObjects(0)
+    {}
+
+    //! \brief Removes every object and setups the buckets for a map of the given size
+    void resize(int mapSizeX, int mapSizeY)
+    {
+        mNbBucketsX = (mapSizeX + BUCKET_SIZE - 1) / BUCKET_SIZE;
+        mNbBucketsY = (mapSizeY + BUCKET_SIZE - 1) / BUCKET_SIZE;
+        mBuckets.assign(mNbBucketsX * mNbBucketsY, std::vector<T*>());
+        mNbObjects = 0;
+    }
+
+    void clear()
+    {
+        resize(0, 0);
+    }
+
+    //! \brief Adds or removes the object depending on isWanted. Objects outside of the map are ignored
+    void update(T& object, bool isWanted)
+    {
+        int bucketX = object.getX() / BUCKET_SIZE;
+        int bucketY = object.getY() / BUCKET_SIZE;
+        if((object.getX() < 0) || (object.getY() < 0) || (bucketX >= mNbBucketsX) || (bucketY >= mNbBucketsY))
+            return;
+
+        std::vector<T*>& bucket = mBuckets[bucketX * mNbBucketsY + bucketY];
+        auto it = std::find(bucket.begin(), bucket.end(), &object);
+        bool isIndexed = (it != bucket.end());
+        if(isWanted == isIndexed)
+            return;
+
+        if(isWanted)
+        {
+            bucket.push_back(&object);
+            ++mNbObjects;
+            return;
+        }
+
+        // Order does not matter within a bucket
+        *it = bucket.back();
+        bucket.pop_back();
+        --mNbObjects;
+    }
+
+    inline uint32_t getNbObjects() const
+    { return mNbObjects; }
+
+    /*! \brief Returns the closest object from (startX, startY) for which isAccepted returns true. Objects are
+     * ordered like when scanning the square rings around the start: first by ring, then by distance to the
+     * middle of the ring side. If several objects are at the same place in the ring, one of them is randomly
+     * chosen to not be too predictable. Objects on the start tile are ignored.
+     * Returns nullptr if no such object is found
+     */
+    template <typename Pred>
+    T* getNearest(int startX, int startY, Pred isAccepted, RandomStream& random) const
+    {
+        if(mNbObjects == 0)
+            return nullptr;
+
+        int bucketStartX = startX / BUCKET_SIZE;
+        int bucketStartY = startY / BUCKET_SIZE;
+        int maxRing = std::max(mNbBucketsX, mNbBucketsY);
+
+        // An object at (dx, dy) from the start is on the square ring max(|dx|, |dy|) at the offset
+        // min(|dx|, |dy|) from the middle of the ring side. We keep every object at the smallest (ring, offset)
+        std::vector<T*> candidates;
+        int bestRing = 0;
+        int bestOffset = 0;
+        for(int ring = 0; ring < maxRing; ++ring)
+        {
+            // Any object in a bucket from this ring is at least that far away on one axis. If we already
+            // found a closer object, no need to go further
+            if(!candidates.empty())
+            {
+                int minDist = std::max(0, (ring - 1) * BUCKET_SIZE + 1);
+                if(minDist > bestRing)
+                    break;
+            }
+
+            for(int bx = bucketStartX - ring; bx <= bucketStartX + ring; ++bx)
+            {
+                if((bx < 0) || (bx >= mNbBucketsX))
+                    continue;
+
+                // On the left and right columns, we process every bucket. Otherwise, only the top and bottom ones
+                bool isBorderColumn = (bx == bucketStartX - ring) || (bx == bucketStartX + ring);
+                int stepY = isBorderColumn ? 1 : std::max(1, 2 * ring);
+                for(int by = bucketStartY - ring; by <= bucketStartY + ring; by += stepY)
+                {
+                    if((by < 0) || (by >= mNbBucketsY))
+                        continue;
+
+                    for(T* object : mBuckets[bx * mNbBucketsY + by])
+                    {
+                        int dx = std::abs(object->getX() - startX);
+                        int dy = std::abs(object->getY() - startY);
+                        int objectRing = std::max(dx, dy);
+                        int objectOffset = std::min(dx, dy);
+                        if(objectRing == 0)
+                            continue;
+
+                        if(!candidates.empty())
+                        {
+                            if(objectRing > bestRing)
+                                continue;
+                            if((objectRing == bestRing) && (objectOffset > bestOffset))
+                                continue;
+                        }
+
+                        if(!isAccepted(*object))
+                            continue;
+
+                        if(candidates.empty() || (objectRing < bestRing) || (objectOffset < bestOffset))
+                        {
+                            candidates.clear();
+                            bestRing = objectRing;
+                            bestOffset = objectOffset;
+                        }
+                        candidates.push_back(object);
+                    }
+                }
+            }
+        }
+
+        if(candidates.empty())
+            return nullptr;
+
+        // We look at the objects in the same order as a ring scan would: North-East, North-West, South-East,
+        // South-West, East-North, East-South, West-North, West-South. When the offset is 0, a mirrored
+        // slot is the same tile as the previous one so it is only looked at once.
+        const int d = bestRing;
+        const int k = bestOffset;
+        const int slots[8][2] = {
+            { k, d }, { -k, d }, { k, -d }, { -k, -d },
+            { d, k }, { d, -k }, { -d, k }, { -d, -k }
+        };
+        T* chosen = nullptr;
+        for(int slot = 0; slot < 8; ++slot)
+        {
+            // Odd slots are mirrored versions of the previous one
+            if(((slot % 2) == 1) && (k == 0))
+                continue;
+
+            for(T* object : candidates)
+            {
+                if((object->getX() - startX != slots[slot][0]) || (object->getY() - startY != slots[slot][1]))
+                    continue;
+
+                // If we already have an object at same distance, we randomly change to
+                // try to not be too predictable
+                if((chosen == nullptr) || (random.Uint(1,2) == 1))
+                    chosen = object;
+            }
+        }
+
+        return chosen;
+    }
+
+private:
+    int mNbBucketsX;
+    int mNbBucketsY;
+
+    //! \brief Buckets are indexed by bucketX * mNbBucketsY + bucketY
+    std::vector<std::vector<T*>> mBuckets;
+
+    uint32_t mNbObjects;
+};
+
+#endif // RESOURCEBUCKETS_H
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gamemap/ResourceIndex.h"
+
+#include "entities/Tile.h"
+#include "gamemap/TileContainer.h"
+#include "utils/Random.h"
+
+ResourceIndex::ResourceIndex() :
+    mTiles(nullptr)
+{
+}
+
+bool ResourceIndex::isGoldTile(const Tile& tile)
+{
+    return (tile.getType() == TileType::gold) && (tile.getFullness() > 0.0);
+}
+
+void ResourceIndex::clear()
+{
+    mTiles = nullptr;
+    mGoldTiles.clear();
+    mReachability.clear();
+}
+
+void ResourceIndex::build(const TileContainer& tiles)
+{
+    clear();
+    mTiles = &tiles;
+    mGoldTiles.resize(tiles.getMapSizeX(), tiles.getMapSizeY());
+    for(int xx = 0; xx < tiles.getMapSizeX(); ++xx)
+    {
+        for(int yy = 0; yy < tiles.getMapSizeY(); ++yy)
+        {
+            Tile* tile = tiles.getTile(xx, yy);
+            if((tile == nullptr) || !isGoldTile(*tile))
+                continue;
+
+            mGoldTiles.update(*tile, true);
+        }
+    }
+}
+
+void ResourceIndex::updateTile(Tile& tile)
+{
+    // Nothing to do if the index is not built
+    if(mTiles == nullptr)
+        return;
+
+    mGoldTiles.update(tile, isGoldTile(tile));
+}
+
+Tile* ResourceIndex::getNearestGoldTile(Tile& tileStart, Seat& seat, RandomStream& random) const
+{
+    if((mTiles == nullptr) || (mGoldTiles.getNbObjects() == 0))
+        return nullptr;
+
+    // The reachable area is only computed if there is a gold tile to check
+    bool isReachabilityComputed = false;
+    const TileContainer& tiles = *mTiles;
+    return mGoldTiles.getNearest(tileStart.getX(), tileStart.getY(), [&](const Tile& tile)
+    {
+        if(!isReachabilityComputed)
+        {
+            isReachabilityComputed = true;
+            mReachability.compute(tiles.getMapSizeX(), tiles.getMapSizeY(), tileStart.getX(), tileStart.getY(),
+                [&tiles, &seat](int x, int y)
+            {
+                Tile* t = tiles.getTile(x, y);
+                if(t == nullptr)
+                    return DigReachability::Passability::blocked;
+                if(t->getFloodFillValue(&seat, FloodFillType::ground) != Tile::NO_FLOODFILL)
+                    return DigReachability::Passability::walkable;
+                if(t->isDiggable(&seat))
+                    return DigReachability::Passability::diggable;
+
+                return DigReachability::Passability::blocked;
+            });
+        }
+
+        return mReachability.isReachable(tile.getX(), tile.getY());
+    }, random);
+}
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RESOURCEINDEX_H
+#define RESOURCEINDEX_H
+
+#include "gamemap/DigReachability.h"
+#include "gamemap/ResourceBuckets.h"
+
+class RandomStream;
+class Seat;
+class Tile;
+class TileContainer;
+
+/*! \brief Index of the remaining gold tiles of a map. See ResourceBuckets.
+ * The index is built once the map is loaded and then updated each time a tile changes
+ * (for example when a gold tile is dug out).
+ */
+class ResourceIndex
+{
+public:
+    ResourceIndex();
+
+    //! \brief Removes every tile from the index
+    void clear();
+
+    //! \brief Indexes every gold tile from the given container
+    void build(const TileContainer& tiles);
+
+    //! \brief Adds or removes the tile from the index depending on its type and fullness
+    void updateTile(Tile& tile);
+
+    /*! \brief Returns the closest gold tile from tileStart that the workers of the given seat can reach
+     * by walking or digging (see DigReachability). Tiles are ordered like in ResourceBuckets::getNearest.
+     * Returns nullptr if no such tile is found
+     */
+    Tile* getNearestGoldTile(Tile& tileStart, Seat& seat, RandomStream& random) const;
+
+    //! \brief Returns true if the given tile is considered as a gold tile that can be dug
+    static bool isGoldTile(const Tile& tile);
+
+private:
+    const TileContainer* mTiles;
+
+    ResourceBuckets<Tile> mGoldTiles;
+
+    //! \brief Used by getNearestGoldTile. Kept to reuse its memory
+    mutable DigReachability mReachability;
+};
+
+#endif // RESOURCEINDEX_H
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/SaveGameWriter.h"
+
+#include "gamemap/BinaryLevel.h"
+#include "gamemap/MapHandler.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+#include "utils/Profiler.h"
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+SaveGameWriter::SaveGameWriter() :
+    mIsWriting(false),
+    mIsStopping(false)
+{
+}
+
+SaveGameWriter::~SaveGameWriter()
+{
+    // The thread is only started with the first save
+    if(!mThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mCondition.notify_all();
+    mThread.join();
+}
+
+void SaveGameWriter::queueSave(std::unique_ptr<BinaryLevel::LevelSnapshot> snapshot, const std::string& fileName,
+    Format format, bool isAutosave)
+{
+    Job job;
+    job.mSnapshot = std::move(snapshot);
+    job.mFileName = fileName;
+    job.mFormat = format;
+    job.mIsAutosave = isAutosave;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(std::move(job));
+    }
+
+    // Only the server saves games. We do not start the thread before it is needed so that clients do not have one
+    if(!mThread.joinable())
+    {
+        mThread = std::thread(&SaveGameWriter::writerThread, this);
+        return;
+    }
+
+    mCondition.notify_all();
+}
+
+std::vector<SaveGameWriter::Result> SaveGameWriter::popFinishedSaves()
+{
+    std::vector<Result> results;
+    std::lock_guard<std::mutex> lock(mMutex);
+    results.swap(mFinishedSaves);
+    return results;
+}
+
+bool SaveGameWriter::isSaving()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mIsWriting || !mJobs.empty();
+}
+
+void SaveGameWriter::writerThread()
+{
+    while(true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mIsStopping || !mJobs.empty(); });
+            // Pending saves are written before stopping
+            if(mJobs.empty())
+                return;
+
+            job = std::move(mJobs.front());
+            mJobs.pop_front();
+            mIsWriting = true;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Result result;
+        result.mFileName = job.mFileName;
+        result.mIsAutosave = job.mIsAutosave;
+        result.mIsSuccess = writeSave(job);
+        result.mDurationMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        OD_LOG_INF("Savegame " + job.mFileName + (result.mIsSuccess ? " written in " : " failed after ")
+            + Helper::toString(result.mDurationMs) + " ms");
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFinishedSaves.push_back(result);
+        mIsWriting = false;
+    }
+}
+
+bool SaveGameWriter::writeSave(const Job& job)
+{
+    OD_PROFILE_SCOPE("SaveGameWriter::writeSave");
+    MapHandler::formatCapturedSections(*job.mSnapshot);
+    std::string data;
+    if(job.mFormat == Format::binary)
+    {
+        BinaryLevel::serializeBinary(*job.mSnapshot, data);
+    }
+    else
+    {
+        std::stringstream ss;
+        BinaryLevel::writeText(*job.mSnapshot, ss);
+        data = ss.str();
+    }
+
+    const std::string tmpFileName = job.mFileName + ".tmp";
+    if(!writeFileSync(tmpFileName, data))
+        return false;
+
+    try
+    {
+        // If the file exists, we make a backup
+        boost::filesystem::path levelSave(job.mFileName);
+        if(boost::filesystem::exists(levelSave))
+            boost::filesystem::rename(levelSave, job.mFileName + ".bak");
+
+        boost::filesystem::rename(tmpFileName, levelSave);
+    }
+    catch(const boost::filesystem::filesystem_error& e)
+    {
+        OD_LOG_WRN("Couldn't rename savegame " + tmpFileName + ", error=" + e.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool SaveGameWriter::writeFileSync(const std::string& fileName, const std::string& data)
+{
+    FILE* file = std::fopen(fileName.c_str(), "wb");
+    if(file == nullptr)
+    {
+        OD_LOG_WRN("Couldn't open file for writing: " + fileName);
+        return false;
+    }
+
+    bool isWritten = (std::fwrite(data.data(), 1, data.size(), file) == data.size()) &&
+        (std::fflush(file) == 0);
+#ifdef _WIN32
+    isWritten = isWritten && (_commit(_fileno(file)) == 0);
+#else
+    isWritten = isWritten && (fsync(fileno(file)) == 0);
+#endif
+    isWritten = (std::fclose(file) == 0) && isWritten;
+
+    if(!isWritten)
+        OD_LOG_WRN("Unexpected failure on file: " + fileName);
+
+    return isWritten;
+}
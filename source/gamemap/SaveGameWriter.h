@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SAVEGAMEWRITER_H
+#define SAVEGAMEWRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BinaryLevel
+{
+    struct LevelSnapshot;
+}
+
+/*! \brief Writes savegames from a background thread. The server thread only captures a snapshot of the
+ * game map (see MapHandler::captureGameMap) at a turn boundary. Formatting the snapshot, writing it
+ * and flushing it to the disk is done by the writer thread so that the game does not stall.
+ * The file is first written next to the destination and then renamed so that a crash while saving
+ * cannot leave a truncated savegame. If the destination exists, it is kept as a backup (.bak).
+ */
+class SaveGameWriter
+{
+public:
+    enum class Format
+    {
+        text,
+        binary
+    };
+
+    struct Result
+    {
+        std::string mFileName;
+        bool mIsSuccess;
+        bool mIsAutosave;
+        uint64_t mDurationMs;
+    };
+
+    SaveGameWriter();
+    //! \brief Waits until the queued saves are written
+    ~SaveGameWriter();
+
+    //! \brief Queues the given snapshot to be written. The writer thread is started with the first save
+    void queueSave(std::unique_ptr<BinaryLevel::LevelSnapshot> snapshot, const std::string& fileName,
+        Format format, bool isAutosave);
+
+    //! \brief Returns the saves finished since the last call. Should be called from the thread queuing the saves
+    std::vector<Result> popFinishedSaves();
+
+    //! \brief Returns true if a save is queued or being written
+    bool isSaving();
+
+private:
+    struct Job
+    {
+        std::unique_ptr<BinaryLevel::LevelSnapshot> mSnapshot;
+        std::string mFileName;
+        Format mFormat;
+        bool mIsAutosave;
+    };
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<Job> mJobs;
+    std::vector<Result> mFinishedSaves;
+    bool mIsWriting;
+    bool mIsStopping;
+    std::thread mThread;
+
+    void writerThread();
+
+    //! \brief Writes the given job. Returns false if the savegame could not be written
+    static bool writeSave(const Job& job);
+
+    //! \brief Writes data in the given file and flushes it to the disk
+    static bool writeFileSync(const std::string& fileName, const std::string& data);
+
+    SaveGameWriter(const SaveGameWriter&) = delete;
+    SaveGameWriter& operator=(const SaveGameWriter&) = delete;
+};
+
+#endif // SAVEGAMEWRITER_H
@@ -0,0 +1,568 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/ShadowTables.h"
+
+#include <algorithm>
+
+class TileDistance
+{
+public:
+    enum TileDistanceType
+    {
+        Horizontal,
+        Diagonal,
+        Other
+    };
+
+    TileDistance(int diffX, int diffY, TileDistanceType type, int distSquared):
+        mDiffX(diffX),
+        mDiffY(diffY),
+        mType(type),
+        mDistSquared(distSquared)
+    {
+    }
+
+    inline int getDiffX() const
+    { return mDiffX; }
+
+    inline int getDiffY() const
+    { return mDiffY; }
+
+    inline TileDistanceType getType() const
+    { return mType; }
+
+    inline int getDistSquared() const
+    { return mDistSquared; }
+
+    void computeTileDistances(double coefNorth, double coefSouth, const TileDistance& tileDistance,
+        uint32_t indexTileDistance)
+    {
+        // A tile can only hide tiles behind (x > tile.x and y > tile.y)
+        if(tileDistance.getDiffX() < getDiffX())
+            return;
+        if(tileDistance.getDiffY() < getDiffY())
+            return;
+
+        // We don't want a tile to hide itself
+        if((tileDistance.getDiffX() == getDiffX()) &&
+           (tileDistance.getDiffY() == getDiffY()))
+        {
+            return;
+        }
+
+        if(getType() == TileDistance::TileDistanceType::Horizontal)
+        {
+            // For horizontal tiles, we hide following tiles (x > tile.x). But we process
+            // north tiles normally
+            if(tileDistance.getType() == TileDistance::TileDistanceType::Horizontal)
+            {
+                addHiddenTileSouth(indexTileDistance, 1.0);
+                return;
+            }
+
+            double xTileDeb = static_cast<double>(tileDistance.getDiffX()) - 0.5;
+            double xTileEnd = xTileDeb + 1.0;
+            double yTileDeb = static_cast<double>(tileDistance.getDiffY()) - 0.5;
+            double yTileEnd = yTileDeb + 1.0;
+            double yHideDebNorth = coefNorth * xTileDeb;
+            double yHideEndNorth = coefNorth * xTileEnd;
+
+            // If the tile is over the North ray, it is not hidden
+            if(yHideEndNorth <= yTileDeb)
+                return;
+
+            // We check which part of the tile is hidden
+            if((yHideDebNorth >= yTileDeb) &&
+               (yHideEndNorth <= yTileEnd))
+            {
+                // The ray hits the left side of the tile and the right side.
+                // The south part is partially hidden
+                double hiddenArea = (yHideEndNorth - yHideDebNorth) / 2.0;
+                hiddenArea += yHideDebNorth - yTileDeb;
+                addHiddenTileSouth(indexTileDistance, hiddenArea);
+            }
+            else if((yHideDebNorth < yTileDeb) &&
+                    (yHideEndNorth > yTileDeb))
+            {
+                // The ray hits the bottom side of the tile but hits the right side. We compute
+                // the south visible part
+                double xHit = yTileDeb / coefNorth;
+                double hiddenArea = (yHideEndNorth - yTileDeb) * (xTileEnd - xHit) / 2.0;
+                addHiddenTileSouth(indexTileDistance, hiddenArea);
+            }
+            else if((yHideDebNorth < yTileEnd) &&
+                    (yHideEndNorth > yTileEnd))
+            {
+                // The ray hits the left side of the tile but is over the right side. We compute
+                // the hidden part on north.
+                double xHit = yTileEnd / coefNorth;
+                double visibleArea = (yTileEnd - yHideDebNorth) * (xHit - xTileDeb) / 2.0;
+                addHiddenTileSouth(indexTileDistance, 1.0 - visibleArea);
+            }
+            else
+            {
+                // The entire tile is hidden
+                addHiddenTileSouth(indexTileDistance, 1.0);
+            }
+
+            return;
+        }
+
+        double xTileDeb = static_cast<double>(tileDistance.getDiffX()) - 0.5;
+        double xTileEnd = xTileDeb + 1.0;
+        double yTileDeb = static_cast<double>(tileDistance.getDiffY()) - 0.5;
+        double yTileEnd = yTileDeb + 1.0;
+
+        // We check if the current tile is hidden by the tile. To consider that the
+        // tile is hidden by the south, as we know the angle will be between 0 and 45 degrees,
+        // we consider that the tile has to be hit by the ray passing through the hiding tile
+        // on the left side of the tile (otherwise, the hidden part will be too small).
+        double yHideDebSouth = coefSouth * xTileDeb;
+        double yHideEndSouth = coefSouth * xTileEnd;
+        double yHideDebNorth = coefNorth * xTileDeb;
+        double yHideEndNorth = coefNorth * xTileEnd;
+        // We check if at least a part of the tile is hidden
+        if((yHideDebSouth < yTileEnd) &&
+           (yHideEndNorth > yTileDeb))
+        {
+            // At least a part of this tile is hidden
+            if((yHideDebSouth >= yTileDeb) &&
+               (yHideEndSouth <= yTileEnd))
+            {
+                // The ray hits the left side of the tile and the right side.
+                // The south part is partially hidden
+                // The visible part is composed from a square between the tile inferior part and
+                // the triangle made by the ray
+                double visibleArea = (yHideEndSouth - yHideDebSouth) / 2.0;
+                visibleArea += yHideDebSouth - yTileDeb;
+                addHiddenTileNorth(indexTileDistance, 1.0 - visibleArea);
+            }
+            else if((yHideDebSouth < yTileDeb) &&
+                    (yHideEndSouth > yTileDeb))
+            {
+                // The ray hits the bottom side of the tile but hits the right side. We compute
+                // the south visible part
+                double xHit = yTileDeb / coefSouth;
+                double visibleArea = (yHideEndSouth - yTileDeb) * (xTileEnd - xHit) / 2.0;
+                addHiddenTileNorth(indexTileDistance, 1.0 - visibleArea);
+            }
+            else if((yHideDebSouth < yTileEnd) &&
+                    (yHideEndSouth > yTileEnd))
+            {
+                // The ray hits the left side of the tile but is over the right side. We compute
+                // the hidden part on north.
+                double xHit = yTileEnd / coefSouth;
+                double hiddenArea = (yTileEnd - yHideDebSouth) * (xHit - xTileDeb) / 2.0;
+                addHiddenTileNorth(indexTileDistance, hiddenArea);
+
+            }
+            else if((yHideDebNorth >= yTileDeb) &&
+               (yHideEndNorth <= yTileEnd))
+            {
+                double hiddenArea = (yHideEndNorth - yHideDebNorth) / 2.0;
+                hiddenArea += yHideDebNorth - yTileDeb;
+                addHiddenTileSouth(indexTileDistance, hiddenArea);
+            }
+            else if((yHideDebNorth < yTileDeb) &&
+                    (yHideEndNorth > yTileDeb))
+            {
+                // The ray hits the bottom side of the tile but hits the right side. We compute
+                // the south visible part
+                double xHit = yTileDeb / coefNorth;
+                double hiddenArea = (yHideEndNorth - yTileDeb) * (xTileEnd - xHit) / 2.0;
+                addHiddenTileSouth(indexTileDistance, hiddenArea);
+            }
+            else if((yHideDebNorth < yTileEnd) &&
+                    (yHideEndNorth > yTileEnd))
+            {
+                // The ray hits the left side of the tile but is over the right side. We compute
+                // the hidden part on north.
+                double xHit = yTileEnd / coefNorth;
+                double visibleArea = (yTileEnd - yHideDebNorth) * (xHit - xTileDeb) / 2.0;
+                addHiddenTileSouth(indexTileDistance, 1.0 - visibleArea);
+            }
+            else
+            {
+                // The entire tile is hidden
+                addHiddenTileSouth(indexTileDistance, 1.0);
+            }
+        }
+    }
+
+    const std::vector<std::pair<uint32_t, double>>& getHiddenTilesNorth() const
+    {
+        return mHiddenTilesNorth;
+    }
+
+    const std::vector<std::pair<uint32_t, double>>& getHiddenTilesSouth() const
+    {
+        return mHiddenTilesSouth;
+    }
+
+private:
+    void addHiddenTileNorth(uint32_t indexTile, double hiddenPercent)
+    {
+        mHiddenTilesNorth.push_back(std::pair<uint32_t, double>(indexTile, hiddenPercent));
+    }
+
+    void addHiddenTileSouth(uint32_t indexTile, double hiddenPercent)
+    {
+        mHiddenTilesSouth.push_back(std::pair<uint32_t, double>(indexTile, hiddenPercent));
+    }
+
+    int mDiffX;
+    int mDiffY;
+    TileDistanceType mType;
+    int mDistSquared;
+    std::vector<std::pair<uint32_t, double>> mHiddenTilesNorth;
+    std::vector<std::pair<uint32_t, double>> mHiddenTilesSouth;
+};
+
+static bool sortByDistSquared(const TileDistance& tileDist1, const TileDistance& tileDist2)
+{
+    return tileDist1.getDistSquared() < tileDist2.getDistSquared();
+}
+
+//! \brief Octants are processed in this order (c being the center tile):
+//! 514
+//! 2c0
+//! 637
+//! For each octant, gives the offset on x/y of an entry (diffX, diffY) as a factor of diffX and diffY
+static const int OCTANT_X_FROM_X[8] = { 1,  0, -1,  0,  0,  1,  0, -1 };
+static const int OCTANT_X_FROM_Y[8] = { 0,  1,  0, -1,  1,  0, -1,  0 };
+static const int OCTANT_Y_FROM_X[8] = { 0, -1,  0,  1,  1,  0, -1,  0 };
+static const int OCTANT_Y_FROM_Y[8] = { 1,  0, -1,  0,  0, -1,  0,  1 };
+
+static const uint32_t NB_OCTANTS = 8;
+
+ShadowTables::ShadowTables() :
+    mDistanceComputed(-1)
+{
+}
+
+ShadowTables::~ShadowTables()
+{
+}
+
+void ShadowTables::build(int distance)
+{
+    if(mDistanceComputed >= distance)
+        return;
+
+    // We want to be able to fill a vector of tiles sorted beginning with the closest tile. If we look a grid (each letter
+    // represents a tile at the same distance from the center: a):
+    // jihghij
+    // ifedefi
+    // hecbceh
+    // gdbabdg
+    // hecbceh
+    // ifedefi
+    // jihghij
+    // We can see that there are 3 kind of tiles:
+    // - Vertical/Horizontal tiles (abdg): at each distance, there are 4 of them
+    // - Diagonal tiles (acfj): at each distance, there are 4 of them
+    // - Other tiles (ehi...): at each distance, there are 8 of them
+    // Moreover, we can see a symmetry. We can compute all tiles by computing only 1/8 tiles:
+    //    j
+    //   fi
+    //  ceh
+    // abdg
+
+    // If we compute only the minimum tiles needed, we have no vertical tiles (since each of them can be deduced from the horizontal)
+    // To compute tiles easily, we will compute the 1/8 tiles until distance. Then, we will sort the tiles to begin with
+    // closest distance until farthest
+    mTileDistance.clear();
+    for(int y = 0; y <= distance; ++y)
+    {
+        for(int x = y; x <= distance; ++x)
+        {
+            TileDistance::TileDistanceType type;
+            if(y == 0)
+            {
+                type = TileDistance::TileDistanceType::Horizontal;
+            }
+            else if(x == y)
+            {
+                type = TileDistance::TileDistanceType::Diagonal;
+            }
+            else
+            {
+                type = TileDistance::TileDistanceType::Other;
+            }
+            int distSquared = x * x + y * y;
+            mTileDistance.push_back(TileDistance(x, y, type, distSquared));
+        }
+    }
+
+    // The sort is stable so that the entries within a radius are always the first ones, in the same
+    // order, whatever the distance computed. That allows to keep the radius tables already built
+    std::stable_sort(mTileDistance.begin(), mTileDistance.end(), sortByDistSquared);
+
+    // We have filled the tile distance vector. Now, we fill how each tile hides the
+    // other ones when they mask vision to help calculate visible tiles
+    for(TileDistance& tileDistance : mTileDistance)
+    {
+        // We don't process the first tile
+        if(tileDistance.getDiffX() == 0 && tileDistance.getDiffY() == 0)
+            continue;
+
+        // Other tiles can hide with their down side and their up side other tiles
+        // or diagonal tiles (but not Horizontal tiles)
+        // We compute the tiles hidden from the south. In this case, only tiles with
+        // x > tile.x can be hidden
+        double coefNorth = (static_cast<double>(tileDistance.getDiffY()) + 0.5) / (static_cast<double>(tileDistance.getDiffX()) - 0.5);
+        double coefSouth = (static_cast<double>(tileDistance.getDiffY()) - 0.5) / (static_cast<double>(tileDistance.getDiffX()) + 0.5);
+        for(uint32_t index = 0; index < mTileDistance.size(); ++index)
+        {
+            const TileDistance& tileDistance2 = mTileDistance[index];
+            tileDistance.computeTileDistances(coefNorth, coefSouth, tileDistance2, index);
+        }
+    }
+
+    mDistanceComputed = distance;
+}
+
+uint32_t ShadowTables::getNbEntries() const
+{
+    return static_cast<uint32_t>(mTileDistance.size());
+}
+
+uint32_t ShadowTables::getNbEntriesInRadius(int radius) const
+{
+    int radiusSquared = radius * radius;
+    uint32_t nbEntries = 0;
+    while((nbEntries < mTileDistance.size()) &&
+          (mTileDistance[nbEntries].getDistSquared() <= radiusSquared))
+    {
+        ++nbEntries;
+    }
+    return nbEntries;
+}
+
+int ShadowTables::getEntryDiffX(uint32_t entry) const
+{
+    return mTileDistance[entry].getDiffX();
+}
+
+int ShadowTables::getEntryDiffY(uint32_t entry) const
+{
+    return mTileDistance[entry].getDiffY();
+}
+
+ShadowTables::EntryType ShadowTables::getEntryType(uint32_t entry) const
+{
+    switch(mTileDistance[entry].getType())
+    {
+        case TileDistance::TileDistanceType::Horizontal:
+            return EntryType::Horizontal;
+        case TileDistance::TileDistanceType::Diagonal:
+            return EntryType::Diagonal;
+        case TileDistance::TileDistanceType::Other:
+        default:
+            return EntryType::Other;
+    }
+}
+
+int ShadowTables::getEntryDistSquared(uint32_t entry) const
+{
+    return mTileDistance[entry].getDistSquared();
+}
+
+const std::vector<std::pair<uint32_t, double>>& ShadowTables::getHiddenEntriesNorth(uint32_t entry) const
+{
+    return mTileDistance[entry].getHiddenTilesNorth();
+}
+
+const std::vector<std::pair<uint32_t, double>>& ShadowTables::getHiddenEntriesSouth(uint32_t entry) const
+{
+    return mTileDistance[entry].getHiddenTilesSouth();
+}
+
+static void flattenHiddenEntries(const std::vector<std::pair<uint32_t, double>>& hiddenEntries, uint32_t nbEntries,
+    std::vector<uint32_t>& start, std::vector<uint32_t>& entries, std::vector<double>& values)
+{
+    start.push_back(static_cast<uint32_t>(entries.size()));
+    for(const std::pair<uint32_t, double>& p : hiddenEntries)
+    {
+        // The shadow can reach entries farther than the radius
+        if(p.first >= nbEntries)
+            continue;
+
+        entries.push_back(p.first);
+        values.push_back(p.second);
+    }
+}
+
+const ShadowTables::RadiusTable& ShadowTables::getRadiusTable(int radius)
+{
+    if(radius >= static_cast<int>(mRadiusTables.size()))
+        mRadiusTables.resize(radius + 1);
+
+    std::unique_ptr<RadiusTable>& tablePtr = mRadiusTables[radius];
+    if(tablePtr)
+        return *tablePtr;
+
+    build(radius);
+    tablePtr.reset(new RadiusTable);
+    RadiusTable& table = *tablePtr;
+    uint32_t nbEntries = getNbEntriesInRadius(radius);
+    table.mNbEntries = nbEntries;
+
+    table.mOctantDiffX.resize(NB_OCTANTS * nbEntries);
+    table.mOctantDiffY.resize(NB_OCTANTS * nbEntries);
+    for(uint32_t k = 0; k < NB_OCTANTS; ++k)
+    {
+        for(uint32_t i = 0; i < nbEntries; ++i)
+        {
+            const TileDistance& tileDist = mTileDistance[i];
+            table.mOctantDiffX[k * nbEntries + i] = OCTANT_X_FROM_X[k] * tileDist.getDiffX() + OCTANT_X_FROM_Y[k] * tileDist.getDiffY();
+            table.mOctantDiffY[k * nbEntries + i] = OCTANT_Y_FROM_X[k] * tileDist.getDiffX() + OCTANT_Y_FROM_Y[k] * tileDist.getDiffY();
+        }
+    }
+
+    for(uint32_t i = 0; i < nbEntries; ++i)
+    {
+        const TileDistance& tileDist = mTileDistance[i];
+        flattenHiddenEntries(tileDist.getHiddenTilesNorth(), nbEntries, table.mHiddenNorthStart,
+            table.mHiddenNorthEntry, table.mHiddenNorthValue);
+        flattenHiddenEntries(tileDist.getHiddenTilesSouth(), nbEntries, table.mHiddenSouthStart,
+            table.mHiddenSouthEntry, table.mHiddenSouthValue);
+    }
+    table.mHiddenNorthStart.push_back(static_cast<uint32_t>(table.mHiddenNorthEntry.size()));
+    table.mHiddenSouthStart.push_back(static_cast<uint32_t>(table.mHiddenSouthEntry.size()));
+
+    for(uint32_t i = 0; i < nbEntries; ++i)
+    {
+        const TileDistance& tileDist = mTileDistance[i];
+        for(uint32_t k = 0; k < NB_OCTANTS; ++k)
+        {
+            // The center tile is common to every octant
+            if((k > 0) && (tileDist.getDistSquared() == 0))
+                continue;
+
+            // Horizontal tiles of an octant are the vertical tiles of the next one. Diagonal tiles are common
+            // to octants k and k + 4 and their shadows will be merged
+            if((k >= NB_OCTANTS / 2) && (tileDist.getType() != TileDistance::TileDistanceType::Other))
+                continue;
+
+            table.mOutputEntry.push_back(i);
+            table.mOutputOctant.push_back(static_cast<uint8_t>(k));
+        }
+    }
+
+    return table;
+}
+
+void ShadowTables::computeVisibleTiles(const OpacityGrid& grid, int x, int y, int radius, std::vector<uint32_t>& visibleTiles)
+{
+    visibleTiles.clear();
+    if(radius < 0)
+        return;
+
+    const RadiusTable& table = getRadiusTable(radius);
+    const uint32_t nbEntries = table.mNbEntries;
+    const int mapSizeX = grid.getMapSizeX();
+    const int mapSizeY = grid.getMapSizeY();
+
+    // If the whole square is within the map, we don't need to check the coordinates
+    const bool isInMap = (x - radius >= 0) && (y - radius >= 0) &&
+        (x + radius < mapSizeX) && (y + radius < mapSizeY);
+
+    // We compute for each entry which octants block vision (bit k for octant k). Tiles outside of the map
+    // do not block vision
+    mOpaqueOctants.assign(nbEntries, 0);
+    for(uint32_t k = 0; k < NB_OCTANTS; ++k)
+    {
+        const int32_t* diffX = table.mOctantDiffX.data() + k * nbEntries;
+        const int32_t* diffY = table.mOctantDiffY.data() + k * nbEntries;
+        const uint8_t octantBit = static_cast<uint8_t>(1 << k);
+        for(uint32_t i = 0; i < nbEntries; ++i)
+        {
+            int tileX = x + diffX[i];
+            int tileY = y + diffY[i];
+            if(!isInMap &&
+               ((tileX < 0) || (tileY < 0) || (tileX >= mapSizeX) || (tileY >= mapSizeY)))
+            {
+                continue;
+            }
+
+            if(grid.isOpaque(tileX, tileY))
+                mOpaqueOctants[i] |= octantBit;
+        }
+    }
+
+    // Each entry blocking vision in at least one octant applies its shadow. The hidden values of an entry are
+    // stored for the 8 octants next to each other and updated in the same loop (that the compiler can vectorize).
+    // We only keep the highest hidden value from north and from south
+    mHiddenNorth.assign(nbEntries * NB_OCTANTS, 0.0);
+    mHiddenSouth.assign(nbEntries * NB_OCTANTS, 0.0);
+    double octantFactors[NB_OCTANTS];
+    for(uint32_t i = 0; i < nbEntries; ++i)
+    {
+        uint8_t opaqueOctants = mOpaqueOctants[i];
+        if(opaqueOctants == 0)
+            continue;
+
+        for(uint32_t k = 0; k < NB_OCTANTS; ++k)
+            octantFactors[k] = ((opaqueOctants >> k) & 1) ? 1.0 : 0.0;
+
+        for(uint32_t j = table.mHiddenNorthStart[i]; j < table.mHiddenNorthStart[i + 1]; ++j)
+        {
+            double* hidden = mHiddenNorth.data() + table.mHiddenNorthEntry[j] * NB_OCTANTS;
+            const double value = table.mHiddenNorthValue[j];
+            for(uint32_t k = 0; k < NB_OCTANTS; ++k)
+                hidden[k] = std::max(hidden[k], octantFactors[k] * value);
+        }
+        for(uint32_t j = table.mHiddenSouthStart[i]; j < table.mHiddenSouthStart[i + 1]; ++j)
+        {
+            double* hidden = mHiddenSouth.data() + table.mHiddenSouthEntry[j] * NB_OCTANTS;
+            const double value = table.mHiddenSouthValue[j];
+            for(uint32_t k = 0; k < NB_OCTANTS; ++k)
+                hidden[k] = std::max(hidden[k], octantFactors[k] * value);
+        }
+    }
+
+    // Now, we check which tiles are visible
+    for(uint32_t index = 0; index < table.mOutputEntry.size(); ++index)
+    {
+        uint32_t i = table.mOutputEntry[index];
+        uint32_t k = table.mOutputOctant[index];
+        int tileX = x + table.mOctantDiffX[k * nbEntries + i];
+        int tileY = y + table.mOctantDiffY[k * nbEntries + i];
+        if(!isInMap &&
+           ((tileX < 0) || (tileY < 0) || (tileX >= mapSizeX) || (tileY >= mapSizeY)))
+        {
+            continue;
+        }
+
+        double hiddenNorth = mHiddenNorth[i * NB_OCTANTS + k];
+        double hiddenSouth = mHiddenSouth[i * NB_OCTANTS + k];
+        if(mTileDistance[i].getType() == TileDistance::TileDistanceType::Diagonal)
+        {
+            // Diagonal tiles are common to octants k and k + 4. Because they are inverted, south hidden
+            // value becomes north and vice-versa
+            hiddenNorth = std::max(hiddenNorth, mHiddenSouth[i * NB_OCTANTS + k + NB_OCTANTS / 2]);
+            hiddenSouth = std::max(hiddenSouth, mHiddenNorth[i * NB_OCTANTS + k + NB_OCTANTS / 2]);
+        }
+
+        if((hiddenNorth + hiddenSouth) > 0.5)
+            continue;
+
+        visibleTiles.push_back(static_cast<uint32_t>(tileX + tileY * mapSizeX));
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SHADOWTABLES_H
+#define SHADOWTABLES_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class TileDistance;
+
+//! \brief Packed bit grid of the tiles blocking vision. Tiles are indexed by x + y * mapSizeX
+class OpacityGrid
+{
+public:
+    OpacityGrid() :
+        mMapSizeX(0),
+        mMapSizeY(0)
+    {}
+
+    //! \brief Setups the grid for a map of the given size. Every tile permits vision
+    void resize(int mapSizeX, int mapSizeY)
+    {
+        mMapSizeX = mapSizeX;
+        mMapSizeY = mapSizeY;
+        mBits.assign((mMapSizeX * mMapSizeY + 63) / 64, 0);
+    }
+
+    void clear()
+    {
+        mMapSizeX = 0;
+        mMapSizeY = 0;
+        mBits.clear();
+    }
+
+    inline int getMapSizeX() const
+    { return mMapSizeX; }
+
+    inline int getMapSizeY() const
+    { return mMapSizeY; }
+
+    //! \brief The coordinates are not checked
+    inline void setOpaque(int x, int y, bool isOpaque)
+    {
+        uint32_t index = static_cast<uint32_t>(x + y * mMapSizeX);
+        uint64_t mask = static_cast<uint64_t>(1) << (index % 64);
+        if(isOpaque)
+            mBits[index / 64] |= mask;
+        else
+            mBits[index / 64] &= ~mask;
+    }
+
+    //! \brief The coordinates are not checked
+    inline bool isOpaque(int x, int y) const
+    {
+        uint32_t index = static_cast<uint32_t>(x + y * mMapSizeX);
+        return ((mBits[index / 64] >> (index % 64)) & 1) != 0;
+    }
+
+private:
+    int mMapSizeX;
+    int mMapSizeY;
+    std::vector<uint64_t> mBits;
+};
+
+/*! \brief Precomputed tables used to compute the tiles visible from a tile.
+ * Tiles around the center are described by their distance on 1/8 of the square (the other tiles are deduced
+ * by symmetry, see build). Each entry knows which entries it hides (and how much) when it blocks vision.
+ * For each sight radius used, these shadows are flattened in arrays (one per field) containing only the
+ * entries within the radius so that computeVisibleTiles only walks contiguous memory. The 8 octants are
+ * processed at the same time: the hidden values of an entry are stored together for the 8 octants.
+ */
+class ShadowTables
+{
+public:
+    enum class EntryType : uint8_t
+    {
+        Horizontal,
+        Diagonal,
+        Other
+    };
+
+    ShadowTables();
+    ~ShadowTables();
+
+    //! \brief Computes the entries up to the given distance if not already done
+    void build(int distance);
+
+    //! \brief Returns the number of entries computed (sorted from the closest to the furthest)
+    uint32_t getNbEntries() const;
+
+    //! \brief Returns the number of entries within the given radius. The entries must have been built
+    //! at least up to radius
+    uint32_t getNbEntriesInRadius(int radius) const;
+
+    int getEntryDiffX(uint32_t entry) const;
+    int getEntryDiffY(uint32_t entry) const;
+    EntryType getEntryType(uint32_t entry) const;
+    int getEntryDistSquared(uint32_t entry) const;
+
+    //! \brief Entries hidden by the given entry when it blocks vision with the hidden part of each of them.
+    //! Horizontal entries hide from the south. Others also hide from the north
+    const std::vector<std::pair<uint32_t, double>>& getHiddenEntriesNorth(uint32_t entry) const;
+    const std::vector<std::pair<uint32_t, double>>& getHiddenEntriesSouth(uint32_t entry) const;
+
+    /*! \brief Fills visibleTiles with the index (x + y * mapSizeX) of the tiles visible from (x, y) within radius
+     * depending on the given opacity grid. The tiles are ordered from the closest to the furthest. A tile is
+     * visible if at most half of it is hidden by the tiles blocking vision.
+     * The previous content of visibleTiles is removed but its memory is reused
+     */
+    void computeVisibleTiles(const OpacityGrid& grid, int x, int y, int radius, std::vector<uint32_t>& visibleTiles);
+
+private:
+    //! \brief Shadows of the entries within a radius
+    struct RadiusTable
+    {
+        uint32_t mNbEntries;
+
+        //! \brief Offset from the center of each entry for each octant (indexed by octant * mNbEntries + entry)
+        std::vector<int32_t> mOctantDiffX;
+        std::vector<int32_t> mOctantDiffY;
+
+        //! \brief Hidden entries of each entry. The entries hidden by entry i are in [mHiddenStart[i], mHiddenStart[i + 1][
+        std::vector<uint32_t> mHiddenNorthStart;
+        std::vector<uint32_t> mHiddenNorthEntry;
+        std::vector<double> mHiddenNorthValue;
+        std::vector<uint32_t> mHiddenSouthStart;
+        std::vector<uint32_t> mHiddenSouthEntry;
+        std::vector<double> mHiddenSouthValue;
+
+        //! \brief Entry and octant of each tile that can be visible in the order they should be returned. Horizontal
+        //! and diagonal entries are common to 2 octants and are only returned once
+        std::vector<uint32_t> mOutputEntry;
+        std::vector<uint8_t> mOutputOctant;
+    };
+
+    std::vector<TileDistance> mTileDistance;
+
+    //! \brief Highest distance computed
+    int mDistanceComputed;
+
+    //! \brief Tables by radius. They are built when first used
+    std::vector<std::unique_ptr<RadiusTable>> mRadiusTables;
+
+    //! \brief Memory reused by computeVisibleTiles
+    std::vector<uint8_t> mOpaqueOctants;
+    std::vector<double> mHiddenNorth;
+    std::vector<double> mHiddenSouth;
+
+    const RadiusTable& getRadiusTable(int radius);
+};
+
+#endif // SHADOWTABLES_H
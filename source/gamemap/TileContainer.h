@@ -18,12 +18,13 @@
 #ifndef TILECONTAINER_H
 #define TILECONTAINER_H
 
+#include "gamemap/ShadowTables.h"
+
 #include <cassert>
 #include <list>
 #include <vector>
 
 class ODPacket;
-class TileDistance;
 class Tile;
 
 enum class TileType;
@@ -94,9 +95,13 @@ public:
     std::list<Tile*> tilesBetween(int x1, int y1, int x2, int y2) const;
 
     //! \brief Returns the tiles visible from the given start tile within radius. The tiles are ordered from the closest to
-    //! the furthest
+    //! the furthest. Used on server side (see notifyTileOpacityChanged)
     std::vector<Tile*> visibleTiles(int x, int y, int radius);
 
+    //! \brief Should be called when something that may block vision changes on the given tile. The opacity
+    //! of the tile will be read again before the next visibility computation
+    void notifyTileOpacityChanged(const Tile& tile);
+
 protected:
     //! \brief The map size
     int mMapSizeX;
@@ -109,15 +114,20 @@ protected:
 private:
     Tile*** mTiles;
 
-    //! \brief Fills mTileDistance that will help to compute a vector with sorted Tiles more efficiently
-    void buildTileDistance(int distance);
+    //! \brief Helper to compute tile distances and visibility more efficiently
+    ShadowTables mShadowTables;
+
+    //! \brief Tiles blocking vision. Built when first needed and cleared when the map is allocated
+    OpacityGrid mOpacityGrid;
+
+    //! \brief Tiles (x + y * mMapSizeX) which opacity may have changed since mOpacityGrid was updated
+    std::vector<uint32_t> mOpacityDirtyTiles;
 
-    //! \brief Helper to compute tile distances more efficiently
-    std::vector<TileDistance> mTileDistance;
+    //! \brief Memory reused by visibleTiles
+    std::vector<uint32_t> mVisibleTileIndexes;
 
-    //! \brief Stores the highest distance computed. If a bigger distance is asked, mTileDistance will have to be updated by
-    //! calling buildTileDistance with the higher distance
-    int mTileDistanceComputed;
+    //! \brief Builds mOpacityGrid if needed or updates the tiles in mOpacityDirtyTiles
+    void updateOpacityGrid();
 };
 
 #endif //TILECONTAINER_H
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TILEREGION_H
+#define TILEREGION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+//! \brief Index computations on rectangular regions of tiles shared by TileContainer and the network code
+namespace TileRegion
+{
+    /*! \brief Orders the corners and clamps the rectangle (x1, y1) - (x2, y2) to the map. Returns false if
+     * the rectangle is outside of the map
+     */
+    inline bool clampToMap(int& x1, int& y1, int& x2, int& y2, int mapSizeX, int mapSizeY)
+    {
+        if(x1 > x2)
+            std::swap(x1, x2);
+        if(y1 > y2)
+            std::swap(y1, y2);
+        x1 = std::max(x1, 0);
+        y1 = std::max(y1, 0);
+        x2 = std::min(x2, mapSizeX - 1);
+        y2 = std::min(y2, mapSizeY - 1);
+        return (x1 <= x2) && (y1 <= y2);
+    }
+
+    /*! \brief Returns the index of the tile (x, y) in the tiles returned by TileContainer::rectangularRegion for
+     * the clamped rectangle (x1, y1) - (x2, y2). The tiles are ordered column by column
+     */
+    inline uint32_t getIndex(int x, int y, int x1, int y1, int y2)
+    {
+        int height = y2 - y1 + 1;
+        return static_cast<uint32_t>((x - x1) * height + (y - y1));
+    }
+
+    /*! \brief Returns the tiles of region and their neighbors without duplicates (see
+     * TileContainer::tilesBorderedByRegion). T should define getX(), getY() and getAllNeighbors().
+     * The tiles already added are flagged in a grid covering the bounding box of the region plus its border
+     * instead of the whole map
+     */
+    template <typename T>
+    std::vector<T*> getBorderedTiles(const std::vector<T*>& region)
+    {
+        std::vector<T*> returnList;
+        if(region.empty())
+            return returnList;
+
+        int xMin = region.front()->getX();
+        int xMax = xMin;
+        int yMin = region.front()->getY();
+        int yMax = yMin;
+        for(T* tile : region)
+        {
+            xMin = std::min(xMin, tile->getX());
+            xMax = std::max(xMax, tile->getX());
+            yMin = std::min(yMin, tile->getY());
+            yMax = std::max(yMax, tile->getY());
+        }
+        --xMin;
+        --yMin;
+        int width = xMax - xMin + 2;
+        int height = yMax - yMin + 2;
+        std::vector<uint8_t> isAdded(width * height, 0);
+
+        returnList.reserve(region.size() + 2 * (width + height));
+        for(T* t1 : region)
+        {
+            uint8_t& isTileAdded = isAdded[(t1->getX() - xMin) + (t1->getY() - yMin) * width];
+            if(isTileAdded == 0)
+            {
+                isTileAdded = 1;
+                returnList.push_back(t1);
+            }
+
+            // Get the tiles bordering the current tile and loop over them.
+            for(T* t2 : t1->getAllNeighbors())
+            {
+                uint8_t& isNeighborAdded = isAdded[(t2->getX() - xMin) + (t2->getY() - yMin) * width];
+                if(isNeighborAdded != 0)
+                    continue;
+
+                isNeighborAdded = 1;
+                returnList.push_back(t2);
+            }
+        }
+
+        return returnList;
+    }
+}
+
+#endif // TILEREGION_H
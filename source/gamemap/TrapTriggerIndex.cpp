@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/TrapTriggerIndex.h"
+
+#include "entities/GameEntity.h"
+#include "entities/GameEntityType.h"
+#include "entities/Tile.h"
+#include "gamemap/TileContainer.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+const uint32_t TrapTriggerIndex::NO_ZONE = static_cast<uint32_t>(-1);
+
+//! \brief Returns the number of creatures standing on the given tile
+static uint32_t countCreatures(const Tile& tile)
+{
+    uint32_t nbCreatures = 0;
+    for(GameEntity* entity : tile.getEntitiesInTile())
+    {
+        if(entity->getObjectType() == GameEntityType::creature)
+            ++nbCreatures;
+    }
+    return nbCreatures;
+}
+
+TrapTriggerIndex::TrapTriggerIndex() :
+    mMapSizeX(0),
+    mMapSizeY(0)
+{
+}
+
+void TrapTriggerIndex::clear()
+{
+    mMapSizeX = 0;
+    mMapSizeY = 0;
+    mZones.clear();
+    mFreeZones.clear();
+    mTileZones.clear();
+}
+
+void TrapTriggerIndex::build(const TileContainer& tiles)
+{
+    clear();
+    mMapSizeX = tiles.getMapSizeX();
+    mMapSizeY = tiles.getMapSizeY();
+    mTileZones.resize(mMapSizeX * mMapSizeY);
+}
+
+int TrapTriggerIndex::getTileIndex(const Tile& tile) const
+{
+    if((tile.getX() < 0) || (tile.getX() >= mMapSizeX) ||
+       (tile.getY() < 0) || (tile.getY() >= mMapSizeY))
+    {
+        return -1;
+    }
+
+    return tile.getX() + tile.getY() * mMapSizeX;
+}
+
+uint32_t TrapTriggerIndex::addZone(int trapX, int trapY, int visionRange, const std::vector<Tile*>& tiles)
+{
+    uint32_t zoneId;
+    if(mFreeZones.empty())
+    {
+        zoneId = static_cast<uint32_t>(mZones.size());
+        mZones.emplace_back();
+    }
+    else
+    {
+        zoneId = mFreeZones.back();
+        mFreeZones.pop_back();
+    }
+
+    Zone& zone = mZones[zoneId];
+    zone.mTrapX = trapX;
+    zone.mTrapY = trapY;
+    zone.mVisionRange = visionRange;
+    zone.mTiles = tiles;
+    registerZoneTiles(zoneId);
+    return zoneId;
+}
+
+void TrapTriggerIndex::updateZone(uint32_t zoneId, const std::vector<Tile*>& tiles)
+{
+    if(zoneId >= mZones.size())
+    {
+        OD_LOG_ERR("zoneId=" + Helper::toString(zoneId));
+        return;
+    }
+
+    unregisterZoneTiles(zoneId);
+    mZones[zoneId].mTiles = tiles;
+    registerZoneTiles(zoneId);
+}
+
+void TrapTriggerIndex::removeZone(uint32_t zoneId)
+{
+    if(zoneId >= mZones.size())
+    {
+        OD_LOG_ERR("zoneId=" + Helper::toString(zoneId));
+        return;
+    }
+
+    unregisterZoneTiles(zoneId);
+    Zone& zone = mZones[zoneId];
+    zone.mTiles.clear();
+    zone.mVisionRange = -1;
+    zone.mNbCreatures = 0;
+    zone.mIsDirty = false;
+    mFreeZones.push_back(zoneId);
+}
+
+void TrapTriggerIndex::registerZoneTiles(uint32_t zoneId)
+{
+    Zone& zone = mZones[zoneId];
+    zone.mNbCreatures = 0;
+    zone.mIsDirty = false;
+    for(Tile* tile : zone.mTiles)
+    {
+        int index = getTileIndex(*tile);
+        if(index < 0)
+            continue;
+
+        mTileZones[index].push_back(zoneId);
+        zone.mNbCreatures += countCreatures(*tile);
+    }
+}
+
+void TrapTriggerIndex::unregisterZoneTiles(uint32_t zoneId)
+{
+    for(Tile* tile : mZones[zoneId].mTiles)
+    {
+        int index = getTileIndex(*tile);
+        if(index < 0)
+            continue;
+
+        std::vector<uint32_t>& tileZones = mTileZones[index];
+        auto it = std::find(tileZones.begin(), tileZones.end(), zoneId);
+        if(it != tileZones.end())
+            tileZones.erase(it);
+    }
+}
+
+bool TrapTriggerIndex::isTriggered(uint32_t zoneId) const
+{
+    // If the index is not built, creatures are not followed
+    if(mTileZones.empty() || (zoneId >= mZones.size()))
+        return true;
+
+    const Zone& zone = mZones[zoneId];
+    return zone.mIsDirty || (zone.mNbCreatures > 0);
+}
+
+bool TrapTriggerIndex::isDirty(uint32_t zoneId) const
+{
+    if(zoneId >= mZones.size())
+        return true;
+
+    return mZones[zoneId].mIsDirty;
+}
+
+const std::vector<Tile*>& TrapTriggerIndex::getZoneTiles(uint32_t zoneId) const
+{
+    static const std::vector<Tile*> emptyZone;
+    if(zoneId >= mZones.size())
+    {
+        OD_LOG_ERR("zoneId=" + Helper::toString(zoneId));
+        return emptyZone;
+    }
+
+    return mZones[zoneId].mTiles;
+}
+
+void TrapTriggerIndex::notifyCreatureEntered(const Tile& tile)
+{
+    int index = getTileIndex(tile);
+    if(index < 0)
+        return;
+
+    for(uint32_t zoneId : mTileZones[index])
+        ++mZones[zoneId].mNbCreatures;
+}
+
+void TrapTriggerIndex::notifyCreatureLeft(const Tile& tile)
+{
+    int index = getTileIndex(tile);
+    if(index < 0)
+        return;
+
+    for(uint32_t zoneId : mTileZones[index])
+    {
+        Zone& zone = mZones[zoneId];
+        if(zone.mNbCreatures > 0)
+            --zone.mNbCreatures;
+    }
+}
+
+void TrapTriggerIndex::notifyTileChanged(const Tile& tile)
+{
+    // There are only a few armed trap tiles on a map so we check them all
+    for(Zone& zone : mZones)
+    {
+        if(zone.mIsDirty || (zone.mVisionRange < 0))
+            continue;
+
+        if(std::abs(zone.mTrapX - tile.getX()) > zone.mVisionRange)
+            continue;
+        if(std::abs(zone.mTrapY - tile.getY()) > zone.mVisionRange)
+            continue;
+
+        zone.mIsDirty = true;
+    }
+}
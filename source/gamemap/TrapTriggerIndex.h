@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRAPTRIGGERINDEX_H
+#define TRAPTRIGGERINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+class Tile;
+class TileContainer;
+
+/*! \brief Index of the trigger zones of the armed trap tiles. A trigger zone is the list of tiles where a
+ * creature can be targeted by the trap tile (for example, the tiles a cannon can see). Each map tile
+ * knows the zones containing it so that when a creature enters or leaves a tile, only the concerned
+ * zones are updated. A trap tile only has to be checked when its zone contains a creature.
+ * Zones depending on vision are marked dirty when a tile close enough from the trap changes (wall dug,
+ * building built or removed, door locked, ...). Dirty zones should be computed again by the trap
+ * before being used.
+ */
+class TrapTriggerIndex
+{
+public:
+    TrapTriggerIndex();
+
+    //! \brief Value used for trap tiles without zone
+    static const uint32_t NO_ZONE;
+
+    //! \brief Removes every zone from the index
+    void clear();
+
+    //! \brief Setups the index for the given container
+    void build(const TileContainer& tiles);
+
+    //! \brief Adds a zone for the trap tile at the given position and returns its id. visionRange is the
+    //! distance from the trap tile up to which a tile change can change the zone (-1 if it cannot)
+    uint32_t addZone(int trapX, int trapY, int visionRange, const std::vector<Tile*>& tiles);
+
+    //! \brief Replaces the tiles of the given zone and unmarks it as dirty
+    void updateZone(uint32_t zoneId, const std::vector<Tile*>& tiles);
+
+    void removeZone(uint32_t zoneId);
+
+    //! \brief Returns true if the trap tile should be checked: there is at least one creature within
+    //! its zone or the zone is dirty
+    bool isTriggered(uint32_t zoneId) const;
+
+    bool isDirty(uint32_t zoneId) const;
+
+    const std::vector<Tile*>& getZoneTiles(uint32_t zoneId) const;
+
+    uint32_t getNbZones() const
+    { return static_cast<uint32_t>(mZones.size() - mFreeZones.size()); }
+
+    //! \brief Should be called when a creature is added to/removed from the given tile
+    void notifyCreatureEntered(const Tile& tile);
+    void notifyCreatureLeft(const Tile& tile);
+
+    //! \brief Should be called when something that may block vision changes on the given tile
+    void notifyTileChanged(const Tile& tile);
+
+private:
+    struct Zone
+    {
+        int mTrapX;
+        int mTrapY;
+        int mVisionRange;
+        std::vector<Tile*> mTiles;
+        uint32_t mNbCreatures;
+        bool mIsDirty;
+    };
+
+    int mMapSizeX;
+    int mMapSizeY;
+
+    //! \brief Zones by id. Ids of removed zones are kept in mFreeZones to be reused
+    std::vector<Zone> mZones;
+    std::vector<uint32_t> mFreeZones;
+
+    //! \brief Ids of the zones containing each tile (indexed by x + y * mMapSizeX)
+    std::vector<std::vector<uint32_t>> mTileZones;
+
+    //! \brief Returns the index of the tile in mTileZones or -1 if it is not in the indexed map
+    int getTileIndex(const Tile& tile) const;
+
+    void registerZoneTiles(uint32_t zoneId);
+    void unregisterZoneTiles(uint32_t zoneId);
+};
+
+#endif // TRAPTRIGGERINDEX_H
@@ -30,7 +30,7 @@ GiftBoxSkill::GiftBoxSkill(GameMap* gameMap, const std::string& baseName, SkillT
     GiftBoxEntity(gameMap, baseName, "MysteryBox", GiftBoxType::skill),
     mSkillType(skillType)
 {
-    mPrevAnimationState = "Loop";
+    mPrevAnimationState = EntityAnimation::loop_anim;
     mPrevAnimationStateLoop = true;
 }
 
@@ -15,6 +15,7 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Profiler.h"
 
 #include <OgreCamera.h>
 #include <OgreSceneManager.h>
@@ -56,7 +57,8 @@ const std::string HELPMESSAGE =
         "\n\tcatmullspline - Triggers the catmullspline camera movement type."
         "\n\tcirclearound - Triggers the circle camera movement type."
         "\n\tsetcamerafovy - Sets the camera vertical field of view aspect ratio value."
-        "\n\tlogfloodfill - Displays the FloodFillValues of all the Tiles in the GameMap.";
+        "\n\tlogfloodfill - Displays the FloodFillValues of all the Tiles in the GameMap."
+        "\n\tprofiler - Displays the time spent per turn or writes a Chrome trace file.";
 
 //! \brief Template function to get/set a variable from the ODFrameListener object
 template<typename ValType, typename Getter, typename Setter>
@@ -444,6 +446,54 @@ Command::Result cListMeshAnims(const Command::ArgumentList_t& args, ConsoleInter
     return Command::Result::SUCCESS;
 }
 
+Command::Result cProfiler(const Command::ArgumentList_t& args, ConsoleInterface& c, AbstractModeManager&)
+{
+    if(args.size() < 2)
+    {
+        c.print("\nERROR : Need to specify stats, trace or clear");
+        return Command::Result::INVALID_ARGUMENT;
+    }
+
+#ifndef OD_ENABLE_PROFILER
+    c.print("\nWARNING : The game was compiled without OD_ENABLE_PROFILER. No sample will be recorded");
+#endif
+
+    if(args[1] == "stats")
+    {
+        std::string stats = Profiler::getTurnStats();
+        OD_LOG_INF(stats);
+        c.print("\n" + stats);
+        return Command::Result::SUCCESS;
+    }
+
+    if(args[1] == "trace")
+    {
+        if(args.size() < 3)
+        {
+            c.print("\nERROR : Need to specify the trace file name");
+            return Command::Result::INVALID_ARGUMENT;
+        }
+
+        if(!Profiler::writeChromeTrace(args[2]))
+        {
+            c.print("\nERROR : Could not write trace file " + args[2]);
+            return Command::Result::FAILED;
+        }
+
+        c.print("\nTrace written to " + args[2]);
+        return Command::Result::SUCCESS;
+    }
+
+    if(args[1] == "clear")
+    {
+        Profiler::clear();
+        return Command::Result::SUCCESS;
+    }
+
+    c.print("\nERROR : Unknown profiler option " + args[1]);
+    return Command::Result::INVALID_ARGUMENT;
+}
+
 Command::Result cSetLogLevel(const Command::ArgumentList_t& args, ConsoleInterface& c, AbstractModeManager&)
 {
     if(args.size() < 2)
@@ -677,6 +727,15 @@ void addConsoleCommands(ConsoleInterface& cl)
                    Command::cStubServer,
                    {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR},
                    {});
+    cl.addCommand("profiler",
+                   "'profiler' gives the time spent in the profiled parts of the game.\nExample:\n"
+                   "profiler stats => Displays, for each profiled scope, percentiles of the time spent per turn\n"
+                   "profiler trace trace.json => Writes the recorded samples in a Chrome trace_event file\n"
+                   "profiler clear => Removes every recorded sample",
+                   cProfiler,
+                   Command::cStubServer,
+                   {AbstractModeManager::ModeType::GAME, AbstractModeManager::ModeType::EDITOR},
+                   {});
     cl.addCommand("keys",
                    "list keys",
                    cKeys,
@@ -27,6 +27,7 @@
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
 #include "utils/LogManager.h"
+#include "gamemap/LevelInfoCache.h"
 #include "gamemap/MapHandler.h"
 #include "utils/ResourceManager.h"
 #include "utils/ConfigManager.h"
@@ -36,7 +37,9 @@
 #include <boost/filesystem.hpp>
 
 MenuModeEditorLoad::MenuModeEditorLoad(ModeManager* modeManager):
-    AbstractApplicationMode(modeManager, ModeManager::MENU_EDITOR_LOAD)
+    AbstractApplicationMode(modeManager, ModeManager::MENU_EDITOR_LOAD),
+    mLevelInfoRevision(0),
+    mIsLevelInfoPending(false)
 {
     CEGUI::Window* window = modeManager->getGui().getGuiSheet(Gui::guiSheet::editorLoadMenu);
 
@@ -144,6 +147,7 @@ bool MenuModeEditorLoad::updateFilesList(const CEGUI::EventArgs&)
     loadText->setText("");
     mFilesList.clear();
     mDescriptionList.clear();
+    mHasCustomMap.clear();
     levelSelectList->resetList();
 
     std::string levelPath;
@@ -183,42 +187,80 @@ bool MenuModeEditorLoad::updateFilesList(const CEGUI::EventArgs&)
                 officialFileList.clear();
         }
 
+        mDescriptionList.resize(mFilesList.size());
         for (uint32_t n = 0; n < mFilesList.size(); ++n)
         {
-            std::string filename = mFilesList[n];
-
-            LevelInfo levelInfo;
-            std::string mapName;
-            std::string mapDescription;
-            bool customMapExists = findFileStemIn(officialFileList, filename);
-            if(MapHandler::getMapInfo(filename, levelInfo))
-            {
-                mapName.clear();
-                if (customMapExists)
-                    mapName = "[image-size='w:16 h:16'][image='OpenDungeonsIcons/CogIcon'][vert-alignment='centre'] ";
-                mapName += levelInfo.mLevelName;
-                mapDescription = levelInfo.mLevelDescription;
-                if (customMapExists)
-                    mapDescription += "\n(A custom map exists for this level.)";
-            }
-            else
-            {
-                mapName = "invalid map";
-                mapDescription = "invalid map";
-            }
-
-            mDescriptionList.push_back(mapDescription);
-            CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(mapName);
+            mHasCustomMap.push_back(findFileStemIn(officialFileList, mFilesList[n]));
+            CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem("");
             item->setID(n);
             item->setSelectionBrushImage("OpenDungeonsSkin/SelectionBrush");
             levelSelectList->addItem(item);
         }
     }
 
+    refreshLevelInfos();
     updateDescription();
     return true;
 }
 
+void MenuModeEditorLoad::onFrameStarted(const Ogre::FrameEvent& evt)
+{
+    if(mIsLevelInfoPending && (mLevelInfoRevision != LevelInfoCache::getSingleton().getRevision()))
+        refreshLevelInfos();
+}
+
+void MenuModeEditorLoad::refreshLevelInfos()
+{
+    CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::editorLoadMenu);
+    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(window->getChild(Gui::EDM_LIST_LEVELS));
+
+    LevelInfoCache& levelInfoCache = LevelInfoCache::getSingleton();
+    mLevelInfoRevision = levelInfoCache.getRevision();
+    mIsLevelInfoPending = false;
+    for (size_t i = 0; i < levelSelectList->getItemCount(); ++i)
+    {
+        CEGUI::ListboxItem* item = levelSelectList->getListboxItemFromIndex(i);
+        uint32_t n = item->getID();
+        const std::string& filename = mFilesList[n];
+
+        LevelInfo levelInfo;
+        std::string mapName;
+        std::string mapDescription;
+        bool customMapExists = mHasCustomMap[n];
+        LevelInfoCache::Status status = levelInfoCache.getLevelInfo(filename, levelInfo);
+        if(status != LevelInfoCache::Status::invalid)
+        {
+            // Until the level is read, we show what we know about it
+            if(status == LevelInfoCache::Status::pending)
+            {
+                mIsLevelInfoPending = true;
+                if(levelInfo.mLevelName.empty())
+                    levelInfo.mLevelName = boost::filesystem::path(filename).stem().string();
+                levelInfo.mLevelDescription = "Reading level...";
+            }
+
+            if (customMapExists)
+                mapName = "[image-size='w:16 h:16'][image='OpenDungeonsIcons/CogIcon'][vert-alignment='centre'] ";
+            mapName += levelInfo.mLevelName;
+            mapDescription = levelInfo.mLevelDescription;
+            if (customMapExists)
+                mapDescription += "\n(A custom map exists for this level.)";
+        }
+        else
+        {
+            mapName = "invalid map";
+            mapDescription = "invalid map";
+        }
+
+        mDescriptionList[n] = mapDescription;
+        item->setText(mapName);
+        if(item->isSelected())
+            window->getChild("LevelWindowFrame/MapDescriptionText")->setText(
+                reinterpret_cast<const CEGUI::utf8*>(mapDescription.c_str()));
+    }
+    levelSelectList->handleUpdatedItemData();
+}
+
 bool MenuModeEditorLoad::launchSelectedButtonPressed(const CEGUI::EventArgs&)
 {
     CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::editorLoadMenu);
@@ -32,9 +32,22 @@ public:
     bool launchSelectedButtonPressed(const CEGUI::EventArgs&);
     bool updateDescription(const CEGUI::EventArgs& e = {});
 
+    void onFrameStarted(const Ogre::FrameEvent& evt) override;
+
 private:
     std::vector<std::string> mFilesList;
     std::vector<std::string> mDescriptionList;
+    //! \brief True for the official levels that have a custom version
+    std::vector<bool> mHasCustomMap;
+
+    //! \brief Revision of the LevelInfoCache when the level list was last refreshed
+    uint32_t mLevelInfoRevision;
+
+    //! \brief True if some listed levels are still being read by the LevelInfoCache
+    bool mIsLevelInfoPending;
+
+    //! \brief Sets the name and the description of the listed levels from the LevelInfoCache
+    void refreshLevelInfos();
 
     //! \brief Update the level list according to the level type chosen.
     bool updateFilesList(const CEGUI::EventArgs& e = {});
@@ -28,6 +28,7 @@
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
 #include "utils/LogManager.h"
+#include "gamemap/LevelInfoCache.h"
 #include "gamemap/MapHandler.h"
 #include "utils/ConfigManager.h"
 #include "utils/ResourceManager.h"
@@ -38,7 +39,9 @@
 const std::string SAVEGAME_EXTENSION = ".level";
 
 MenuModeLoad::MenuModeLoad(ModeManager *modeManager):
-    AbstractApplicationMode(modeManager, ModeManager::MENU_LOAD_SAVEDGAME)
+    AbstractApplicationMode(modeManager, ModeManager::MENU_LOAD_SAVEDGAME),
+    mLevelInfoRevision(0),
+    mIsLevelInfoPending(false)
 {
     CEGUI::Window* window = modeManager->getGui().getGuiSheet(Gui::guiSheet::loadSavedGameMenu);
     addEventConnection(
@@ -107,8 +110,13 @@ void MenuModeLoad::activate()
     std::string levelPath = ResourceManager::getSingleton().getSaveGamePath();
     if(Helper::fillFilesList(levelPath, mFilesList, SAVEGAME_EXTENSION))
     {
+        // The savegames are queued in the LevelInfoCache so that their descriptions are ready when selected
+        LevelInfoCache& levelInfoCache = LevelInfoCache::getSingleton();
         for (uint32_t n = 0; n < mFilesList.size(); ++n)
         {
+            LevelInfo levelInfo;
+            levelInfoCache.getLevelInfo(mFilesList[n], levelInfo);
+
             std::string filename = boost::filesystem::path(mFilesList[n]).filename().string();
             CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(filename);
             item->setID(n);
@@ -214,19 +222,50 @@ bool MenuModeLoad::updateDescription(const CEGUI::EventArgs&)
 
     getModeManager().getGui().playButtonClickSound();
 
+    refreshDescription();
+    return true;
+}
+
+void MenuModeLoad::onFrameStarted(const Ogre::FrameEvent& evt)
+{
+    if(mIsLevelInfoPending && (mLevelInfoRevision != LevelInfoCache::getSingleton().getRevision()))
+        refreshDescription();
+}
+
+void MenuModeLoad::refreshDescription()
+{
+    CEGUI::Window* tmpWin = getModeManager().getGui().getGuiSheet(Gui::loadSavedGameMenu)->getChild("LevelWindowFrame/SaveGameSelect");
+    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(tmpWin);
+
+    CEGUI::Window* descTxt = getModeManager().getGui().getGuiSheet(Gui::loadSavedGameMenu)->getChild("LevelWindowFrame/MapDescriptionText");
+
+    mIsLevelInfoPending = false;
     CEGUI::ListboxItem* selItem = levelSelectList->getFirstSelectedItem();
+    if(selItem == nullptr)
+        return;
+
     int id = selItem->getID();
 
     std::string filename = mFilesList[id];
 
     LevelInfo levelInfo;
     std::string mapDescription;
-    if(MapHandler::getMapInfo(filename, levelInfo))
-        mapDescription = levelInfo.mLevelDescription;
-    else
-        mapDescription = "invalid map";
+    LevelInfoCache& levelInfoCache = LevelInfoCache::getSingleton();
+    mLevelInfoRevision = levelInfoCache.getRevision();
+    switch(levelInfoCache.getLevelInfo(filename, levelInfo))
+    {
+        case LevelInfoCache::Status::upToDate:
+            mapDescription = levelInfo.mLevelDescription;
+            break;
+        case LevelInfoCache::Status::pending:
+            mIsLevelInfoPending = true;
+            mapDescription = "Reading level...";
+            break;
+        case LevelInfoCache::Status::invalid:
+        default:
+            mapDescription = "invalid map";
+            break;
+    }
 
     descTxt->setText(mapDescription);
-
-    return true;
 }
@@ -33,8 +33,19 @@ public:
     bool deleteSelectedButtonPressed(const CEGUI::EventArgs&);
     bool updateDescription(const CEGUI::EventArgs&);
 
+    void onFrameStarted(const Ogre::FrameEvent& evt) override;
+
 private:
     std::vector<std::string> mFilesList;
+
+    //! \brief Revision of the LevelInfoCache when the description was last refreshed
+    uint32_t mLevelInfoRevision;
+
+    //! \brief True if the selected savegame is still being read by the LevelInfoCache
+    bool mIsLevelInfoPending;
+
+    //! \brief Sets the description of the selected savegame from the LevelInfoCache
+    void refreshDescription();
 };
 
 #endif // MENUMODELOAD_H
@@ -171,6 +171,15 @@ void MenuModeMasterServerJoin::onFrameStarted(const Ogre::FrameEvent& evt)
     mTimeSinceLastUpdateList += evt.timeSinceLastFrame;
     if(mTimeSinceLastUpdateList >= PERIOD_REFRESH_LIST)
         refreshList();
+
+    // Shows the progress of the map loading
+    ODClient& client = ODClient::getSingleton();
+    if(client.isConnected() && client.isLoadingMap())
+    {
+        CEGUI::Window* mainWin = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiMasterServerJoinMenu);
+        mainWin->getChild("LoadingText")->setText("Loading map... "
+            + Helper::toString(client.getMapLoadingPercent()) + "%");
+    }
 }
 
 bool MenuModeMasterServerJoin::clientButtonPressed(const CEGUI::EventArgs&)
@@ -129,3 +129,14 @@ bool MenuModeMultiplayerClient::clientButtonPressed(const CEGUI::EventArgs&)
     infoText->setText("Loading...");
     return true;
 }
+
+void MenuModeMultiplayerClient::onFrameStarted(const Ogre::FrameEvent& evt)
+{
+    ODClient& client = ODClient::getSingleton();
+    if(!client.isConnected() || !client.isLoadingMap())
+        return;
+
+    CEGUI::Window* mainWin = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiplayerClientMenu);
+    mainWin->getChild(Gui::MPM_TEXT_LOADING)->setText("Loading map... "
+        + Helper::toString(client.getMapLoadingPercent()) + "%");
+}
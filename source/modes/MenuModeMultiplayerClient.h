@@ -30,6 +30,9 @@ public:
     void activate() final override;
 
     bool clientButtonPressed(const CEGUI::EventArgs&);
+
+    //! \brief Shows the progress of the map loading
+    void onFrameStarted(const Ogre::FrameEvent& evt) override;
 };
 
 #endif // MENUMODEMULTIPLAYERCLIENT_H
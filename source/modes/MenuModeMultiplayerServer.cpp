@@ -27,6 +27,7 @@
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
 #include "utils/LogManager.h"
+#include "gamemap/LevelInfoCache.h"
 #include "gamemap/MapHandler.h"
 #include "utils/ConfigManager.h"
 #include "utils/ResourceManager.h"
@@ -38,7 +39,9 @@
 const std::string MPM_LIST_LEVEL_TYPES = "LevelWindowFrame/LevelTypeSelect";
 
 MenuModeMultiplayerServer::MenuModeMultiplayerServer(ModeManager *modeManager, bool useMasterServer):
-    AbstractApplicationMode(modeManager, useMasterServer ? ModeManager::MENU_MASTERSERVER_HOST : ModeManager::MENU_MULTIPLAYER_SERVER)
+    AbstractApplicationMode(modeManager, useMasterServer ? ModeManager::MENU_MASTERSERVER_HOST : ModeManager::MENU_MULTIPLAYER_SERVER),
+    mLevelInfoRevision(0),
+    mIsLevelInfoPending(false)
 {
     CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiplayerServerMenu);
 
@@ -158,36 +161,72 @@ bool MenuModeMultiplayerServer::updateFilesList(const CEGUI::EventArgs&)
 
     if(Helper::fillFilesList(levelPath, mFilesList, MapHandler::LEVEL_EXTENSION))
     {
+        mDescriptionList.resize(mFilesList.size());
         for (uint32_t n = 0; n < mFilesList.size(); ++n)
         {
-            std::string filename = mFilesList[n];
-
-            LevelInfo levelInfo;
-            std::string mapName;
-            std::string mapDescription;
-            if(MapHandler::getMapInfo(filename, levelInfo))
-            {
-                mapName = levelInfo.mLevelName;
-                mapDescription = levelInfo.mLevelDescription;
-            }
-            else
-            {
-                mapName = "invalid map";
-                mapDescription = "invalid map";
-            }
-
-            mDescriptionList.push_back(mapDescription);
-            CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(mapName);
+            CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem("");
             item->setID(n);
             item->setSelectionBrushImage("OpenDungeonsSkin/SelectionBrush");
             levelSelectList->addItem(item);
         }
     }
 
+    refreshLevelInfos();
     updateDescription();
     return true;
 }
 
+void MenuModeMultiplayerServer::onFrameStarted(const Ogre::FrameEvent& evt)
+{
+    if(mIsLevelInfoPending && (mLevelInfoRevision != LevelInfoCache::getSingleton().getRevision()))
+        refreshLevelInfos();
+}
+
+void MenuModeMultiplayerServer::refreshLevelInfos()
+{
+    CEGUI::Window* window = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiplayerServerMenu);
+    CEGUI::Listbox* levelSelectList = static_cast<CEGUI::Listbox*>(window->getChild(Gui::MPM_LIST_LEVELS));
+
+    LevelInfoCache& levelInfoCache = LevelInfoCache::getSingleton();
+    mLevelInfoRevision = levelInfoCache.getRevision();
+    mIsLevelInfoPending = false;
+    for (size_t i = 0; i < levelSelectList->getItemCount(); ++i)
+    {
+        CEGUI::ListboxItem* item = levelSelectList->getListboxItemFromIndex(i);
+        uint32_t n = item->getID();
+        const std::string& filename = mFilesList[n];
+
+        LevelInfo levelInfo;
+        std::string mapName;
+        std::string mapDescription;
+        switch(levelInfoCache.getLevelInfo(filename, levelInfo))
+        {
+            case LevelInfoCache::Status::upToDate:
+                mapName = levelInfo.mLevelName;
+                mapDescription = levelInfo.mLevelDescription;
+                break;
+            case LevelInfoCache::Status::pending:
+                // Until the level is read, we show what we know about it
+                mIsLevelInfoPending = true;
+                mapName = levelInfo.mLevelName.empty() ? boost::filesystem::path(filename).stem().string() : levelInfo.mLevelName;
+                mapDescription = "Reading level...";
+                break;
+            case LevelInfoCache::Status::invalid:
+            default:
+                mapName = "invalid map";
+                mapDescription = "invalid map";
+                break;
+        }
+
+        mDescriptionList[n] = mapDescription;
+        item->setText(mapName);
+        if(item->isSelected())
+            window->getChild("LevelWindowFrame/MapDescriptionText")->setText(
+                reinterpret_cast<const CEGUI::utf8*>(mapDescription.c_str()));
+    }
+    levelSelectList->handleUpdatedItemData();
+}
+
 bool MenuModeMultiplayerServer::serverButtonPressed(const CEGUI::EventArgs&)
 {
     CEGUI::Window* mainWin = getModeManager().getGui().getGuiSheet(Gui::guiSheet::multiplayerServerMenu);
@@ -33,6 +33,8 @@ std::string ClientNotification::typeString(ClientNotificationType type)
             return "hello";
         case ClientNotificationType::levelOK:
             return "levelOK";
+        case ClientNotificationType::mapChunkReceived:
+            return "mapChunkReceived";
         case ClientNotificationType::setNick:
             return "setNick";
         case ClientNotificationType::chat:
@@ -63,6 +65,8 @@ std::string ClientNotification::typeString(ClientNotificationType type)
             return "editorAskDestroyTrapTiles";
         case ClientNotificationType::ackNewTurn:
             return "ackNewTurn";
+        case ClientNotificationType::stateHashMismatch:
+            return "stateHashMismatch";
         case ClientNotificationType::askCreatureInfos:
             return "askCreatureInfos";
         case ClientNotificationType::askPickupWorker:
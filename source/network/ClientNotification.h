@@ -25,6 +25,7 @@ enum class ClientNotificationType
     // Communication with server
     hello,
     levelOK, // Tells the server the level loading was ok.
+    mapChunkReceived, // Tells the server how many map chunks were read so that the next ones can be sent
     setNick,
     readyForSeatConfiguration,
     // Messages that should be sent only by the client side of the server
@@ -43,6 +44,7 @@ enum class ClientNotificationType
     askBuildTrap,
     askSellTrapTiles,
     ackNewTurn,
+    stateHashMismatch, // Hashes of the tiles of the chunks that do not match the server ones (see StateHash)
     askCreatureInfos,
     askPickupWorker,
     askPickupFighter,
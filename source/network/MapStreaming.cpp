@@ -0,0 +1,237 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "network/MapStreaming.h"
+
+#include "entities/Tile.h"
+#include "gamemap/GameMap.h"
+#include "network/ODPacket.h"
+#include "rooms/Room.h"
+#include "rooms/RoomType.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+//! \brief Tile types that are not sent (dirt, claimed, water, lava, ...)
+const uint8_t UNSENT_TILE = 0;
+
+uint32_t getNbChunksX(int32_t mapSizeX)
+{
+    return static_cast<uint32_t>((mapSizeX + MapStreaming::CHUNK_SIZE - 1) / MapStreaming::CHUNK_SIZE);
+}
+
+uint8_t getStreamedType(const Tile* tile)
+{
+    switch(tile->getType())
+    {
+        case TileType::gold:
+        case TileType::rock:
+        case TileType::gem:
+            return static_cast<uint8_t>(tile->getType());
+        default:
+            return UNSENT_TILE;
+    }
+}
+
+//! \brief Calls func for each tile of the given chunk, in the order they are streamed
+template<typename Func>
+void forEachChunkTile(const GameMap& gameMap, uint32_t chunk, Func func)
+{
+    uint32_t nbChunksX = getNbChunksX(gameMap.getMapSizeX());
+    int32_t xMin = static_cast<int32_t>(chunk % nbChunksX) * MapStreaming::CHUNK_SIZE;
+    int32_t yMin = static_cast<int32_t>(chunk / nbChunksX) * MapStreaming::CHUNK_SIZE;
+    int32_t xMax = std::min(xMin + MapStreaming::CHUNK_SIZE, gameMap.getMapSizeX());
+    int32_t yMax = std::min(yMin + MapStreaming::CHUNK_SIZE, gameMap.getMapSizeY());
+    for(int32_t yy = yMin; yy < yMax; ++yy)
+    {
+        for(int32_t xx = xMin; xx < xMax; ++xx)
+            func(gameMap.getTile(xx, yy));
+    }
+}
+}
+
+namespace MapStreaming
+{
+uint32_t getNbChunks(int32_t mapSizeX, int32_t mapSizeY)
+{
+    return getNbChunksX(mapSizeX) * getNbChunksX(mapSizeY);
+}
+
+std::vector<uint32_t> getChunkOrder(GameMap& gameMap)
+{
+    // If the level has no temple, we start from the center of the map
+    std::vector<std::pair<int32_t, int32_t>> origins;
+    for(Room* temple : gameMap.getRoomsByType(RoomType::dungeonTemple))
+    {
+        Tile* tile = temple->getCentralTile();
+        if(tile != nullptr)
+            origins.push_back(std::make_pair(tile->getX(), tile->getY()));
+    }
+    if(origins.empty())
+        origins.push_back(std::make_pair(gameMap.getMapSizeX() / 2, gameMap.getMapSizeY() / 2));
+
+    uint32_t nbChunksX = getNbChunksX(gameMap.getMapSizeX());
+    uint32_t nbChunks = getNbChunks(gameMap.getMapSizeX(), gameMap.getMapSizeY());
+    std::vector<std::pair<int64_t, uint32_t>> chunkDistances;
+    chunkDistances.reserve(nbChunks);
+    for(uint32_t chunk = 0; chunk < nbChunks; ++chunk)
+    {
+        int32_t centerX = static_cast<int32_t>(chunk % nbChunksX) * CHUNK_SIZE + CHUNK_SIZE / 2;
+        int32_t centerY = static_cast<int32_t>(chunk / nbChunksX) * CHUNK_SIZE + CHUNK_SIZE / 2;
+        int64_t minDist = std::numeric_limits<int64_t>::max();
+        for(const std::pair<int32_t, int32_t>& origin : origins)
+        {
+            int64_t dx = centerX - origin.first;
+            int64_t dy = centerY - origin.second;
+            minDist = std::min(minDist, dx * dx + dy * dy);
+        }
+        chunkDistances.push_back(std::make_pair(minDist, chunk));
+    }
+
+    std::sort(chunkDistances.begin(), chunkDistances.end());
+    std::vector<uint32_t> order;
+    order.reserve(nbChunks);
+    for(const std::pair<int64_t, uint32_t>& chunkDistance : chunkDistances)
+        order.push_back(chunkDistance.second);
+
+    return order;
+}
+
+void getChunkTiles(const GameMap& gameMap, uint32_t chunk, std::vector<Tile*>& tiles)
+{
+    tiles.clear();
+    forEachChunkTile(gameMap, chunk, [&tiles](Tile* tile)
+    {
+        tiles.push_back(tile);
+    });
+}
+
+void computeChunkHashes(const GameMap& gameMap, const StateHash::TileHashFunction& tileHash,
+    std::vector<uint64_t>& chunkHashes)
+{
+    uint32_t nbChunks = getNbChunks(gameMap.getMapSizeX(), gameMap.getMapSizeY());
+    chunkHashes.clear();
+    chunkHashes.reserve(nbChunks);
+    std::vector<uint64_t> tileHashes;
+    for(uint32_t chunk = 0; chunk < nbChunks; ++chunk)
+    {
+        getChunkTileHashes(gameMap, chunk, tileHash, tileHashes);
+        chunkHashes.push_back(StateHash::computeChunkHash(tileHashes));
+    }
+}
+
+void getChunkTileHashes(const GameMap& gameMap, uint32_t chunk, const StateHash::TileHashFunction& tileHash,
+    std::vector<uint64_t>& tileHashes)
+{
+    tileHashes.clear();
+    forEachChunkTile(gameMap, chunk, [&tileHashes, &tileHash](Tile* tile)
+    {
+        tileHashes.push_back(tileHash(*tile));
+    });
+}
+
+void chunkToPacket(ODPacket& packet, const GameMap& gameMap, uint32_t chunk)
+{
+    // The runs are stored as (type, length). A chunk has at most CHUNK_SIZE * CHUNK_SIZE tiles
+    std::vector<std::pair<uint8_t, uint16_t>> runs;
+    forEachChunkTile(gameMap, chunk, [&runs](const Tile* tile)
+    {
+        uint8_t type = getStreamedType(tile);
+        if(!runs.empty() && (runs.back().first == type))
+            ++runs.back().second;
+        else
+            runs.push_back(std::make_pair(type, static_cast<uint16_t>(1)));
+    });
+
+    uint32_t nbRuns = runs.size();
+    packet << chunk << nbRuns;
+    for(const std::pair<uint8_t, uint16_t>& run : runs)
+        packet << run.first << run.second;
+}
+
+bool chunkFromPacket(ODPacket& packet, GameMap& gameMap)
+{
+    uint32_t chunk;
+    uint32_t nbRuns;
+    if(!(packet >> chunk >> nbRuns))
+        return false;
+
+    if(chunk >= getNbChunks(gameMap.getMapSizeX(), gameMap.getMapSizeY()))
+    {
+        OD_LOG_ERR("Invalid chunk=" + Helper::toString(chunk));
+        return false;
+    }
+
+    std::vector<uint8_t> types;
+    types.reserve(CHUNK_SIZE * CHUNK_SIZE);
+    for(uint32_t i = 0; i < nbRuns; ++i)
+    {
+        uint8_t type;
+        uint16_t length;
+        if(!(packet >> type >> length))
+            return false;
+
+        types.insert(types.end(), length, type);
+        if(types.size() > static_cast<size_t>(CHUNK_SIZE * CHUNK_SIZE))
+        {
+            OD_LOG_ERR("Too many tiles in chunk=" + Helper::toString(chunk));
+            return false;
+        }
+    }
+
+    uint32_t index = 0;
+    bool isValid = true;
+    forEachChunkTile(gameMap, chunk, [&types, &index, &isValid](Tile* tile)
+    {
+        if(index >= types.size())
+        {
+            isValid = false;
+            return;
+        }
+
+        switch(static_cast<TileType>(types[index++]))
+        {
+            case TileType::gold:
+                tile->setType(TileType::gold);
+                tile->setTileVisual(TileVisual::goldFull);
+                break;
+            case TileType::rock:
+                tile->setType(TileType::rock);
+                tile->setTileVisual(TileVisual::rockFull);
+                break;
+            case TileType::gem:
+                tile->setType(TileType::gem);
+                tile->setTileVisual(TileVisual::gemFull);
+                break;
+            default:
+                break;
+        }
+    });
+
+    if(!isValid || (index != types.size()))
+    {
+        OD_LOG_ERR("Invalid tiles in chunk=" + Helper::toString(chunk));
+        return false;
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPSTREAMING_H
+#define MAPSTREAMING_H
+
+#include "network/StateHash.h"
+
+#include <cstdint>
+#include <vector>
+
+class GameMap;
+class ODPacket;
+class Tile;
+
+/*! \brief Transfer of the level tiles to a joining client. The map is split in square chunks that are
+ * sent one by one (loadLevelTiles) after the loadLevel message. Each chunk is run-length encoded because
+ * most of the tiles of a level are dirt. The chunks near the dungeon temples are sent first.
+ * The client acknowledges the chunks it read once per frame (mapChunkReceived with the number of chunks)
+ * and the server only keeps a limited number of chunks in flight so that a slow client does not block
+ * the server thread on a huge packet.
+ */
+namespace MapStreaming
+{
+    //! \brief Size of the side of a chunk, in tiles
+    const int32_t CHUNK_SIZE = 16;
+
+    //! \brief Number of chunks sent to a client before waiting for its acknowledgements. Since the client
+    //! acknowledges the chunks once per frame, this is roughly the number of chunks loaded per frame
+    const uint32_t NB_CHUNKS_IN_FLIGHT = 32;
+
+    uint32_t getNbChunks(int32_t mapSizeX, int32_t mapSizeY);
+
+    //! \brief Returns the chunks of the given map in the order they should be sent: the chunks
+    //! nearest to a dungeon temple first
+    std::vector<uint32_t> getChunkOrder(GameMap& gameMap);
+
+    //! \brief Returns the tiles of the given chunk, in the order they are streamed
+    void getChunkTiles(const GameMap& gameMap, uint32_t chunk, std::vector<Tile*>& tiles);
+
+    //! \brief Computes the hash of each chunk of the map from the hashes of its tiles (see StateHash)
+    void computeChunkHashes(const GameMap& gameMap, const StateHash::TileHashFunction& tileHash,
+        std::vector<uint64_t>& chunkHashes);
+
+    //! \brief Returns the hashes of the tiles of the given chunk in the order they are streamed
+    void getChunkTileHashes(const GameMap& gameMap, uint32_t chunk, const StateHash::TileHashFunction& tileHash,
+        std::vector<uint64_t>& tileHashes);
+
+    //! \brief Writes the tiles of the given chunk in the packet. Only the gold, rock and gem tiles are
+    //! sent. The other tiles are dirt until the client receives them in refreshTiles
+    void chunkToPacket(ODPacket& packet, const GameMap& gameMap, uint32_t chunk);
+
+    //! \brief Reads a chunk written by chunkToPacket and sets the type and visual of its tiles.
+    //! Returns false if the packet is invalid
+    bool chunkFromPacket(ODPacket& packet, GameMap& gameMap);
+}
+
+#endif // MAPSTREAMING_H
@@ -19,6 +19,7 @@
 
 #include "entities/Creature.h"
 #include "entities/CreatureDefinition.h"
+#include "entities/CreatureStats.h"
 #include "entities/EntityLoading.h"
 #include "entities/GameEntityType.h"
 #include "entities/MapLight.h"
@@ -34,9 +35,11 @@
 #include "modes/MenuModeConfigureSeats.h"
 #include "modes/ModeManager.h"
 #include "network/ChatEventMessage.h"
+#include "network/MapStreaming.h"
 #include "network/ODPacket.h"
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
+#include "network/StateHash.h"
 #include "render/ODFrameListener.h"
 #include "render/RenderManager.h"
 #include "sound/MusicPlayer.h"
@@ -45,6 +48,7 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Symbol.h"
 #include "ODApplication.h"
 
 #include <boost/lexical_cast.hpp>
@@ -55,7 +59,10 @@ template<> ODClient* Ogre::Singleton<ODClient>::msSingleton = nullptr;
 
 ODClient::ODClient() :
     ODSocketClient(),
-    mIsPlayerConfig(false)
+    mIsPlayerConfig(false),
+    mNbMapChunks(0),
+    mNbMapChunksReceived(0),
+    mNbMapChunksToAcknowledge(0)
 {
 }
 
@@ -147,34 +154,32 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                 gameMap->addWeapon(def);
             }
 
-            // Tiles
-            // Gold
-            OD_ASSERT_TRUE(packetReceived >> nb);
-            while(nb > 0)
-            {
-                --nb;
-                Tile* tile = gameMap->tileFromPacket(packetReceived);
-                tile->setType(TileType::gold);
-                tile->setTileVisual(TileVisual::goldFull);
-            }
-            // Rock
-            OD_ASSERT_TRUE(packetReceived >> nb);
-            while(nb > 0)
-            {
-                --nb;
-                Tile* tile = gameMap->tileFromPacket(packetReceived);
-                tile->setType(TileType::rock);
-                tile->setTileVisual(TileVisual::rockFull);
-            }
-            // Gem
-            OD_ASSERT_TRUE(packetReceived >> nb);
-            while(nb > 0)
+            // Tiles are received in chunks (loadLevelTiles)
+            OD_ASSERT_TRUE(packetReceived >> mNbMapChunks);
+            mNbMapChunksReceived = 0;
+            mNbMapChunksToAcknowledge = 0;
+            break;
+        }
+
+        case ServerNotificationType::loadLevelTiles:
+        {
+            if(!isLoadingMap())
             {
-                --nb;
-                Tile* tile = gameMap->tileFromPacket(packetReceived);
-                tile->setType(TileType::gem);
-                tile->setTileVisual(TileVisual::gemFull);
+                OD_LOG_ERR("Unexpected map chunk");
+                return false;
             }
+
+            if(!MapStreaming::chunkFromPacket(packetReceived, *gameMap))
+                return false;
+
+            ++mNbMapChunksReceived;
+            ++mNbMapChunksToAcknowledge;
+            // The chunks are acknowledged in processClientNotifications once every received message is processed
+            if(isLoadingMap())
+                break;
+
+            // The server expects every chunk to be acknowledged before levelOK
+            acknowledgeMapChunks();
             gameMap->setAllFullnessAndNeighbors();
 
             ODPacket packSend;
@@ -183,6 +188,20 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
             break;
         }
 
+        case ServerNotificationType::addSymbols:
+        {
+            uint32_t firstId;
+            uint32_t nbNames;
+            OD_ASSERT_TRUE(packetReceived >> firstId >> nbNames);
+            for(uint32_t i = 0; i < nbNames; ++i)
+            {
+                std::string name;
+                OD_ASSERT_TRUE(packetReceived >> name);
+                Symbol::setServerSymbol(firstId + i, name);
+            }
+            break;
+        }
+
         case ServerNotificationType::pickNick:
         {
             ServerMode serverMode;
@@ -279,7 +298,9 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::clientAccepted:
         {
             int32_t nbPlayers;
-            OD_ASSERT_TRUE(packetReceived >> ODApplication::turnsPerSecond);
+            uint64_t matchSeed;
+            OD_ASSERT_TRUE(packetReceived >> ODApplication::turnsPerSecond >> matchSeed);
+            gameMap->setMatchSeed(matchSeed);
 
             OD_ASSERT_TRUE(packetReceived >> nbPlayers);
             for(int i = 0; i < nbPlayers; ++i)
@@ -474,8 +495,8 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::animatedObjectSetWalkPath:
         {
             std::string objName;
-            std::string walkAnim;
-            std::string endAnim;
+            Symbol walkAnim;
+            Symbol endAnim;
             bool loopEndAnim;
             bool playIdleWhenAnimationEnds;
             uint32_t nbDest;
@@ -553,7 +574,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::setObjectAnimationState:
         {
             std::string objName;
-            std::string animState;
+            Symbol animState;
             bool loop;
             bool playIdleWhenAnimationEnds;
             bool shouldSetWalkDirection;
@@ -562,7 +583,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
             MovableGameEntity *obj = gameMap->getAnimatedObject(objName);
             if (obj == nullptr)
             {
-                OD_LOG_ERR("objName=" + objName + ", state=" + animState);
+                OD_LOG_ERR("objName=" + objName + ", state=" + animState.getName());
                 break;
             }
 
@@ -655,11 +676,11 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::playSpatialSound:
         {
-            std::string family;
+            Symbol family;
             int xPos;
             int yPos;
             OD_ASSERT_TRUE(packetReceived >> family >> xPos >> yPos);
-            SoundEffectsManager::getSingleton().playSpatialSound(family, xPos, yPos);
+            SoundEffectsManager::getSingleton().playSpatialSound(family.getName(), xPos, yPos);
             break;
         }
 
@@ -674,8 +695,9 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::notifyCreatureInfo:
         {
             std::string name;
-            std::string infos;
-            OD_ASSERT_TRUE(packetReceived >> name >> infos);
+            CreatureStats stats;
+            OD_ASSERT_TRUE(packetReceived >> name);
+            OD_ASSERT_TRUE(stats.importFromPacket(packetReceived));
             Creature* creature = gameMap->getCreature(name);
             if(creature == nullptr)
             {
@@ -683,7 +705,7 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                 break;
             }
 
-            creature->updateStatsWindow(infos);
+            creature->updateStatsWindow(stats.getStatsText());
             break;
         }
 
@@ -804,6 +826,91 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
             break;
         }
 
+        case ServerNotificationType::refreshTilesRegion:
+        {
+            int32_t x1, y1, x2, y2;
+            uint32_t nbRuns;
+            OD_ASSERT_TRUE(packetReceived >> x1 >> y1 >> x2 >> y2 >> nbRuns);
+            std::vector<Tile*> region = gameMap->rectangularRegion(x1, y1, x2, y2);
+            std::vector<Tile*> tiles;
+            uint32_t index = 0;
+            while(nbRuns > 0)
+            {
+                --nbRuns;
+                uint32_t nbTiles;
+                bool isChanged;
+                OD_ASSERT_TRUE(packetReceived >> nbTiles >> isChanged);
+                if(index + nbTiles > region.size())
+                {
+                    OD_LOG_ERR("index=" + Helper::toString(index) + ", nbTiles=" + Helper::toString(nbTiles)
+                        + ", regionSize=" + Helper::toString(region.size()));
+                    break;
+                }
+
+                if(isChanged)
+                {
+                    // The state is sent once for the run
+                    Tile* firstTile = region[index];
+                    firstTile->updateFromPacket(packetReceived);
+                    tiles.push_back(firstTile);
+                    for(uint32_t i = 1; i < nbTiles; ++i)
+                    {
+                        Tile* tile = region[index + i];
+                        tile->copyStateFrom(*firstTile);
+                        tiles.push_back(tile);
+                    }
+                }
+                index += nbTiles;
+            }
+            gameMap->refreshBorderingTilesOf(tiles);
+            break;
+        }
+
+        case ServerNotificationType::stateHashes:
+        {
+            int64_t turn;
+            uint32_t nbChunks;
+            OD_ASSERT_TRUE(packetReceived >> turn >> nbChunks);
+            std::vector<uint64_t> chunkHashes;
+            StateHash::TileHashFunction tileHash = [](const Tile& tile)
+            {
+                return tile.getStateHash();
+            };
+            MapStreaming::computeChunkHashes(*gameMap, tileHash, chunkHashes);
+            if(nbChunks != chunkHashes.size())
+            {
+                OD_LOG_ERR("nbChunks=" + Helper::toString(nbChunks) + ", expected=" + Helper::toString(chunkHashes.size()));
+                break;
+            }
+
+            std::vector<uint64_t> serverChunkHashes(nbChunks);
+            for(uint64_t& serverHash : serverChunkHashes)
+                OD_ASSERT_TRUE(packetReceived >> serverHash);
+
+            std::vector<uint32_t> wrongChunks;
+            StateHash::findWrongChunks(serverChunkHashes, chunkHashes, wrongChunks);
+            if(wrongChunks.empty())
+                break;
+
+            // We send the hashes of the tiles of the wrong chunks so that the server can resend the wrong tiles
+            OD_LOG_WRN("Desync detected at turn=" + Helper::toString(turn) + " in nbChunks="
+                + Helper::toString(wrongChunks.size()));
+            ODPacket packSend;
+            uint32_t nbWrongChunks = wrongChunks.size();
+            packSend << ClientNotificationType::stateHashMismatch << turn << nbWrongChunks;
+            std::vector<uint64_t> tileHashes;
+            for(uint32_t chunk : wrongChunks)
+            {
+                MapStreaming::getChunkTileHashes(*gameMap, chunk, tileHash, tileHashes);
+                uint32_t nbTiles = tileHashes.size();
+                packSend << chunk << nbTiles;
+                for(uint64_t hash : tileHashes)
+                    packSend << hash;
+            }
+            send(packSend);
+            break;
+        }
+
         case ServerNotificationType::markTiles:
         {
             bool digSet;
@@ -961,6 +1068,8 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
 void ODClient::processClientNotifications()
 {
+    acknowledgeMapChunks();
+
     while (isConnected())
     {
         // Wait until a message is place in the queue
@@ -986,6 +1095,20 @@ void ODClient::processClientNotifications()
     }
 }
 
+void ODClient::acknowledgeMapChunks()
+{
+    if(mNbMapChunksToAcknowledge == 0)
+        return;
+
+    if(isConnected())
+    {
+        ODPacket packSend;
+        packSend << ClientNotificationType::mapChunkReceived << mNbMapChunksToAcknowledge;
+        send(packSend);
+    }
+    mNbMapChunksToAcknowledge = 0;
+}
+
 void ODClient::addEventMessage(EventMessage* event)
 {
     ODFrameListener* frameListener = ODFrameListener::getSingletonPtr();
@@ -1027,6 +1150,7 @@ bool ODClient::connect(const std::string& host, const int port, uint32_t timeout
         return false;
     }
 
+    Symbol::clearServerSymbols();
     if(!ODSocketClient::connect(host, port, timeout, outputReplayFilename))
         return false;
 
@@ -1049,6 +1173,7 @@ bool ODClient::replay(const std::string& filename)
         return false;
     }
 
+    Symbol::clearServerSymbols();
     if(!ODSocketClient::replay(filename))
         return false;
 
@@ -1063,6 +1188,7 @@ void ODClient::queueClientNotification(ClientNotification* n)
 void ODClient::disconnect(bool keepReplay)
 {
     ODSocketClient::disconnect(keepReplay);
+    Symbol::clearServerSymbols();
     while(!mClientNotificationQueue.empty())
     {
         delete mClientNotificationQueue.front();
@@ -1070,6 +1196,9 @@ void ODClient::disconnect(bool keepReplay)
     }
 
     mIsPlayerConfig = false;
+    mNbMapChunks = 0;
+    mNbMapChunksReceived = 0;
+    mNbMapChunksToAcknowledge = 0;
 }
 
 void ODClient::notifyExit()
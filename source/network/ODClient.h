@@ -85,6 +85,14 @@ class ODClient: public Ogre::Singleton<ODClient>,
     inline bool getIsPlayerConfig() const
     { return mIsPlayerConfig; }
 
+    //! \brief Returns true while the tiles of the level are being received from the server
+    inline bool isLoadingMap() const
+    { return mNbMapChunksReceived < mNbMapChunks; }
+
+    //! \brief Percentage of the tiles of the level received from the server
+    inline uint32_t getMapLoadingPercent() const
+    { return (mNbMapChunks == 0) ? 100 : (100 * mNbMapChunksReceived) / mNbMapChunks; }
+
  protected:
     bool processMessage(ServerNotificationType cmd, ODPacket& packetReceived) override;
     void playerDisconnected() override;
@@ -96,6 +104,9 @@ class ODClient: public Ogre::Singleton<ODClient>,
     //! \brief Refreshes the player's goals + main data
     void refreshMainUI(const std::string& goalsString);
 
+    //! \brief Tells the server how many map chunks were read since the last acknowledgement
+    void acknowledgeMapChunks();
+
     std::string mTmpReceivedString;
     std::string mLevelFilename;
 
@@ -104,6 +115,12 @@ class ODClient: public Ogre::Singleton<ODClient>,
     // true if the server told us we are allowed to configure the game. False otherwise
     bool mIsPlayerConfig;
 
+    //! \brief Number of map chunks of the level being loaded and number of chunks received (see MapStreaming)
+    uint32_t mNbMapChunks;
+    uint32_t mNbMapChunksReceived;
+    //! \brief Chunks received but not acknowledged yet. They are acknowledged together once per frame
+    uint32_t mNbMapChunksToAcknowledge;
+
 };
 
 template<typename ...Args>
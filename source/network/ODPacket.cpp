@@ -243,6 +243,11 @@ void ODPacket::clear()
     mPacket.clear();
 }
 
+std::size_t ODPacket::getDataSize() const
+{
+    return mPacket.getDataSize();
+}
+
 void ODPacket::writePacket(int32_t timestamp, std::ofstream& os)
 {
     int32_t bufferSize = mPacket.getDataSize();
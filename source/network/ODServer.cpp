@@ -29,12 +29,18 @@
 #include "game/SkillManager.h"
 #include "game/SkillType.h"
 #include "game/Seat.h"
+#include "gamemap/BinaryLevel.h"
 #include "gamemap/GameMap.h"
 #include "gamemap/MapHandler.h"
+#include "gamemap/TileRegion.h"
 #include "modes/ConsoleCommands.h"
+#include "network/MapStreaming.h"
 #include "network/ODClient.h"
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
+#include "network/StateHash.h"
+#include "network/TileRuns.h"
+#include "rooms/Room.h"
 #include "rooms/RoomManager.h"
 #include "rooms/RoomType.h"
 #include "spells/SpellManager.h"
@@ -46,7 +52,12 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MasterServer.h"
+#include "utils/ObjectPool.h"
+#include "utils/Profiler.h"
+#include "utils/Random.h"
 #include "utils/ResourceManager.h"
+#include "utils/Symbol.h"
+#include "utils/TurnArena.h"
 #include "ODApplication.h"
 
 #include <SFML/Network.hpp>
@@ -57,14 +68,23 @@
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <ctime>
+
 
 const std::string SAVEGAME_SKIRMISH_PREFIX = "SK-";
 const std::string SAVEGAME_MULTIPLAYER_PREFIX = "MP-";
+const std::string SAVEGAME_AUTOSAVE_PREFIX = "autosave-";
 static const double MASTER_SERVER_UPDATE_PERIOD_MS = 30000.0;
 static const int32_t MASTER_SERVER_STATUS_PENDING = 0;
 static const int32_t MASTER_SERVER_STATUS_STARTED = 1;
 static const int32_t MASTER_SERVER_STATUS_FINISHED = 2;
 
+//! \brief Sends the allocation counters of the pools and arenas to the profiler
+static void reportAllocationCounter(const char* name, uint64_t value)
+{
+    OD_PROFILE_COUNTER(name, value);
+}
+
 template<> ODServer* Ogre::Singleton<ODServer>::msSingleton = nullptr;
 
 ODServer::ODServer() :
@@ -123,6 +143,11 @@ bool ODServer::startServer(const std::string& creator, const std::string& levelF
         return false;
     }
 
+    // Every random stream used during the match is derived from the match seed
+    Random::initialize(static_cast<uint64_t>(std::time(nullptr)));
+    gameMap->setMatchSeed(Random::getMatchSeed());
+    OD_LOG_INF("Match seed=" + Helper::toString(gameMap->getMatchSeed()));
+
     // Set up the socket to listen on the specified port
     int32_t port = getNetworkPort();
     if (!createServer(port))
@@ -253,7 +278,7 @@ void ODServer::sendMsg(Player* player, ODPacket& packet)
     {
         // If player is nullptr, we send the message to every connected player
         for (ODSocketClient* client : mSockClients)
-            client->send(packet);
+            sendToClient(client, packet);
 
         return;
     }
@@ -270,7 +295,28 @@ void ODServer::sendMsg(Player* player, ODPacket& packet)
     }
 
     if(client != nullptr)
-        client->send(packet);
+        sendToClient(client, packet);
+}
+
+void ODServer::sendToClient(ODSocketClient* client, ODPacket& packet)
+{
+    uint32_t nbSymbols = Symbol::getNbSymbols();
+    if(client->getNbSymbolsSent() < nbSymbols)
+    {
+        std::vector<std::string> names;
+        Symbol::getNames(client->getNbSymbolsSent(), names);
+        ODPacket packetSymbols;
+        uint32_t firstId = client->getNbSymbolsSent();
+        uint32_t nbNames = static_cast<uint32_t>(names.size());
+        packetSymbols << ServerNotificationType::addSymbols << firstId << nbNames;
+        for(const std::string& name : names)
+            packetSymbols << name;
+
+        client->send(packetSymbols);
+        client->setNbSymbolsSent(firstId + nbNames);
+    }
+
+    client->send(packet);
 }
 
 void ODServer::handleConsoleCommand(Player* player, GameMap* gameMap, const std::vector<std::string>& args)
@@ -303,6 +349,7 @@ void ODServer::handleConsoleCommand(Player* player, GameMap* gameMap, const std:
 
 void ODServer::startNewTurn(double timeSinceLastTurn)
 {
+    OD_PROFILE_SCOPE("ODServer::startNewTurn");
     GameMap* gameMap = mGameMap;
     int64_t turn = gameMap->getTurnNumber();
 
@@ -314,7 +361,12 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
             return;
     }
 
+    // The allocation counters are reported for the turn that just ended
+    ObjectPool::reportTurnCounts(reportAllocationCounter);
+    TurnArena::reportTurnCounts(reportAllocationCounter);
+
     gameMap->setTurnNumber(++turn);
+    OD_PROFILE_TURN(turn);
 
     ServerNotification* serverNotification = new ServerNotification(
         ServerNotificationType::turnStarted, nullptr);
@@ -339,31 +391,12 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
         seat->exportToPacketForUpdate(serverNotification->mPacket);
         serverNotification->mPacket << goals;
         ODServer::getSingleton().queueServerNotification(serverNotification);
-
-        // Here, the creature list is pulled. It could be possible that the creature dies before the stat window is
-        // closed. So, if we cannot find the creature, we just erase it.
-        std::vector<std::string>& creatures = mCreaturesInfoWanted[sock];
-        std::vector<std::string>::iterator itCreatures = creatures.begin();
-        while(itCreatures != creatures.end())
-        {
-            std::string& name = *itCreatures;
-            Creature* creature = gameMap->getCreature(name);
-            if(creature == nullptr)
-                itCreatures = creatures.erase(itCreatures);
-            else
-            {
-                std::string creatureInfos = creature->getStatsText();
-
-                ServerNotification *serverNotification = new ServerNotification(
-                    ServerNotificationType::notifyCreatureInfo, player);
-                serverNotification->mPacket << name << creatureInfos;
-                ODServer::getSingleton().queueServerNotification(serverNotification);
-
-                ++itCreatures;
-            }
-        }
     }
 
+    // The creatures having their stats window opened send them if they changed
+    for(Creature* creature : gameMap->getCreatures())
+        creature->notifyStatsWatchers();
+
     gameMap->updateVisibleEntities();
     switch(mServerMode)
     {
@@ -388,6 +421,196 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
 
     gameMap->fireRefreshEntities();
     gameMap->processDeletionQueues();
+
+    // From time to time, the clients check that their tiles match what we sent them
+    if((turn % StateHash::NB_TURNS_BETWEEN_CHECKS) == 0)
+        queueStateHashes();
+
+    // Autosave is done at the end of the turn so that the captured gamemap is consistent. If the previous
+    // autosave is still being written, we skip this one
+    uint32_t nbTurnsAutosave = ConfigManager::getSingleton().getNbTurnsAutosave();
+    if((mServerMode != ServerMode::ModeEditor) &&
+       (nbTurnsAutosave > 0) &&
+       (gameMap->getTurnNumber() > 0) &&
+       ((gameMap->getTurnNumber() % nbTurnsAutosave) == 0) &&
+       !mSaveGameWriter.isSaving())
+    {
+        const boost::filesystem::path levelPath(gameMap->getLevelFileName());
+        std::string fileName = ResourceManager::getSingleton().getSaveGamePath() + SAVEGAME_AUTOSAVE_PREFIX
+            + getSaveGameLevelName(levelPath.filename().string());
+        queueSave(fileName, SaveGameWriter::Format::binary, true);
+    }
+}
+
+void ODServer::queueStateHashes()
+{
+    OD_PROFILE_SCOPE("ODServer::queueStateHashes");
+    GameMap* gameMap = mGameMap;
+    std::vector<uint64_t> chunkHashes;
+    for(Seat* seat : gameMap->getSeats())
+    {
+        if(seat->getPlayer() == nullptr)
+            continue;
+        if(!seat->getPlayer()->getIsHuman())
+            continue;
+
+        MapStreaming::computeChunkHashes(*gameMap, [seat](const Tile& tile)
+        {
+            return seat->getTileStateHashSent(&tile);
+        }, chunkHashes);
+
+        ServerNotification* serverNotification = new ServerNotification(
+            ServerNotificationType::stateHashes, seat->getPlayer());
+        uint32_t nbChunks = chunkHashes.size();
+        serverNotification->mPacket << gameMap->getTurnNumber() << nbChunks;
+        for(uint64_t hash : chunkHashes)
+            serverNotification->mPacket << hash;
+
+        queueServerNotification(serverNotification);
+    }
+}
+
+void ODServer::sendTilesRegion(int x1, int y1, int x2, int y2, const std::vector<Tile*>& changedTiles)
+{
+    OD_PROFILE_SCOPE("ODServer::sendTilesRegion");
+    GameMap* gameMap = mGameMap;
+    if(!TileRegion::clampToMap(x1, y1, x2, y2, gameMap->getMapSizeX(), gameMap->getMapSizeY()))
+        return;
+
+    std::vector<Tile*> region = gameMap->rectangularRegion(x1, y1, x2, y2);
+    std::vector<uint8_t> isChanged(region.size(), 0);
+    for(Tile* tile : changedTiles)
+        isChanged[TileRegion::getIndex(tile->getX(), tile->getY(), x1, y1, y2)] = 1;
+
+    std::vector<TileRuns::Run> runs;
+    for(Seat* seat : gameMap->getSeats())
+    {
+        if(seat->getPlayer() == nullptr)
+            continue;
+        if(!seat->getPlayer()->getIsHuman())
+            continue;
+
+        // The key of a changed tile is the hash of the state the player will receive. Only the first tile
+        // of a run is exported but the state is notified for every tile. Tiles with particle effects are
+        // sent alone as the effects are not copied to the other tiles of the run
+        TileRuns::buildRuns(static_cast<uint32_t>(region.size()), [&isChanged](uint32_t index)
+        {
+            return isChanged[index] != 0;
+        }, [&region, seat](uint32_t index)
+        {
+            Tile* tile = region[index];
+            seat->updateTileStateForSeat(tile, false);
+            tile->changeNotifiedForSeat(seat);
+            return seat->notifyTileStateSent(tile, false);
+        }, [&region](uint32_t index)
+        {
+            return region[index]->getEntityParticleEffects().empty();
+        }, runs);
+
+        ServerNotification notif(ServerNotificationType::refreshTilesRegion, seat->getPlayer());
+        uint32_t nbRuns = runs.size();
+        notif.mPacket << x1 << y1 << x2 << y2 << nbRuns;
+        for(const TileRuns::Run& run : runs)
+        {
+            bool isRunChanged = (run.mFirstIndex != TileRuns::UNCHANGED);
+            notif.mPacket << run.mNbTiles << isRunChanged;
+            if(isRunChanged)
+                region[run.mFirstIndex]->exportToPacketForUpdate(notif.mPacket, seat);
+        }
+        sendAsyncMsg(notif);
+    }
+}
+
+void ODServer::queueSave(const std::string& fileName, SaveGameWriter::Format format, bool isAutosave)
+{
+    std::unique_ptr<BinaryLevel::LevelSnapshot> snapshot(new BinaryLevel::LevelSnapshot);
+    MapHandler::captureGameMap(*mGameMap, *snapshot);
+    mSaveGameWriter.queueSave(std::move(snapshot), fileName, format, isAutosave);
+}
+
+void ODServer::processFinishedSaves()
+{
+    for(const SaveGameWriter::Result& result : mSaveGameWriter.popFinishedSaves())
+    {
+        // Successful autosaves are only logged to not spam the chat
+        if(result.mIsAutosave && result.mIsSuccess)
+            continue;
+
+        std::string msg;
+        if(result.mIsSuccess)
+            msg = "Map saved successfully as: " + result.mFileName;
+        else if(result.mIsAutosave)
+            msg = "Couldn't autosave the game as: " + result.mFileName + "\nPlease check logs.";
+        else
+            msg = "Couldn't not save map file as: " + result.mFileName + "\nPlease check logs.";
+
+        // We notify all the players
+        ServerNotification notif(ServerNotificationType::chatServer, nullptr);
+        notif.mPacket << msg << EventShortNoticeType::genericGameInfo;
+        sendAsyncMsg(notif);
+    }
+}
+
+std::string ODServer::getSaveGameLevelName(const std::string& fileLevel) const
+{
+    std::ostringstream ss;
+    switch(mServerMode)
+    {
+        case ServerMode::ModeGameSinglePlayer:
+            ss << SAVEGAME_SKIRMISH_PREFIX;
+            ss << fileLevel;
+            break;
+        case ServerMode::ModeGameMultiPlayer:
+            ss << SAVEGAME_MULTIPLAYER_PREFIX;
+            ss << fileLevel;
+            break;
+        case ServerMode::ModeGameLoaded:
+        {
+            // We look for the Skirmish or multiplayer prefix and keep it.
+            size_t indexSk = fileLevel.find(SAVEGAME_SKIRMISH_PREFIX);
+            size_t indexMp = fileLevel.find(SAVEGAME_MULTIPLAYER_PREFIX);
+            if((indexSk != std::string::npos) && (indexMp == std::string::npos))
+            {
+                // Skirmish savegame
+                ss << SAVEGAME_SKIRMISH_PREFIX;
+                ss << fileLevel.substr(indexSk + SAVEGAME_SKIRMISH_PREFIX.length());
+
+            }
+            else if((indexSk == std::string::npos) && (indexMp != std::string::npos))
+            {
+                // Multiplayer savegame
+                ss << SAVEGAME_MULTIPLAYER_PREFIX;
+                ss << fileLevel.substr(indexMp + SAVEGAME_MULTIPLAYER_PREFIX.length());
+            }
+            else if((indexSk != std::string::npos) && (indexMp != std::string::npos))
+            {
+                // We found both prefixes. That can happen if the name contains the other
+                // prefix. Because of filename construction, we know that the lowest is the good
+                if(indexSk < indexMp)
+                {
+                    ss << SAVEGAME_SKIRMISH_PREFIX;
+                    ss << fileLevel.substr(indexSk + SAVEGAME_SKIRMISH_PREFIX.length());
+                }
+                else
+                {
+                    ss << SAVEGAME_MULTIPLAYER_PREFIX;
+                    ss << fileLevel.substr(indexMp + SAVEGAME_MULTIPLAYER_PREFIX.length());
+                }
+            }
+            else
+            {
+                // We couldn't find any prefix. That's not normal
+                OD_LOG_ERR("fileLevel=" + fileLevel);
+                ss << fileLevel;
+            }
+            break;
+        }
+        default:
+            OD_LOG_ERR("mode=" + Helper::toString(static_cast<int>(mServerMode)));
+            ss << fileLevel;
+            break;
+    }
+    return ss.str();
 }
 
 void ODServer::serverThread()
@@ -513,6 +736,8 @@ void ODServer::serverThread()
         startNewTurn(static_cast<double>(clock.restart().asSeconds()) * 0.95);
 
         processServerNotifications();
+
+        processFinishedSaves();
     }
 
     if(!mMasterServerGameId.empty())
@@ -524,6 +749,7 @@ void ODServer::serverThread()
 
 void ODServer::processServerNotifications()
 {
+    OD_PROFILE_SCOPE("ODServer::processServerNotifications");
     GameMap* gameMap = mGameMap;
 
     bool running = true;
@@ -639,7 +865,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             mPlayerConfig = otherHumanConnected->getPlayer();
             ODPacket packetSend;
             packetSend << ServerNotificationType::playerConfigChange;
-            otherHumanConnected->send(packetSend);
+            sendToClient(otherHumanConnected, packetSend);
 
             OD_LOG_INF("Changing game host to " + mPlayerConfig->getNick());
         }
@@ -711,55 +937,39 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 packet << def;
             }
 
-            // Tiles
-            std::vector<Tile*> goldTiles;
-            std::vector<Tile*> rockTiles;
-            std::vector<Tile*> gemTiles;
-            for (int xxx = 0; xxx < mapSizeX; ++xxx)
-            {
-                for (int yyy = 0; yyy < mapSizeY; ++yyy)
-                {
-                    Tile* tile = gameMap->getTile(xxx,yyy);
-                    switch(tile->getType())
-                    {
-                        case TileType::gold:
-                            goldTiles.push_back(tile);
-                            break;
-                        case TileType::rock:
-                            rockTiles.push_back(tile);
-                            break;
-                        case TileType::gem:
-                            gemTiles.push_back(tile);
-                            break;
-                        default:
-                            // Per default, tiles are dirt and don't need to be notified
-                            break;
-                    }
-                }
-            }
+            // Tiles are streamed in chunks after this message
+            uint32_t nbChunks = MapStreaming::getNbChunks(mapSizeX, mapSizeY);
+            packet << nbChunks;
+            sendToClient(clientSocket, packet);
 
-            nb = goldTiles.size();
-            packet << nb;
-            for(Tile* tile : goldTiles)
-            {
-                gameMap->tileToPacket(packet, tile);
-            }
+            MapTransfer& transfer = mMapTransfers[clientSocket];
+            transfer.mChunkOrder = MapStreaming::getChunkOrder(*gameMap);
+            transfer.mNbChunksSent = 0;
+            transfer.mNbChunksAcknowledged = 0;
+            sendMapChunks(clientSocket);
+            break;
+        }
 
-            nb = rockTiles.size();
-            packet << nb;
-            for(Tile* tile : rockTiles)
-            {
-                gameMap->tileToPacket(packet, tile);
-            }
+        case ClientNotificationType::mapChunkReceived:
+        {
+            if(std::string("loadLevel").compare(clientSocket->getState()) != 0)
+                return false;
 
-            nb = gemTiles.size();
-            packet << nb;
-            for(Tile* tile : gemTiles)
+            auto it = mMapTransfers.find(clientSocket);
+            if(it == mMapTransfers.end())
+                return false;
+
+            uint32_t nbChunks;
+            OD_ASSERT_TRUE(packetReceived >> nbChunks);
+            MapTransfer& transfer = it->second;
+            if((nbChunks == 0) || (nbChunks > transfer.mNbChunksSent - transfer.mNbChunksAcknowledged))
             {
-                gameMap->tileToPacket(packet, tile);
+                OD_LOG_ERR("Unexpected map chunk acknowledgement nbChunks=" + Helper::toString(nbChunks));
+                return false;
             }
 
-            clientSocket->send(packet);
+            transfer.mNbChunksAcknowledged += nbChunks;
+            sendMapChunks(clientSocket);
             break;
         }
 
@@ -768,11 +978,21 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             if(std::string("loadLevel").compare(clientSocket->getState()) != 0)
                 return false;
 
+            // The client should have received the whole map
+            auto it = mMapTransfers.find(clientSocket);
+            if((it == mMapTransfers.end()) ||
+               (it->second.mNbChunksAcknowledged != it->second.mChunkOrder.size()))
+            {
+                OD_LOG_ERR("Client sent levelOK before receiving the whole map");
+                return false;
+            }
+            mMapTransfers.erase(it);
+
             clientSocket->setState("nick");
             // Tell the client to give us their nickname
             ODPacket packetSend;
             packetSend << ServerNotificationType::pickNick << mServerMode;
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
             break;
         }
 
@@ -814,7 +1034,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 mPlayerConfig = curPlayer;
                 ODPacket packetSend;
                 packetSend << ServerNotificationType::playerConfigChange;
-                clientSocket->send(packetSend);
+                sendToClient(clientSocket, packetSend);
             }
 
             Seat* seat = seats[0];
@@ -822,7 +1042,8 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             //This makes sure the player is deleted on exit.
             gameMap->addPlayer(curPlayer);
             ODPacket packetSend;
-            packetSend << ServerNotificationType::clientAccepted << ODApplication::turnsPerSecond;
+            packetSend << ServerNotificationType::clientAccepted << ODApplication::turnsPerSecond
+                << gameMap->getMatchSeed();
             int32_t nbPlayers = 1;
             packetSend << nbPlayers;
             const std::string& nick = clientSocket->getPlayer()->getNick();
@@ -831,11 +1052,11 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             int32_t teamId = 0;
             seat->setMapSize(gameMap->getMapSizeX(), gameMap->getMapSizeY());
             packetSend << nick << id << seatId << teamId;
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
 
             packetSend.clear();
             packetSend << ServerNotificationType::startGameMode << seatId << mServerMode;
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
             mSeatsConfigured = true;
             break;
         }
@@ -852,7 +1073,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 OD_LOG_INF("New player host: " + mPlayerConfig->getNick());
                 ODPacket packetSend;
                 packetSend << ServerNotificationType::playerConfigChange;
-                clientSocket->send(packetSend);
+                sendToClient(clientSocket, packetSend);
             }
 
             ODPacket packetSend;
@@ -866,7 +1087,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 int32_t id = client->getPlayer()->getId();
                 packetSend << nick << id;
             }
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
 
             // Then, we notify the newly connected client to every client
             const std::string& clientNick = clientSocket->getPlayer()->getNick();
@@ -880,7 +1101,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 if(clientSocket == client)
                     continue;
 
-                client->send(packetSend);
+                sendToClient(client, packetSend);
             }
 
             // Then we look for the first available human seat and assign the player there (if available)
@@ -1082,14 +1303,15 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                         + Helper::toString(player->getId())
                         + ", nick=" + player->getNick());
                     client->setState("rejected");
-                    client->send(packetSend);
+                    sendToClient(client, packetSend);
                     delete player;
                     client->setPlayer(nullptr);
                 }
             }
 
             ODPacket packetSend;
-            packetSend << ServerNotificationType::clientAccepted << ODApplication::turnsPerSecond;
+            packetSend << ServerNotificationType::clientAccepted << ODApplication::turnsPerSecond
+                << gameMap->getMatchSeed();
             const std::vector<Player*>& players = gameMap->getPlayers();
             int32_t nbPlayers = players.size();
             packetSend << nbPlayers;
@@ -1109,7 +1331,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 ODPacket packetSend;
                 int seatId = client->getPlayer()->getSeat()->getId();
                 packetSend << ServerNotificationType::startGameMode << seatId << mServerMode;
-                client->send(packetSend);
+                sendToClient(client, packetSend);
             }
 
             for(Seat* seat : gameMap->getSeats())
@@ -1332,8 +1554,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             if(player->getHasLost())
                 break;
 
-            std::vector<Room*> rooms = gameMap->getRoomsByTypeAndSeat(RoomType::workshop, player->getSeat());
-            if(!rooms.empty())
+            if(!gameMap->getRoomsByTypeAndSeat(RoomType::workshop, player->getSeat()).empty())
                 break;
 
             ServerNotification *serverNotification = new ServerNotification(
@@ -1418,20 +1639,88 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             break;
         }
 
+        case ClientNotificationType::stateHashMismatch:
+        {
+            Player* player = clientSocket->getPlayer();
+            Seat* seat = player->getSeat();
+            int64_t turn;
+            uint32_t nbChunks;
+            OD_ASSERT_TRUE(packetReceived >> turn >> nbChunks);
+            uint32_t nbChunksMap = MapStreaming::getNbChunks(gameMap->getMapSizeX(), gameMap->getMapSizeY());
+            StateHash::TileHashFunction tileHash = [seat](const Tile& tile)
+            {
+                return seat->getTileStateHashSent(&tile);
+            };
+            std::vector<Tile*> tiles;
+            std::vector<uint64_t> serverTileHashes;
+            std::vector<uint64_t> clientTileHashes;
+            std::vector<uint32_t> wrongTiles;
+            std::vector<Tile*> tilesToResend;
+            while(nbChunks > 0)
+            {
+                --nbChunks;
+                uint32_t chunk;
+                uint32_t nbTiles;
+                OD_ASSERT_TRUE(packetReceived >> chunk >> nbTiles);
+                if(chunk >= nbChunksMap)
+                {
+                    OD_LOG_ERR("player=" + player->getNick() + ", chunk=" + Helper::toString(chunk));
+                    break;
+                }
+
+                MapStreaming::getChunkTiles(*gameMap, chunk, tiles);
+                if(nbTiles != tiles.size())
+                {
+                    OD_LOG_ERR("player=" + player->getNick() + ", chunk=" + Helper::toString(chunk)
+                        + ", nbTiles=" + Helper::toString(nbTiles));
+                    break;
+                }
+
+                clientTileHashes.resize(nbTiles);
+                for(uint64_t& clientHash : clientTileHashes)
+                    OD_ASSERT_TRUE(packetReceived >> clientHash);
+
+                MapStreaming::getChunkTileHashes(*gameMap, chunk, tileHash, serverTileHashes);
+                uint32_t nbWrongTiles = StateHash::findTilesToResend(serverTileHashes, clientTileHashes, wrongTiles);
+                for(uint32_t index : wrongTiles)
+                    tilesToResend.push_back(tiles[index]);
+
+                OD_LOG_WRN("Desync detected for player=" + player->getNick() + " at turn="
+                    + Helper::toString(turn) + " in chunk=" + Helper::toString(chunk)
+                    + ", nbWrongTiles=" + Helper::toString(nbWrongTiles));
+            }
+
+            if(tilesToResend.empty())
+                break;
+
+            // We resend the state as it was notified to the seat (and not the current one) so that
+            // the player does not get information about tiles it has no vision on
+            ServerNotification notif(ServerNotificationType::refreshTiles, player);
+            uint32_t nbTiles = tilesToResend.size();
+            notif.mPacket << nbTiles;
+            for(Tile* tile : tilesToResend)
+            {
+                gameMap->tileToPacket(notif.mPacket, tile);
+                tile->exportToPacketForUpdate(notif.mPacket, seat);
+            }
+            sendAsyncMsg(notif);
+            break;
+        }
+
         case ClientNotificationType::askCreatureInfos:
         {
             std::string name;
             bool refreshEachTurn;
             OD_ASSERT_TRUE(packetReceived >> name >> refreshEachTurn);
-            std::vector<std::string>& creatures = mCreaturesInfoWanted[clientSocket];
+            // The creature might have died before the stat window is closed
+            Creature* creature = gameMap->getCreature(name);
+            if(creature == nullptr)
+                break;
 
-            std::vector<std::string>::iterator it = std::find(creatures.begin(), creatures.end(), name);
-            if(refreshEachTurn && (it == creatures.end()))
-            {
-                creatures.push_back(name);
-            }
-            else if(!refreshEachTurn && (it != creatures.end()))
-                creatures.erase(it);
+            if(refreshEachTurn)
+                creature->addStatsWatcher(clientSocket->getPlayer());
+            else
+                creature->removeStatsWatcher(clientSocket->getPlayer());
 
             break;
         }
@@ -1492,79 +1781,14 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 std::ostringstream ss;
                 ss.imbue(loc);
                 ss << boost::posix_time::second_clock::local_time() << "-";
-                switch(mServerMode)
-                {
-                    case ServerMode::ModeGameSinglePlayer:
-                        ss << SAVEGAME_SKIRMISH_PREFIX;
-                        ss << fileLevel;
-                        break;
-                    case ServerMode::ModeGameMultiPlayer:
-                        ss << SAVEGAME_MULTIPLAYER_PREFIX;
-                        ss << fileLevel;
-                        break;
-                    case ServerMode::ModeGameLoaded:
-                    {
-                        // We look for the Skirmish or multiplayer prefix and keep it.
-                        size_t indexSk = fileLevel.find(SAVEGAME_SKIRMISH_PREFIX);
-                        size_t indexMp = fileLevel.find(SAVEGAME_MULTIPLAYER_PREFIX);
-                        if((indexSk != std::string::npos) && (indexMp == std::string::npos))
-                        {
-                            // Skirmish savegame
-                            ss << SAVEGAME_SKIRMISH_PREFIX;
-                            ss << fileLevel.substr(indexSk + SAVEGAME_SKIRMISH_PREFIX.length());
-
-                        }
-                        else if((indexSk == std::string::npos) && (indexMp != std::string::npos))
-                        {
-                            // Multiplayer savegame
-                            ss << SAVEGAME_MULTIPLAYER_PREFIX;
-                            ss << fileLevel.substr(indexMp + SAVEGAME_MULTIPLAYER_PREFIX.length());
-                        }
-                        else if((indexSk != std::string::npos) && (indexMp != std::string::npos))
-                        {
-                            // We found both prefixes. That can happen if the name contains the other
-                            // prefix. Because of filename construction, we know that the lowest is the good
-                            if(indexSk < indexMp)
-                            {
-                                ss << SAVEGAME_SKIRMISH_PREFIX;
-                                ss << fileLevel.substr(indexSk + SAVEGAME_SKIRMISH_PREFIX.length());
-                            }
-                            else
-                            {
-                                ss << SAVEGAME_MULTIPLAYER_PREFIX;
-                                ss << fileLevel.substr(indexMp + SAVEGAME_MULTIPLAYER_PREFIX.length());
-                            }
-                        }
-                        else
-                        {
-                            // We couldn't find any prefix. That's not normal
-                            OD_LOG_ERR("fileLevel=" + fileLevel);
-                            ss << fileLevel;
-                        }
-                        break;
-                    }
-                    default:
-                        OD_LOG_ERR("mode=" + Helper::toString(static_cast<int>(mServerMode)));
-                        ss << fileLevel;
-                        break;
-                }
+                ss << getSaveGameLevelName(fileLevel);
                 std::string savePath = ResourceManager::getSingleton().getSaveGamePath() + ss.str();
                 levelSave = boost::filesystem::path(savePath);
             }
 
-            // If the file exists, we make a backup
-            if (boost::filesystem::exists(levelSave))
-                boost::filesystem::rename(levelSave, levelSave.string() + ".bak");
-
-            std::string msg = "Map saved successfully as: " + levelSave.string();
-            if (!MapHandler::writeGameMapToFile(levelSave.string(), *gameMap))
-            {
-                msg = "Couldn't not save map file as: " + levelSave.string() + "\nPlease check logs.";
-            }
-            // We notify all the players that the game was saved successfully
-            ServerNotification notif(ServerNotificationType::chatServer, nullptr);
-            notif.mPacket << msg << EventShortNoticeType::genericGameInfo;
-            sendAsyncMsg(notif);
+            // The map is captured now and written by the save thread. The players are notified
+            // when the file is written (see processFinishedSaves)
+            queueSave(levelSave.string(), SaveGameWriter::Format::text, false);
             break;
         }
 
@@ -1581,54 +1805,15 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             int seatId;
 
             OD_ASSERT_TRUE(packetReceived >> x1 >> y1 >> x2 >> y2 >> tileType >> tileFullness >> seatId);
-            std::vector<Tile*> selectedTiles = gameMap->rectangularRegion(x1, y1, x2, y2);
-            std::vector<Tile*> affectedTiles;
             Seat* seat = nullptr;
             if(seatId != -1)
                 seat = gameMap->getSeatById(seatId);
 
-            for(Tile* tile : selectedTiles)
-            {
-                // We do not change tiles where there is something
-                if((tile->numEntitiesInTile() > 0) &&
-                   ((tileFullness > 0.0) || (tileType == TileType::lava) || (tileType == TileType::water)))
-                    continue;
-                if(tile->getCoveringBuilding() != nullptr)
-                    continue;
-
-                affectedTiles.push_back(tile);
-                tile->setType(tileType);
-                tile->setFullness(tileFullness);
-                if(seat != nullptr)
-                    tile->claimTile(seat);
-                else
-                    tile->unclaimTile();
-
-                tile->computeTileVisual();
-            }
+            std::vector<Tile*> affectedTiles = gameMap->editorChangeTiles(x1, y1, x2, y2,
+                tileType, tileFullness, seat);
             if(!affectedTiles.empty())
-            {
-                uint32_t nbTiles = affectedTiles.size();
-                const std::vector<Seat*>& seats = gameMap->getSeats();
-                for(Seat* seat : seats)
-                {
-                    if(seat->getPlayer() == nullptr)
-                        continue;
-                    if(!seat->getPlayer()->getIsHuman())
-                        continue;
-
-                    ServerNotification notif(ServerNotificationType::refreshTiles, seat->getPlayer());
-                    notif.mPacket << nbTiles;
-                    for(Tile* tile : affectedTiles)
-                    {
-                        gameMap->tileToPacket(notif.mPacket, tile);
-                        seat->updateTileStateForSeat(tile, false);
-                        tile->exportToPacketForUpdate(notif.mPacket, seat);
+                sendTilesRegion(x1, y1, x2, y2, affectedTiles);
 
-                    }
-                    sendAsyncMsg(notif);
-                }
-            }
             break;
         }
 
@@ -1865,11 +2050,27 @@ ODSocketClient* ODServer::notifyNewConnection(sf::TcpListener& sockListener)
     return nullptr;
 }
 
+void ODServer::sendMapChunks(ODSocketClient* clientSocket)
+{
+    MapTransfer& transfer = mMapTransfers[clientSocket];
+    while((transfer.mNbChunksSent < transfer.mChunkOrder.size()) &&
+          (transfer.mNbChunksSent - transfer.mNbChunksAcknowledged < MapStreaming::NB_CHUNKS_IN_FLIGHT))
+    {
+        ODPacket packet;
+        packet << ServerNotificationType::loadLevelTiles;
+        MapStreaming::chunkToPacket(packet, *mGameMap, transfer.mChunkOrder[transfer.mNbChunksSent]);
+        sendToClient(clientSocket, packet);
+        ++transfer.mNbChunksSent;
+    }
+}
+
 bool ODServer::notifyClientMessage(ODSocketClient *clientSocket)
 {
     bool ret = processClientNotifications(clientSocket);
     if(!ret)
     {
+        mMapTransfers.erase(clientSocket);
+
         std::string nick = clientSocket->getPlayer() ? clientSocket->getPlayer()->getNick() : std::string();
         std::string message = nick.empty() ?
                               "Client disconnected state=" + clientSocket->getState() :
@@ -1909,6 +2110,7 @@ void ODServer::stopServer()
     mServerState = ServerState::StateNone;
     mSeatsConfigured = false;
     mDisconnectedPlayers.clear();
+    mMapTransfers.clear();
     mPlayerConfig = nullptr;
 
     // Now that the server is stopped, we can remove all pending messages
@@ -19,12 +19,14 @@
 #define ODSERVER_H
 
 #include "ODSocketServer.h"
+#include "gamemap/SaveGameWriter.h"
 #include "modes/ConsoleInterface.h"
 
 #include <OgreSingleton.h>
 
 class ServerNotification;
 class GameMap;
+class Tile;
 
 enum class ServerMode;
 
@@ -112,13 +114,23 @@ private:
 
     std::deque<ServerNotification*> mServerNotificationQueue;
 
-    std::map<ODSocketClient*, std::vector<std::string>> mCreaturesInfoWanted;
+    //! \brief State of the map being streamed to a joining client (see MapStreaming)
+    struct MapTransfer
+    {
+        std::vector<uint32_t> mChunkOrder;
+        uint32_t mNbChunksSent;
+        uint32_t mNbChunksAcknowledged;
+    };
+    std::map<ODSocketClient*, MapTransfer> mMapTransfers;
 
     ConsoleInterface mConsoleInterface;
 
     std::string mMasterServerGameId;
     double mMasterServerGameStatusUpdateTime;
 
+    //! Writes the savegames out of the server thread
+    SaveGameWriter mSaveGameWriter;
+
     void printConsoleMsg(const std::string& text);
 
     ODSocketClient* getClientFromPlayer(Player* player);
@@ -127,6 +139,28 @@ private:
     //! \brief Called when a new turn started.
     void startNewTurn(double timeSinceLastTurn);
 
+    //! \brief Returns the name of the savegame for the given level file, with the prefix of the
+    //! current game mode (skirmish or multiplayer)
+    std::string getSaveGameLevelName(const std::string& fileLevel) const;
+
+    //! \brief Sends to each human player the hashes of the map chunks as they were notified to it so
+    //! that desyncs can be detected (see StateHash)
+    void queueStateHashes();
+
+    /*! \brief Sends to each human player the given tiles changed in the given rectangle with one
+     * refreshTilesRegion message. The tiles of the rectangle are sent column by column (like
+     * TileContainer::rectangularRegion) as runs of consecutive tiles: a run is either unchanged tiles
+     * or changed tiles having the same state which is sent only once.
+     */
+    void sendTilesRegion(int x1, int y1, int x2, int y2, const std::vector<Tile*>& changedTiles);
+
+    //! \brief Captures the server gamemap and queues its writing in the given file. Should be called at a turn
+    //! boundary so that the savegame is consistent
+    void queueSave(const std::string& fileName, SaveGameWriter::Format format, bool isAutosave);
+
+    //! \brief Notifies the players about the savegames written since the last call
+    void processFinishedSaves();
+
     /*! \brief Monitors mServerNotificationQueue for new events and informs the clients about them.
      *
      * This function is used in server mode and acts as a "consumer" on
@@ -148,6 +182,14 @@ private:
     //! \brief Sends the packet to the given player. If player is nullptr, the packet is sent to every connected player
     void sendMsg(Player* player, ODPacket& packet);
 
+    //! \brief Sends the packet to the given client. The symbols interned since the last packet sent to this
+    //! client are sent before so that the client can translate the symbols used in the packet
+    void sendToClient(ODSocketClient* client, ODPacket& packet);
+
+    //! \brief Sends the next chunks of the map to the given client while the number of chunks
+    //! it did not acknowledge is lower than MapStreaming::NB_CHUNKS_IN_FLIGHT
+    void sendMapChunks(ODSocketClient* clientSocket);
+
     void fireSeatConfigurationRefresh();
 
     //! \brief Handles console command. player is the player that launched the command
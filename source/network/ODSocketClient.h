@@ -49,6 +49,7 @@ class ODSocketClient
             mSource(ODSource::none),
             mPlayer(nullptr),
             mLastTurnAck(-1),
+            mNbSymbolsSent(1),
             mPendingTimestamp(-1)
         {}
 
@@ -69,6 +70,9 @@ class ODSocketClient
         void setPlayer(Player* player) { mPlayer = player; }
         int64_t getLastTurnAck() { return mLastTurnAck; }
         void setLastTurnAck(int64_t lastTurnAck) { mLastTurnAck = lastTurnAck; }
+        //! \brief Number of symbols the server already sent to this client (see Symbol)
+        uint32_t getNbSymbolsSent() const { return mNbSymbolsSent; }
+        void setNbSymbolsSent(uint32_t nbSymbolsSent) { mNbSymbolsSent = nbSymbolsSent; }
         const std::string& getState() {return mState;}
         bool isDataAvailable();
         int32_t getGameTimeMillis()
@@ -116,6 +120,7 @@ class ODSocketClient
         sf::TcpSocket mSockClient;
         Player* mPlayer;
         int64_t mLastTurnAck;
+        uint32_t mNbSymbolsSent;
         std::string mState;
 
         sf::Clock mGameClock;
@@ -19,21 +19,75 @@
 
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/TurnArena.h"
+
+//! \brief Size of the buffer used for the notifications of one turn. If there are more, they are
+//! allocated on the heap
+static const std::size_t NOTIFICATIONS_ARENA_SIZE = 128 * 1024;
+
+//! \brief Number of packets kept for the next notifications and size above which a packet is not kept
+static const std::size_t NOTIFICATIONS_MAX_FREE_PACKETS = 1024;
+static const std::size_t NOTIFICATIONS_MAX_PACKET_SIZE = 16 * 1024;
+
+static TurnArena& getServerNotificationArena()
+{
+    static TurnArena* arena = new TurnArena("ServerNotification", NOTIFICATIONS_ARENA_SIZE);
+    return *arena;
+}
+
+static RecyclingPool<ODPacket>& getServerNotificationPackets()
+{
+    static RecyclingPool<ODPacket>* packets = new RecyclingPool<ODPacket>(NOTIFICATIONS_MAX_FREE_PACKETS,
+        NOTIFICATIONS_MAX_PACKET_SIZE);
+    return *packets;
+}
+
+//! \brief Returns a packet for a new notification. The heap allocations done for the packets are counted
+//! with the ones of the notifications arena
+static RecyclingPool<ODPacket>::Item* acquirePacket()
+{
+    uint32_t nbHeapAllocations;
+    RecyclingPool<ODPacket>::Item* item = getServerNotificationPackets().acquire(nbHeapAllocations);
+    getServerNotificationArena().countHeapAllocations(nbHeapAllocations);
+    return item;
+}
+
+void* ServerNotification::operator new(std::size_t size)
+{
+    return getServerNotificationArena().allocate(size);
+}
+
+void ServerNotification::operator delete(void* ptr)
+{
+    getServerNotificationArena().deallocate(ptr);
+}
 
 ServerNotification::ServerNotification(ServerNotificationType type,
     Player* concernedPlayer) :
+        mPacketItem(acquirePacket()),
+        mPacket(mPacketItem->mObject),
         mType(type),
         mConcernedPlayer(concernedPlayer)
 {
     mPacket << type;
 }
 
+ServerNotification::~ServerNotification()
+{
+    uint32_t nbHeapAllocations = getServerNotificationPackets().release(mPacketItem);
+    getServerNotificationArena().countHeapAllocations(nbHeapAllocations);
+}
+
 std::string ServerNotification::typeString(ServerNotificationType type)
 {
     switch(type)
     {
         case ServerNotificationType::loadLevel:
             return "loadLevel";
+        case ServerNotificationType::loadLevelTiles:
+            return "loadLevelTiles";
+        case ServerNotificationType::addSymbols:
+            return "addSymbols";
         case ServerNotificationType::pickNick:
             return "pickNick";
         case ServerNotificationType::addPlayers:
@@ -98,8 +152,12 @@ std::string ServerNotification::typeString(ServerNotificationType type)
             return "markTiles";
         case ServerNotificationType::refreshTiles:
             return "refreshTiles";
+        case ServerNotificationType::refreshTilesRegion:
+            return "refreshTilesRegion";
         case ServerNotificationType::refreshVisibleTiles:
             return "refreshVisibleTiles";
+        case ServerNotificationType::stateHashes:
+            return "stateHashes";
         case ServerNotificationType::carryEntity:
             return "carryEntity";
         case ServerNotificationType::releaseCarriedEntity:
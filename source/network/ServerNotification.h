@@ -19,6 +19,7 @@
 #define SERVERNOTIFICATION_H
 
 #include "network/ODPacket.h"
+#include "utils/RecyclingPool.h"
 
 #include <string>
 #include <OgreVector3.h>
@@ -32,6 +33,8 @@ enum class ServerNotificationType
 {
     // Negotiation for multiplayer
     loadLevel, // Tells the client to load the level: + string LevelFilename
+    loadLevelTiles, // A chunk of the tiles of the level being loaded (see MapStreaming)
+    addSymbols, // Names interned by the server since the last addSymbols sent to the client (see Symbol)
     pickNick,
     addPlayers,
     removePlayers,
@@ -73,7 +76,9 @@ enum class ServerNotificationType
 
     markTiles,
     refreshTiles,
+    refreshTilesRegion, // Tiles of a rectangle sent as runs of tiles with the same state (see ODServer::sendTilesRegion)
     refreshVisibleTiles,
+    stateHashes, // Hashes of the map chunks as sent to the player (see StateHash)
     carryEntity,
     releaseCarriedEntity,
 
@@ -97,21 +102,33 @@ class ServerNotification
 {
     friend class ODServer;
 
+    private:
+        //! \brief Item holding mPacket. Packets are reused by the next notifications so that their buffer
+        //! does not have to be allocated again
+        RecyclingPool<ODPacket>::Item* mPacketItem;
+
     public:
         /*! \brief Creates a message to be sent to concernedPlayer. If concernedPlayer is null, the message will be sent to
          *         every connected player.
          */
         ServerNotification(ServerNotificationType type, Player* concernedPlayer);
-        virtual ~ServerNotification()
-        {}
+        virtual ~ServerNotification();
 
-        ODPacket mPacket;
+        //! \brief Notifications are queued and freed during the same turn so they are allocated
+        //! from a TurnArena
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr);
+
+        ODPacket& mPacket;
 
         static std::string typeString(ServerNotificationType type);
 
     private:
         ServerNotificationType mType;
         Player *mConcernedPlayer;
+
+        ServerNotification(const ServerNotification&) = delete;
+        ServerNotification& operator=(const ServerNotification&) = delete;
 };
 
 #endif // SERVERNOTIFICATION_H
@@ -0,0 +1,214 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "network/StateHash.h"
+
+namespace
+{
+const uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+const uint64_t PRIME3 = 0x165667B19E3779F9ull;
+const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+const uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t rotl(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// The input is read as little endian whatever the platform
+inline uint64_t read64(const uint8_t* data)
+{
+    uint64_t value = 0;
+    for(int i = 7; i >= 0; --i)
+        value = (value << 8) | data[i];
+    return value;
+}
+
+inline uint64_t read32(const uint8_t* data)
+{
+    uint64_t value = 0;
+    for(int i = 3; i >= 0; --i)
+        value = (value << 8) | data[i];
+    return value;
+}
+
+inline uint64_t accumulate(uint64_t acc, uint64_t input)
+{
+    acc += input * PRIME2;
+    acc = rotl(acc, 31);
+    return acc * PRIME1;
+}
+
+inline uint64_t mergeAccumulate(uint64_t acc, uint64_t value)
+{
+    acc ^= accumulate(0, value);
+    return acc * PRIME1 + PRIME4;
+}
+
+void appendLittleEndian(std::string& data, uint64_t value, uint32_t nbBytes)
+{
+    for(uint32_t i = 0; i < nbBytes; ++i)
+    {
+        data.push_back(static_cast<char>(value & 0xFF));
+        value >>= 8;
+    }
+}
+}
+
+namespace StateHash
+{
+uint64_t xxHash64(const void* data, std::size_t size, uint64_t seed)
+{
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    const uint8_t* end = input + size;
+    uint64_t hash;
+
+    if(size >= 32)
+    {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        const uint8_t* limit = end - 32;
+        do
+        {
+            v1 = accumulate(v1, read64(input));
+            v2 = accumulate(v2, read64(input + 8));
+            v3 = accumulate(v3, read64(input + 16));
+            v4 = accumulate(v4, read64(input + 24));
+            input += 32;
+        }
+        while(input <= limit);
+
+        hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        hash = mergeAccumulate(hash, v1);
+        hash = mergeAccumulate(hash, v2);
+        hash = mergeAccumulate(hash, v3);
+        hash = mergeAccumulate(hash, v4);
+    }
+    else
+    {
+        hash = seed + PRIME5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+
+    while(input + 8 <= end)
+    {
+        hash ^= accumulate(0, read64(input));
+        hash = rotl(hash, 27) * PRIME1 + PRIME4;
+        input += 8;
+    }
+
+    if(input + 4 <= end)
+    {
+        hash ^= read32(input) * PRIME1;
+        hash = rotl(hash, 23) * PRIME2 + PRIME3;
+        input += 4;
+    }
+
+    while(input < end)
+    {
+        hash ^= (*input) * PRIME5;
+        hash = rotl(hash, 11) * PRIME1;
+        ++input;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+Hasher& Hasher::operator<<(bool value)
+{
+    mData.push_back(value ? 1 : 0);
+    return *this;
+}
+
+Hasher& Hasher::operator<<(int32_t value)
+{
+    appendLittleEndian(mData, static_cast<uint32_t>(value), 4);
+    return *this;
+}
+
+Hasher& Hasher::operator<<(uint32_t value)
+{
+    appendLittleEndian(mData, value, 4);
+    return *this;
+}
+
+Hasher& Hasher::operator<<(uint64_t value)
+{
+    appendLittleEndian(mData, value, 8);
+    return *this;
+}
+
+Hasher& Hasher::operator<<(const std::string& value)
+{
+    // The size is written so that ("ab", "c") and ("a", "bc") do not give the same data
+    appendLittleEndian(mData, value.size(), 4);
+    mData += value;
+    return *this;
+}
+
+uint64_t Hasher::getHash() const
+{
+    uint64_t hash = xxHash64(mData.data(), mData.size(), 0);
+    return (hash == 0) ? 1 : hash;
+}
+
+uint64_t computeChunkHash(const std::vector<uint64_t>& tileHashes)
+{
+    Hasher hasher;
+    for(uint64_t hash : tileHashes)
+        hasher << hash;
+
+    return hasher.getHash();
+}
+
+void findWrongChunks(const std::vector<uint64_t>& serverChunkHashes, const std::vector<uint64_t>& clientChunkHashes,
+    std::vector<uint32_t>& wrongChunks)
+{
+    wrongChunks.clear();
+    for(uint32_t chunk = 0; chunk < serverChunkHashes.size(); ++chunk)
+    {
+        if(serverChunkHashes[chunk] != clientChunkHashes[chunk])
+            wrongChunks.push_back(chunk);
+    }
+}
+
+uint32_t findTilesToResend(const std::vector<uint64_t>& serverTileHashes, const std::vector<uint64_t>& clientTileHashes,
+    std::vector<uint32_t>& tilesToResend)
+{
+    tilesToResend.clear();
+    uint32_t nbWrongTiles = 0;
+    for(uint32_t index = 0; index < serverTileHashes.size(); ++index)
+    {
+        if(serverTileHashes[index] == clientTileHashes[index])
+            continue;
+
+        ++nbWrongTiles;
+        if(serverTileHashes[index] != 0)
+            tilesToResend.push_back(index);
+    }
+    return nbWrongTiles;
+}
+}
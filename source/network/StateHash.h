@@ -0,0 +1,85 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Tile;
+
+/*! \brief Detection of desyncs between the tiles known by the server and the tiles displayed by a client.
+ * Each time the server sends the state of a tile to a seat (see Seat::exportTileToPacket), it keeps the
+ * hash of the sent state. The client computes the same hash when it applies the state (see Tile::updateFromPacket).
+ * Tiles whose state was never sent have a hash of 0.
+ * Every NB_TURNS_BETWEEN_CHECKS turns, the server sends to each client the hashes of the chunks of the map (the
+ * chunks used by MapStreaming), each one computed from the hashes of its tiles (see MapStreaming::computeChunkHashes). The client compares them with its
+ * own chunks and, for the ones that differ, sends back the hashes of their tiles. The server then resends only
+ * the tiles whose hash differs, so repairing a desync costs bandwidth proportional to the number of wrong tiles.
+ * The entities are not checked because their positions are interpolated by the clients.
+ */
+namespace StateHash
+{
+    //! \brief Number of turns between two checks
+    const int64_t NB_TURNS_BETWEEN_CHECKS = 20;
+
+    //! \brief xxHash64 of the given data
+    uint64_t xxHash64(const void* data, std::size_t size, uint64_t seed);
+
+    /*! \brief Accumulates values to compute their hash. Values are written with a fixed byte order
+     * so that the server and the clients compute the same hash whatever their platform.
+     */
+    class Hasher
+    {
+    public:
+        Hasher& operator<<(bool value);
+        Hasher& operator<<(int32_t value);
+        Hasher& operator<<(uint32_t value);
+        Hasher& operator<<(uint64_t value);
+        Hasher& operator<<(const std::string& value);
+
+        //! \brief Returns the hash of the accumulated values. Never returns 0 so that 0 can be used for
+        //! the tiles with no state
+        uint64_t getHash() const;
+
+    private:
+        std::string mData;
+    };
+
+    typedef std::function<uint64_t(const Tile& tile)> TileHashFunction;
+
+    //! \brief Returns the hash of a chunk from the hashes of its tiles (see MapStreaming::computeChunkHashes)
+    uint64_t computeChunkHash(const std::vector<uint64_t>& tileHashes);
+
+    //! \brief Used by the client to fill wrongChunks with the chunks whose hash differs from the server one.
+    //! Both vectors are expected to have the same size
+    void findWrongChunks(const std::vector<uint64_t>& serverChunkHashes, const std::vector<uint64_t>& clientChunkHashes,
+        std::vector<uint32_t>& wrongChunks);
+
+    /*! \brief Used by the server to fill tilesToResend with the index in the chunk of the tiles whose hash
+     * differs from the client one. Tiles never sent to the client are not resent as we cannot know what it
+     * displays. Returns the number of tiles with a different hash. Both vectors are expected to have the same size
+     */
+    uint32_t findTilesToResend(const std::vector<uint64_t>& serverTileHashes, const std::vector<uint64_t>& clientTileHashes,
+        std::vector<uint32_t>& tilesToResend);
+}
+
+#endif // STATEHASH_H
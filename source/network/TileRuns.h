@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TILERUNS_H
+#define TILERUNS_H
+
+#include <cstdint>
+#include <vector>
+
+/*! \brief Run length encoding of the tiles of a region sent in a refreshTilesRegion message (see
+ * ODServer::sendTilesRegion). Consecutive unchanged tiles are grouped in one run. Consecutive changed
+ * tiles with the same key (the hash of the state sent to the seat) are grouped in one run if they can be
+ * merged (tiles with particle effects cannot as the effects are not copied to the other tiles of the run).
+ */
+namespace TileRuns
+{
+    //! \brief Index given to mFirstIndex for the runs of unchanged tiles
+    const uint32_t UNCHANGED = 0xFFFFFFFF;
+
+    struct Run
+    {
+        uint32_t mNbTiles;
+        //! \brief Index in the region of the first tile of the run. UNCHANGED if the tiles are not changed
+        uint32_t mFirstIndex;
+        uint64_t mKey;
+    };
+
+    /*! \brief Fills runs for the nbTiles tiles of a region. isChanged(index) tells if the tile should be sent.
+     * For the changed tiles, getKey(index) returns the key of the tile and isMergeable(index) if it can be
+     * part of a run of several tiles. getKey is called once per changed tile, in the region order
+     */
+    template <typename IsChangedFunc, typename KeyFunc, typename MergeableFunc>
+    void buildRuns(uint32_t nbTiles, IsChangedFunc isChanged, KeyFunc getKey, MergeableFunc isMergeable,
+        std::vector<Run>& runs)
+    {
+        runs.clear();
+        bool isLastMergeable = false;
+        for(uint32_t index = 0; index < nbTiles; ++index)
+        {
+            if(!isChanged(index))
+            {
+                if(!runs.empty() && (runs.back().mFirstIndex == UNCHANGED))
+                    ++runs.back().mNbTiles;
+                else
+                    runs.push_back({ 1, UNCHANGED, 0 });
+
+                continue;
+            }
+
+            uint64_t key = getKey(index);
+            bool isTileMergeable = isMergeable(index);
+            if(!runs.empty() &&
+               (runs.back().mFirstIndex != UNCHANGED) &&
+               (runs.back().mKey == key) &&
+               isLastMergeable &&
+               isTileMergeable)
+            {
+                ++runs.back().mNbTiles;
+                continue;
+            }
+
+            runs.push_back({ 1, index, key });
+            isLastMergeable = isTileMergeable;
+        }
+    }
+}
+
+#endif // TILERUNS_H
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/MaterialVariantCache.h"
+
+#include "game/Seat.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <OgreMaterialManager.h>
+#include <OgrePass.h>
+#include <OgreTechnique.h>
+#include <RTShaderSystem/OgreShaderGenerator.h>
+
+#include <algorithm>
+
+MaterialVariantCache::MaterialVariantCache() :
+    mNbHits(0),
+    mNbMisses(0)
+{
+}
+
+const Ogre::MaterialPtr& MaterialVariantCache::getColourized(const Ogre::MaterialPtr& material, const Seat* seat,
+    bool markedForDigging, bool playerHasVision)
+{
+    Variant variant = getVariant(material);
+    variant.mSeatKey = (seat == nullptr) ? 0 : static_cast<uint16_t>(seat->getId() + 1);
+    variant.mSeat = seat;
+    if(markedForDigging)
+        variant.mFlag = VariantFlag::markedForDigging;
+    else if(!playerHasVision)
+        variant.mFlag = VariantFlag::noVision;
+    else
+        variant.mFlag = VariantFlag::none;
+
+    return getMaterial(variant);
+}
+
+const Ogre::MaterialPtr& MaterialVariantCache::getWithOpacity(const Ogre::MaterialPtr& material, float opacity)
+{
+    if(opacity < 0.0f || opacity > 1.0f)
+        return material;
+
+    Variant variant = getVariant(material);
+    // Only precise the opacity when it is useful, otherwise the opaque material is used
+    variant.mOpacity = (opacity == 1.0f) ? FULL_OPACITY : static_cast<uint8_t>(opacity * 255.0f);
+    return getMaterial(variant);
+}
+
+void MaterialVariantCache::clear()
+{
+    mMaterials.clear();
+    mBaseMaterials.clear();
+    mVariants.clear();
+}
+
+MaterialVariantCache::Variant MaterialVariantCache::getVariant(const Ogre::MaterialPtr& material)
+{
+    auto it = mMaterials.find(material->getHandle());
+    if(it != mMaterials.end())
+        return it->second;
+
+    // If the material is a variant created before the cache was cleared, we use its base material
+    const std::string& name = material->getName();
+    std::size_t index = std::min(name.find("##"), name.find("_alpha_"));
+    if(index != std::string::npos)
+    {
+        Ogre::MaterialPtr baseMaterial = Ogre::MaterialManager::getSingleton().getByName(name.substr(0, index));
+        if(!baseMaterial.isNull())
+            return getVariant(baseMaterial);
+    }
+
+    Variant variant;
+    variant.mBaseId = static_cast<uint32_t>(mBaseMaterials.size());
+    variant.mSeatKey = 0;
+    variant.mFlag = VariantFlag::none;
+    variant.mOpacity = FULL_OPACITY;
+    variant.mSeat = nullptr;
+    mBaseMaterials.push_back(material);
+    mMaterials.emplace(material->getHandle(), variant);
+    return variant;
+}
+
+const Ogre::MaterialPtr& MaterialVariantCache::getMaterial(const Variant& variant)
+{
+    if((variant.mSeatKey == 0) && (variant.mFlag == VariantFlag::none) && (variant.mOpacity == FULL_OPACITY))
+        return mBaseMaterials[variant.mBaseId];
+
+    uint64_t key = computeKey(variant);
+    auto it = mVariants.find(key);
+    if(it != mVariants.end())
+    {
+        ++mNbHits;
+        return it->second;
+    }
+
+    ++mNbMisses;
+    Ogre::MaterialPtr material = createMaterial(variant);
+    mMaterials.emplace(material->getHandle(), variant);
+    return mVariants.emplace(key, material).first->second;
+}
+
+Ogre::MaterialPtr MaterialVariantCache::createMaterial(const Variant& variant)
+{
+    const Ogre::MaterialPtr& baseMaterial = mBaseMaterials[variant.mBaseId];
+    std::string name = baseMaterial->getName();
+    if((variant.mSeatKey != 0) || (variant.mFlag != VariantFlag::none))
+    {
+        name += "##";
+        if(variant.mSeat != nullptr)
+            name += "Color_" + variant.mSeat->getColorId() + "_";
+        else
+            name += "Color_null_";
+
+        if(variant.mFlag == VariantFlag::markedForDigging)
+            name += "dig_";
+        else if(variant.mFlag == VariantFlag::noVision)
+            name += "novision_";
+    }
+    if(variant.mOpacity != FULL_OPACITY)
+        name += "_alpha_" + Helper::toString(static_cast<int>(variant.mOpacity));
+
+    // The material may have been created before the cache was cleared. Seats with the same
+    // colour also share the same material
+    Ogre::MaterialPtr requestedMaterial = Ogre::MaterialManager::getSingleton().getByName(name);
+    if (!requestedMaterial.isNull())
+        return requestedMaterial;
+
+    Ogre::MaterialPtr newMaterial = baseMaterial->clone(name);
+    bool cloned = Ogre::RTShader::ShaderGenerator::getSingleton().cloneShaderBasedTechniques(
+        baseMaterial->getName(), baseMaterial->getGroup(), newMaterial->getName(), newMaterial->getGroup());
+    if(!cloned)
+    {
+        OD_LOG_ERR("Failed to clone rtss for material: " + baseMaterial->getName());
+    }
+
+    // Loop over the techniques for the new material
+    for (unsigned int j = 0; j < newMaterial->getNumTechniques(); ++j)
+    {
+        Ogre::Technique* technique = newMaterial->getTechnique(j);
+        if (technique->getNumPasses() == 0)
+            continue;
+
+        if (variant.mFlag == VariantFlag::markedForDigging)
+        {
+            // Color the material with yellow on the latest pass
+            // so we're sure to see the taint.
+            Ogre::ColourValue color(1.0, 1.0, 0.0, 1.0);
+            for (uint16_t i = 0; i < technique->getNumPasses(); ++i)
+            {
+                Ogre::Pass* pass = technique->getPass(i);
+                pass->setSpecular(color);
+                pass->setAmbient(color);
+                pass->setDiffuse(color);
+                pass->setEmissive(color);
+            }
+        }
+        else if(variant.mFlag == VariantFlag::noVision)
+        {
+            // Color the material with dark color on the latest pass
+            // so we're sure to see the taint.
+            Ogre::Pass* pass = technique->getPass(0);
+            Ogre::ColourValue color(0.2, 0.2, 0.2, 1.0);
+            pass->setSpecular(color);
+            pass->setAmbient(color);
+            pass->setDiffuse(color);
+        }
+        if (variant.mSeat != nullptr)
+        {
+            // Color the material with the Seat's color.
+            Ogre::Pass* pass = technique->getPass(technique->getNumPasses() - 1);
+            Ogre::ColourValue color = variant.mSeat->getColorValue();
+            color.a = 1.0;
+            pass->setAmbient(color);
+            pass->setDiffuse(color);
+            pass->setSpecular(color);
+        }
+
+        if(variant.mOpacity == FULL_OPACITY)
+            continue;
+
+        // Set alpha value for all passes
+        float opacity = static_cast<float>(variant.mOpacity) / 255.0f;
+        for(uint16_t i = 0; i < technique->getNumPasses(); ++i)
+        {
+            Ogre::Pass* pass = technique->getPass(i);
+            Ogre::ColourValue color = pass->getEmissive();
+            color.a = opacity;
+            pass->setEmissive(color);
+
+            color = pass->getSpecular();
+            color.a = opacity;
+            pass->setSpecular(color);
+
+            color = pass->getAmbient();
+            color.a = opacity;
+            pass->setAmbient(color);
+
+            color = pass->getDiffuse();
+            color.a = opacity;
+            pass->setDiffuse(color);
+
+            pass->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+            pass->setDepthWriteEnabled(false);
+        }
+    }
+
+    return newMaterial;
+}
+
+uint64_t MaterialVariantCache::computeKey(const Variant& variant)
+{
+    return (static_cast<uint64_t>(variant.mBaseId) << 32)
+        | (static_cast<uint64_t>(variant.mSeatKey) << 16)
+        | (static_cast<uint64_t>(variant.mFlag) << 8)
+        | static_cast<uint64_t>(variant.mOpacity);
+}
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATERIALVARIANTCACHE_H
+#define MATERIALVARIANTCACHE_H
+
+#include <OgreMaterial.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Seat;
+
+/*! \brief Keeps the colourized and transparent copies of the materials used by the entities. A variant
+ * is identified by its base material, the seat colour, whether it is marked for digging or not visible
+ * and its opacity. Materials are identified by their Ogre handle so that getting the variant of a
+ * sub entity material does not involve any string building or lookup once it has been created.
+ * The variants are created once (by cloning the base material) and kept in Ogre MaterialManager.
+ */
+class MaterialVariantCache
+{
+public:
+    MaterialVariantCache();
+
+    //! \brief Returns the variant of material colourized with the seat colour. If the material is
+    //! marked for digging (wall tiles only), a yellow color is used. If the player has no vision,
+    //! it is darkened. The opacity of material is kept
+    const Ogre::MaterialPtr& getColourized(const Ogre::MaterialPtr& material, const Seat* seat,
+        bool markedForDigging, bool playerHasVision);
+
+    //! \brief Returns the variant of material with the given opacity (0.0f - 1.0f). The colour
+    //! of material is kept
+    const Ogre::MaterialPtr& getWithOpacity(const Ogre::MaterialPtr& material, float opacity);
+
+    //! \brief Forgets the variants. Should be called when the seats change (the colour of a variant
+    //! is keyed by seat id). The materials stay in Ogre MaterialManager and will be reused by name
+    void clear();
+
+    inline uint64_t getNbHits() const
+    { return mNbHits; }
+
+    inline uint64_t getNbMisses() const
+    { return mNbMisses; }
+
+    inline uint32_t getNbVariants() const
+    { return static_cast<uint32_t>(mVariants.size()); }
+
+private:
+    enum class VariantFlag : uint8_t
+    {
+        none,
+        markedForDigging,
+        noVision
+    };
+
+    static const uint8_t FULL_OPACITY = 255;
+
+    //! \brief Describes a material known by the cache. Base materials have no seat (mSeatKey = 0),
+    //! no flag and are opaque
+    struct Variant
+    {
+        uint32_t mBaseId;
+        uint16_t mSeatKey;
+        VariantFlag mFlag;
+        uint8_t mOpacity;
+        //! \brief Seat giving the colour. Only used when the material is created
+        const Seat* mSeat;
+    };
+
+    //! \brief Variant description of each material handle known by the cache (base materials and variants)
+    std::unordered_map<Ogre::ResourceHandle, Variant> mMaterials;
+
+    //! \brief Base materials indexed by id
+    std::vector<Ogre::MaterialPtr> mBaseMaterials;
+
+    //! \brief Variants by key (see computeKey)
+    std::unordered_map<uint64_t, Ogre::MaterialPtr> mVariants;
+
+    uint64_t mNbHits;
+    uint64_t mNbMisses;
+
+    //! \brief Returns the variant description of the given material. If it is not known, it is
+    //! registered as a base material
+    Variant getVariant(const Ogre::MaterialPtr& material);
+
+    const Ogre::MaterialPtr& getMaterial(const Variant& variant);
+
+    //! \brief Clones the base material and applies the variant colour and opacity
+    Ogre::MaterialPtr createMaterial(const Variant& variant);
+
+    static uint64_t computeKey(const Variant& variant);
+};
+
+#endif // MATERIALVARIANTCACHE_H
@@ -277,6 +277,11 @@ void ODFrameListener::printDebugInfo()
         infoSS << "\ntriangleCount: " << mWindow->getStatistics().triangleCount;
         infoSS << "\nBatches: " << mWindow->getStatistics().batchCount;
         infoSS << "\nTurn number:  " << mGameMap->getTurnNumber();
+        const MaterialVariantCache& materialVariants = mRenderManager->getMaterialVariantCache();
+        uint64_t nbLookups = materialVariants.getNbHits() + materialVariants.getNbMisses();
+        infoSS << "\nMaterial variants: " << materialVariants.getNbVariants();
+        if(nbLookups > 0)
+            infoSS << " (hit rate: " << (100 * materialVariants.getNbHits() / nbLookups) << "%)";
         infoSS << "\nCursor:  " << mModeManager->getInputManager().mXPos << ", " << mModeManager->getInputManager().mYPos;
         if(ODClient::getSingleton().isConnected())
         {
@@ -169,6 +169,9 @@ void RenderManager::stopGameRenderer(GameMap* gameMap)
         mSceneManager->destroyLight(mHandLight);
         mHandLight = nullptr;
     }
+
+    // The variants are keyed by seat id and the seats will change with the next game
+    mMaterialVariants.clear();
 }
 
 void RenderManager::triggerCompositor(const std::string& compositorName)
@@ -1120,7 +1123,7 @@ void RenderManager::rrDestroySeatVisionVisualDebug(int seatId, Tile* tile)
     }
 }
 
-void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, const std::string& animation, bool loop)
+void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, const Symbol& animation, bool loop)
 {
     std::string objectName = curAnimatedObject->getOgreNamePrefix()
         + curAnimatedObject->getName();
@@ -1133,10 +1136,10 @@ void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObje
     if (!objectEntity->hasSkeleton())
         return;
 
-    std::string anim = animation;
+    Symbol anim = animation;
 
     // Handle the case where this entity does not have the requested animation.
-    while (!objectEntity->getSkeleton()->hasAnimation(anim))
+    while (!objectEntity->getSkeleton()->hasAnimation(anim.getName()))
     {
         // Try to change the unexisting animation to a close existing one.
         if (anim == EntityAnimation::sleep_anim)
@@ -1165,10 +1168,10 @@ void RenderManager::rrSetObjectAnimationState(MovableGameEntity* curAnimatedObje
         }
     }
 
-    if (!objectEntity->getSkeleton()->hasAnimation(anim))
+    if (!objectEntity->getSkeleton()->hasAnimation(anim.getName()))
         return;
 
-    Ogre::AnimationState* animState = setEntityAnimation(objectEntity, anim, loop);
+    Ogre::AnimationState* animState = setEntityAnimation(objectEntity, anim.getName(), loop);
     curAnimatedObject->setAnimationState(animState);
 }
 void RenderManager::rrMoveEntity(GameEntity* entity, const Ogre::Vector3& position)
@@ -1256,111 +1259,11 @@ void RenderManager::colourizeEntity(Ogre::Entity *ent, const Seat* seat, bool ma
     for (unsigned int i = 0; i < ent->getNumSubEntities(); ++i)
     {
         Ogre::SubEntity *tempSubEntity = ent->getSubEntity(i);
-
-        std::string materialName = tempSubEntity->getMaterialName();
-        // If the material name have been modified, we restore the original name
-        std::size_t index = materialName.find("##");
-        if(index != std::string::npos)
-            materialName = materialName.substr(0, index);
-
-        materialName = colourizeMaterial(materialName, seat, markedForDigging, playerHasVision);
-        tempSubEntity->setMaterialName(materialName);
+        tempSubEntity->setMaterial(mMaterialVariants.getColourized(tempSubEntity->getMaterial(),
+            seat, markedForDigging, playerHasVision));
     }
 }
 
-std::string RenderManager::colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision)
-{
-    if (seat == nullptr && !markedForDigging && playerHasVision)
-        return materialName;
-
-    std::stringstream tempSS;
-
-    tempSS.str("");
-
-    tempSS << materialName << "##";
-
-    // Create the material name.
-    if(seat != nullptr)
-        tempSS << "Color_" << seat->getColorId() << "_" ;
-    else
-        tempSS << "Color_null_" ;
-
-    if (markedForDigging)
-        tempSS << "dig_";
-    else if(!playerHasVision)
-        tempSS << "novision_";
-
-    Ogre::MaterialPtr requestedMaterial = Ogre::MaterialManager::getSingleton().getByName(tempSS.str());
-
-    //cout << "\nCloning material:  " << tempSS.str();
-
-    // If this texture has been copied and colourized, we can return
-    if (!requestedMaterial.isNull())
-        return tempSS.str();
-
-    // If not yet, then do so
-
-    // Check to see if we find a seat with the requested color, if not then just use the original, uncolored material.
-    if (seat == nullptr && !markedForDigging && playerHasVision)
-        return materialName;
-
-    Ogre::MaterialPtr oldMaterial = Ogre::MaterialManager::getSingleton().getByName(materialName);
-
-    //std::cout << "\nMaterial does not exist, creating a new one.";
-    Ogre::MaterialPtr newMaterial = oldMaterial->clone(tempSS.str());
-    bool cloned = mShaderGenerator->cloneShaderBasedTechniques(oldMaterial->getName(), oldMaterial->getGroup(),
-                                                 newMaterial->getName(), newMaterial->getGroup());
-    if(!cloned)
-    {
-        OD_LOG_ERR("Failed to clone rtss for material: " + materialName);
-    }
-
-    // Loop over the techniques for the new material
-    for (unsigned int j = 0; j < newMaterial->getNumTechniques(); ++j)
-    {
-        Ogre::Technique* technique = newMaterial->getTechnique(j);
-        if (technique->getNumPasses() == 0)
-            continue;
-
-        if (markedForDigging)
-        {
-            // Color the material with yellow on the latest pass
-            // so we're sure to see the taint.
-            Ogre::ColourValue color(1.0, 1.0, 0.0, 1.0);
-            for (uint16_t i = 0; i < technique->getNumPasses(); ++i)
-            {
-                Ogre::Pass* pass = technique->getPass(i);
-                pass->setSpecular(color);
-                pass->setAmbient(color);
-                pass->setDiffuse(color);
-                pass->setEmissive(color);
-            }
-        }
-        else if(!playerHasVision)
-        {
-            // Color the material with dark color on the latest pass
-            // so we're sure to see the taint.
-            Ogre::Pass* pass = technique->getPass(0);
-            Ogre::ColourValue color(0.2, 0.2, 0.2, 1.0);
-            pass->setSpecular(color);
-            pass->setAmbient(color);
-            pass->setDiffuse(color);
-        }
-        if (seat != nullptr)
-        {
-            // Color the material with the Seat's color.
-            Ogre::Pass* pass = technique->getPass(technique->getNumPasses() - 1);
-            Ogre::ColourValue color = seat->getColorValue();
-            color.a = 1.0;
-            pass->setAmbient(color);
-            pass->setDiffuse(color);
-            pass->setSpecular(color);
-        }
-    }
-
-    return tempSS.str();
-}
-
 void RenderManager::rrCarryEntity(Creature* carrier, GameEntity* carried)
 {
     Ogre::Entity* carrierEnt = mSceneManager->getEntity(carrier->getOgreNamePrefix() + carrier->getName());
@@ -1414,88 +1317,10 @@ void RenderManager::setEntityOpacity(Ogre::Entity* ent, float opacity)
     for (unsigned int i = 0; i < ent->getNumSubEntities(); ++i)
     {
         Ogre::SubEntity* subEntity = ent->getSubEntity(i);
-        subEntity->setMaterialName(setMaterialOpacity(subEntity->getMaterialName(), opacity));
+        subEntity->setMaterial(mMaterialVariants.getWithOpacity(subEntity->getMaterial(), opacity));
     }
 }
 
-std::string RenderManager::setMaterialOpacity(const std::string& materialName, float opacity)
-{
-    if (opacity < 0.0f || opacity > 1.0f)
-        return materialName;
-
-    std::stringstream newMaterialName;
-    newMaterialName.str("");
-
-    // Check whether the material name has alreay got an _alpha_ suffix and remove it.
-    size_t alphaPos = materialName.find("_alpha_");
-    // Create the material name accordingly.
-    if (alphaPos == std::string::npos)
-        newMaterialName << materialName;
-    else
-        newMaterialName << materialName.substr(0, alphaPos);
-
-    // Only precise the opactiy when its useful, otherwise give the original material name.
-    if (opacity != 1.0f)
-        newMaterialName << "_alpha_" << static_cast<int>(opacity * 255.0f);
-
-    Ogre::MaterialPtr requestedMaterial = Ogre::MaterialManager::getSingleton().getByName(newMaterialName.str());
-
-    // If this texture has been copied and colourized, we can return
-    if (!requestedMaterial.isNull())
-        return newMaterialName.str();
-
-    // If not yet, then do so
-    Ogre::MaterialPtr oldMaterial = Ogre::MaterialManager::getSingleton().getByName(materialName);
-    //std::cout << "\nMaterial does not exist, creating a new one.";
-    Ogre::MaterialPtr newMaterial = oldMaterial->clone(newMaterialName.str());
-    bool cloned = mShaderGenerator->cloneShaderBasedTechniques(oldMaterial->getName(), oldMaterial->getGroup(),
-                                                               newMaterial->getName(), newMaterial->getGroup());
-    if(!cloned)
-    {
-        OD_LOG_ERR("Failed to clone rtss for material: " + materialName);
-    }
-
-    // Loop over the techniques for the new material
-    for (auto i = 0; i < newMaterial->getNumTechniques(); ++i)
-    {
-        Ogre::Technique* technique = newMaterial->getTechnique(i);
-        for(auto j = 0; j < technique->getNumPasses(); ++j)
-        {
-            // Set alpha value for all passes
-            Ogre::Pass* pass = technique->getPass(j);
-            Ogre::ColourValue color = pass->getEmissive();
-            color.a = opacity;
-            pass->setEmissive(color);
-
-            color = pass->getSpecular();
-            color.a = opacity;
-            pass->setSpecular(color);
-
-            color = pass->getAmbient();
-            color.a = opacity;
-            pass->setAmbient(color);
-
-            color = pass->getDiffuse();
-            color.a = opacity;
-            pass->setDiffuse(color);
-
-            if (opacity < 1.0f)
-            {
-                pass->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
-                pass->setDepthWriteEnabled(false);
-            }
-            else
-            {
-                // Use sane default, but this should never happen...
-                pass->setSceneBlending(Ogre::SBT_MODULATE);
-                pass->setDepthWriteEnabled(true);
-            }
-        }
-    }
-
-    return newMaterialName.str();
-}
-
 void RenderManager::moveCursor(float relX, float relY)
 {
     Ogre::Camera* cam = mViewport->getCamera();
@@ -22,6 +22,8 @@
 #ifndef RENDERMANAGER_H
 #define RENDERMANAGER_H
 
+#include "render/MaterialVariantCache.h"
+
 #include <string>
 #include <OgreSingleton.h>
 #include <OgreMath.h>
@@ -37,6 +39,7 @@ class MapLight;
 class Creature;
 class Player;
 class RenderedMovableEntity;
+class Symbol;
 class Weapon;
 
 namespace Ogre
@@ -63,6 +66,9 @@ public:
     inline Ogre::SceneManager* getSceneManager() const
     { return mSceneManager; }
 
+    inline const MaterialVariantCache& getMaterialVariantCache() const
+    { return mMaterialVariants; }
+
     //! \brief Loop through the render requests in the queue and process them
     void updateRenderAnimations(Ogre::Real timeSinceLastFrame);
 
@@ -121,7 +127,7 @@ public:
     void rrDestroyCreatureVisualDebug(Creature* curCreature, Tile* curTile);
     void rrCreateSeatVisionVisualDebug(int seatId, Tile* tile);
     void rrDestroySeatVisionVisualDebug(int seatId, Tile* tile);
-    void rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, const std::string& animation, bool loop);
+    void rrSetObjectAnimationState(MovableGameEntity* curAnimatedObject, const Symbol& animation, bool loop);
     void rrMoveEntity(GameEntity* entity, const Ogre::Vector3& position);
     void rrMoveMapLightFlicker(MapLight* mapLight, const Ogre::Vector3& position);
     void rrCarryEntity(Creature* carrier, GameEntity* carried);
@@ -182,21 +188,11 @@ private:
     //! \brief Correctly places entities in hand next to the keeper hand
     void rrOrderHand(Player* localPlayer);
 
-    //! \brief Colorize the material with the corresponding team id color.
-    //! \note If the material (wall tiles only) is marked for digging, a yellow color is added
-    //! to the given color.
-    //! \returns The new material name according to the current colorization.
-    std::string colourizeMaterial(const std::string& materialName, const Seat* seat, bool markedForDigging, bool playerHasVision);
-
     //! \brief Colorize an entity with the team corresponding color.
     //! \Note: if the entity is marked for digging (wall tiles only), then a yellow color
     //! is added to the current colorization.
     void colourizeEntity(Ogre::Entity* ent, const Seat* seat, bool markedForDigging, bool playerHasVision);
 
-    //! \brief Makes the material be transparent with the given opacity (0.0f - 1.0f)
-    //! \returns The new material name according to the current opacity.
-    std::string setMaterialOpacity(const std::string& materialName, float opacity);
-
     //! \brief Disables all animations of the given entity and starts the given one
     Ogre::AnimationState* setEntityAnimation(Ogre::Entity* ent, const std::string& animation, bool loop);
 
@@ -215,6 +211,9 @@ private:
     Ogre::Viewport* mViewport;
     Ogre::RTShader::ShaderGenerator* mShaderGenerator;
 
+    //! \brief Colourized and transparent copies of the entities materials
+    MaterialVariantCache mMaterialVariants;
+
     //! For the keeper hand
     Ogre::SceneNode* mHandKeeperNode;
     Ogre::Light* mHandLight;
@@ -114,7 +114,8 @@ void Room::absorbRoom(Room *r)
     mCreaturesUsingRoom.insert(mCreaturesUsingRoom.end(), r->mCreaturesUsingRoom.begin(), r->mCreaturesUsingRoom.end());
     r->mCreaturesUsingRoom.clear();
 
-    mBuildingObjects.insert(r->mBuildingObjects.begin(), r->mBuildingObjects.end());
+    for(const std::pair<Tile*, BuildingObject*>& p : r->mBuildingObjects)
+        mBuildingObjects.insert(p);
     r->mBuildingObjects.clear();
 
     // We consider that the new room will be composed with the covered tiles it uses + the covered tiles absorbed. In the
@@ -570,7 +571,7 @@ void Room::restoreInitialEntityState()
 {
     // We restore the vision if we need to
     std::map<Seat*, std::vector<Tile*>> tiles;
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
     {
         if(p.second->mSeatsVision.empty())
             continue;
@@ -691,23 +692,6 @@ bool Room::sortForMapSave(Room* r1, Room* r2)
     return r1->getName().compare(r2->getName()) < 0;
 }
 
-void Room::fireRoomSound(Tile& tile, const std::string& soundFamily)
-{
-    std::string sound = "Rooms/" + soundFamily;
-    for(Seat* seat : tile.getSeatsWithVision())
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << sound << tile.getX() << tile.getY();
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
-}
-
 bool Room::importRoomFromStream(Room& room, std::istream& is)
 {
     return room.importFromStream(is);
@@ -351,7 +351,9 @@ void RoomBridge::claimForSeat(Seat* seat, Tile* tile, double danceRate)
 
     OD_LOG_INF("Bridge=" + getName() + " claimed by seat id=" + Helper::toString(seat->getId()));
     mClaimedValue = static_cast<double>(numCoveredTiles());
+    Seat* oldSeat = getSeat();
     setSeat(seat);
+    getGameMap()->notifyRoomSeatChanged(this, oldSeat);
 
     for(Tile* tile : mCoveredTiles)
         tile->claimTile(seat);
@@ -30,7 +30,7 @@
 #include "gamemap/GameMap.h"
 #include "gamemap/Pathfinding.h"
 #include "rooms/RoomManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
@@ -40,6 +40,13 @@ const std::string RoomCasinoName = "Casino";
 const std::string RoomCasinoNameDisplay = "Casino room";
 const RoomType RoomCasino::mRoomType = RoomType::casino;
 
+static RoomConfigParam<int32_t> CasinoCostPerTile("CasinoCostPerTile");
+static RoomConfigParam<uint32_t> CasinoCooldownWorkMin("CasinoCooldownWorkMin");
+static RoomConfigParam<uint32_t> CasinoCooldownWorkMax("CasinoCooldownWorkMax");
+static RoomConfigParam<double> CasinoFee("CasinoFee");
+static RoomConfigParam<double> CasinoWakefulnessPerWork("CasinoWakefulnessPerWork");
+static RoomConfigParam<int32_t> CasinoBet("CasinoBet");
+
 namespace
 {
 class RoomCasinoFactory : public RoomFactory
@@ -54,7 +61,7 @@ class RoomCasinoFactory : public RoomFactory
     { return RoomCasinoNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("CasinoCostPerTile"); }
+    { return CasinoCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -370,16 +377,16 @@ void RoomCasino::doUpkeep()
             return;
         }
 
-        ro->setAnimationState("Triggered", false);
+        ro->setAnimationState(EntityAnimation::triggered_anim, false);
 
         // TODO: we could use the wall active spots to change feePercent/bets
 
         // We set anim for both creatures
-        uint32_t cooldown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMin"),
-            ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMax"));
-        double feePercent = std::min(ConfigManager::getSingleton().getRoomConfigDouble("CasinoFee"), 1.0);
-        double wakefullness = ConfigManager::getSingleton().getRoomConfigDouble("CasinoWakefulnessPerWork");
-        int32_t creatureBet = ConfigManager::getSingleton().getRoomConfigInt32("CasinoBet");
+        uint32_t cooldown = Random::Uint(CasinoCooldownWorkMin.get(),
+            CasinoCooldownWorkMax.get());
+        double feePercent = std::min(CasinoFee.get(), 1.0);
+        double wakefullness = CasinoWakefulnessPerWork.get();
+        int32_t creatureBet = CasinoBet.get();
         creatureBet = std::min(creatureBet, p.second.mCreature1.mCreature->getGoldCarried());
         creatureBet = std::min(creatureBet, p.second.mCreature2.mCreature->getGoldCarried());
         int32_t totalBet = 0;
@@ -27,7 +27,7 @@
 #include "game/Player.h"
 #include "gamemap/GameMap.h"
 #include "rooms/RoomManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
@@ -36,6 +36,8 @@ const std::string RoomDormitoryName = "Dormitory";
 const std::string RoomDormitoryNameDisplay = "Dormitory room";
 const RoomType RoomDormitory::mRoomType = RoomType::dormitory;
 
+static RoomConfigParam<int32_t> DormitoryCostPerTile("DormitoryCostPerTile");
+
 namespace
 {
 class RoomDormitoryFactory : public RoomFactory
@@ -50,7 +52,7 @@ class RoomDormitoryFactory : public RoomFactory
     { return RoomDormitoryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("DormitoryCostPerTile"); }
+    { return DormitoryCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -165,7 +167,7 @@ std::vector<Tile*> RoomDormitory::getOpenTiles()
 {
     std::vector<Tile*> returnVector;
 
-    for (std::pair<Tile* const, TileData*>& p : mTileData)
+    for (std::pair<Tile*, TileData*>& p : mTileData)
     {
         RoomDormitoryTileData* roomDormitoryTileData = static_cast<RoomDormitoryTileData*>(p.second);
         if (roomDormitoryTileData->mHP <=0)
@@ -264,7 +266,7 @@ bool RoomDormitory::releaseTileForSleeping(Tile* t, Creature* c)
         return false;
 
     // Loop over all the tiles in this room and if they are slept on by creature c then set them back to nullptr.
-    for (std::pair<Tile* const, TileData*>& p : mTileData)
+    for (std::pair<Tile*, TileData*>& p : mTileData)
     {
         RoomDormitoryTileData* roomDormitoryTileData = static_cast<RoomDormitoryTileData*>(p.second);
         if (roomDormitoryTileData->mCreature == c)
@@ -27,7 +27,7 @@
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "rooms/RoomManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
 
@@ -35,6 +35,9 @@ const std::string RoomHatcheryName = "Hatchery";
 const std::string RoomHatcheryNameDisplay = "Hatchery room";
 const RoomType RoomHatchery::mRoomType = RoomType::hatchery;
 
+static RoomConfigParam<int32_t> HatcheryCostPerTile("HatcheryCostPerTile");
+static RoomConfigParam<uint32_t> HatcheryChickenSpawnRate("HatcheryChickenSpawnRate");
+
 namespace
 {
 class RoomHatcheryFactory : public RoomFactory
@@ -49,7 +52,7 @@ class RoomHatcheryFactory : public RoomFactory
     { return RoomHatcheryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("HatcheryCostPerTile"); }
+    { return HatcheryCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -155,7 +158,7 @@ void RoomHatchery::doUpkeep()
 
     // Chickens have been eaten. We check when we will spawn another one
     ++mSpawnChickenCooldown;
-    if(mSpawnChickenCooldown < ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryChickenSpawnRate"))
+    if(mSpawnChickenCooldown < HatcheryChickenSpawnRate.get())
         return;
 
     // We spawn 1 chicken per chicken coop (until chickens are maxed)
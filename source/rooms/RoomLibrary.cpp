@@ -28,7 +28,7 @@
 #include "game/Seat.h"
 #include "gamemap/GameMap.h"
 #include "rooms/RoomManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/Random.h"
@@ -37,6 +37,13 @@ const std::string RoomLibraryName = "Library";
 const std::string RoomLibraryNameDisplay = "Library room";
 const RoomType RoomLibrary::mRoomType = RoomType::library;
 
+static RoomConfigParam<int32_t> LibraryCostPerTile("LibraryCostPerTile");
+static RoomConfigParam<int32_t> LibrarySkillPointsBook("LibrarySkillPointsBook");
+static RoomConfigParam<double> LibraryPointsPerWork("LibraryPointsPerWork");
+static RoomConfigParam<double> LibraryWakefulnessPerWork("LibraryWakefulnessPerWork");
+static RoomConfigParam<uint32_t> LibraryCooldownWorkMin("LibraryCooldownWorkMin");
+static RoomConfigParam<uint32_t> LibraryCooldownWorkMax("LibraryCooldownWorkMax");
+
 namespace
 {
 class RoomLibraryFactory : public RoomFactory
@@ -51,7 +58,7 @@ class RoomLibraryFactory : public RoomFactory
     { return RoomLibraryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("LibraryCostPerTile"); }
+    { return LibraryCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -324,7 +331,7 @@ void RoomLibrary::doUpkeep()
 
 bool RoomLibrary::useRoom(Creature& creature, bool forced)
 {
-    int32_t skillEntityPoints = ConfigManager::getSingleton().getRoomConfigInt32("LibrarySkillPointsBook");
+    int32_t skillEntityPoints = LibrarySkillPointsBook.get();
     auto it = mCreaturesSpots.find(&creature);
     if(it == mCreaturesSpots.end())
     {
@@ -368,16 +375,16 @@ bool RoomLibrary::useRoom(Creature& creature, bool forced)
     walkDirection.normalise();
     creature.setAnimationState(EntityAnimation::attack_anim, false, walkDirection);
 
-    ro->setAnimationState("Triggered", false);
+    ro->setAnimationState(EntityAnimation::triggered_anim, false);
 
     const CreatureRoomAffinity& creatureRoomAffinity = creature.getDefinition()->getRoomAffinity(getType());
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
-    int32_t pointsEarned = static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("LibraryPointsPerWork"));
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("LibraryWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMax")));
+    int32_t pointsEarned = static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * LibraryPointsPerWork.get());
+    creature.jobDone(LibraryWakefulnessPerWork.get());
+    creature.setJobCooldown(Random::Uint(LibraryCooldownWorkMin.get(),
+        LibraryCooldownWorkMax.get()));
 
     // We check if we have enough points to create a skill entity
     mSkillPoints += pointsEarned;
@@ -416,7 +423,7 @@ uint32_t RoomLibrary::countSkillItemsOnRoom()
 
 Tile* RoomLibrary::checkIfAvailableSpot()
 {
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
     {
         RoomLibraryTileData* roomLibraryTileData = static_cast<RoomLibraryTileData*>(p.second);
         if(!roomLibraryTileData->mCanHaveSkillEntity)
@@ -29,6 +29,7 @@
 #include "network/ServerNotification.h"
 #include "rooms/RoomManager.h"
 #include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/Random.h"
@@ -39,6 +40,9 @@ const std::string RoomPortalName = "Portal";
 const std::string RoomPortalNameDisplay = "Portal room";
 const RoomType RoomPortal::mRoomType = RoomType::portal;
 
+static RoomConfigParam<uint32_t> PortalCooldownSpawnMin("PortalCooldownSpawnMin");
+static RoomConfigParam<uint32_t> PortalCooldownSpawnMax("PortalCooldownSpawnMax");
+
 namespace
 {
 class RoomPortalFactory : public RoomFactory
@@ -147,7 +151,9 @@ void RoomPortal::claimForSeat(Seat* seat, Tile* tile, double danceRate)
     }
 
     mClaimedValue = static_cast<double>(numCoveredTiles());
+    Seat* oldSeat = getSeat();
     setSeat(seat);
+    getGameMap()->notifyRoomSeatChanged(this, oldSeat);
 
     for(Tile* tile : mCoveredTiles)
         tile->claimTile(seat);
@@ -196,7 +202,7 @@ void RoomPortal::updatePortalPosition()
         return;
 
     mPortalObject = new PersistentObject(getGameMap(), *this, "PortalObject",
-        centralTile, 0.0, false, 1.0f, "Idle", true);
+        centralTile, 0.0, false, 1.0f, EntityAnimation::idle_anim, true);
     addBuildingObject(centralTile, mPortalObject);
 }
 
@@ -216,8 +222,8 @@ void RoomPortal::doUpkeep()
         --mSpawnCreatureCountdown;
         return;
     }
-    mSpawnCreatureCountdown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMax"));
+    mSpawnCreatureCountdown = Random::Uint(PortalCooldownSpawnMin.get(),
+        PortalCooldownSpawnMax.get());
 
     if (mCoveredTiles.empty())
         return;
@@ -256,7 +262,7 @@ void RoomPortal::spawnCreature()
         return;
 
     if (mPortalObject != nullptr)
-        mPortalObject->setAnimationState("Triggered", false);
+        mPortalObject->setAnimationState(EntityAnimation::triggered_anim, false);
 
     Ogre::Real xPos = static_cast<Ogre::Real>(centralTile->getX());
     Ogre::Real yPos = static_cast<Ogre::Real>(centralTile->getY());
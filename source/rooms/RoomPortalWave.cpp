@@ -197,7 +197,7 @@ void RoomPortalWave::claimForSeat(Seat* seat, Tile* tile, double danceRate)
     }
 
     // In the case of RoomPortalWave, when it is claimed, it is destroyed
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
         p.second->mHP = 0.0;
 }
 
@@ -246,7 +246,7 @@ void RoomPortalWave::updatePortalPosition()
     mPortalObject = new PersistentObject(getGameMap(), *this, "KnightCoffin", centralTile, 0.0, false);
     addBuildingObject(centralTile, mPortalObject);
 
-    mPortalObject->setAnimationState("Idle");
+    mPortalObject->setAnimationState(EntityAnimation::idle_anim);
 }
 
 void RoomPortalWave::destroyMeshLocal()
@@ -282,7 +282,7 @@ void RoomPortalWave::doUpkeep()
     if (mSpawnCountdown < mTurnsBetween2Waves)
     {
         ++mSpawnCountdown;
-        mPortalObject->setAnimationState("Idle");
+        mPortalObject->setAnimationState(EntityAnimation::idle_anim);
         return;
     }
 
@@ -331,7 +331,7 @@ void RoomPortalWave::spawnWave(RoomPortalWaveData* roomPortalWaveData, uint32_t
         return;
 
     if (mPortalObject != nullptr)
-        mPortalObject->setAnimationState("Triggered", false);
+        mPortalObject->setAnimationState(EntityAnimation::triggered_anim, false);
 
     Ogre::Real xPos = static_cast<Ogre::Real>(centralTile->getX());
     Ogre::Real yPos = static_cast<Ogre::Real>(centralTile->getY());
@@ -723,7 +723,7 @@ bool RoomPortalWave::handleSearchFoe()
     uint32_t index = Random::Uint(0, creatures.size() - 1);
     Creature* creature = creatures[index];
 
-    std::vector<Room*> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
+    BuildingView<Room> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
 
     // First, we check if a dungeon temple is reachable by ground. If yes, we cast a call to war
     // if not, we search the closest and try to go there
@@ -850,7 +850,7 @@ bool RoomPortalWave::handleDigging()
 
     // We sort the dungeon temples by distance. We will try to reach the closest accessible one
     std::vector<std::pair<Room*,Ogre::Real>> tileDungeons;
-    std::vector<Room*> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
+    BuildingView<Room> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
     for(Room* room : dungeonTemples)
     {
         // We check if the strategy allows us to attack the dungeon
@@ -1102,7 +1102,7 @@ void RoomPortalWave::handleFirstUpkeep()
     if(mRangeTilesAttack <= 0)
     {
         // We take all dungeons
-        std::vector<Room*> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
+        BuildingView<Room> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
         for(Room* room : dungeonTemples)
         {
             Seat* roomSeat = room->getSeat();
@@ -1124,7 +1124,7 @@ void RoomPortalWave::handleFirstUpkeep()
     }
 
     double squaredRange = static_cast<double>(mRangeTilesAttack) * static_cast<double>(mRangeTilesAttack);
-    std::vector<Room*> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
+    BuildingView<Room> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
     for(Room* room : dungeonTemples)
     {
         Seat* roomSeat = room->getSeat();
@@ -28,7 +28,7 @@
 #include "network/ODServer.h"
 #include "network/ServerNotification.h"
 #include "rooms/RoomManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
@@ -38,6 +38,12 @@ const std::string RoomTortureName = "Torture";
 const std::string RoomTortureNameDisplay = "Torture room";
 const RoomType RoomTorture::mRoomType = RoomType::torture;
 
+static RoomConfigParam<int32_t> TortureCostPerTile("TortureCostPerTile");
+static RoomConfigParam<double> TortureDamagePerTurn("TortureDamagePerTurn");
+static RoomConfigParam<double> TortureRallyPercent("TortureRallyPercent");
+static RoomConfigParam<uint32_t> TortureSessionLengthMin("TortureSessionLengthMin");
+static RoomConfigParam<uint32_t> TortureSessionLengthMax("TortureSessionLengthMax");
+
 namespace
 {
 class RoomTortureFactory : public RoomFactory
@@ -52,7 +58,7 @@ class RoomTortureFactory : public RoomFactory
     { return RoomTortureNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TortureCostPerTile"); }
+    { return TortureCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -281,7 +287,6 @@ void RoomTorture::doUpkeep()
     if (mCoveredTiles.empty())
         return;
 
-    ConfigManager& config = ConfigManager::getSingleton();
     for(std::pair<Tile* const,RoomTortureCreatureInfo>& p : mCreaturesSpots)
     {
         if(p.second.mCreature == nullptr)
@@ -297,7 +302,7 @@ void RoomTorture::doUpkeep()
             break;
         }
         creature->increaseTurnsTorture();
-        double damage = config.getRoomConfigDouble("TortureDamagePerTurn");
+        double damage = TortureDamagePerTurn.get();
         creature->takeDamage(this, damage, 0.0, 0.0, 0.0, tileCreature, false);
         break;
     }
@@ -312,7 +317,6 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         return false;
     }
 
-    ConfigManager& config = ConfigManager::getSingleton();
     for(std::pair<Tile* const,RoomTortureCreatureInfo>& p : mCreaturesSpots)
     {
         if(p.second.mCreature != &creature)
@@ -328,7 +332,7 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         p.second.mIsReady = true;
 
         if((getSeat() != creature.getSeat()) &&
-           (Random::Double(0.0, 1.0) <= config.getRoomConfigDouble("TortureRallyPercent")))
+           (Random::Double(0.0, 1.0) <= TortureRallyPercent.get()))
         {
             // The creature changes side
             creature.changeSeat(getSeat());
@@ -349,8 +353,8 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         }
 
         // We start the fire effect and we set job cooldown
-        uint32_t nbTurns = Random::Uint(config.getRoomConfigUInt32("TortureSessionLengthMin"),
-            config.getRoomConfigUInt32("TortureSessionLengthMax"));
+        uint32_t nbTurns = Random::Uint(TortureSessionLengthMin.get(),
+            TortureSessionLengthMax.get());
         creature.setJobCooldown(nbTurns);
 
         BuildingObject* obj = getBuildingObjectFromTile(tileCreature);
@@ -24,7 +24,7 @@
 #include "game/Player.h"
 #include "gamemap/GameMap.h"
 #include "rooms/RoomManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/Random.h"
@@ -33,6 +33,14 @@ const std::string RoomTrainingHallName = "TrainingHall";
 const std::string RoomTrainingHallNameDisplay = "Training hall room";
 const RoomType RoomTrainingHall::mRoomType = RoomType::trainingHall;
 
+static RoomConfigParam<int32_t> TrainHallCostPerTile("TrainHallCostPerTile");
+static RoomConfigParam<uint32_t> TrainHallMaxTrainingLevel("TrainHallMaxTrainingLevel");
+static RoomConfigParam<double> TrainHallBonusWallActiveSpot("TrainHallBonusWallActiveSpot");
+static RoomConfigParam<double> TrainHallXpPerAttack("TrainHallXpPerAttack");
+static RoomConfigParam<double> TrainHallWakefulnessPerAttack("TrainHallWakefulnessPerAttack");
+static RoomConfigParam<uint32_t> TrainHallCooldownHitMin("TrainHallCooldownHitMin");
+static RoomConfigParam<uint32_t> TrainHallCooldownHitMax("TrainHallCooldownHitMax");
+
 namespace
 {
 class RoomTrainingHallFactory : public RoomFactory
@@ -47,7 +55,7 @@ class RoomTrainingHallFactory : public RoomFactory
     { return RoomTrainingHallNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TrainHallCostPerTile"); }
+    { return TrainHallCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -266,7 +274,7 @@ void RoomTrainingHall::refreshCreaturesDummies()
 
 bool RoomTrainingHall::hasOpenCreatureSpot(Creature* c)
 {
-    if (c->getLevel() >= ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallMaxTrainingLevel"))
+    if (c->getLevel() >= TrainHallMaxTrainingLevel.get())
         return false;
 
     // We accept all creatures as soon as there are free dummies
@@ -383,20 +391,20 @@ bool RoomTrainingHall::useRoom(Creature& creature, bool forced)
     Ogre::Vector3 walkDirection(ro->getPosition().x - creature.getPosition().x, ro->getPosition().y - creature.getPosition().y, 0);
     walkDirection.normalise();
     creature.setAnimationState(EntityAnimation::attack_anim, false, walkDirection);
-    ro->setAnimationState("Triggered", false);
+    ro->setAnimationState(EntityAnimation::triggered_anim, false);
     const CreatureRoomAffinity& creatureRoomAffinity = creature.getDefinition()->getRoomAffinity(getType());
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
     // We add a bonus per wall active spots
-    double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * ConfigManager::getSingleton().getRoomConfigDouble("TrainHallBonusWallActiveSpot");
-    double expReceived = creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("TrainHallXpPerAttack");
+    double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * TrainHallBonusWallActiveSpot.get();
+    double expReceived = creatureRoomAffinity.getEfficiency() * TrainHallXpPerAttack.get();
     expReceived *= coef;
 
     creature.receiveExp(expReceived);
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("TrainHallWakefulnessPerAttack"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallCooldownHitMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallCooldownHitMax")));
+    creature.jobDone(TrainHallWakefulnessPerAttack.get());
+    creature.setJobCooldown(Random::Uint(TrainHallCooldownHitMin.get(),
+        TrainHallCooldownHitMax.get()));
 
     return false;
 }
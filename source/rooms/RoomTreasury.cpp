@@ -31,10 +31,11 @@
 #include "network/ServerNotification.h"
 #include "rooms/RoomManager.h"
 #include "sound/SoundEffectsManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/Random.h"
+#include "utils/Symbol.h"
 
 #include <string>
 
@@ -42,6 +43,8 @@ const std::string RoomTreasuryName = "Treasury";
 const std::string RoomTreasuryNameDisplay = "Treasury room";
 const RoomType RoomTreasury::mRoomType = RoomType::treasury;
 
+static RoomConfigParam<int32_t> TreasuryCostPerTile("TreasuryCostPerTile");
+
 namespace
 {
 class RoomTreasuryFactory : public RoomFactory
@@ -56,7 +59,7 @@ class RoomTreasuryFactory : public RoomFactory
     { return RoomTreasuryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TreasuryCostPerTile"); }
+    { return TreasuryCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -221,8 +224,7 @@ class RoomTreasuryFactory : public RoomFactory
         int32_t pricePerTarget = RoomManager::costPerTile(RoomTreasury::mRoomType);
         int32_t price = static_cast<int32_t>(tiles.size()) * pricePerTarget;
         // First treasury tile is free
-        std::vector<Room*> treasuriesOwned = gameMap->getRoomsByTypeAndSeat(RoomTreasury::mRoomType, player->getSeat());
-        if(treasuriesOwned.empty())
+        if(gameMap->getRoomsByTypeAndSeat(RoomTreasury::mRoomType, player->getSeat()).empty())
             price -= pricePerTarget;
 
         return price;
@@ -251,7 +253,7 @@ void RoomTreasury::doUpkeep()
 
     if(mGoldChanged)
     {
-        for (std::pair<Tile* const, TileData*>& p : mTileData)
+        for (std::pair<Tile*, TileData*>& p : mTileData)
         {
             RoomTreasuryTileData* roomTreasuryTileData = static_cast<RoomTreasuryTileData*>(p.second);
             updateMeshesForTile(p.first, roomTreasuryTileData);
@@ -287,7 +289,23 @@ bool RoomTreasury::removeCoveredTile(Tile* t)
 
     roomTreasuryTileData->mMeshOfTile.clear();
     roomTreasuryTileData->mGoldInTile = 0;
-    return Room::removeCoveredTile(t);
+    bool ret = Room::removeCoveredTile(t);
+    getGameMap()->notifyTreasuryTilesChanged(this);
+    return ret;
+}
+
+void RoomTreasury::absorbRoom(Room* r)
+{
+    Room::absorbRoom(r);
+    // The gold stored in the absorbed room now belongs to this one
+    getGameMap()->notifyTreasuryTilesChanged(r);
+    getGameMap()->notifyTreasuryTilesChanged(this);
+}
+
+void RoomTreasury::repairRoom()
+{
+    Room::repairRoom();
+    getGameMap()->notifyTreasuryTilesChanged(this);
 }
 
 int RoomTreasury::getTotalGoldStorage() const
@@ -299,7 +317,7 @@ int RoomTreasury::getTotalGoldStored() const
 {
     int totalGold = 0;
 
-    for (const std::pair<Tile* const, TileData*>& p : mTileData)
+    for (const std::pair<Tile*, TileData*>& p : mTileData)
     {
         RoomTreasuryTileData* roomTreasuryTileData = static_cast<RoomTreasuryTileData*>(p.second);
         totalGold += roomTreasuryTileData->mGoldInTile;
@@ -320,7 +338,7 @@ int RoomTreasury::depositGold(int gold, Tile *tile)
     goldToDeposit -= goldDeposited;
 
     // If there is still gold left to deposit after the first tile, loop over all of the tiles and see if we can put the gold in another tile.
-    for (std::pair<Tile* const, TileData*>& p : mTileData)
+    for (std::pair<Tile*, TileData*>& p : mTileData)
     {
         if(goldToDeposit <= 0)
             break;
@@ -344,10 +362,12 @@ int RoomTreasury::depositGold(int gold, Tile *tile)
         return wasDeposited;
 
     mGoldChanged = true;
+    getGameMap()->notifyTreasuryGoldChanged(this, wasDeposited);
 
     // Tells the client to play a deposit gold sound. For now, we only send it to the players
     // with vision on tile
-    fireRoomSound(*tile, "Treasury/DepositGold");
+    static const Symbol soundDepositGold("Rooms/Treasury/DepositGold");
+    getGameMap()->fireSpatialSound(*tile, soundDepositGold);
 
     return wasDeposited;
 }
@@ -357,7 +377,7 @@ int RoomTreasury::withdrawGold(int gold)
     mGoldChanged = true;
 
     int withdrawlAmount = 0;
-    for (std::pair<Tile* const, TileData*>& p : mTileData)
+    for (std::pair<Tile*, TileData*>& p : mTileData)
     {
         RoomTreasuryTileData* roomTreasuryTileData = static_cast<RoomTreasuryTileData*>(p.second);
         // Check to see if the current room tile has enough gold in it to fill the amount we still need to pick up.
@@ -377,6 +397,7 @@ int RoomTreasury::withdrawGold(int gold)
         }
     }
 
+    getGameMap()->notifyTreasuryGoldChanged(this, -withdrawlAmount);
     return withdrawlAmount;
 }
 
@@ -56,6 +56,8 @@ public:
 
     // Functions overriding virtual functions in the Room base class.
     bool removeCoveredTile(Tile* t) override;
+    void absorbRoom(Room* r) override;
+    void repairRoom() override;
 
     // Functions specific to this class.
     virtual void doUpkeep() override;
@@ -30,7 +30,7 @@
 #include "traps/Trap.h"
 #include "traps/TrapManager.h"
 #include "traps/TrapType.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/Random.h"
@@ -39,6 +39,12 @@ const std::string RoomWorkshopName = "Workshop";
 const std::string RoomWorkshopNameDisplay = "Workshop room";
 const RoomType RoomWorkshop::mRoomType = RoomType::workshop;
 
+static RoomConfigParam<int32_t> WorkshopCostPerTile("WorkshopCostPerTile");
+static RoomConfigParam<double> WorkshopPointsPerWork("WorkshopPointsPerWork");
+static RoomConfigParam<double> WorkshopWakefulnessPerWork("WorkshopWakefulnessPerWork");
+static RoomConfigParam<uint32_t> WorkshopCooldownWorkMin("WorkshopCooldownWorkMin");
+static RoomConfigParam<uint32_t> WorkshopCooldownWorkMax("WorkshopCooldownWorkMax");
+
 namespace
 {
 class RoomWorkshopFactory : public RoomFactory
@@ -53,7 +59,7 @@ class RoomWorkshopFactory : public RoomFactory
     { return RoomWorkshopNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("WorkshopCostPerTile"); }
+    { return WorkshopCostPerTile.get(); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -141,7 +147,7 @@ BuildingObject* RoomWorkshop::notifyActiveSpotCreated(ActiveSpotPlace place, Til
             if(result < 2)
                 return new BuildingObject(getGameMap(), *this, "WorkshopMachine1", tile, x, y, z, 30.0, false);
             else
-                return new BuildingObject(getGameMap(), *this, "WorkshopMachine2", tile, x, y, z, 30.0, false, 1.0, "Loop");
+                return new BuildingObject(getGameMap(), *this, "WorkshopMachine2", tile, x, y, z, 30.0, false, 1.0, EntityAnimation::loop_anim);
         }
         case ActiveSpotPlace::activeSpotLeft:
         {
@@ -465,16 +471,16 @@ bool RoomWorkshop::useRoom(Creature& creature, bool forced)
     walkDirection.normalise();
     creature.setAnimationState(EntityAnimation::attack_anim, false, walkDirection);
 
-    ro->setAnimationState("Triggered", false);
+    ro->setAnimationState(EntityAnimation::triggered_anim, false);
 
     const CreatureRoomAffinity& creatureRoomAffinity = creature.getDefinition()->getRoomAffinity(getType());
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
-    mPoints += static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("WorkshopPointsPerWork"));
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("WorkshopWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMax")));
+    mPoints += static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * WorkshopPointsPerWork.get());
+    creature.jobDone(WorkshopWakefulnessPerWork.get());
+    creature.setJobCooldown(Random::Uint(WorkshopCooldownWorkMin.get(),
+        WorkshopCooldownWorkMax.get()));
 
     return false;
 }
@@ -492,7 +498,7 @@ uint32_t RoomWorkshop::countCraftedItemsOnRoom()
 
 Tile* RoomWorkshop::checkIfAvailableSpot()
 {
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
     {
         // If the tile contains no crafted trap, we can add a new one
         RoomWorkshopTileData* roomWorkshopTileData = static_cast<RoomWorkshopTileData*>(p.second);
@@ -59,8 +59,6 @@ public:
     virtual void computeVisibleTiles()
     {}
 
-    static void fireSpellSound(Tile& tile, const std::string& soundFamily);
-
     static std::string getSpellStreamFormat();
 
 protected:
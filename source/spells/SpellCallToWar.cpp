@@ -26,15 +26,18 @@
 #include "modes/InputManager.h"
 #include "network/ODClient.h"
 #include "spells/SpellManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
 const std::string SpellCallToWarName = "callToWar";
 const std::string SpellCallToWarNameDisplay = "Call to war";
-const std::string SpellCallToWarCooldownKey = "CallToWarCooldown";
 const SpellType SpellCallToWar::mSpellType = SpellType::callToWar;
 
+static SpellConfigParam<uint32_t> CallToWarCooldown("CallToWarCooldown");
+static SpellConfigParam<int32_t> CallToWarNbTurnsMax("CallToWarNbTurnsMax");
+static SpellConfigParam<int32_t> CallToWarPrice("CallToWarPrice");
+
 namespace
 {
 class SpellCallToWarFactory : public SpellFactory
@@ -45,8 +48,8 @@ class SpellCallToWarFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCallToWarName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCallToWarCooldownKey; }
+    uint32_t getCooldown() const override
+    { return CallToWarCooldown.get(); }
 
     const std::string& getNameReadable() const override
     { return SpellCallToWarNameDisplay; }
@@ -70,9 +73,9 @@ static SpellRegister reg(new SpellCallToWarFactory);
 
 SpellCallToWar::SpellCallToWar(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(SpellType::callToWar), "WarBanner", 0.0,
-        ConfigManager::getSingleton().getSpellConfigInt32("CallToWarNbTurnsMax"))
+        CallToWarNbTurnsMax.get())
 {
-    mPrevAnimationState = "Loop";
+    mPrevAnimationState = EntityAnimation::loop_anim;
     mPrevAnimationStateLoop = true;
 }
 
@@ -110,7 +113,7 @@ void SpellCallToWar::checkSpellCast(GameMap* gameMap, const InputManager& inputM
         return;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("CallToWarPrice");
+    int32_t price = CallToWarPrice.get();
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
         if(playerMana < price)
@@ -153,7 +156,7 @@ bool SpellCallToWar::castSpell(GameMap* gameMap, Player* player, ODPacket& packe
         return false;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t manaCost = ConfigManager::getSingleton().getSpellConfigInt32("CallToWarPrice");
+    int32_t manaCost = CallToWarPrice.get();
     if(playerMana < manaCost)
         return false;
 
@@ -31,15 +31,20 @@
 #include "sound/SoundEffectsManager.h"
 #include "spells/SpellType.h"
 #include "spells/SpellManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Symbol.h"
 
 const std::string SpellCreatureDefenseName = "creatureDefense";
 const std::string SpellCreatureDefenseNameDisplay = "Creature defense";
-const std::string SpellCreatureDefenseCooldownKey = "CreatureDefenseCooldown";
 const SpellType SpellCreatureDefense::mSpellType = SpellType::creatureDefense;
 
+static SpellConfigParam<uint32_t> CreatureDefenseCooldown("CreatureDefenseCooldown");
+static SpellConfigParam<int32_t> CreatureDefensePrice("CreatureDefensePrice");
+static SpellConfigParam<uint32_t> CreatureDefenseDuration("CreatureDefenseDuration");
+static SpellConfigParam<double> CreatureDefenseValue("CreatureDefenseValue");
+
 namespace
 {
 class SpellCreatureDefenseFactory : public SpellFactory
@@ -50,8 +55,8 @@ class SpellCreatureDefenseFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureDefenseName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureDefenseCooldownKey; }
+    uint32_t getCooldown() const override
+    { return CreatureDefenseCooldown.get(); }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureDefenseNameDisplay; }
@@ -76,7 +81,7 @@ static SpellRegister reg(new SpellCreatureDefenseFactory);
 void SpellCreatureDefense::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureDefensePrice");
+    int32_t pricePerTarget = CreatureDefensePrice.get();
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -194,17 +199,18 @@ bool SpellCreatureDefense::castSpell(GameMap* gameMap, Player* player, ODPacket&
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureDefensePrice");
+    int32_t pricePerTarget = CreatureDefensePrice.get();
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureDefenseDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureDefenseValue");
+    uint32_t duration = CreatureDefenseDuration.get();
+    double value = CreatureDefenseValue.get();
     CreatureEffectDefense* effect = new CreatureEffectDefense(duration, value, 0.0, 0.0, "SpellCreatureDefense");
     creature->addCreatureEffect(effect);
 
-    fireSpellSound(*pos, "Defense");
+    static const Symbol soundDefense("Spells/Defense");
+    gameMap->fireSpatialSound(*pos, soundDefense);
 
     return true;
 }
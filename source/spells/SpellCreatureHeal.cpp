@@ -30,15 +30,20 @@
 #include "sound/SoundEffectsManager.h"
 #include "spells/SpellType.h"
 #include "spells/SpellManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/Symbol.h"
 
 const std::string SpellCreatureHealName = "creatureHeal";
 const std::string SpellCreatureHealNameDisplay = "Creature heal";
-const std::string SpellCreatureHealCooldownKey = "CreatureHealCooldown";
 const SpellType SpellCreatureHeal::mSpellType = SpellType::creatureHeal;
 
+static SpellConfigParam<uint32_t> CreatureHealCooldown("CreatureHealCooldown");
+static SpellConfigParam<int32_t> CreatureHealPrice("CreatureHealPrice");
+static SpellConfigParam<uint32_t> CreatureHealDuration("CreatureHealDuration");
+static SpellConfigParam<double> CreatureHealValue("CreatureHealValue");
+
 namespace
 {
 class SpellCreatureHealFactory : public SpellFactory
@@ -49,8 +54,8 @@ class SpellCreatureHealFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureHealName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureHealCooldownKey; }
+    uint32_t getCooldown() const override
+    { return CreatureHealCooldown.get(); }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureHealNameDisplay; }
@@ -76,7 +81,7 @@ void SpellCreatureHeal::checkSpellCast(GameMap* gameMap, const InputManager& inp
 {
     Player* player = gameMap->getLocalPlayer();
     int32_t priceTotal = 0;
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHealPrice");
+    int32_t pricePerTarget = CreatureHealPrice.get();
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -233,7 +238,7 @@ bool SpellCreatureHeal::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
     if(creatures.empty())
         return false;
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHealPrice");
+    int32_t pricePerTarget = CreatureHealPrice.get();
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     uint32_t nbTargets = std::min(static_cast<uint32_t>(playerMana / pricePerTarget), static_cast<uint32_t>(creatures.size()));
     int32_t priceTotal = nbTargets * pricePerTarget;
@@ -244,8 +249,8 @@ bool SpellCreatureHeal::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
     if(!player->getSeat()->takeMana(priceTotal))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureHealDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureHealValue");
+    uint32_t duration = CreatureHealDuration.get();
+    double value = CreatureHealValue.get();
     std::vector<Tile*> affectedTiles;
     for(Creature* creature : creatures)
     {
@@ -267,7 +272,8 @@ bool SpellCreatureHeal::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
 
     for(Tile* tile : affectedTiles)
     {
-        fireSpellSound(*tile, "Heal");
+        static const Symbol soundHeal("Spells/Heal");
+        gameMap->fireSpatialSound(*tile, soundHeal);
     }
 
     return true;
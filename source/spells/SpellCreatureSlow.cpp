@@ -30,15 +30,19 @@
 #include "network/ODClient.h"
 #include "spells/SpellType.h"
 #include "spells/SpellManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
 const std::string SpellCreatureSlowName = "creatureSlow";
 const std::string SpellCreatureSlowNameDisplay = "Creature Slow";
-const std::string SpellCreatureSlowCooldownKey = "CreatureSlowCooldown";
 const SpellType SpellCreatureSlow::mSpellType = SpellType::creatureSlow;
 
+static SpellConfigParam<uint32_t> CreatureSlowCooldown("CreatureSlowCooldown");
+static SpellConfigParam<int32_t> CreatureSlowPrice("CreatureSlowPrice");
+static SpellConfigParam<uint32_t> CreatureSlowDuration("CreatureSlowDuration");
+static SpellConfigParam<double> CreatureSlowValue("CreatureSlowValue");
+
 namespace
 {
 class SpellCreatureSlowFactory : public SpellFactory
@@ -49,8 +53,8 @@ class SpellCreatureSlowFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureSlowName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureSlowCooldownKey; }
+    uint32_t getCooldown() const override
+    { return CreatureSlowCooldown.get(); }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureSlowNameDisplay; }
@@ -75,7 +79,7 @@ static SpellRegister reg(new SpellCreatureSlowFactory);
 void SpellCreatureSlow::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureSlowPrice");
+    int32_t pricePerTarget = CreatureSlowPrice.get();
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +197,13 @@ bool SpellCreatureSlow::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureSlowPrice");
+    int32_t pricePerTarget = CreatureSlowPrice.get();
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureSlowDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureSlowValue");
+    uint32_t duration = CreatureSlowDuration.get();
+    double value = CreatureSlowValue.get();
     CreatureEffectSpeedChange* effect = new CreatureEffectSpeedChange(duration, value, "SpellCreatureSlow");
     creature->addCreatureEffect(effect);
 
@@ -26,15 +26,19 @@
 #include "modes/InputManager.h"
 #include "network/ODClient.h"
 #include "spells/SpellManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
 const std::string SpellEyeEvilName = "eyeEvil";
 const std::string SpellEyeEvilNameDisplay = "Eye of Evil";
-const std::string SpellEyeEvilCooldownKey = "EyeEvilCooldown";
 const SpellType SpellEyeEvil::mSpellType = SpellType::eyeEvil;
 
+static SpellConfigParam<uint32_t> EyeEvilCooldown("EyeEvilCooldown");
+static SpellConfigParam<int32_t> EyeEvilNbTurns("EyeEvilNbTurns");
+static SpellConfigParam<uint32_t> EyeEvilRadiusTiles("EyeEvilRadiusTiles");
+static SpellConfigParam<int32_t> EyeEvilPrice("EyeEvilPrice");
+
 namespace
 {
 class SpellEyeEvilFactory : public SpellFactory
@@ -45,8 +49,8 @@ class SpellEyeEvilFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellEyeEvilName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellEyeEvilCooldownKey; }
+    uint32_t getCooldown() const override
+    { return EyeEvilCooldown.get(); }
 
     const std::string& getNameReadable() const override
     { return SpellEyeEvilNameDisplay; }
@@ -70,9 +74,9 @@ static SpellRegister reg(new SpellEyeEvilFactory);
 
 SpellEyeEvil::SpellEyeEvil(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(getSpellType()), "FlyingSkull", 0.0,
-        ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilNbTurns"))
+        EyeEvilNbTurns.get())
 {
-    mPrevAnimationState = "Triggered";
+    mPrevAnimationState = EntityAnimation::triggered_anim;
     mPrevAnimationStateLoop = true;
 }
 
@@ -82,7 +86,7 @@ SpellEyeEvil::~SpellEyeEvil()
 
 void SpellEyeEvil::computeVisibleTiles()
 {
-    uint32_t radius = ConfigManager::getSingleton().getSpellConfigUInt32("EyeEvilRadiusTiles");
+    uint32_t radius = EyeEvilRadiusTiles.get();
     Tile* posTile = getPositionTile();
     if(posTile == nullptr)
     {
@@ -104,7 +108,7 @@ void SpellEyeEvil::checkSpellCast(GameMap* gameMap, const InputManager& inputMan
         return;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilPrice");
+    int32_t price = EyeEvilPrice.get();
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
         if(playerMana < price)
@@ -147,7 +151,7 @@ bool SpellEyeEvil::castSpell(GameMap* gameMap, Player* player, ODPacket& packet)
         return false;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t manaCost = ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilPrice");
+    int32_t manaCost = EyeEvilPrice.get();
     if(playerMana < manaCost)
         return false;
 
@@ -27,7 +27,6 @@
 #include "network/ClientNotification.h"
 #include "network/ODPacket.h"
 #include "spells/SpellType.h"
-#include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
@@ -255,5 +254,5 @@ uint32_t SpellManager::getSpellCooldown(SpellType type)
     }
 
     const SpellFactory& factory = *factories[index];
-    return ConfigManager::getSingleton().getSpellConfigUInt32(factory.getCooldownKey());
+    return factory.getCooldown();
 }
@@ -43,7 +43,8 @@ public:
     virtual SpellType getSpellType() const = 0;
     virtual const std::string& getName() const = 0;
     virtual const std::string& getNameReadable() const = 0;
-    virtual const std::string& getCooldownKey() const = 0;
+    //! \brief Number of turns before the spell can be cast again
+    virtual uint32_t getCooldown() const = 0;
 
     virtual void checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const = 0;
     virtual bool castSpell(GameMap* gameMap, Player* player, ODPacket& packet) const = 0;
@@ -19,9 +19,11 @@
 
 #include "game/SeatData.h"
 #include "network/ClientNotification.h"
+#include "network/MapStreaming.h"
 #include "network/ServerMode.h"
 #include "network/ServerNotification.h"
 #include "utils/LogManager.h"
+#include "utils/Symbol.h"
 
 #include <BoostTestTargetConfig.h>
 
@@ -38,6 +40,8 @@ ODClientTest::ODClientTest(const std::vector<PlayerInfo>& players, uint32_t inde
     mContinueLoop(true),
     mIsActivated(false),
     mIsGameModeStarted(false),
+    mNbMapChunks(0),
+    mNbMapChunksReceived(0),
     mPlayers(players),
     mLocalPlayerIndex(indexLocalPlayer)
 {
@@ -78,6 +82,8 @@ bool ODClientTest::connect(const std::string& host, const int port, uint32_t tim
 void ODClientTest::disconnect(bool keepReplay)
 {
     ODSocketClient::disconnect(keepReplay);
+    mNbMapChunks = 0;
+    mNbMapChunksReceived = 0;
 
     // We wait for the server to terminate so that if a server is launched after this one, it doesn't collapse
     sf::sleep(sf::milliseconds(5000));
@@ -134,13 +140,50 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
             BOOST_CHECK(mSeats.size() == (mPlayers.size() + 1));
 
             // We do not read the following data as it would imply to embed creature definitions
-            // and many other stuff
+            // and many other stuff. The tiles are streamed in chunks (loadLevelTiles). We will send
+            // levelOK once every chunk is received
+            uint32_t nbChunksX = static_cast<uint32_t>((mapSizeX + MapStreaming::CHUNK_SIZE - 1) / MapStreaming::CHUNK_SIZE);
+            uint32_t nbChunksY = static_cast<uint32_t>((mapSizeY + MapStreaming::CHUNK_SIZE - 1) / MapStreaming::CHUNK_SIZE);
+            mNbMapChunks = nbChunksX * nbChunksY;
+            mNbMapChunksReceived = 0;
+            return true;
+        }
+
+        case ServerNotificationType::loadLevelTiles:
+        {
+            uint32_t chunk;
+            BOOST_CHECK(packetReceived >> chunk);
+            BOOST_CHECK(chunk < mNbMapChunks);
+            BOOST_CHECK(mNbMapChunksReceived < mNbMapChunks);
+            ++mNbMapChunksReceived;
+
+            // We acknowledge each chunk
             ODPacket packSend;
+            packSend << ClientNotificationType::mapChunkReceived << static_cast<uint32_t>(1);
+            send(packSend);
+
+            if(mNbMapChunksReceived < mNbMapChunks)
+                return true;
+
+            packSend.clear();
             packSend << ClientNotificationType::levelOK;
             send(packSend);
             return true;
         }
 
+        case ServerNotificationType::addSymbols:
+        {
+            uint32_t firstId;
+            uint32_t nbNames;
+            BOOST_CHECK(packetReceived >> firstId >> nbNames);
+            for(uint32_t i = 0; i < nbNames; ++i)
+            {
+                std::string name;
+                BOOST_CHECK(packetReceived >> name);
+                Symbol::setServerSymbol(firstId + i, name);
+            }
+            return true;
+        }
         case ServerNotificationType::pickNick:
         {
             ServerMode serverMode;
@@ -311,6 +354,10 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
             BOOST_CHECK(packetReceived >> turnsPerSecond);
             OD_LOG_INF("turnsPerSecond=" + Helper::toString(turnsPerSecond));
 
+            uint64_t matchSeed;
+            BOOST_CHECK(packetReceived >> matchSeed);
+            OD_LOG_INF("matchSeed=" + Helper::toString(matchSeed));
+
             int32_t nbPlayers;
             BOOST_CHECK(packetReceived >> nbPlayers);
             OD_LOG_INF("nbPlayers=" + Helper::toString(nbPlayers));
@@ -397,7 +444,7 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
         case ServerNotificationType::setObjectAnimationState:
         {
             std::string entityName;
-            std::string animState;
+            Symbol animState;
             bool loop;
             bool playIdleWhenAnimationEnds;
             bool shouldSetWalkDirection;
@@ -410,14 +457,14 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
                 BOOST_CHECK(packetReceived >> walkDirection);
             }
 
-            animationPlayed(entityName, animState, loop, playIdleWhenAnimationEnds, shouldSetWalkDirection, walkDirection);
+            animationPlayed(entityName, animState.getName(), loop, playIdleWhenAnimationEnds, shouldSetWalkDirection, walkDirection);
             break;
         }
         case ServerNotificationType::animatedObjectSetWalkPath:
         {
             std::string entityName;
-            std::string walkAnim;
-            std::string endAnim;
+            Symbol walkAnim;
+            Symbol endAnim;
             bool loopEndAnim;
             bool playIdleWhenAnimationEnds;
             uint32_t nbDest;
@@ -434,9 +481,9 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
 
             //! We want to make sure animationPlayed is played for both animations (if required)
             if(!walkAnim.empty())
-                animationPlayed(entityName, walkAnim, true, false, false, Ogre::Vector3::ZERO);
+                animationPlayed(entityName, walkAnim.getName(), true, false, false, Ogre::Vector3::ZERO);
             if(!endAnim.empty())
-                animationPlayed(entityName, endAnim, loopEndAnim, false, false, Ogre::Vector3::ZERO);
+                animationPlayed(entityName, endAnim.getName(), loopEndAnim, false, false, Ogre::Vector3::ZERO);
             break;
         }
         default:
@@ -87,6 +87,9 @@ protected:
 private:
     bool mIsActivated;
     bool mIsGameModeStarted;
+    //! \brief Number of map chunks of the level and number of chunks received (see MapStreaming)
+    uint32_t mNbMapChunks;
+    uint32_t mNbMapChunksReceived;
     std::vector<PlayerInfo> mPlayers;
     std::vector<SeatData*> mSeats;
     uint32_t mLocalPlayerIndex;
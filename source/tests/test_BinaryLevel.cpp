@@ -0,0 +1,372 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE BinaryLevel
+#include "BoostTestTargetConfig.h"
+
+#include "entities/Tile.h"
+#include "gamemap/BinaryLevel.h"
+#include "gamemap/DeferredTextStream.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+#include "utils/LogSinkConsole.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+//! \brief Builds a text level with the given size where every other tile is claimed ground
+std::string buildTextLevel(int mapSize)
+{
+    std::stringstream ss;
+    ss << "0.7.0  # version\n";
+    ss << "\n[Info]\nName\tTest level\nDescription\tA level with spaces # and a comment\n[/Info]\n";
+    ss << "\n[Seats]\n[Seat]\nseatId\t1\nteamId\t1\nplayer\tHuman\n[/Seat]\n[/Seats]\n";
+    ss << "\n[Goals]\nKillAllEnemies\n[/Goals]\n";
+    ss << "\n[Tiles]\n# Map Size\n" << mapSize << " # MapSizeX\n" << mapSize << " # MapSizeY\n";
+    for(int x = 0; x < mapSize; ++x)
+    {
+        for(int y = 0; y < mapSize; ++y)
+        {
+            if((x + y) % 2 == 0)
+                ss << x << "\t" << y << "\t1\t0\t1\n";
+            else if(x % 3 == 0)
+                ss << x << "\t" << y << "\t2\t33.3\n";
+        }
+    }
+    ss << "[/Tiles]\n";
+    ss << "\n[Rooms]\n[/Rooms]\n\n[Traps]\n[/Traps]\n\n[Lights]\n[/Lights]\n";
+    ss << "\n[Creatures]\n[/Creatures]\n";
+    ss << "\n[Spells]\n[/Spells]\n\n[CraftedTraps]\n[/CraftedTraps]\n\n[SkillEntity]\n[/SkillEntity]\n";
+    ss << "\n[GiftBoxEntity]\n[/GiftBoxEntity]\n\n[Missiles]\n[/Missiles]\n";
+    ss << "\n[TreasuryObject]\n[/TreasuryObject]\n\n[Chickens]\n[/Chickens]\n";
+    return ss.str();
+}
+
+std::string readFile(const std::string& fileName)
+{
+    std::ifstream file(fileName.c_str(), std::ios_base::in | std::ios_base::binary);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+void writeFile(const std::string& fileName, const std::string& content)
+{
+    std::ofstream file(fileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    file << content;
+}
+
+template<typename T>
+T readValue(const std::string& content, uint64_t offset)
+{
+    T value;
+    std::memcpy(&value, content.data() + offset, sizeof(T));
+    return value;
+}
+
+template<typename T>
+void writeValue(std::string& content, uint64_t offset, const T& value)
+{
+    std::memcpy(&content[offset], &value, sizeof(T));
+}
+
+/*! \brief Returns a copy of the given binary level where the tiles section is modified by the given function.
+ * The section checksum is updated so that only the validation of the tiles can refuse the file. The
+ * function receives the content, the offset of the tiles section and its number of tiles
+ */
+std::string modifyTilesSection(const std::string& content,
+    const std::function<void(std::string& content, uint64_t offset, uint32_t nbTiles)>& modify)
+{
+    // See FileHeader and SectionEntry in BinaryLevel.cpp
+    const uint64_t fileHeaderSize = 32;
+    const uint64_t sectionEntrySize = 24;
+    const uint64_t tilesHeaderSize = 16;
+    std::string modified = content;
+    uint32_t nbSections = readValue<uint32_t>(content, 24);
+    for(uint32_t i = 0; i < nbSections; ++i)
+    {
+        uint64_t entry = fileHeaderSize + i * sectionEntrySize;
+        if(readValue<uint32_t>(content, entry) != static_cast<uint32_t>(BinaryLevel::Section::tiles))
+            continue;
+
+        uint64_t offset = readValue<uint64_t>(content, entry + 8);
+        uint64_t size = readValue<uint64_t>(content, entry + 16);
+        modify(modified, offset, readValue<uint32_t>(content, offset + 8));
+        BOOST_REQUIRE(size >= tilesHeaderSize);
+
+        // FNV-1a like computeChecksum
+        uint32_t checksum = 2166136261u;
+        for(uint64_t k = offset; k < offset + size; ++k)
+        {
+            checksum ^= static_cast<uint8_t>(modified[k]);
+            checksum *= 16777619u;
+        }
+        writeValue(modified, entry + 4, checksum);
+        return modified;
+    }
+
+    BOOST_FAIL("No tiles section");
+    return modified;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_BinaryLevel_RoundTrip)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    const std::string textFile = "test_BinaryLevel.level";
+    const std::string binaryFile = "test_BinaryLevel.levelbin";
+    const std::string textFile2 = "test_BinaryLevel2.level";
+    const std::string binaryFile2 = "test_BinaryLevel2.levelbin";
+
+    writeFile(textFile, buildTextLevel(20));
+    BOOST_CHECK(!BinaryLevel::isBinaryLevel(textFile));
+    BOOST_REQUIRE(BinaryLevel::convertTextToBinary(textFile, binaryFile));
+    BOOST_CHECK(BinaryLevel::isBinaryLevel(binaryFile));
+
+    BinaryLevel::MappedLevel level;
+    BOOST_REQUIRE(level.open(binaryFile));
+    BOOST_CHECK(level.getVersion() == "0.7.0");
+    BOOST_CHECK(level.hasSection(BinaryLevel::Section::seats));
+    BOOST_CHECK(!level.hasSection(BinaryLevel::Section::creatureDefinitions));
+
+    // Comments are removed from text sections
+    uint64_t size;
+    const char* data = level.getSectionText(BinaryLevel::Section::info, size);
+    std::string info(data, size);
+    BOOST_CHECK(info == "[Info]\nName\tTest level\nDescription\tA level with spaces \n[/Info]\n");
+
+    const BinaryLevel::TileArrays& tiles = level.getTiles();
+    BOOST_CHECK(tiles.mMapSizeX == 20);
+    BOOST_CHECK(tiles.mMapSizeY == 20);
+    BOOST_CHECK(tiles.mNbTiles == 200 + 7 * 10);
+    BOOST_CHECK(tiles.mPosX[2] == 0);
+    BOOST_CHECK(tiles.mPosY[2] == 2);
+    BOOST_CHECK(tiles.mType[2] == 1);
+    BOOST_CHECK(tiles.mHasSeat[2] == 1);
+    BOOST_CHECK(tiles.mSeatId[2] == 1);
+    bool isGoldFound = false;
+    for(uint32_t i = 0; i < tiles.mNbTiles; ++i)
+    {
+        if(tiles.mType[i] != 2)
+            continue;
+
+        isGoldFound = true;
+        BOOST_CHECK(tiles.mFullness[i] == 33.3);
+        BOOST_CHECK(tiles.mHasSeat[i] == 0);
+    }
+    BOOST_CHECK(isGoldFound);
+
+    // Converting back to text and then to binary should give the same file
+    BOOST_REQUIRE(BinaryLevel::convertBinaryToText(binaryFile, textFile2));
+    BOOST_REQUIRE(BinaryLevel::convertTextToBinary(textFile2, binaryFile2));
+    BOOST_CHECK(readFile(binaryFile) == readFile(binaryFile2));
+
+    std::remove(textFile.c_str());
+    std::remove(binaryFile.c_str());
+    std::remove(textFile2.c_str());
+    std::remove(binaryFile2.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(test_BinaryLevel_Validation)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    const std::string binaryFile = "test_BinaryLevelValidation.levelbin";
+    const std::string corruptedFile = "test_BinaryLevelCorrupted.levelbin";
+    std::stringstream levelText(buildTextLevel(10));
+    BOOST_REQUIRE(BinaryLevel::writeBinaryFromText(levelText, binaryFile));
+    const std::string content = readFile(binaryFile);
+
+    // Truncated file
+    writeFile(corruptedFile, content.substr(0, content.size() - 1));
+    BinaryLevel::MappedLevel truncated;
+    BOOST_CHECK(!truncated.open(corruptedFile));
+
+    // Modified byte in the last section
+    std::string modified = content;
+    modified[modified.size() - 2] = 'X';
+    writeFile(corruptedFile, modified);
+    BinaryLevel::MappedLevel corrupted;
+    BOOST_CHECK(!corrupted.open(corruptedFile));
+
+    // Unknown format version
+    modified = content;
+    ++modified[8];
+    writeFile(corruptedFile, modified);
+    BinaryLevel::MappedLevel badVersion;
+    BOOST_CHECK(!badVersion.open(corruptedFile));
+
+    // Missing tiles section
+    std::stringstream noTiles("0.7.0\n[Info]\n[/Info]\n[Seats]\n[/Seats]\n");
+    BOOST_CHECK(BinaryLevel::writeBinaryFromText(noTiles, corruptedFile));
+    BinaryLevel::MappedLevel incomplete;
+    BOOST_CHECK(!incomplete.open(corruptedFile));
+
+    // Tiles sections with a valid checksum but invalid values. The packed arrays are, after the 16 bytes
+    // header: fullness (double), posX, posY, seatId (int32_t), type and hasSeat (uint8_t)
+    const uint64_t tilesHeaderSize = 16;
+    writeFile(corruptedFile, modifyTilesSection(content, [](std::string&, uint64_t, uint32_t) {}));
+    BinaryLevel::MappedLevel sameChecksum;
+    BOOST_CHECK(sameChecksum.open(corruptedFile));
+
+    writeFile(corruptedFile, modifyTilesSection(content, [&](std::string& data, uint64_t offset, uint32_t nbTiles)
+    {
+        uint64_t typeOffset = offset + tilesHeaderSize + nbTiles * (sizeof(double) + 3 * sizeof(int32_t));
+        data[typeOffset + nbTiles / 2] = static_cast<char>(TileType::countTileType);
+    }));
+    BinaryLevel::MappedLevel badType;
+    BOOST_CHECK(!badType.open(corruptedFile));
+
+    writeFile(corruptedFile, modifyTilesSection(content, [&](std::string& data, uint64_t offset, uint32_t)
+    {
+        writeValue(data, offset + tilesHeaderSize, std::numeric_limits<double>::quiet_NaN());
+    }));
+    BinaryLevel::MappedLevel nanFullness;
+    BOOST_CHECK(!nanFullness.open(corruptedFile));
+
+    writeFile(corruptedFile, modifyTilesSection(content, [&](std::string& data, uint64_t offset, uint32_t nbTiles)
+    {
+        writeValue(data, offset + tilesHeaderSize + (nbTiles - 1) * sizeof(double), -1.0);
+    }));
+    BinaryLevel::MappedLevel negativeFullness;
+    BOOST_CHECK(!negativeFullness.open(corruptedFile));
+
+    writeFile(corruptedFile, modifyTilesSection(content, [&](std::string& data, uint64_t offset, uint32_t nbTiles)
+    {
+        uint64_t posXOffset = offset + tilesHeaderSize + nbTiles * sizeof(double);
+        writeValue(data, posXOffset, static_cast<int32_t>(10));
+    }));
+    BinaryLevel::MappedLevel badPosition;
+    BOOST_CHECK(!badPosition.open(corruptedFile));
+
+    // Tiles section claiming more tiles than it contains
+    writeFile(corruptedFile, modifyTilesSection(content, [&](std::string& data, uint64_t offset, uint32_t nbTiles)
+    {
+        writeValue(data, offset + 8, nbTiles + 1);
+    }));
+    BinaryLevel::MappedLevel truncatedTiles;
+    BOOST_CHECK(!truncatedTiles.open(corruptedFile));
+
+    // Invalid levels are refused by the converter
+    std::stringstream unclosed("0.7.0\n[Info]\nName\tTest\n");
+    BOOST_CHECK(!BinaryLevel::writeBinaryFromText(unclosed, corruptedFile));
+    std::stringstream badTiles("0.7.0\n[Tiles]\n0 10\n[/Tiles]\n");
+    BOOST_CHECK(!BinaryLevel::writeBinaryFromText(badTiles, corruptedFile));
+    std::stringstream badTileType("0.7.0\n[Tiles]\n10 10\n1\t1\t7\t0\n[/Tiles]\n");
+    BOOST_CHECK(!BinaryLevel::writeBinaryFromText(badTileType, corruptedFile));
+    std::stringstream badFullness("0.7.0\n[Tiles]\n10 10\n1\t1\t1\t-5\n[/Tiles]\n");
+    BOOST_CHECK(!BinaryLevel::writeBinaryFromText(badFullness, corruptedFile));
+
+    std::remove(binaryFile.c_str());
+    std::remove(corruptedFile.c_str());
+}
+
+//! \brief Writes values the way entities export themselves in levels
+void writeEntityLines(std::ostream& os)
+{
+    os << "[Creatures]\n";
+    for(int i = 0; i < 50; ++i)
+    {
+        os << "Creature" << i << "\t" << (i % 3) << "\t" << (i * 0.37) << "\t" << (1.0 / (i + 1))
+            << "\t" << static_cast<uint32_t>(i * 1000) << "\t" << (i % 2 == 0) << std::endl;
+    }
+    os << std::setw(8) << std::setfill('0') << 42 << std::setfill(' ') << "\t" << std::hex << 255 << std::dec << "\n";
+    os.precision(std::numeric_limits<double>::max_digits10);
+    os << 0.1 << "\t" << -1e-30 << "\t" << std::string("a\0b", 3) << "\n";
+    os << "[/Creatures]" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(test_BinaryLevel_DeferredSections)
+{
+    std::stringstream expected;
+    writeEntityLines(expected);
+
+    // The record is formatted later and may be formatted after the stream is destroyed
+    std::string record;
+    {
+        DeferredTextStream deferred;
+        writeEntityLines(deferred);
+        record = deferred.takeRecord();
+        BOOST_CHECK(deferred.takeRecord().empty());
+    }
+
+    std::stringstream formatted;
+    DeferredTextStream::format(record, formatted);
+    BOOST_CHECK(formatted.str() == expected.str());
+}
+
+BOOST_AUTO_TEST_CASE(test_BinaryLevel_LoadBenchmark)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    // Compares reading the tiles of a 400x400 level in both formats. The text path does what
+    // MapHandler does before creating the tiles: copy the file without comments and split every tile line
+    const std::string textFile = "test_BinaryLevelBenchmark.level";
+    const std::string binaryFile = "test_BinaryLevelBenchmark.levelbin";
+    writeFile(textFile, buildTextLevel(400));
+    BOOST_REQUIRE(BinaryLevel::convertTextToBinary(textFile, binaryFile));
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::stringstream levelFile;
+    BOOST_REQUIRE(Helper::readFileWithoutComments(textFile, levelFile));
+    std::string line;
+    uint32_t nbTextTiles = 0;
+    while(std::getline(levelFile, line) && (line != "[Tiles]"))
+        ;
+    int mapSizeX;
+    int mapSizeY;
+    levelFile >> mapSizeX >> mapSizeY;
+    std::string nextParam;
+    while((levelFile >> nextParam) && (nextParam != "[/Tiles]"))
+    {
+        line = nextParam;
+        std::getline(levelFile, nextParam);
+        line += nextParam;
+        std::vector<std::string> elems = Helper::split(line, '\t');
+        nbTextTiles += (Helper::toInt(elems[2]) > 0) ? 1 : 0;
+    }
+    std::chrono::steady_clock::duration textDuration = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    BinaryLevel::MappedLevel level;
+    BOOST_REQUIRE(level.open(binaryFile));
+    uint32_t nbBinaryTiles = 0;
+    const BinaryLevel::TileArrays& tiles = level.getTiles();
+    for(uint32_t i = 0; i < tiles.mNbTiles; ++i)
+        nbBinaryTiles += (tiles.mType[i] > 0) ? 1 : 0;
+    std::chrono::steady_clock::duration binaryDuration = std::chrono::steady_clock::now() - start;
+
+    BOOST_CHECK(nbTextTiles == nbBinaryTiles);
+    BOOST_TEST_MESSAGE("Tiles read: " << nbBinaryTiles
+        << ", text: " << std::chrono::duration_cast<std::chrono::milliseconds>(textDuration).count() << " ms"
+        << ", binary: " << std::chrono::duration_cast<std::chrono::milliseconds>(binaryDuration).count() << " ms");
+
+    std::remove(textFile.c_str());
+    std::remove(binaryFile.c_str());
+}
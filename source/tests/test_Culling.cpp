@@ -0,0 +1,239 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Culling
+#include "BoostTestTargetConfig.h"
+
+#include "camera/TileSpans.h"
+#include "utils/LogManager.h"
+#include "utils/LogSinkConsole.h"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace
+{
+//! \brief Returns the ground corners of a camera looking down at (x, y): the far side of the
+//! quad is wider than the near one like with the game camera
+std::vector<Ogre::Vector3> buildCameraQuad(double x, double y, double nearHalfWidth, double farHalfWidth,
+    double halfHeight)
+{
+    std::vector<Ogre::Vector3> corners;
+    corners.push_back(Ogre::Vector3(static_cast<Ogre::Real>(x - farHalfWidth), static_cast<Ogre::Real>(y + halfHeight), 0));
+    corners.push_back(Ogre::Vector3(static_cast<Ogre::Real>(x + farHalfWidth), static_cast<Ogre::Real>(y + halfHeight), 0));
+    corners.push_back(Ogre::Vector3(static_cast<Ogre::Real>(x + nearHalfWidth), static_cast<Ogre::Real>(y - halfHeight), 0));
+    corners.push_back(Ogre::Vector3(static_cast<Ogre::Real>(x - nearHalfWidth), static_cast<Ogre::Real>(y - halfHeight), 0));
+    return corners;
+}
+
+//! \brief Returns true if the point (x, y) is inside the given convex quad (in any winding order)
+bool isInsideQuad(const std::vector<Ogre::Vector3>& quad, double x, double y)
+{
+    bool hasPositive = false;
+    bool hasNegative = false;
+    for(uint32_t i = 0; i < quad.size(); ++i)
+    {
+        const Ogre::Vector3& p1 = quad[i];
+        const Ogre::Vector3& p2 = quad[(i + 1) % quad.size()];
+        double cross = (p2.x - p1.x) * (y - p1.y) - (p2.y - p1.y) * (x - p1.x);
+        hasPositive |= (cross > 0);
+        hasNegative |= (cross < 0);
+    }
+    return !(hasPositive && hasNegative);
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_Culling_IntersectionPoints)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    // Frustum corners as returned by Ogre: 4 near corners then the 4 matching far corners
+    Ogre::Vector3 cameraCorners[8] = {
+        Ogre::Vector3(4, 6, 10), Ogre::Vector3(6, 6, 10), Ogre::Vector3(6, 4, 10), Ogre::Vector3(4, 4, 10),
+        Ogre::Vector3(0, 10, -10), Ogre::Vector3(10, 10, -10), Ogre::Vector3(10, 0, -10), Ogre::Vector3(0, 0, -10)
+    };
+    std::vector<Ogre::Vector3> groundCorners(4);
+    BOOST_REQUIRE(TileSpans::computeIntersectionPoints(cameraCorners, groundCorners));
+    BOOST_CHECK(groundCorners[0].positionEquals(Ogre::Vector3(2, 8, 0)));
+    BOOST_CHECK(groundCorners[1].positionEquals(Ogre::Vector3(8, 8, 0)));
+    BOOST_CHECK(groundCorners[2].positionEquals(Ogre::Vector3(8, 2, 0)));
+    BOOST_CHECK(groundCorners[3].positionEquals(Ogre::Vector3(2, 2, 0)));
+
+    // The quad is enlarged by a few percents: tiles 2 to 8 are seen
+    TileSpans spans;
+    spans.compute(groundCorners, 20, 20);
+    BOOST_CHECK(spans.getNbTiles() == 49);
+    BOOST_CHECK(spans.contains(2, 2));
+    BOOST_CHECK(spans.contains(8, 8));
+    BOOST_CHECK(!spans.contains(1, 5));
+    BOOST_CHECK(!spans.contains(5, 9));
+
+    // A ray parallel to the ground never reaches it
+    cameraCorners[4] = Ogre::Vector3(0, 10, 10);
+    BOOST_CHECK(!TileSpans::computeIntersectionPoints(cameraCorners, groundCorners));
+
+    // Spans are clipped to the map
+    spans.compute(buildCameraQuad(0, 0, 10, 10, 10), 5, 5);
+    BOOST_CHECK(spans.getNbTiles() == 25);
+    spans.compute(buildCameraQuad(-50, -50, 10, 10, 10), 5, 5);
+    BOOST_CHECK(spans.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(test_Culling_TilesInQuad)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    // Every tile whose center is in the quad should be visible. The spans can only be larger than
+    // the quad by the enlarging factor and half a tile
+    const int32_t mapSize = 64;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(-10.0, mapSize + 10.0);
+    for(uint32_t i = 0; i < 500; ++i)
+    {
+        double centerX = coordinate(generator);
+        double centerY = coordinate(generator);
+        double farHalfWidth = 4.0 + i % 13;
+        double halfHeight = 3.0 + i % 5;
+        std::vector<Ogre::Vector3> quad = buildCameraQuad(centerX, centerY, 2.0 + i % 7, farHalfWidth, halfHeight);
+        TileSpans spans;
+        spans.compute(quad, mapSize, mapSize);
+        for(int32_t y = 0; y < mapSize; ++y)
+        {
+            for(int32_t x = 0; x < mapSize; ++x)
+            {
+                if(isInsideQuad(quad, x, y))
+                    BOOST_REQUIRE(spans.contains(x, y));
+            }
+        }
+
+        // The centroid is not the center of the trapezoid so we allow one more tile
+        TileSpans::forEachTile(spans, [&](int32_t x, int32_t y)
+        {
+            BOOST_REQUIRE(std::abs(x - centerX) <= 1.0565 * 2.0 * farHalfWidth + 1.5);
+            BOOST_REQUIRE(std::abs(y - centerY) <= 1.0565 * 2.0 * halfHeight + 1.5);
+        });
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_Culling_Differences)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    // We apply the differences between consecutive spans to a grid like CullingManager does with
+    // the tiles. Each tile should be toggled at most once and the grid should match the new spans
+    const int32_t mapSize = 64;
+    std::vector<bool> grid(mapSize * mapSize, false);
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> coordinate(-10.0, mapSize + 10.0);
+    std::uniform_real_distribution<double> move(-4.0, 4.0);
+    double x = mapSize / 2.0;
+    double y = mapSize / 2.0;
+    TileSpans spans;
+    TileSpans newSpans;
+    spans.compute(buildCameraQuad(x, y, 6, 9, 5), mapSize, mapSize);
+    TileSpans::forEachTile(spans, [&](int32_t xx, int32_t yy)
+    {
+        grid[yy * mapSize + xx] = true;
+    });
+
+    for(uint32_t i = 0; i < 2000; ++i)
+    {
+        // Mostly small moves with some jumps across the map
+        if(i % 50 == 0)
+        {
+            x = coordinate(generator);
+            y = coordinate(generator);
+        }
+        else
+        {
+            x += move(generator);
+            y += move(generator);
+        }
+        newSpans.compute(buildCameraQuad(x, y, 3 + i % 5, 6 + i % 7, 4 + i % 3), mapSize, mapSize);
+
+        TileSpans::forEachDifference(spans, newSpans, [&](int32_t xx, int32_t yy)
+        {
+            BOOST_REQUIRE(grid[yy * mapSize + xx]);
+            grid[yy * mapSize + xx] = false;
+        });
+        TileSpans::forEachDifference(newSpans, spans, [&](int32_t xx, int32_t yy)
+        {
+            BOOST_REQUIRE(!grid[yy * mapSize + xx]);
+            grid[yy * mapSize + xx] = true;
+        });
+        std::swap(spans, newSpans);
+
+        for(int32_t yy = 0; yy < mapSize; ++yy)
+        {
+            for(int32_t xx = 0; xx < mapSize; ++xx)
+                BOOST_REQUIRE(grid[yy * mapSize + xx] == spans.contains(xx, yy));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_Culling_PanBenchmark)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    // Fast pans across a 512x512 map. We compare the number of tiles changed with the diffs against
+    // the number of tiles that would be walked by hiding the previous view and showing the new one
+    const int32_t mapSize = 512;
+    const uint32_t nbFrames = 20000;
+    std::vector<uint8_t> grid(mapSize * mapSize, 0);
+    TileSpans spans;
+    TileSpans newSpans;
+    uint64_t nbToggles = 0;
+    uint64_t nbFullToggles = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < nbFrames; ++i)
+    {
+        // The camera goes back and forth along diagonals at 1.5 tile per frame
+        double progress = std::fmod(i * 1.5, 2.0 * mapSize);
+        double x = (progress < mapSize) ? progress : 2.0 * mapSize - progress;
+        double y = std::fmod(x * 0.7 + i * 0.01, static_cast<double>(mapSize));
+        newSpans.compute(buildCameraQuad(x, y, 14, 22, 12), mapSize, mapSize);
+        if(newSpans == spans)
+            continue;
+
+        nbFullToggles += spans.getNbTiles() + newSpans.getNbTiles();
+        TileSpans::forEachDifference(spans, newSpans, [&](int32_t xx, int32_t yy)
+        {
+            grid[yy * mapSize + xx] = 0;
+            ++nbToggles;
+        });
+        TileSpans::forEachDifference(newSpans, spans, [&](int32_t xx, int32_t yy)
+        {
+            grid[yy * mapSize + xx] = 1;
+            ++nbToggles;
+        });
+        std::swap(spans, newSpans);
+    }
+    std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - start;
+
+    BOOST_CHECK(nbToggles < nbFullToggles);
+    double usPerFrame = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) / nbFrames;
+    BOOST_TEST_MESSAGE("Frames: " << nbFrames << ", visible tiles: " << spans.getNbTiles()
+        << ", time: " << usPerFrame << " us/frame"
+        << ", toggles: " << static_cast<double>(nbToggles) / nbFrames << " tiles/frame"
+        << " (hide all + show all: " << static_cast<double>(nbFullToggles) / nbFrames << " tiles/frame)");
+}
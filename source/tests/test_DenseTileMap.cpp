@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE DenseTileMap
+#include "BoostTestTargetConfig.h"
+
+#include "entities/DenseTileMap.h"
+
+#include <map>
+#include <random>
+
+BOOST_AUTO_TEST_CASE(test_DenseTileMap_CompareToMap)
+{
+    // The tiles are never dereferenced so we can use the addresses of a buffer. Like the real tiles,
+    // they are close to each other in memory
+    std::vector<uint64_t> buffer(300);
+    std::vector<Tile*> tiles;
+    for(uint64_t& value : buffer)
+        tiles.push_back(reinterpret_cast<Tile*>(&value));
+
+    std::mt19937 generator(5);
+    DenseTileMap<int> denseMap;
+    std::map<Tile*, int> reference;
+    for(int step = 0; step < 20000; ++step)
+    {
+        Tile* tile = tiles[generator() % tiles.size()];
+        switch(generator() % 4)
+        {
+            case 0:
+            case 1:
+                denseMap[tile] = step;
+                reference[tile] = step;
+                break;
+            case 2:
+                BOOST_REQUIRE(denseMap.erase(tile) == reference.erase(tile));
+                break;
+            default:
+            {
+                // Erase while iterating like Building::removeBuildingObject does
+                for(auto it = denseMap.begin(); it != denseMap.end(); ++it)
+                {
+                    if(it->second % 7 != 0)
+                        continue;
+
+                    reference.erase(it->first);
+                    denseMap.erase(it);
+                    break;
+                }
+                break;
+            }
+        }
+
+        if(step % 100 != 0)
+            continue;
+
+        BOOST_REQUIRE(denseMap.size() == reference.size());
+        for(Tile* t : tiles)
+        {
+            auto itRef = reference.find(t);
+            auto it = denseMap.find(t);
+            BOOST_REQUIRE((itRef == reference.end()) == (it == denseMap.end()));
+            BOOST_REQUIRE(denseMap.count(t) == reference.count(t));
+            if(itRef != reference.end())
+                BOOST_REQUIRE(it->second == itRef->second);
+        }
+    }
+
+    BOOST_CHECK_THROW(denseMap.at(nullptr), std::out_of_range);
+    denseMap.clear();
+    BOOST_CHECK(denseMap.empty());
+    BOOST_CHECK(denseMap.find(tiles[0]) == denseMap.end());
+    BOOST_CHECK(denseMap.insert(std::make_pair(tiles[0], 3)).second);
+    BOOST_CHECK(!denseMap.insert(std::make_pair(tiles[0], 4)).second);
+    BOOST_CHECK(denseMap.at(tiles[0]) == 3);
+}
@@ -0,0 +1,239 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE LogManager
+#include "BoostTestTargetConfig.h"
+
+#include "utils/LogManager.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+//! \brief Messages written to the sinks. Shared with the test because the sinks are owned by the LogManager
+struct WrittenMessages
+{
+    std::mutex mMutex;
+    std::vector<std::pair<LogMessageLevel, std::string>> mMessages;
+
+    std::vector<std::pair<LogMessageLevel, std::string>> get()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mMessages;
+    }
+
+    bool contains(const std::string& message)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for(const std::pair<LogMessageLevel, std::string>& written : mMessages)
+        {
+            if(written.second == message)
+                return true;
+        }
+        return false;
+    }
+};
+
+class LogSinkTest : public LogSink
+{
+public:
+    LogSinkTest(WrittenMessages& written) :
+        mWritten(written)
+    {}
+
+    void write(LogMessageLevel level, const std::string&, const std::string&, const std::string&, int, const std::string& message) override
+    {
+        std::lock_guard<std::mutex> lock(mWritten.mMutex);
+        mWritten.mMessages.emplace_back(level, message);
+    }
+
+private:
+    WrittenMessages& mWritten;
+};
+
+//! \brief Sink logging more messages than the buffer of the sink thread can hold when it writes "trigger"
+class LogSinkLogging : public LogSinkTest
+{
+public:
+    LogSinkLogging(WrittenMessages& written) :
+        LogSinkTest(written)
+    {}
+
+    void write(LogMessageLevel level, const std::string& module, const std::string& timestamp, const std::string& filename, int line, const std::string& message) override
+    {
+        LogSinkTest::write(level, module, timestamp, filename, line, message);
+        if(message != "trigger")
+            return;
+
+        for(uint32_t i = 0; i < 2 * LogManager::RING_BUFFER_SIZE; ++i)
+            OD_LOG_ERR("fromSink");
+    }
+};
+}
+
+BOOST_AUTO_TEST_CASE(test_LogManager_MultiThreadOrdering)
+{
+    // More messages than the ring buffer size so that the threads have to wait for the sink thread
+    const uint32_t nbThreads = 4;
+    const uint32_t nbMessages = 3 * LogManager::RING_BUFFER_SIZE;
+    WrittenMessages written;
+    {
+        LogManager logMgr;
+        logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkTest(written)));
+        OD_LOG_INF("first");
+
+        std::vector<std::thread> threads;
+        for(uint32_t t = 0; t < nbThreads; ++t)
+        {
+            threads.emplace_back([t, nbMessages]()
+            {
+                for(uint32_t i = 0; i < nbMessages; ++i)
+                    OD_LOG_INF(std::to_string(t) + ":" + std::to_string(i));
+            });
+        }
+        for(std::thread& thread : threads)
+            thread.join();
+
+        OD_LOG_INF("last");
+        logMgr.flush();
+
+        std::vector<std::pair<LogMessageLevel, std::string>> messages = written.get();
+        BOOST_REQUIRE_EQUAL(messages.size(), nbThreads * nbMessages + 2);
+        BOOST_CHECK_EQUAL(messages.front().second, "first");
+        BOOST_CHECK_EQUAL(messages.back().second, "last");
+
+        // The messages of each thread are written in the order they were logged
+        std::vector<uint32_t> nextIndex(nbThreads, 0);
+        for(std::size_t k = 1; k + 1 < messages.size(); ++k)
+        {
+            const std::string& message = messages[k].second;
+            std::size_t separator = message.find(':');
+            BOOST_REQUIRE(separator != std::string::npos);
+            uint32_t t = static_cast<uint32_t>(std::stoul(message.substr(0, separator)));
+            uint32_t i = static_cast<uint32_t>(std::stoul(message.substr(separator + 1)));
+            BOOST_REQUIRE(t < nbThreads);
+            BOOST_REQUIRE_EQUAL(i, nextIndex[t]);
+            ++nextIndex[t];
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_LogManager_CriticalFlushed)
+{
+    WrittenMessages written;
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkTest(written)));
+
+    // The sink thread waits SINK_THREAD_PERIOD between writes so a normal message is usually
+    // still pending. A critical one must be written when logMessage returns
+    OD_LOG_INF("normal");
+    OD_LOG_ERR("critical");
+    std::vector<std::pair<LogMessageLevel, std::string>> messages = written.get();
+    BOOST_REQUIRE_EQUAL(messages.size(), 2);
+    BOOST_CHECK_EQUAL(messages[0].second, "normal");
+    BOOST_CHECK(messages[1].first == LogMessageLevel::CRITICAL);
+    BOOST_CHECK_EQUAL(messages[1].second, "critical");
+
+    // Messages under the level are not written
+    logMgr.setLevel(LogMessageLevel::WARNING);
+    OD_LOG_INF("filtered");
+    OD_LOG_ERR("critical2");
+    BOOST_CHECK(!written.contains("filtered"));
+    BOOST_CHECK(written.contains("critical2"));
+}
+
+BOOST_AUTO_TEST_CASE(test_LogManager_PreviousInstance)
+{
+    // A thread alive across two LogManager keeps a thread local reference to the buffer
+    // created by the first one. It has to push in a new buffer for the second one
+    std::mutex mutex;
+    std::condition_variable condition;
+    int step = 0;
+    auto waitStep = [&mutex, &condition, &step](int wanted)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&step, wanted]() { return step >= wanted; });
+    };
+    auto setStep = [&mutex, &condition, &step](int newStep)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            step = newStep;
+        }
+        condition.notify_all();
+    };
+
+    WrittenMessages written1;
+    WrittenMessages written2;
+    std::unique_ptr<LogManager> logMgr(new LogManager);
+    logMgr->addSink(std::unique_ptr<LogSink>(new LogSinkTest(written1)));
+
+    std::thread thread([&waitStep, &setStep]()
+    {
+        OD_LOG_INF("thread1");
+        setStep(1);
+        waitStep(2);
+        OD_LOG_INF("thread2");
+    });
+
+    OD_LOG_INF("main1");
+    waitStep(1);
+
+    // Pending messages are written when the LogManager is destroyed
+    logMgr.reset();
+    BOOST_CHECK(written1.contains("main1"));
+    BOOST_CHECK(written1.contains("thread1"));
+
+    logMgr.reset(new LogManager);
+    logMgr->addSink(std::unique_ptr<LogSink>(new LogSinkTest(written2)));
+    OD_LOG_INF("main2");
+    setStep(2);
+    thread.join();
+    logMgr->flush();
+
+    BOOST_CHECK(written2.contains("main2"));
+    BOOST_CHECK(written2.contains("thread2"));
+    BOOST_CHECK_EQUAL(written1.get().size(), 2);
+    BOOST_CHECK_EQUAL(written2.get().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_LogManager_SinkLogging)
+{
+    // A sink logging from the sink thread must not wait for itself when its buffer is full. The
+    // messages that do not fit are dropped
+    WrittenMessages written;
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkLogging(written)));
+    OD_LOG_INF("trigger");
+    logMgr.flush();
+    // The messages logged by the sink are written at the next iteration of the sink thread
+    logMgr.flush();
+
+    uint32_t nbFromSink = 0;
+    for(const std::pair<LogMessageLevel, std::string>& message : written.get())
+    {
+        if(message.second == "fromSink")
+            ++nbFromSink;
+    }
+    BOOST_CHECK_EQUAL(nbFromSink, LogManager::RING_BUFFER_SIZE);
+}
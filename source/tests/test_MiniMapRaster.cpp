@@ -0,0 +1,205 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE MiniMapRaster
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/MiniMapRaster.h"
+
+#include <random>
+
+namespace
+{
+const uint32_t NB_PIXEL_VALUES = static_cast<uint32_t>(MiniMapDrawnFullPixel::enemyCreature) + 1;
+
+//! \brief Tile states given to the rasters. Claimed tiles get a seat colour depending on their position
+struct TileStates
+{
+    TileStates(uint32_t mapSizeX, uint32_t mapSizeY) :
+        mMapSizeX(mapSizeX),
+        mValues(mapSizeX * mapSizeY, MiniMapDrawnFullPixel::dirtFull),
+        mColours(mapSizeX * mapSizeY, MiniMapRaster::getPixelColour(MiniMapDrawnFullPixel::dirtFull, nullptr))
+    {}
+
+    void set(uint32_t x, uint32_t y, MiniMapDrawnFullPixel value)
+    {
+        Ogre::ColourValue seatColour(static_cast<float>(x % 5) / 5.0f, static_cast<float>(y % 3) / 3.0f, 0.5f);
+        bool isClaimed = (value == MiniMapDrawnFullPixel::claimedFull) || (value == MiniMapDrawnFullPixel::claimedGround);
+        mValues[x + y * mMapSizeX] = value;
+        mColours[x + y * mMapSizeX] = MiniMapRaster::getPixelColour(value, isClaimed ? &seatColour : nullptr);
+    }
+
+    void apply(MiniMapRaster& raster, uint32_t x, uint32_t y) const
+    {
+        raster.setTile(x, y, mValues[x + y * mMapSizeX], mColours[x + y * mMapSizeX]);
+    }
+
+    uint32_t mMapSizeX;
+    std::vector<MiniMapDrawnFullPixel> mValues;
+    std::vector<uint32_t> mColours;
+};
+
+MiniMapDrawnFullPixel randomValue(std::mt19937& generator)
+{
+    return static_cast<MiniMapDrawnFullPixel>(generator() % NB_PIXEL_VALUES);
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_MiniMapRaster_Reference)
+{
+    // With a minimap half the size of the map, each pixel shows the tile with the highest value
+    // among 2x2 tiles. The minimap y axis goes up while the image rows go down
+    const uint32_t mapSize = 64;
+    std::mt19937 generator(3);
+    TileStates states(mapSize, mapSize);
+    MiniMapRaster raster(mapSize / 2, mapSize / 2, mapSize, mapSize);
+    for(uint32_t y = 0; y < mapSize; ++y)
+    {
+        for(uint32_t x = 0; x < mapSize; ++x)
+        {
+            states.set(x, y, randomValue(generator));
+            states.apply(raster, x, y);
+        }
+    }
+    BOOST_REQUIRE(raster.flush());
+
+    for(uint32_t row = 0; row < raster.getHeight(); ++row)
+    {
+        for(uint32_t col = 0; col < raster.getWidth(); ++col)
+        {
+            uint32_t minimapY = raster.getHeight() - 1 - row;
+            uint32_t bestIndex = 2 * col + 2 * minimapY * mapSize;
+            for(uint32_t x = 2 * col; x < 2 * col + 2; ++x)
+            {
+                for(uint32_t y = 2 * minimapY; y < 2 * minimapY + 2; ++y)
+                {
+                    if(states.mValues[x + y * mapSize] > states.mValues[bestIndex])
+                        bestIndex = x + y * mapSize;
+                }
+            }
+            BOOST_REQUIRE(raster.getPixels()[col + row * raster.getWidth()] == states.mColours[bestIndex]);
+        }
+    }
+
+    // Nothing changed: nothing to upload
+    BOOST_CHECK(!raster.flush());
+    BOOST_CHECK(raster.getDirtyRects().empty());
+    states.apply(raster, 0, 0);
+    BOOST_CHECK(!raster.flush());
+}
+
+BOOST_AUTO_TEST_CASE(test_MiniMapRaster_Outline)
+{
+    const uint32_t mapSize = 50;
+    MiniMapRaster raster(mapSize, mapSize, mapSize, mapSize);
+    std::vector<Ogre::Vector3> corners;
+    corners.push_back(Ogre::Vector3(30, 40, 0));
+    corners.push_back(Ogre::Vector3(10, 40, 0));
+    corners.push_back(Ogre::Vector3(10, 20, 0));
+    corners.push_back(Ogre::Vector3(30, 20, 0));
+    raster.setOutline(corners);
+    BOOST_REQUIRE(raster.flush());
+
+    const std::vector<uint32_t>& pixels = raster.getPixels();
+    uint32_t dirtColour = MiniMapRaster::getPixelColour(MiniMapDrawnFullPixel::dirtFull, nullptr);
+    // Tile (x, y) is drawn at column x and row mapSize - 1 - y
+    BOOST_CHECK(pixels[10 + (mapSize - 1 - 30) * mapSize] == MiniMapRaster::OUTLINE_COLOUR);
+    BOOST_CHECK(pixels[20 + (mapSize - 1 - 40) * mapSize] == MiniMapRaster::OUTLINE_COLOUR);
+    BOOST_CHECK(pixels[30 + (mapSize - 1 - 20) * mapSize] == MiniMapRaster::OUTLINE_COLOUR);
+    BOOST_CHECK(pixels[20 + (mapSize - 1 - 30) * mapSize] == dirtColour);
+    BOOST_CHECK(pixels[5 + (mapSize - 1 - 5) * mapSize] == dirtColour);
+
+    // Moving the outline only repaints the cells it leaves and enters
+    for(Ogre::Vector3& corner : corners)
+        corner.x += 1;
+    raster.setOutline(corners);
+    BOOST_REQUIRE(raster.flush());
+    uint32_t nbPixels = 0;
+    for(const MiniMapRect& rect : raster.getDirtyRects())
+        nbPixels += (rect.mXMax - rect.mXMin) * (rect.mYMax - rect.mYMin);
+    BOOST_CHECK(nbPixels < mapSize * mapSize / 4);
+    BOOST_CHECK(pixels[10 + (mapSize - 1 - 30) * mapSize] == dirtColour);
+    BOOST_CHECK(pixels[11 + (mapSize - 1 - 30) * mapSize] == MiniMapRaster::OUTLINE_COLOUR);
+
+    // Corners far away from the map are clipped
+    corners[0] = Ogre::Vector3(1e6, 1e6, 0);
+    raster.setOutline(corners);
+    raster.flush();
+}
+
+BOOST_AUTO_TEST_CASE(test_MiniMapRaster_Incremental)
+{
+    // The incremental raster should match a raster painted from scratch with the same state and
+    // only the pixels within the dirty rectangles should change
+    const uint32_t mapSizeX = 100;
+    const uint32_t mapSizeY = 80;
+    const uint32_t sizes[][2] = {{150, 130}, {70, 50}, {100, 80}};
+    for(const uint32_t* size : sizes)
+    {
+        std::mt19937 generator(size[0]);
+        std::uniform_real_distribution<double> coordinate(-20.0, 120.0);
+        TileStates states(mapSizeX, mapSizeY);
+        MiniMapRaster raster(size[0], size[1], mapSizeX, mapSizeY);
+        raster.flush();
+        std::vector<Ogre::Vector3> corners(4);
+        for(uint32_t frame = 0; frame < 200; ++frame)
+        {
+            for(uint32_t i = 0; i < 20; ++i)
+            {
+                uint32_t x = generator() % mapSizeX;
+                uint32_t y = generator() % mapSizeY;
+                states.set(x, y, randomValue(generator));
+                states.apply(raster, x, y);
+            }
+            if(frame % 3 == 0)
+            {
+                for(Ogre::Vector3& corner : corners)
+                    corner = Ogre::Vector3(static_cast<Ogre::Real>(coordinate(generator)), static_cast<Ogre::Real>(coordinate(generator)), 0);
+            }
+            raster.setOutline(corners);
+
+            std::vector<uint32_t> previousPixels = raster.getPixels();
+            raster.flush();
+            std::vector<bool> isInDirtyRect(raster.getPixels().size(), false);
+            for(const MiniMapRect& rect : raster.getDirtyRects())
+            {
+                BOOST_REQUIRE(rect.mXMax <= raster.getWidth());
+                BOOST_REQUIRE(rect.mYMax <= raster.getHeight());
+                for(uint32_t yy = rect.mYMin; yy < rect.mYMax; ++yy)
+                {
+                    for(uint32_t xx = rect.mXMin; xx < rect.mXMax; ++xx)
+                        isInDirtyRect[xx + yy * raster.getWidth()] = true;
+                }
+            }
+            for(uint32_t i = 0; i < previousPixels.size(); ++i)
+            {
+                if(previousPixels[i] != raster.getPixels()[i])
+                    BOOST_REQUIRE(isInDirtyRect[i]);
+            }
+
+            MiniMapRaster reference(size[0], size[1], mapSizeX, mapSizeY);
+            for(uint32_t y = 0; y < mapSizeY; ++y)
+            {
+                for(uint32_t x = 0; x < mapSizeX; ++x)
+                    states.apply(reference, x, y);
+            }
+            reference.setOutline(corners);
+            reference.flush();
+            BOOST_REQUIRE(reference.getPixels() == raster.getPixels());
+        }
+    }
+}
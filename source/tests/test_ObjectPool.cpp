@@ -0,0 +1,342 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ObjectPool
+#include "BoostTestTargetConfig.h"
+
+#include "utils/ObjectPool.h"
+#include "utils/RecyclingPool.h"
+#include "utils/TurnArena.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+//! \brief Number of calls to the global operator new while isCountingAllocations is set
+std::atomic<uint64_t> nbGlobalAllocations(0);
+std::atomic<bool> isCountingAllocations(false);
+}
+
+void* operator new(std::size_t size)
+{
+    if(isCountingAllocations.load(std::memory_order_relaxed))
+        ++nbGlobalAllocations;
+
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if(ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+// GCC inlines the replaced operators and then reports the free as not matching the operator new
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+BOOST_AUTO_TEST_CASE(test_ObjectPool_ReuseBlocks)
+{
+    ObjectPool* pool = new ObjectPool("test");
+
+    // Freed blocks should be reused by the allocations of the same size class
+    std::vector<void*> blocks;
+    for(int i = 0; i < 100; ++i)
+    {
+        void* ptr = pool->allocate(40);
+        std::memset(ptr, i, 40);
+        blocks.push_back(ptr);
+    }
+    BOOST_CHECK(std::set<void*>(blocks.begin(), blocks.end()).size() == blocks.size());
+
+    std::set<void*> freed(blocks.begin(), blocks.end());
+    for(void* ptr : blocks)
+        pool->deallocate(ptr, 40);
+
+    for(int i = 0; i < 100; ++i)
+    {
+        void* ptr = pool->allocate(33 + (i % 15));
+        BOOST_CHECK(freed.count(ptr) == 1);
+        freed.erase(ptr);
+    }
+
+    // Big objects go to the heap
+    void* big = pool->allocate(100000);
+    std::memset(big, 0, 100000);
+    pool->deallocate(big, 100000);
+}
+
+BOOST_AUTO_TEST_CASE(test_TurnArena_Rewind)
+{
+    TurnArena* arena = new TurnArena("test", 1024);
+
+    void* first = arena->allocate(100);
+    void* second = arena->allocate(100);
+    BOOST_CHECK(first != second);
+    BOOST_CHECK(reinterpret_cast<uintptr_t>(second) % 16 == 0);
+
+    // When the arena is full, objects are allocated on the heap
+    void* heap = arena->allocate(2000);
+    std::memset(heap, 0, 2000);
+    arena->deallocate(heap);
+
+    // The buffer is used again only when every object has been freed
+    arena->deallocate(first);
+    void* third = arena->allocate(100);
+    BOOST_CHECK(third != first);
+    arena->deallocate(second);
+    arena->deallocate(third);
+    BOOST_CHECK(arena->allocate(100) == first);
+}
+
+BOOST_AUTO_TEST_CASE(test_RecyclingPool_Reuse)
+{
+    struct Buffer
+    {
+        std::vector<char> mData;
+        void clear()
+        { mData.clear(); }
+        std::size_t getDataSize() const
+        { return mData.size(); }
+    };
+
+    RecyclingPool<Buffer>* pool = new RecyclingPool<Buffer>(2, 100);
+    uint32_t nbHeapAllocations;
+    RecyclingPool<Buffer>::Item* item = pool->acquire(nbHeapAllocations);
+    BOOST_CHECK(nbHeapAllocations == 1);
+    item->mObject.mData.resize(50);
+    BOOST_CHECK(pool->release(item) == 1);
+
+    // The item is reused cleared and does not allocate as long as it does not grow
+    BOOST_CHECK(pool->acquire(nbHeapAllocations) == item);
+    BOOST_CHECK(nbHeapAllocations == 0);
+    BOOST_CHECK(item->mObject.mData.empty());
+    item->mObject.mData.resize(40);
+    BOOST_CHECK(pool->release(item) == 0);
+
+    // Items too big are not kept
+    item = pool->acquire(nbHeapAllocations);
+    item->mObject.mData.resize(200);
+    BOOST_CHECK(pool->release(item) == 1);
+    pool->acquire(nbHeapAllocations);
+    BOOST_CHECK(nbHeapAllocations == 1);
+}
+
+namespace
+{
+//! \brief Packet written field by field like ODPacket: its buffer grows with each field and keeps its capacity when cleared
+struct BenchPacket
+{
+    std::vector<char> mData;
+
+    void append(const void* data, std::size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        mData.insert(mData.end(), bytes, bytes + size);
+    }
+
+    void clear()
+    { mData.clear(); }
+
+    std::size_t getDataSize() const
+    { return mData.size(); }
+};
+
+//! \brief Writes a message similar to the ones sent for a fighting creature (type, name, position, state)
+void writeFightMessage(BenchPacket& packet, int index)
+{
+    int32_t type = index % 40;
+    const char* name = "Creature_Fighter";
+    float position[3] = { 1.0f, 2.0f, 0.0f };
+    double hp = 100.0 - index;
+    packet.append(&type, sizeof(type));
+    packet.append(name, std::strlen(name));
+    packet.append(position, sizeof(position));
+    packet.append(&hp, sizeof(hp));
+}
+
+//! \brief Objects created during a fight, with sizes close to the game ones (creature actions, missiles,
+//! particle effects). Pooled objects use an ObjectPool like the game classes
+template<std::size_t Size>
+struct HeapObject
+{
+    char mData[Size];
+};
+
+template<std::size_t Size>
+struct PooledObject
+{
+    char mData[Size];
+
+    static ObjectPool& getPool()
+    {
+        static ObjectPool* pool = new ObjectPool("Bench" + std::to_string(Size));
+        return *pool;
+    }
+
+    static void* operator new(std::size_t size)
+    { return getPool().allocate(size); }
+
+    static void operator delete(void* ptr, std::size_t size)
+    { getPool().deallocate(ptr, size); }
+};
+
+//! \brief Server notification as it was before: allocated on the heap with its own packet
+struct HeapNotification
+{
+    BenchPacket mPacket;
+};
+
+//! \brief Server notification allocated like ServerNotification: from a TurnArena with a recycled packet
+struct ArenaNotification
+{
+    static TurnArena& getArena()
+    {
+        static TurnArena* arena = new TurnArena("BenchNotification", 128 * 1024);
+        return *arena;
+    }
+
+    static RecyclingPool<BenchPacket>& getPackets()
+    {
+        static RecyclingPool<BenchPacket>* packets = new RecyclingPool<BenchPacket>(1024, 16 * 1024);
+        return *packets;
+    }
+
+    static void* operator new(std::size_t size)
+    { return getArena().allocate(size); }
+
+    static void operator delete(void* ptr)
+    { getArena().deallocate(ptr); }
+
+    ArenaNotification() :
+        mPacketItem(acquirePacket()),
+        mPacket(mPacketItem->mObject)
+    {}
+
+    ~ArenaNotification()
+    { getArena().countHeapAllocations(getPackets().release(mPacketItem)); }
+
+    static RecyclingPool<BenchPacket>::Item* acquirePacket()
+    {
+        uint32_t nbHeapAllocations;
+        RecyclingPool<BenchPacket>::Item* item = getPackets().acquire(nbHeapAllocations);
+        getArena().countHeapAllocations(nbHeapAllocations);
+        return item;
+    }
+
+    RecyclingPool<BenchPacket>::Item* mPacketItem;
+    BenchPacket& mPacket;
+};
+
+const int BENCH_NB_CREATURES = 40;
+
+/*! \brief Simulates the allocations of the combat turns of BENCH_NB_CREATURES creatures. Each turn, each
+ * creature pushes and pops 2 actions, one creature out of 2 fires a missile and each hit spawns 2 particle
+ * effects. Missiles and effects live until the next turn. Each creature also sends 5 notifications freed at
+ * the end of the turn. Returns the average number of heap allocations per turn
+ */
+template<typename Action, typename Missile, typename Effect, typename Notification>
+double runCombatTurns(int nbTurns)
+{
+    std::vector<Missile*> missiles;
+    std::vector<Effect*> effects;
+    std::vector<Notification*> notifications;
+    missiles.reserve(BENCH_NB_CREATURES);
+    effects.reserve(BENCH_NB_CREATURES * 2);
+    notifications.reserve(BENCH_NB_CREATURES * 5);
+
+    nbGlobalAllocations = 0;
+    isCountingAllocations = true;
+    for(int turn = 0; turn < nbTurns; ++turn)
+    {
+        for(Missile* missile : missiles)
+            delete missile;
+        missiles.clear();
+        for(Effect* effect : effects)
+            delete effect;
+        effects.clear();
+
+        for(int i = 0; i < BENCH_NB_CREATURES; ++i)
+        {
+            for(int k = 0; k < 2; ++k)
+                delete new Action();
+
+            if(i % 2 == 0)
+                missiles.push_back(new Missile());
+
+            effects.push_back(new Effect());
+            effects.push_back(new Effect());
+
+            for(int k = 0; k < 5; ++k)
+            {
+                Notification* notification = new Notification();
+                writeFightMessage(notification->mPacket, i);
+                notifications.push_back(notification);
+            }
+        }
+
+        for(Notification* notification : notifications)
+            delete notification;
+        notifications.clear();
+    }
+    isCountingAllocations = false;
+
+    for(Missile* missile : missiles)
+        delete missile;
+    for(Effect* effect : effects)
+        delete effect;
+
+    return static_cast<double>(nbGlobalAllocations.load()) / nbTurns;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_ObjectPool_CombatTurnBenchmark)
+{
+    const int nbTurns = 200;
+    double heapPerTurn = runCombatTurns<HeapObject<96>, HeapObject<640>, HeapObject<80>, HeapNotification>(nbTurns);
+
+    // The first turns fill the pools
+    runCombatTurns<PooledObject<96>, PooledObject<640>, PooledObject<80>, ArenaNotification>(10);
+    double pooledPerTurn = runCombatTurns<PooledObject<96>, PooledObject<640>, PooledObject<80>, ArenaNotification>(nbTurns);
+
+    // The counters reported to the profiler should see the same heap allocations
+    uint64_t reportedHeapAllocations = 0;
+    TurnArena::reportTurnCounts([&reportedHeapAllocations](const char* name, uint64_t value)
+    {
+        if(std::string(name) == "BenchNotification heap allocations")
+            reportedHeapAllocations += value;
+    });
+
+    BOOST_TEST_MESSAGE("Heap allocations per combat turn: " + std::to_string(heapPerTurn)
+        + " without pools, " + std::to_string(pooledPerTurn) + " with pools");
+    BOOST_CHECK(pooledPerTurn * 10 <= heapPerTurn);
+    // The packets grown during the warm up turns are counted in the notification arena
+    BOOST_CHECK(reportedHeapAllocations > 0);
+}
@@ -0,0 +1,220 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE OccupancyGrid
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/OccupancyGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+struct FakeCreature
+{
+    int mX;
+    int mY;
+    int mTeam;
+    bool mIsAlive;
+};
+
+//! \brief Calls func for each tile between (x1, y1) and (x2, y2) like TileContainer::tilesBetween
+template <typename Func>
+void walkSegment(int x1, int y1, int x2, int y2, int sizeX, int sizeY, Func func)
+{
+    int deltaX = x2 - x1;
+    int deltaY = y2 - y1;
+    int nbSteps = std::max(std::abs(deltaX), std::abs(deltaY));
+    for(int step = 0; step < nbSteps; ++step)
+    {
+        int x = x1 + (deltaX * step) / nbSteps;
+        int y = y1 + (deltaY * step) / nbSteps;
+        if((x < 0) || (x >= sizeX) || (y < 0) || (y >= sizeY))
+            return;
+
+        func(x, y);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_OccupancyGrid_Cells)
+{
+    const int sizeX = 37;
+    const int sizeY = 23;
+    std::mt19937 generator(7);
+    OccupancyGrid<int> grid;
+    BOOST_CHECK(grid.getCell(0, 0).empty());
+
+    for(int build = 0; build < 5; ++build)
+    {
+        std::vector<std::vector<int>> expected(sizeX * sizeY);
+        grid.beginBuild(sizeX, sizeY);
+        for(int value = 0; value < 500; ++value)
+        {
+            // Some values are outside of the map and should be ignored
+            int x = static_cast<int>(generator() % (sizeX + 4)) - 2;
+            int y = static_cast<int>(generator() % (sizeY + 4)) - 2;
+            grid.add(x, y, value);
+            if((x >= 0) && (x < sizeX) && (y >= 0) && (y < sizeY))
+                expected[x + y * sizeX].push_back(value);
+        }
+        grid.endBuild();
+
+        uint32_t nbValues = 0;
+        for(int y = 0; y < sizeY; ++y)
+        {
+            for(int x = 0; x < sizeX; ++x)
+            {
+                OccupancyGrid<int>::Range range = grid.getCell(x, y);
+                const std::vector<int>& expectedValues = expected[x + y * sizeX];
+                BOOST_REQUIRE(range.size() == expectedValues.size());
+                BOOST_REQUIRE(std::equal(range.begin(), range.end(), expectedValues.begin()));
+                nbValues += range.size();
+            }
+        }
+        BOOST_CHECK(nbValues == grid.getNbValues());
+        BOOST_CHECK(grid.getCell(-1, 0).empty());
+        BOOST_CHECK(grid.getCell(sizeX, 0).empty());
+    }
+
+    grid.clear();
+    BOOST_CHECK(grid.getNbValues() == 0);
+    BOOST_CHECK(grid.getCell(3, 3).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_OccupancyGrid_Battle)
+{
+    // Scripted battle: 2 armies walk towards each other and every alive creature launches a missile
+    // at each turn. We compare the creatures found along the missile paths by the per tile lists
+    // (like Tile::mEntitiesInTile with getVisibleCreatures) and by the grid built once per turn
+    const int sizeX = 100;
+    const int sizeY = 60;
+    const int nbCreaturesByTeam = 300;
+    const int nbTurns = 80;
+    const int missileRange = 6;
+    std::mt19937 generator(11);
+
+    std::vector<FakeCreature> creatures;
+    for(int team = 0; team < 2; ++team)
+    {
+        for(int i = 0; i < nbCreaturesByTeam; ++i)
+        {
+            FakeCreature creature;
+            creature.mX = (team == 0) ? static_cast<int>(generator() % 20) : sizeX - 1 - static_cast<int>(generator() % 20);
+            creature.mY = static_cast<int>(generator() % sizeY);
+            creature.mTeam = team;
+            creature.mIsAlive = true;
+            creatures.push_back(creature);
+        }
+    }
+
+    std::vector<std::vector<const FakeCreature*>> tileLists(sizeX * sizeY);
+    OccupancyGrid<const FakeCreature*> grid;
+    std::chrono::duration<double> durationLists(0);
+    std::chrono::duration<double> durationGrid(0);
+    uint64_t nbHitsLists = 0;
+    uint64_t nbHitsGrid = 0;
+    for(int turn = 0; turn < nbTurns; ++turn)
+    {
+        // Creatures move towards the enemy side and some die
+        for(FakeCreature& creature : creatures)
+        {
+            if(!creature.mIsAlive)
+                continue;
+
+            int dir = (creature.mTeam == 0) ? 1 : -1;
+            if(generator() % 3 != 0)
+                creature.mX = std::min(sizeX - 1, std::max(0, creature.mX + dir));
+            creature.mY = std::min(sizeY - 1, std::max(0, creature.mY + static_cast<int>(generator() % 3) - 1));
+            if(generator() % 200 == 0)
+                creature.mIsAlive = false;
+        }
+
+        for(std::vector<const FakeCreature*>& tileList : tileLists)
+            tileList.clear();
+        for(const FakeCreature& creature : creatures)
+            tileLists[creature.mX + creature.mY * sizeX].push_back(&creature);
+
+        auto start = std::chrono::steady_clock::now();
+        grid.beginBuild(sizeX, sizeY);
+        for(const FakeCreature& creature : creatures)
+        {
+            if(creature.mIsAlive)
+                grid.add(creature.mX, creature.mY, &creature);
+        }
+        grid.endBuild();
+        durationGrid += std::chrono::steady_clock::now() - start;
+
+        for(const FakeCreature& shooter : creatures)
+        {
+            if(!shooter.mIsAlive)
+                continue;
+
+            int dir = (shooter.mTeam == 0) ? 1 : -1;
+            int x2 = shooter.mX + dir * missileRange;
+            int y2 = shooter.mY + static_cast<int>(generator() % 5) - 2;
+
+            // Per tile lists with temporary containers like the previous missile code
+            start = std::chrono::steady_clock::now();
+            walkSegment(shooter.mX, shooter.mY, x2, y2, sizeX, sizeY, [&](int x, int y)
+            {
+                std::vector<int> tileVector;
+                tileVector.push_back(x + y * sizeX);
+                for(int allied = 0; allied < 2; ++allied)
+                {
+                    std::vector<const FakeCreature*> found;
+                    for(int index : tileVector)
+                    {
+                        for(const FakeCreature* creature : tileLists[index])
+                        {
+                            if(!creature->mIsAlive)
+                                continue;
+                            if((creature->mTeam == shooter.mTeam) != (allied == 1))
+                                continue;
+                            found.push_back(creature);
+                        }
+                    }
+                    nbHitsLists += found.size();
+                }
+            });
+            durationLists += std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            walkSegment(shooter.mX, shooter.mY, x2, y2, sizeX, sizeY, [&](int x, int y)
+            {
+                for(int allied = 0; allied < 2; ++allied)
+                {
+                    for(const FakeCreature* creature : grid.getCell(x, y))
+                    {
+                        if((creature->mTeam == shooter.mTeam) != (allied == 1))
+                            continue;
+                        ++nbHitsGrid;
+                    }
+                }
+            });
+            durationGrid += std::chrono::steady_clock::now() - start;
+        }
+    }
+
+    BOOST_CHECK(nbHitsLists > 0);
+    BOOST_CHECK(nbHitsLists == nbHitsGrid);
+    BOOST_TEST_MESSAGE("Battle: hits=" << nbHitsGrid << ", per tile lists=" << durationLists.count() * 1000.0
+        << "ms, grid=" << durationGrid.count() * 1000.0 << "ms");
+}
@@ -20,8 +20,122 @@
 #define BOOST_TEST_MODULE Random
 #include "BoostTestTargetConfig.h"
 
+#include <cstdint>
+#include <vector>
+
 BOOST_AUTO_TEST_CASE(test_Random)
 {
     Random::initialize();
     BOOST_CHECK (Random::Int(1, 2 ) <= 2);
 }
+
+BOOST_AUTO_TEST_CASE(test_RandomBounds)
+{
+    Random::initialize(42);
+    bool minFound = false;
+    bool maxFound = false;
+    for(int i = 0; i < 10000; ++i)
+    {
+        int value = Random::Int(5, -3);
+        BOOST_REQUIRE(value >= -3 && value <= 5);
+        minFound |= (value == -3);
+        maxFound |= (value == 5);
+
+        unsigned int uvalue = Random::Uint(7, 10);
+        BOOST_REQUIRE(uvalue >= 7 && uvalue <= 10);
+
+        double dvalue = Random::Double(-1.0, 1.0);
+        BOOST_REQUIRE(dvalue >= -1.0 && dvalue < 1.0);
+    }
+    BOOST_CHECK(minFound);
+    BOOST_CHECK(maxFound);
+
+    // Extreme ranges should not overflow
+    for(int i = 0; i < 100; ++i)
+    {
+        Random::Int(INT32_MIN, INT32_MAX);
+        Random::Uint(0, UINT32_MAX);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_RandomDistribution)
+{
+    // We check that each value is drawn roughly the same number of times with a chi-squared test
+    RandomStream stream(1234);
+    const int nbBuckets = 10;
+    const int nbDraws = 100000;
+    std::vector<int> buckets(nbBuckets, 0);
+    for(int i = 0; i < nbDraws; ++i)
+        ++buckets[stream.Int(0, nbBuckets - 1)];
+
+    double expected = static_cast<double>(nbDraws) / nbBuckets;
+    double chi2 = 0.0;
+    for(int count : buckets)
+        chi2 += (count - expected) * (count - expected) / expected;
+
+    // 99.9% quantile of the chi-squared distribution with 9 degrees of freedom
+    BOOST_CHECK(chi2 < 27.88);
+
+    // Doubles should have a mean close to the middle of the interval
+    double sum = 0.0;
+    for(int i = 0; i < nbDraws; ++i)
+        sum += stream.Double(0.0, 1.0);
+    BOOST_CHECK_CLOSE(sum / nbDraws, 0.5, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_RandomStreams)
+{
+    // Same seed and same stream id should give the same sequence
+    Random::initialize(987654321);
+    RandomStream seat1 = Random::makeStream(RandomStreamType::seat, 1);
+    RandomStream seat1Copy = Random::makeStream(RandomStreamType::seat, 1);
+    RandomStream seat2 = Random::makeStream(RandomStreamType::seat, 2);
+    RandomStream entity1 = Random::makeStream(RandomStreamType::entity, 1);
+
+    // Drawing from the global stream should not change the seat streams
+    for(int i = 0; i < 100; ++i)
+        Random::Int(0, 100);
+
+    const int nbDraws = 10000;
+    int nbSame = 0;
+    int nbSameEntity = 0;
+    for(int i = 0; i < nbDraws; ++i)
+    {
+        uint64_t value = seat1.next();
+        BOOST_REQUIRE_EQUAL(value, seat1Copy.next());
+
+        // Independent streams should agree on the lowest bit about half of the time
+        nbSame += ((value & 1) == (seat2.next() & 1)) ? 1 : 0;
+        nbSameEntity += ((value & 1) == (entity1.next() & 1)) ? 1 : 0;
+    }
+    BOOST_CHECK(nbSame > nbDraws * 45 / 100 && nbSame < nbDraws * 55 / 100);
+    BOOST_CHECK(nbSameEntity > nbDraws * 45 / 100 && nbSameEntity < nbDraws * 55 / 100);
+
+    // A different match seed should give different streams
+    Random::initialize(987654322);
+    RandomStream otherSeat1 = Random::makeStream(RandomStreamType::seat, 1);
+    RandomStream seat1Again(987654321, (static_cast<uint64_t>(RandomStreamType::seat) << 56) ^ 1);
+    BOOST_CHECK(otherSeat1.next() != seat1Again.next());
+}
+
+BOOST_AUTO_TEST_CASE(test_RandomBulkFill)
+{
+    RandomStream stream(55);
+    RandomStream streamCopy(55);
+    std::vector<double> values(1001);
+    stream.fillDouble(values.data(), values.size(), 2.0, 3.0);
+    for(double value : values)
+    {
+        BOOST_REQUIRE(value >= 2.0 && value < 3.0);
+        BOOST_REQUIRE_EQUAL(value, streamCopy.Double(2.0, 3.0));
+    }
+
+    std::vector<uint32_t> uvalues(11);
+    stream.fillUint32(uvalues.data(), uvalues.size());
+    for(uint32_t i = 0; i + 1 < uvalues.size(); i += 2)
+    {
+        uint64_t value = streamCopy.next();
+        BOOST_CHECK_EQUAL(uvalues[i], static_cast<uint32_t>(value >> 32));
+        BOOST_CHECK_EQUAL(uvalues[i + 1], static_cast<uint32_t>(value));
+    }
+}
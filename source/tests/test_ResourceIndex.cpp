@@ -0,0 +1,223 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE ResourceIndex
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/DigReachability.h"
+#include "gamemap/ResourceBuckets.h"
+#include "utils/Random.h"
+
+#include <vector>
+
+namespace
+{
+struct FakeTile
+{
+    int mX;
+    int mY;
+    DigReachability::Passability mPassability;
+    bool mIsGold;
+
+    inline int getX() const
+    { return mX; }
+
+    inline int getY() const
+    { return mY; }
+};
+
+//! \brief Map full of dirt with its gold tiles indexed like ResourceIndex does
+struct FakeMap
+{
+    int mSizeX;
+    int mSizeY;
+    std::vector<FakeTile> mTiles;
+    ResourceBuckets<FakeTile> mGoldTiles;
+
+    FakeMap(int sizeX, int sizeY) :
+        mSizeX(sizeX),
+        mSizeY(sizeY)
+    {
+        for(int y = 0; y < mSizeY; ++y)
+        {
+            for(int x = 0; x < mSizeX; ++x)
+                mTiles.push_back({ x, y, DigReachability::Passability::diggable, false });
+        }
+        mGoldTiles.resize(mSizeX, mSizeY);
+    }
+
+    FakeTile& getTile(int x, int y)
+    {
+        return mTiles[x + y * mSizeX];
+    }
+
+    void setPassability(int x, int y, DigReachability::Passability passability)
+    {
+        getTile(x, y).mPassability = passability;
+    }
+
+    void setGold(int x, int y, bool isGold)
+    {
+        FakeTile& tile = getTile(x, y);
+        tile.mIsGold = isGold;
+        if(isGold)
+            tile.mPassability = DigReachability::Passability::diggable;
+        mGoldTiles.update(tile, isGold);
+    }
+
+    //! \brief Same query as ResourceIndex::getNearestGoldTile
+    FakeTile* getNearestReachableGold(int startX, int startY, RandomStream& random, uint32_t& nbPassabilityCalls)
+    {
+        DigReachability reachability;
+        nbPassabilityCalls = 0;
+        reachability.compute(mSizeX, mSizeY, startX, startY, [this, &nbPassabilityCalls](int x, int y)
+        {
+            ++nbPassabilityCalls;
+            return getTile(x, y).mPassability;
+        });
+        return mGoldTiles.getNearest(startX, startY, [&reachability](const FakeTile& tile)
+        {
+            return reachability.isReachable(tile.getX(), tile.getY());
+        }, random);
+    }
+
+    FakeTile* getNearestGold(int startX, int startY, RandomStream& random)
+    {
+        return mGoldTiles.getNearest(startX, startY, [](const FakeTile&) { return true; }, random);
+    }
+};
+}
+
+BOOST_AUTO_TEST_CASE(test_ResourceBuckets_Order)
+{
+    RandomStream random(42);
+    FakeMap map(40, 30);
+    BOOST_CHECK(map.getNearestGold(10, 10, random) == nullptr);
+
+    // Tiles on the start tile are ignored
+    map.setGold(10, 10, true);
+    BOOST_CHECK(map.getNearestGold(10, 10, random) == nullptr);
+
+    // The closest ring wins, then the tile closest to the middle of the ring side. Buckets are
+    // 8 tiles wide so these tiles are in different buckets
+    map.setGold(35, 10, true);
+    map.setGold(10, 2, true);
+    map.setGold(13, 19, true);
+    BOOST_CHECK(map.getNearestGold(10, 10, random) == &map.getTile(10, 2));
+    map.setGold(17, 9, true);
+    map.setGold(4, 2, true);
+    BOOST_CHECK(map.getNearestGold(10, 10, random) == &map.getTile(17, 9));
+    map.setGold(10, 3, true);
+    BOOST_CHECK(map.getNearestGold(10, 10, random) == &map.getTile(10, 3));
+    BOOST_CHECK(map.mGoldTiles.getNbObjects() == 7);
+
+    // Tiles at the same place on the ring are randomly chosen
+    map.setGold(10, 17, true);
+    bool isNorthChosen = false;
+    bool isSouthChosen = false;
+    for(int i = 0; i < 50; ++i)
+    {
+        FakeTile* tile = map.getNearestGold(10, 10, random);
+        BOOST_REQUIRE((tile == &map.getTile(10, 3)) || (tile == &map.getTile(10, 17)));
+        isNorthChosen |= (tile == &map.getTile(10, 3));
+        isSouthChosen |= (tile == &map.getTile(10, 17));
+    }
+    BOOST_CHECK(isNorthChosen && isSouthChosen);
+
+    // Removed tiles are not returned anymore. Removing twice does nothing
+    map.setGold(10, 3, false);
+    map.setGold(10, 3, false);
+    map.setGold(10, 17, false);
+    BOOST_CHECK(map.getNearestGold(10, 10, random) == &map.getTile(17, 9));
+    BOOST_CHECK(map.mGoldTiles.getNbObjects() == 6);
+}
+
+BOOST_AUTO_TEST_CASE(test_ResourceIndex_UnreachableGold)
+{
+    RandomStream random(7);
+    FakeMap map(30, 30);
+    uint32_t nbPassabilityCalls;
+
+    // The dungeon is a walkable room around (5, 5) in the dirt
+    for(int x = 3; x <= 7; ++x)
+    {
+        for(int y = 3; y <= 7; ++y)
+            map.setPassability(x, y, DigReachability::Passability::walkable);
+    }
+
+    // The nearest gold is behind a lava river crossing the whole map
+    for(int x = 0; x < 30; ++x)
+        map.setPassability(x, 8, DigReachability::Passability::blocked);
+    map.setGold(5, 9, true);
+
+    // Another gold tile is enclosed in rock
+    map.setGold(10, 5, true);
+    for(int x = 9; x <= 11; ++x)
+    {
+        for(int y = 4; y <= 6; ++y)
+        {
+            if((x != 10) || (y != 5))
+                map.setPassability(x, y, DigReachability::Passability::blocked);
+        }
+    }
+
+    // The only reachable gold is further, with dirt to dig on the way
+    map.setGold(0, 0, true);
+    map.setGold(20, 2, true);
+
+    BOOST_CHECK(map.getNearestGold(5, 5, random) == &map.getTile(5, 9));
+    BOOST_CHECK(map.getNearestReachableGold(5, 5, random, nbPassabilityCalls) == &map.getTile(0, 0));
+    BOOST_CHECK(nbPassabilityCalls <= 30 * 30);
+
+    // Once this one is mined, we go to the next reachable one
+    map.setGold(0, 0, false);
+    BOOST_CHECK(map.getNearestReachableGold(5, 5, random, nbPassabilityCalls) == &map.getTile(20, 2));
+
+    // If the river is bridged, the closest gold can be reached
+    map.setPassability(5, 8, DigReachability::Passability::walkable);
+    BOOST_CHECK(map.getNearestReachableGold(5, 5, random, nbPassabilityCalls) == &map.getTile(5, 9));
+
+    // No reachable gold left
+    map.setGold(5, 9, false);
+    map.setGold(20, 2, false);
+    BOOST_CHECK(map.getNearestGold(5, 5, random) == &map.getTile(10, 5));
+    BOOST_CHECK(map.getNearestReachableGold(5, 5, random, nbPassabilityCalls) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_DigReachability_Diagonals)
+{
+    // Workers dig the 4 adjacent tiles only so a tile touching the area by a corner is not reachable
+    const int sizeX = 5;
+    const int sizeY = 5;
+    std::vector<DigReachability::Passability> passability(sizeX * sizeY, DigReachability::Passability::blocked);
+    passability[1 + 1 * sizeX] = DigReachability::Passability::walkable;
+    passability[2 + 1 * sizeX] = DigReachability::Passability::diggable;
+    passability[3 + 2 * sizeX] = DigReachability::Passability::diggable;
+
+    DigReachability reachability;
+    reachability.compute(sizeX, sizeY, 1, 1, [&](int x, int y)
+    {
+        return passability[x + y * sizeX];
+    });
+    BOOST_CHECK(reachability.isReachable(1, 1));
+    BOOST_CHECK(reachability.isReachable(2, 1));
+    BOOST_CHECK(!reachability.isReachable(3, 2));
+    BOOST_CHECK(!reachability.isReachable(0, 0));
+    BOOST_CHECK(!reachability.isReachable(-1, 1));
+    BOOST_CHECK(!reachability.isReachable(1, sizeY));
+}
@@ -0,0 +1,331 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ShadowTables
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/BinaryLevel.h"
+#include "gamemap/ShadowTables.h"
+#include "utils/LogManager.h"
+#include "utils/LogSinkConsole.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace
+{
+//! \brief A map where each tile blocks vision or not
+struct TestMap
+{
+    TestMap(int mapSizeX, int mapSizeY, bool isOpaque) :
+        mMapSizeX(mapSizeX),
+        mMapSizeY(mapSizeY),
+        mOpaque(mapSizeX * mapSizeY, isOpaque)
+    {}
+
+    int mMapSizeX;
+    int mMapSizeY;
+    std::vector<bool> mOpaque;
+
+    void fillGrid(OpacityGrid& grid) const
+    {
+        grid.resize(mMapSizeX, mMapSizeY);
+        for(int x = 0; x < mMapSizeX; ++x)
+        {
+            for(int y = 0; y < mMapSizeY; ++y)
+                grid.setOpaque(x, y, mOpaque[x + y * mMapSizeX]);
+        }
+    }
+};
+
+//! \brief Hidden values of a tile as computed by the previous implementation of TileContainer::visibleTiles
+struct ReferenceTile
+{
+    ReferenceTile() :
+        mEntry(0),
+        mIndex(-1),
+        mHiddenNorth(0.0),
+        mHiddenSouth(0.0)
+    {}
+
+    uint32_t mEntry;
+    //! \brief -1 if the tile is not on the map
+    int mIndex;
+    double mHiddenNorth;
+    double mHiddenSouth;
+};
+
+/*! \brief Visibility computed like TileContainer::visibleTiles did before the shadows were flattened: an
+ * array of tiles is filled for each octant by walking the entries, then every opaque tile applies its
+ * hidden lists and the diagonal tiles are merged. tables should be built up to radius
+ */
+std::vector<uint32_t> referenceVisibleTiles(const ShadowTables& tables, const TestMap& map, int x, int y, int radius)
+{
+    int radiusSquared = radius * radius;
+    std::vector<ReferenceTile> tilesProcess[8];
+    for(uint32_t k = 0; k < 8; ++k)
+    {
+        for(uint32_t entry = 0; entry < tables.getNbEntries(); ++entry)
+        {
+            if(tables.getEntryDistSquared(entry) > radiusSquared)
+                break;
+
+            int diffX = tables.getEntryDiffX(entry);
+            int diffY = tables.getEntryDiffY(entry);
+            int tileX = 0;
+            int tileY = 0;
+            switch(k)
+            {
+                case 0: tileX = x + diffX; tileY = y + diffY; break;
+                case 1: tileX = x + diffY; tileY = y - diffX; break;
+                case 2: tileX = x - diffX; tileY = y - diffY; break;
+                case 3: tileX = x - diffY; tileY = y + diffX; break;
+                case 4: tileX = x + diffY; tileY = y + diffX; break;
+                case 5: tileX = x + diffX; tileY = y - diffY; break;
+                case 6: tileX = x - diffY; tileY = y - diffX; break;
+                case 7: tileX = x - diffX; tileY = y + diffY; break;
+                default: break;
+            }
+            ReferenceTile tile;
+            tile.mEntry = entry;
+            if((tileX >= 0) && (tileY >= 0) && (tileX < map.mMapSizeX) && (tileY < map.mMapSizeY))
+                tile.mIndex = tileX + tileY * map.mMapSizeX;
+
+            tilesProcess[k].push_back(tile);
+        }
+    }
+
+    for(uint32_t k = 0; k < 8; ++k)
+    {
+        for(const ReferenceTile& tile : tilesProcess[k])
+        {
+            if(tile.mIndex < 0)
+                continue;
+            if(!map.mOpaque[tile.mIndex])
+                continue;
+
+            for(const std::pair<uint32_t, double>& p : tables.getHiddenEntriesNorth(tile.mEntry))
+            {
+                if(p.first >= tilesProcess[k].size())
+                    continue;
+
+                ReferenceTile& hidden = tilesProcess[k][p.first];
+                if(p.second > hidden.mHiddenNorth)
+                    hidden.mHiddenNorth = p.second;
+            }
+            for(const std::pair<uint32_t, double>& p : tables.getHiddenEntriesSouth(tile.mEntry))
+            {
+                if(p.first >= tilesProcess[k].size())
+                    continue;
+
+                ReferenceTile& hidden = tilesProcess[k][p.first];
+                if(p.second > hidden.mHiddenSouth)
+                    hidden.mHiddenSouth = p.second;
+            }
+        }
+    }
+
+    std::vector<uint32_t> visibleTiles;
+    for(uint32_t i = 0; i < tilesProcess[0].size(); ++i)
+    {
+        for(uint32_t k = 0; k < 8; ++k)
+        {
+            ReferenceTile& tile = tilesProcess[k][i];
+            if(tile.mIndex < 0)
+                continue;
+
+            if((k > 0) && (tables.getEntryDistSquared(tile.mEntry) == 0))
+                continue;
+
+            ShadowTables::EntryType type = tables.getEntryType(tile.mEntry);
+            if((type != ShadowTables::EntryType::Other) && (k > 3))
+                continue;
+
+            double hiddenNorth = tile.mHiddenNorth;
+            double hiddenSouth = tile.mHiddenSouth;
+            if(type == ShadowTables::EntryType::Diagonal)
+            {
+                const ReferenceTile& tile2 = tilesProcess[k + 4][i];
+                hiddenNorth = std::max(hiddenNorth, tile2.mHiddenSouth);
+                hiddenSouth = std::max(hiddenSouth, tile2.mHiddenNorth);
+            }
+
+            if((hiddenNorth + hiddenSouth) > 0.5)
+                continue;
+
+            visibleTiles.push_back(static_cast<uint32_t>(tile.mIndex));
+        }
+    }
+    return visibleTiles;
+}
+
+const int RADIUSES[] = { 0, 1, 2, 3, 5, 8, 10, 15 };
+const int MAX_RADIUS = 15;
+
+//! \brief Compares the visible tiles from every tile (every step tiles) of the map. Returns the number of
+//! compared positions
+uint32_t compareWithReference(const TestMap& map, int step)
+{
+    ShadowTables referenceTables;
+    referenceTables.build(MAX_RADIUS);
+
+    // The tables tested are built by radius, in the order they are needed
+    ShadowTables tables;
+    OpacityGrid grid;
+    map.fillGrid(grid);
+    std::vector<uint32_t> visibleTiles;
+    uint32_t nbPositions = 0;
+    for(int x = 0; x < map.mMapSizeX; x += step)
+    {
+        for(int y = 0; y < map.mMapSizeY; y += step)
+        {
+            for(int radius : RADIUSES)
+            {
+                tables.computeVisibleTiles(grid, x, y, radius, visibleTiles);
+                std::vector<uint32_t> expected = referenceVisibleTiles(referenceTables, map, x, y, radius);
+                if(visibleTiles != expected)
+                {
+                    BOOST_ERROR("Different visible tiles from x=" << x << ", y=" << y << ", radius=" << radius);
+                    return nbPositions;
+                }
+            }
+            ++nbPositions;
+        }
+    }
+    return nbPositions;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_ShadowTables_OpacityGrid)
+{
+    OpacityGrid grid;
+    grid.resize(13, 7);
+    grid.setOpaque(12, 6, true);
+    grid.setOpaque(4, 5, true);
+    grid.setOpaque(4, 5, false);
+    grid.setOpaque(0, 0, true);
+    BOOST_CHECK(grid.isOpaque(12, 6));
+    BOOST_CHECK(grid.isOpaque(0, 0));
+    BOOST_CHECK(!grid.isOpaque(4, 5));
+    BOOST_CHECK(!grid.isOpaque(11, 6));
+}
+
+BOOST_AUTO_TEST_CASE(test_ShadowTables_OpenMap)
+{
+    // Without walls, every tile within the radius is visible once, sorted by distance
+    TestMap map(40, 40, false);
+    OpacityGrid grid;
+    map.fillGrid(grid);
+    ShadowTables tables;
+    std::vector<uint32_t> visibleTiles;
+    tables.computeVisibleTiles(grid, 20, 20, 5, visibleTiles);
+
+    std::vector<bool> isSeen(40 * 40, false);
+    int lastDistSquared = 0;
+    for(uint32_t index : visibleTiles)
+    {
+        int diffX = static_cast<int>(index % 40) - 20;
+        int diffY = static_cast<int>(index / 40) - 20;
+        int distSquared = diffX * diffX + diffY * diffY;
+        BOOST_CHECK(distSquared <= 25);
+        BOOST_CHECK(distSquared >= lastDistSquared);
+        BOOST_CHECK(!isSeen[index]);
+        isSeen[index] = true;
+        lastDistSquared = distSquared;
+    }
+    // Number of tiles with x² + y² <= 25
+    BOOST_CHECK(visibleTiles.size() == 81);
+}
+
+BOOST_AUTO_TEST_CASE(test_ShadowTables_Walls)
+{
+    // A wall next to the center hides the tiles behind it
+    TestMap map(20, 20, false);
+    map.mOpaque[11 + 10 * 20] = true;
+    OpacityGrid grid;
+    map.fillGrid(grid);
+    ShadowTables tables;
+    std::vector<uint32_t> visibleTiles;
+    tables.computeVisibleTiles(grid, 10, 10, 6, visibleTiles);
+    std::vector<bool> isVisible(20 * 20, false);
+    for(uint32_t index : visibleTiles)
+        isVisible[index] = true;
+
+    BOOST_CHECK(isVisible[11 + 10 * 20]);
+    BOOST_CHECK(!isVisible[12 + 10 * 20]);
+    BOOST_CHECK(!isVisible[16 + 10 * 20]);
+    BOOST_CHECK(isVisible[9 + 10 * 20]);
+    BOOST_CHECK(isVisible[10 + 14 * 20]);
+
+    // Near the map border, the tiles outside of the map are ignored
+    BOOST_CHECK(compareWithReference(map, 1) == 20 * 20);
+}
+
+BOOST_AUTO_TEST_CASE(test_ShadowTables_RandomMaps)
+{
+    uint32_t seed = 12345;
+    for(uint32_t density = 1; density <= 5; ++density)
+    {
+        TestMap map(37, 23, false);
+        for(uint32_t i = 0; i < map.mOpaque.size(); ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            map.mOpaque[i] = ((seed >> 16) % 10) < density;
+        }
+        BOOST_CHECK(compareWithReference(map, 1) == 37 * 23);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ShadowTables_BundledLevels)
+{
+    LogManager logMgr;
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    boost::filesystem::path levelsPath = boost::filesystem::path(__FILE__).parent_path().parent_path().parent_path() / "levels";
+    BOOST_REQUIRE(boost::filesystem::is_directory(levelsPath));
+
+    uint32_t nbLevels = 0;
+    for(boost::filesystem::recursive_directory_iterator it(levelsPath), end; it != end; ++it)
+    {
+        if(it->path().extension() != ".level")
+            continue;
+
+        std::ifstream levelFile(it->path().string().c_str());
+        BinaryLevel::LevelSnapshot snapshot;
+        bool isParsed = BinaryLevel::parseText(levelFile, snapshot);
+        BOOST_CHECK_MESSAGE(isParsed, it->path().string());
+        if(!isParsed)
+            continue;
+
+        // Tiles not listed in the level are full dirt tiles
+        TestMap map(snapshot.mMapSizeX, snapshot.mMapSizeY, true);
+        for(const BinaryLevel::TileRecord& tile : snapshot.mTiles)
+        {
+            if((tile.mPosX < 0) || (tile.mPosY < 0) || (tile.mPosX >= map.mMapSizeX) || (tile.mPosY >= map.mMapSizeY))
+                continue;
+
+            map.mOpaque[tile.mPosX + tile.mPosY * map.mMapSizeX] = (tile.mFullness > 0.0);
+        }
+
+        // We check the positions every 3 tiles to keep the test fast on big levels
+        uint32_t nbPositions = compareWithReference(map, 3);
+        BOOST_CHECK_MESSAGE(nbPositions > 0, it->path().string());
+        ++nbLevels;
+    }
+    BOOST_CHECK(nbLevels > 0);
+}
@@ -0,0 +1,232 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE StateHash
+#include "BoostTestTargetConfig.h"
+
+#include "network/StateHash.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+//! \brief Buffer used by the sanity checks of the reference xxHash implementation
+std::vector<uint8_t> buildSanityBuffer(std::size_t size)
+{
+    const uint64_t prime32 = 2654435761ull;
+    const uint64_t prime64 = 11400714785074694797ull;
+    std::vector<uint8_t> buffer(size);
+    uint64_t byteGen = prime32;
+    for(uint8_t& byte : buffer)
+    {
+        byte = static_cast<uint8_t>(byteGen >> 56);
+        byteGen *= prime64;
+    }
+    return buffer;
+}
+
+uint64_t hashString(const char* str, uint64_t seed)
+{
+    return StateHash::xxHash64(str, std::strlen(str), seed);
+}
+
+//! \brief State of a tile as sent to a client
+struct TileState
+{
+    int32_t mType;
+    bool mIsRoom;
+    uint32_t mRefundPrice;
+    std::string mMeshName;
+
+    uint64_t computeHash() const
+    {
+        StateHash::Hasher hasher;
+        hasher << mType << mIsRoom << mRefundPrice << mMeshName;
+        return hasher.getHash();
+    }
+};
+
+//! \brief Tiles known by a server or a client. Tiles are grouped by chunk like with MapStreaming
+struct TilesView
+{
+    std::vector<std::vector<TileState>> mChunks;
+    //! \brief Hash of each tile as computed when it was sent or received. 0 if it never was
+    std::vector<std::vector<uint64_t>> mTileHashes;
+
+    TilesView(uint32_t nbChunks, uint32_t nbTilesPerChunk) :
+        mChunks(nbChunks, std::vector<TileState>(nbTilesPerChunk)),
+        mTileHashes(nbChunks, std::vector<uint64_t>(nbTilesPerChunk, 0))
+    {}
+
+    void setTile(uint32_t chunk, uint32_t index, const TileState& state)
+    {
+        mChunks[chunk][index] = state;
+        mTileHashes[chunk][index] = state.computeHash();
+    }
+
+    std::vector<uint64_t> computeChunkHashes() const
+    {
+        std::vector<uint64_t> chunkHashes;
+        for(const std::vector<uint64_t>& tileHashes : mTileHashes)
+            chunkHashes.push_back(StateHash::computeChunkHash(tileHashes));
+        return chunkHashes;
+    }
+};
+}
+
+BOOST_AUTO_TEST_CASE(test_xxHash64_ReferenceVectors)
+{
+    // Vectors published with the reference implementation (xxhsum sanity checks)
+    const uint64_t prime32 = 2654435761ull;
+    BOOST_CHECK(StateHash::xxHash64(nullptr, 0, 0) == 0xEF46DB3751D8E999ull);
+    BOOST_CHECK(hashString("a", 0) == 0xD24EC4F1A98C6E5Bull);
+    BOOST_CHECK(hashString("abc", 0) == 0x44BC2CF5AD770999ull);
+    BOOST_CHECK(hashString("The quick brown fox jumps over the lazy dog", 0) == 0x0B242D361FDA71BCull);
+
+    std::vector<uint8_t> buffer = buildSanityBuffer(222);
+    BOOST_CHECK(StateHash::xxHash64(buffer.data(), 1, 0) == 0xE934A84ADB052768ull);
+    BOOST_CHECK(StateHash::xxHash64(buffer.data(), 1, prime32) == 0x5014607643A9B4C3ull);
+    BOOST_CHECK(StateHash::xxHash64(buffer.data(), 14, 0) == 0x8282DCC4994E35C8ull);
+    BOOST_CHECK(StateHash::xxHash64(buffer.data(), 14, prime32) == 0xC3BD6BF63DEB6DF0ull);
+    BOOST_CHECK(StateHash::xxHash64(buffer.data(), 222, 0) == 0xB641AE8CB691C174ull);
+    BOOST_CHECK(StateHash::xxHash64(buffer.data(), 222, prime32) == 0x20CB8AB7AE10C14Aull);
+}
+
+BOOST_AUTO_TEST_CASE(test_Hasher_Encoding)
+{
+    // Values are hashed as little endian whatever the platform
+    StateHash::Hasher hasher;
+    hasher << static_cast<uint32_t>(0x04030201);
+    const uint8_t bytes[] = { 1, 2, 3, 4 };
+    BOOST_CHECK(hasher.getHash() == StateHash::xxHash64(bytes, sizeof(bytes), 0));
+
+    // Strings are prefixed by their size
+    StateHash::Hasher hasher1;
+    hasher1 << std::string("ab") << std::string("c");
+    StateHash::Hasher hasher2;
+    hasher2 << std::string("a") << std::string("bc");
+    BOOST_CHECK(hasher1.getHash() != hasher2.getHash());
+
+    // 0 is kept for the tiles never sent
+    StateHash::Hasher emptyHasher;
+    BOOST_CHECK(emptyHasher.getHash() != 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_StateHash_ChunkFolding)
+{
+    std::vector<uint64_t> tileHashes;
+    for(uint64_t i = 0; i < 256; ++i)
+        tileHashes.push_back(i * 0x9E3779B97F4A7C15ull);
+
+    // The chunk hash is the hash of the tile hashes in order
+    StateHash::Hasher hasher;
+    for(uint64_t hash : tileHashes)
+        hasher << hash;
+    uint64_t chunkHash = StateHash::computeChunkHash(tileHashes);
+    BOOST_CHECK(chunkHash == hasher.getHash());
+    BOOST_CHECK(chunkHash != 0);
+
+    // Changing a tile or the order of the tiles changes the chunk hash
+    std::vector<uint64_t> changedTile = tileHashes;
+    changedTile[200] ^= 1;
+    BOOST_CHECK(StateHash::computeChunkHash(changedTile) != chunkHash);
+    std::vector<uint64_t> swappedTiles = tileHashes;
+    std::swap(swappedTiles[3], swappedTiles[4]);
+    BOOST_CHECK(StateHash::computeChunkHash(swappedTiles) != chunkHash);
+
+    // Chunks with no tile sent only depend on their size
+    std::vector<uint64_t> notSent1(256, 0);
+    std::vector<uint64_t> notSent2(256, 0);
+    std::vector<uint64_t> notSentSmall(64, 0);
+    BOOST_CHECK(StateHash::computeChunkHash(notSent1) == StateHash::computeChunkHash(notSent2));
+    BOOST_CHECK(StateHash::computeChunkHash(notSent1) != StateHash::computeChunkHash(notSentSmall));
+}
+
+BOOST_AUTO_TEST_CASE(test_StateHash_TilesToResend)
+{
+    std::vector<uint64_t> serverHashes = { 10, 20, 0, 40, 50 };
+    std::vector<uint64_t> clientHashes = { 10, 21, 30, 40, 0 };
+    std::vector<uint32_t> tilesToResend;
+    // The tile never sent by the server is wrong but cannot be resent
+    BOOST_CHECK(StateHash::findTilesToResend(serverHashes, clientHashes, tilesToResend) == 3);
+    BOOST_CHECK(tilesToResend == std::vector<uint32_t>({ 1, 4 }));
+
+    BOOST_CHECK(StateHash::findTilesToResend(serverHashes, serverHashes, tilesToResend) == 0);
+    BOOST_CHECK(tilesToResend.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_StateHash_DesyncRepair)
+{
+    const uint32_t nbChunks = 6;
+    const uint32_t nbTilesPerChunk = 256;
+    TilesView server(nbChunks, nbTilesPerChunk);
+    TilesView client(nbChunks, nbTilesPerChunk);
+
+    // The server sends every tile of the first 5 chunks. The last one was never sent
+    for(uint32_t chunk = 0; chunk < nbChunks - 1; ++chunk)
+    {
+        for(uint32_t index = 0; index < nbTilesPerChunk; ++index)
+        {
+            TileState state = { static_cast<int32_t>(index % 5), (index % 7) == 0, index, "Dirt" };
+            server.setTile(chunk, index, state);
+            client.setTile(chunk, index, state);
+        }
+    }
+
+    std::vector<uint32_t> wrongChunks;
+    StateHash::findWrongChunks(server.computeChunkHashes(), client.computeChunkHashes(), wrongChunks);
+    BOOST_CHECK(wrongChunks.empty());
+
+    // The client misses some updates
+    TileState claimed = { 2, true, 150, "Claimed" };
+    server.setTile(1, 17, claimed);
+    server.setTile(1, 200, claimed);
+    server.setTile(4, 0, claimed);
+    TileState wrongState = { 3, false, 0, "Claimed" };
+    client.setTile(4, 0, wrongState);
+
+    // The client finds the wrong chunks from the server chunk hashes (stateHashes)
+    StateHash::findWrongChunks(server.computeChunkHashes(), client.computeChunkHashes(), wrongChunks);
+    BOOST_CHECK(wrongChunks == std::vector<uint32_t>({ 1, 4 }));
+
+    // The server compares the tile hashes of these chunks (stateHashMismatch) and resends the wrong tiles
+    // that the client applies (refreshTiles)
+    uint32_t nbTilesResent = 0;
+    std::vector<uint32_t> tilesToResend;
+    for(uint32_t chunk : wrongChunks)
+    {
+        uint32_t nbWrongTiles = StateHash::findTilesToResend(server.mTileHashes[chunk], client.mTileHashes[chunk],
+            tilesToResend);
+        BOOST_CHECK(nbWrongTiles == tilesToResend.size());
+        for(uint32_t index : tilesToResend)
+        {
+            client.setTile(chunk, index, server.mChunks[chunk][index]);
+            ++nbTilesResent;
+        }
+    }
+    BOOST_CHECK(nbTilesResent == 3);
+
+    // The next check finds no desync
+    std::vector<uint64_t> serverChunkHashes = server.computeChunkHashes();
+    std::vector<uint64_t> clientChunkHashes = client.computeChunkHashes();
+    BOOST_CHECK(serverChunkHashes == clientChunkHashes);
+    StateHash::findWrongChunks(serverChunkHashes, clientChunkHashes, wrongChunks);
+    BOOST_CHECK(wrongChunks.empty());
+}
@@ -0,0 +1,287 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define BOOST_TEST_MODULE TileRegion
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/TileRegion.h"
+#include "network/TileRuns.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace
+{
+struct FakeTile
+{
+    int mX;
+    int mY;
+    //! \brief State sent to the client. 0 for the tiles not sent
+    uint64_t mState;
+    bool mHasParticleEffects;
+    std::vector<FakeTile*> mNeighbors;
+
+    inline int getX() const
+    { return mX; }
+
+    inline int getY() const
+    { return mY; }
+
+    inline const std::vector<FakeTile*>& getAllNeighbors() const
+    { return mNeighbors; }
+};
+
+//! \brief Map with the 8 neighbors of each tile set like TileContainer::setTileNeighbors
+struct FakeMap
+{
+    int mSizeX;
+    int mSizeY;
+    std::vector<FakeTile> mTiles;
+
+    FakeMap(int sizeX, int sizeY) :
+        mSizeX(sizeX),
+        mSizeY(sizeY),
+        mTiles(sizeX * sizeY)
+    {
+        for(int x = 0; x < mSizeX; ++x)
+        {
+            for(int y = 0; y < mSizeY; ++y)
+            {
+                FakeTile& tile = getTile(x, y);
+                tile.mX = x;
+                tile.mY = y;
+                tile.mState = 0;
+                tile.mHasParticleEffects = false;
+                for(int dx = -1; dx <= 1; ++dx)
+                {
+                    for(int dy = -1; dy <= 1; ++dy)
+                    {
+                        if(((dx != 0) || (dy != 0)) && isInMap(x + dx, y + dy))
+                            tile.mNeighbors.push_back(&getTile(x + dx, y + dy));
+                    }
+                }
+            }
+        }
+    }
+
+    bool isInMap(int x, int y) const
+    {
+        return (x >= 0) && (x < mSizeX) && (y >= 0) && (y < mSizeY);
+    }
+
+    FakeTile& getTile(int x, int y)
+    {
+        return mTiles[x * mSizeY + y];
+    }
+
+    //! \brief Same as TileContainer::rectangularRegion
+    std::vector<FakeTile*> rectangularRegion(int x1, int y1, int x2, int y2)
+    {
+        std::vector<FakeTile*> region;
+        for(int x = std::min(x1, x2); x <= std::max(x1, x2); ++x)
+        {
+            for(int y = std::min(y1, y2); y <= std::max(y1, y2); ++y)
+            {
+                if(isInMap(x, y))
+                    region.push_back(&getTile(x, y));
+            }
+        }
+        return region;
+    }
+};
+
+/*! \brief Encodes the changed tiles of the rectangle like ODServer::sendTilesRegion and decodes them like
+ * ODClient into clientStates (indexed like the region). Returns the runs
+ */
+std::vector<TileRuns::Run> sendRegion(FakeMap& map, int x1, int y1, int x2, int y2,
+    const std::vector<FakeTile*>& changedTiles, std::vector<uint64_t>& clientStates, uint32_t& nbKeysComputed)
+{
+    std::vector<TileRuns::Run> runs;
+    BOOST_REQUIRE(TileRegion::clampToMap(x1, y1, x2, y2, map.mSizeX, map.mSizeY));
+    std::vector<FakeTile*> region = map.rectangularRegion(x1, y1, x2, y2);
+    std::vector<uint8_t> isChanged(region.size(), 0);
+    for(FakeTile* tile : changedTiles)
+    {
+        uint32_t index = TileRegion::getIndex(tile->getX(), tile->getY(), x1, y1, y2);
+        BOOST_REQUIRE(index < region.size());
+        BOOST_REQUIRE(region[index] == tile);
+        isChanged[index] = 1;
+    }
+
+    nbKeysComputed = 0;
+    TileRuns::buildRuns(static_cast<uint32_t>(region.size()), [&isChanged](uint32_t index)
+    {
+        return isChanged[index] != 0;
+    }, [&region, &nbKeysComputed](uint32_t index)
+    {
+        ++nbKeysComputed;
+        return region[index]->mState;
+    }, [&region](uint32_t index)
+    {
+        return !region[index]->mHasParticleEffects;
+    }, runs);
+
+    // The client reads the same rectangle and copies the state of the first tile of a run to the others
+    std::vector<FakeTile*> clientRegion = map.rectangularRegion(x1, y1, x2, y2);
+    BOOST_REQUIRE(clientRegion == region);
+    clientStates.assign(region.size(), 0);
+    uint32_t index = 0;
+    for(const TileRuns::Run& run : runs)
+    {
+        BOOST_REQUIRE(index + run.mNbTiles <= region.size());
+        if(run.mFirstIndex != TileRuns::UNCHANGED)
+        {
+            BOOST_CHECK(run.mFirstIndex == index);
+            for(uint32_t i = 0; i < run.mNbTiles; ++i)
+                clientStates[index + i] = region[run.mFirstIndex]->mState;
+        }
+        index += run.mNbTiles;
+    }
+    BOOST_CHECK(index == region.size());
+    return runs;
+}
+}
+
+BOOST_AUTO_TEST_CASE(test_TileRegion_Clamp)
+{
+    int x1 = 25;
+    int y1 = 12;
+    int x2 = -4;
+    int y2 = 3;
+    BOOST_CHECK(TileRegion::clampToMap(x1, y1, x2, y2, 20, 10));
+    BOOST_CHECK((x1 == 0) && (y1 == 3) && (x2 == 19) && (y2 == 9));
+
+    x1 = 20;
+    y1 = 0;
+    x2 = 30;
+    y2 = 5;
+    BOOST_CHECK(!TileRegion::clampToMap(x1, y1, x2, y2, 20, 10));
+}
+
+BOOST_AUTO_TEST_CASE(test_TileRuns_Region)
+{
+    FakeMap map(20, 15);
+
+    // The rectangle is given with its corners swapped and goes over the bottom right corner of the map: it
+    // is clamped to (16, 11) - (19, 14) which gives 4 columns of 4 tiles
+    std::vector<FakeTile*> changedTiles;
+    auto changeTile = [&](int x, int y, uint64_t state)
+    {
+        FakeTile& tile = map.getTile(x, y);
+        tile.mState = state;
+        changedTiles.push_back(&tile);
+    };
+    // Column 16: 2 identical tiles then an unchanged one then a different one
+    changeTile(16, 11, 5);
+    changeTile(16, 12, 5);
+    changeTile(16, 14, 6);
+    // Column 17: identical to the last tile of column 16 so it continues the run over the column change
+    changeTile(17, 11, 6);
+    changeTile(17, 12, 6);
+    // A tile with particle effects is sent alone, and so is the next one
+    changeTile(17, 13, 6);
+    map.getTile(17, 13).mHasParticleEffects = true;
+    changeTile(17, 14, 6);
+    // Columns 18 and 19 are unchanged except the last tile
+    changeTile(19, 14, 7);
+
+    std::vector<uint64_t> clientStates;
+    uint32_t nbKeysComputed;
+    std::vector<TileRuns::Run> runs = sendRegion(map, 25, 18, 16, 11, changedTiles, clientStates, nbKeysComputed);
+    BOOST_CHECK(nbKeysComputed == changedTiles.size());
+
+    struct ExpectedRun
+    {
+        uint32_t mNbTiles;
+        uint32_t mFirstIndex;
+    };
+    const ExpectedRun expected[] = {
+        { 2, 0 }, { 1, TileRuns::UNCHANGED }, { 3, 3 }, { 1, 6 }, { 1, 7 },
+        { 7, TileRuns::UNCHANGED }, { 1, 15 }
+    };
+    BOOST_REQUIRE(runs.size() == sizeof(expected) / sizeof(expected[0]));
+    for(uint32_t i = 0; i < runs.size(); ++i)
+    {
+        BOOST_CHECK(runs[i].mNbTiles == expected[i].mNbTiles);
+        BOOST_CHECK(runs[i].mFirstIndex == expected[i].mFirstIndex);
+    }
+
+    // Every tile of the region got its state on the client side
+    std::vector<FakeTile*> region = map.rectangularRegion(16, 11, 19, 14);
+    for(uint32_t index = 0; index < region.size(); ++index)
+        BOOST_CHECK(clientStates[index] == region[index]->mState);
+}
+
+BOOST_AUTO_TEST_CASE(test_TileRuns_AllChanged)
+{
+    // A 50x50 region where every tile gets the same state is sent as a single run
+    FakeMap map(60, 60);
+    std::vector<FakeTile*> changedTiles = map.rectangularRegion(5, 5, 54, 54);
+    for(FakeTile* tile : changedTiles)
+        tile->mState = 3;
+
+    std::vector<uint64_t> clientStates;
+    uint32_t nbKeysComputed;
+    std::vector<TileRuns::Run> runs = sendRegion(map, 54, 54, 5, 5, changedTiles, clientStates, nbKeysComputed);
+    BOOST_REQUIRE(runs.size() == 1);
+    BOOST_CHECK(runs[0].mNbTiles == 2500);
+    BOOST_CHECK(runs[0].mFirstIndex == 0);
+    BOOST_CHECK(nbKeysComputed == 2500);
+
+    // Nothing changed
+    runs = sendRegion(map, 5, 5, 54, 54, std::vector<FakeTile*>(), clientStates, nbKeysComputed);
+    BOOST_REQUIRE(runs.size() == 1);
+    BOOST_CHECK(runs[0].mFirstIndex == TileRuns::UNCHANGED);
+    BOOST_CHECK(nbKeysComputed == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_TileRegion_BorderedTiles)
+{
+    FakeMap map(12, 10);
+    // Regions in the middle, on a map corner and on the opposite border, with tiles given in any order
+    const int regions[][4] = { { 3, 3, 6, 5 }, { 0, 0, 2, 1 }, { 9, 6, 11, 9 } };
+    for(const int* rect : regions)
+    {
+        std::vector<FakeTile*> region = map.rectangularRegion(rect[0], rect[1], rect[2], rect[3]);
+        std::reverse(region.begin(), region.end());
+        std::vector<FakeTile*> bordered = TileRegion::getBorderedTiles(region);
+
+        // Each tile once, the region tiles and their neighbors in the map
+        std::set<FakeTile*> expected;
+        for(int x = rect[0] - 1; x <= rect[2] + 1; ++x)
+        {
+            for(int y = rect[1] - 1; y <= rect[3] + 1; ++y)
+            {
+                if(map.isInMap(x, y))
+                    expected.insert(&map.getTile(x, y));
+            }
+        }
+        std::set<FakeTile*> borderedSet(bordered.begin(), bordered.end());
+        BOOST_CHECK(borderedSet.size() == bordered.size());
+        BOOST_CHECK(borderedSet == expected);
+        // The region tiles come first
+        BOOST_CHECK(bordered.front() == region.front());
+    }
+
+    // A region made of 2 distant tiles
+    std::vector<FakeTile*> region = { &map.getTile(0, 9), &map.getTile(11, 0) };
+    std::vector<FakeTile*> bordered = TileRegion::getBorderedTiles(region);
+    BOOST_CHECK(bordered.size() == 8);
+    BOOST_CHECK(TileRegion::getBorderedTiles(std::vector<FakeTile*>()).empty());
+}
@@ -101,6 +101,9 @@ void Trap::removeFromGameMap()
             seat->notifyBuildingRemovedFromGameMap(this, tile);
     }
 
+    for(std::pair<Tile*, TileData*>& p : mTileData)
+        removeTriggerZone(static_cast<TrapTileData*>(p.second));
+
     removeAllBuildingObjects();
     getGameMap()->removeActiveObject(this);
 }
@@ -136,6 +139,10 @@ void Trap::doUpkeep()
         if(trapTileData->decreaseReloadTime())
             continue;
 
+        // Nothing to shoot at if no creature is within reach
+        if(!isTriggered(tile, trapTileData))
+            continue;
+
         if(shoot(tile))
         {
             trapTileData->setReloadTime(mReloadTime);
@@ -180,6 +187,7 @@ bool Trap::removeCoveredTile(Tile* t)
 
     TrapTileData* trapTileData = static_cast<TrapTileData*>(mTileData.at(t));
     trapTileData->setRemoveTrap(true);
+    removeTriggerZone(trapTileData);
 
     return true;
 }
@@ -187,7 +195,7 @@ bool Trap::removeCoveredTile(Tile* t)
 void Trap::updateActiveSpots()
 {
     // For a trap, by default, every tile is an active spot
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
     {
         TrapTileData* trapTileData = static_cast<TrapTileData*>(p.second);
         if(trapTileData->getTrapEntity() == nullptr)
@@ -249,6 +257,10 @@ void Trap::activate(Tile* tile)
     trapTileData->setNbShootsBeforeDeactivation(mNbShootsBeforeDeactivation);
     trapTileData->setReloadTime(0);
 
+    // Activated doors block vision
+    if(isDoor())
+        getGameMap()->notifyTileChanged(*tile);
+
     BuildingObject* entity = getBuildingObjectFromTile(tile);
     if (entity == nullptr)
         return;
@@ -263,6 +275,10 @@ void Trap::deactivate(Tile* tile)
 
     TrapTileData* trapTileData = static_cast<TrapTileData*>(mTileData[tile]);
     trapTileData->setActivated(false);
+    removeTriggerZone(trapTileData);
+
+    if(isDoor())
+        getGameMap()->notifyTileChanged(*tile);
 
     BuildingObject* entity = getBuildingObjectFromTile(tile);
     if (entity == nullptr)
@@ -271,9 +287,60 @@ void Trap::deactivate(Tile* tile)
     entity->setMeshOpacity(0.5f);
 }
 
+const std::vector<Tile*>& Trap::getTriggerZone(Tile* tile) const
+{
+    static const std::vector<Tile*> emptyZone;
+    auto it = mTileData.find(tile);
+    if(it == mTileData.end())
+    {
+        OD_LOG_ERR("trap=" + getName() + ", tile=" + Tile::displayAsString(tile));
+        return emptyZone;
+    }
+
+    TrapTileData* trapTileData = static_cast<TrapTileData*>(it->second);
+    if(trapTileData->getTriggerZoneId() == TrapTriggerIndex::NO_ZONE)
+    {
+        OD_LOG_ERR("trap=" + getName() + ", tile=" + Tile::displayAsString(tile));
+        return emptyZone;
+    }
+
+    return getGameMap()->getTrapTriggerIndex().getZoneTiles(trapTileData->getTriggerZoneId());
+}
+
+bool Trap::isTriggered(Tile* tile, TrapTileData* trapTileData)
+{
+    TrapTriggerIndex& index = getGameMap()->getTrapTriggerIndex();
+    uint32_t zoneId = trapTileData->getTriggerZoneId();
+    if((zoneId != TrapTriggerIndex::NO_ZONE) && !index.isDirty(zoneId))
+        return index.isTriggered(zoneId);
+
+    std::vector<Tile*> zone;
+    if(!computeTriggerZone(tile, zone))
+        return true;
+
+    if(zoneId == TrapTriggerIndex::NO_ZONE)
+    {
+        zoneId = index.addZone(tile->getX(), tile->getY(), getTriggerZoneVisionRange(), zone);
+        trapTileData->setTriggerZoneId(zoneId);
+    }
+    else
+        index.updateZone(zoneId, zone);
+
+    return index.isTriggered(zoneId);
+}
+
+void Trap::removeTriggerZone(TrapTileData* trapTileData)
+{
+    if(trapTileData->getTriggerZoneId() == TrapTriggerIndex::NO_ZONE)
+        return;
+
+    getGameMap()->getTrapTriggerIndex().removeZone(trapTileData->getTriggerZoneId());
+    trapTileData->setTriggerZoneId(TrapTriggerIndex::NO_ZONE);
+}
+
 bool Trap::isActivated(Tile* tile) const
 {
-    std::map<Tile*, TileData*>::const_iterator it = mTileData.find(tile);
+    auto it = mTileData.find(tile);
     if (it == mTileData.end())
         return false;
 
@@ -425,7 +492,7 @@ bool Trap::isAttackable(Tile* tile, Seat* seat) const
 void Trap::restoreInitialEntityState()
 {
     // We restore the vision if we need to
-    for(std::pair<Tile* const, TileData*>& p : mTileData)
+    for(std::pair<Tile*, TileData*>& p : mTileData)
     {
         TrapTileData* trapTileData = static_cast<TrapTileData*>(p.second);
         if(trapTileData->mSeatsVision.empty())
@@ -636,23 +703,6 @@ bool Trap::shouldSetCoveringTileDirty(Seat* seat, Tile* tile)
     return true;
 }
 
-void Trap::fireTrapSound(Tile& tile, const std::string& soundFamily)
-{
-    std::string sound = "Traps/" + soundFamily;
-    for(Seat* seat : tile.getSeatsWithVision())
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::playSpatialSound, seat->getPlayer());
-        serverNotification->mPacket << sound << tile.getX() << tile.getY();
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
-}
-
 bool Trap::importTrapFromStream(Trap& trap, std::istream& is)
 {
     return trap.importFromStream(is);
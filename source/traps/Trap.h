@@ -19,6 +19,7 @@
 #define TRAP_H
 
 #include "entities/Building.h"
+#include "gamemap/TrapTriggerIndex.h"
 
 #include <string>
 #include <vector>
@@ -52,7 +53,8 @@ public:
         mNbShootsBeforeDeactivation(0),
         mTrapEntity(nullptr),
         mIsWorking(false),
-        mRemoveTrap(false)
+        mRemoveTrap(false),
+        mTriggerZoneId(TrapTriggerIndex::NO_ZONE)
     {}
 
     TrapTileData(const TrapTileData* trapTileData) :
@@ -63,7 +65,8 @@ public:
         mNbShootsBeforeDeactivation(trapTileData->mNbShootsBeforeDeactivation),
         mTrapEntity(trapTileData->mTrapEntity),
         mIsWorking(trapTileData->mIsWorking),
-        mRemoveTrap(trapTileData->mRemoveTrap)
+        mRemoveTrap(trapTileData->mRemoveTrap),
+        mTriggerZoneId(TrapTriggerIndex::NO_ZONE)
     {}
 
     virtual ~TrapTileData()
@@ -140,6 +143,12 @@ public:
     inline void setRemoveTrap(bool removeTrap)
     { mRemoveTrap = removeTrap; }
 
+    inline uint32_t getTriggerZoneId() const
+    { return mTriggerZoneId; }
+
+    inline void setTriggerZoneId(uint32_t triggerZoneId)
+    { mTriggerZoneId = triggerZoneId; }
+
     void fireSeatsSawTriggering();
     void seatSawTriggering(Seat* seat);
     void seatsSawTriggering(const std::vector<Seat*>& seats);
@@ -154,6 +163,8 @@ private:
     TrapEntity* mTrapEntity;
     bool mIsWorking;
     bool mRemoveTrap;
+    //! \brief Id of the trigger zone in the GameMap TrapTriggerIndex. It is not copied with the tile data
+    uint32_t mTriggerZoneId;
 };
 
 /*! \class Trap Trap.h
@@ -182,6 +193,17 @@ public:
     virtual bool shoot(Tile* tile)
     { return true; }
 
+    //! \brief Fills zone with the tiles where a creature can trigger the trap on the given tile. The
+    //! trap tile will only be checked when a creature is within its zone.
+    //! Returns false if the trap has no trigger zone. In this case, it is checked every turn
+    virtual bool computeTriggerZone(Tile* tile, std::vector<Tile*>& zone)
+    { return false; }
+
+    //! \brief Distance from a trap tile up to which a tile change (wall dug, door locked, ...) can change
+    //! its trigger zone. -1 if the zone does not depend on the surrounding tiles
+    virtual int getTriggerZoneVisionRange() const
+    { return -1; }
+
     virtual bool isDoor() const
     { return false; }
 
@@ -215,8 +237,6 @@ public:
     static bool importTrapFromStream(Trap& trap, std::istream& is);
 
 protected:
-    static void fireTrapSound(Tile& tile, const std::string& soundFamily);
-
     virtual void exportHeadersToStream(std::ostream& os) const override;
     virtual void exportTileDataToStream(std::ostream& os, Tile* tile, TileData* tileData) const override;
     virtual bool importTileDataFromStream(std::istream& is, Tile* tile, TileData* tileData) override;
@@ -233,6 +253,10 @@ protected:
     //! \brief Triggered when deactivated.
     virtual void deactivate(Tile* tile);
 
+    //! \brief Returns the tiles of the trigger zone of the given tile (see computeTriggerZone). It is
+    //! up to date when shoot is called
+    const std::vector<Tile*>& getTriggerZone(Tile* tile) const;
+
     uint32_t mNbShootsBeforeDeactivation;
     uint32_t mReloadTime;
     double mMinDamage;
@@ -241,6 +265,13 @@ protected:
     //! List of traps destroyed but with at least 1 player having vision. They will
     //! get removed when vision is gained by every player having seen it before destruction
     std::vector<BuildingObject*> mTrapEntitiesWaitingRemove;
+
+private:
+    //! \brief Returns true if the given tile should be checked this turn. Creates the trigger zone
+    //! of the tile if it has none or computes it again if it is dirty
+    bool isTriggered(Tile* tile, TrapTileData* trapTileData);
+
+    void removeTriggerZone(TrapTileData* trapTileData);
 };
 
 #endif // TRAP_H
@@ -24,7 +24,7 @@
 #include "gamemap/GameMap.h"
 #include "network/ODPacket.h"
 #include "traps/TrapManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Random.h"
 #include "utils/LogManager.h"
 
@@ -32,6 +32,13 @@ const std::string TrapBoulderName = "Boulder";
 const std::string TrapBoulderNameDisplay = "Boulder trap";
 const TrapType TrapBoulder::mTrapType = TrapType::boulder;
 
+static TrapConfigParam<int32_t> BoulderCostPerTile("BoulderCostPerTile");
+static TrapConfigParam<uint32_t> BoulderReloadTurns("BoulderReloadTurns");
+static TrapConfigParam<double> BoulderDamagePerHitMin("BoulderDamagePerHitMin");
+static TrapConfigParam<double> BoulderDamagePerHitMax("BoulderDamagePerHitMax");
+static TrapConfigParam<uint32_t> BoulderNbShootsBeforeDeactivation("BoulderNbShootsBeforeDeactivation");
+static TrapConfigParam<double> BoulderSpeed("BoulderSpeed");
+
 namespace
 {
 class TrapBoulderFactory : public TrapFactory
@@ -46,7 +53,7 @@ class TrapBoulderFactory : public TrapFactory
     { return TrapBoulderNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("BoulderCostPerTile"); }
+    { return BoulderCostPerTile.get(); }
 
     const std::string& getMeshName() const override
     {
@@ -114,13 +121,19 @@ static TrapRegister reg(new TrapBoulderFactory);
 TrapBoulder::TrapBoulder(GameMap* gameMap) :
     Trap(gameMap)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("BoulderReloadTurns");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("BoulderDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("BoulderDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("BoulderNbShootsBeforeDeactivation");
+    mReloadTime = BoulderReloadTurns.get();
+    mMinDamage = BoulderDamagePerHitMin.get();
+    mMaxDamage = BoulderDamagePerHitMax.get();
+    mNbShootsBeforeDeactivation = BoulderNbShootsBeforeDeactivation.get();
     setMeshName("");
 }
 
+bool TrapBoulder::computeTriggerZone(Tile* tile, std::vector<Tile*>& zone)
+{
+    zone = tile->getAllNeighbors();
+    return true;
+}
+
 bool TrapBoulder::shoot(Tile* tile)
 {
     std::vector<Tile*> tiles = tile->getAllNeighbors();
@@ -150,7 +163,7 @@ bool TrapBoulder::shoot(Tile* tile)
     position.z = 0;
     direction.normalise();
     MissileBoulder* missile = new MissileBoulder(getGameMap(), getSeat(), getName(), "Boulder",
-        direction, ConfigManager::getSingleton().getTrapConfigDouble("BoulderSpeed"),
+        direction, BoulderSpeed.get(),
         Random::Double(mMinDamage, mMaxDamage), nullptr, true);
     missile->addToGameMap();
     missile->createMesh();
@@ -159,7 +172,7 @@ bool TrapBoulder::shoot(Tile* tile)
     // we can safely call the missile doUpkeep as we know the engine will not call it the turn
     // it has been added
     missile->doUpkeep();
-    missile->setAnimationState("Triggered", true);
+    missile->setAnimationState(EntityAnimation::triggered_anim, true);
 
     return true;
 }
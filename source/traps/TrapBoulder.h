@@ -30,6 +30,9 @@ public:
     { return TrapType::boulder; }
 
     virtual bool shoot(Tile* tile) override;
+
+    //! \brief The boulder is launched towards creatures standing next to the trap tile
+    virtual bool computeTriggerZone(Tile* tile, std::vector<Tile*>& zone) override;
     virtual bool isAttackable(Tile* tile, Seat* seat) const override
     {
         return false;
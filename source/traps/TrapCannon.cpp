@@ -25,14 +25,26 @@
 #include "network/ODPacket.h"
 #include "sound/SoundEffectsManager.h"
 #include "traps/TrapManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Random.h"
 #include "utils/LogManager.h"
+#include "utils/Symbol.h"
 
 const std::string TrapCannonName = "Cannon";
 const std::string TrapCannonNameDisplay = "Cannon trap";
 const TrapType TrapCannon::mTrapType = TrapType::cannon;
 
+static TrapConfigParam<int32_t> CannonCostPerTile("CannonCostPerTile");
+static TrapConfigParam<uint32_t> CannonReloadTurns("CannonReloadTurns");
+static TrapConfigParam<uint32_t> CannonRange("CannonRange");
+static TrapConfigParam<double> CannonDamagePerHitMin("CannonDamagePerHitMin");
+static TrapConfigParam<double> CannonDamagePerHitMax("CannonDamagePerHitMax");
+static TrapConfigParam<uint32_t> CannonNbShootsBeforeDeactivation("CannonNbShootsBeforeDeactivation");
+static TrapConfigParam<double> CannonSpeed("CannonSpeed");
+static TrapConfigParam<double> CannonPhyDef("CannonPhyDef");
+static TrapConfigParam<double> CannonMagDef("CannonMagDef");
+static TrapConfigParam<double> CannonEleDef("CannonEleDef");
+
 namespace
 {
 class TrapCannonFactory : public TrapFactory
@@ -47,7 +59,7 @@ class TrapCannonFactory : public TrapFactory
     { return TrapCannonNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("CannonCostPerTile"); }
+    { return CannonCostPerTile.get(); }
 
     const std::string& getMeshName() const override
     {
@@ -118,18 +130,23 @@ TrapCannon::TrapCannon(GameMap* gameMap) :
     Trap(gameMap),
     mRange(0)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("CannonReloadTurns");
-    mRange = ConfigManager::getSingleton().getTrapConfigUInt32("CannonRange");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("CannonDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("CannonDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("CannonNbShootsBeforeDeactivation");
+    mReloadTime = CannonReloadTurns.get();
+    mRange = CannonRange.get();
+    mMinDamage = CannonDamagePerHitMin.get();
+    mMaxDamage = CannonDamagePerHitMax.get();
+    mNbShootsBeforeDeactivation = CannonNbShootsBeforeDeactivation.get();
     setMeshName("");
 }
 
+bool TrapCannon::computeTriggerZone(Tile* tile, std::vector<Tile*>& zone)
+{
+    zone = getGameMap()->visibleTiles(tile->getX(), tile->getY(), mRange);
+    return true;
+}
+
 bool TrapCannon::shoot(Tile* tile)
 {
-    std::vector<Tile*> visibleTiles = getGameMap()->visibleTiles(tile->getX(), tile->getY(), mRange);
-    std::vector<GameEntity*> enemyObjects = getGameMap()->getVisibleCreatures(visibleTiles, getSeat(), true);
+    std::vector<GameEntity*> enemyObjects = getGameMap()->getVisibleCreatures(getTriggerZone(tile), getSeat(), true);
 
     if(enemyObjects.empty())
         return false;
@@ -149,7 +166,7 @@ bool TrapCannon::shoot(Tile* tile)
     direction = direction - position;
     direction.normalise();
     MissileOneHit* missile = new MissileOneHit(getGameMap(), getSeat(), getName(), "Cannonball",
-        "", direction, ConfigManager::getSingleton().getTrapConfigDouble("CannonSpeed"),
+        "", direction, CannonSpeed.get(),
         Random::Double(mMinDamage, mMaxDamage), 0.0, 0.0, nullptr, false, false, true);
     missile->addToGameMap();
     missile->createMesh();
@@ -159,7 +176,8 @@ bool TrapCannon::shoot(Tile* tile)
     // it has been added
     missile->doUpkeep();
 
-    fireTrapSound(*tile, "Cannon/Fire");
+    static const Symbol soundFire("Traps/Cannon/Fire");
+    tile->getGameMap()->fireSpatialSound(*tile, soundFire);
 
     return true;
 }
@@ -171,15 +189,15 @@ TrapEntity* TrapCannon::getTrapEntity(Tile* tile)
 
 double TrapCannon::getPhysicalDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonPhyDef");
+    return CannonPhyDef.get();
 }
 
 double TrapCannon::getMagicalDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonMagDef");
+    return CannonMagDef.get();
 }
 
 double TrapCannon::getElementDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonEleDef");
+    return CannonEleDef.get();
 }
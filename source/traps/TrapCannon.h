@@ -33,6 +33,12 @@ public:
 
     virtual bool shoot(Tile* tile) override;
 
+    //! \brief The cannon can shoot at any tile it can see within its range
+    virtual bool computeTriggerZone(Tile* tile, std::vector<Tile*>& zone) override;
+
+    virtual int getTriggerZoneVisionRange() const override
+    { return static_cast<int>(mRange); }
+
     virtual bool displayTileMesh() const override
     { return true; }
 
@@ -31,7 +31,7 @@
 #include "modes/InputManager.h"
 #include "network/ODClient.h"
 #include "traps/TrapManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/Random.h"
 #include "utils/LogManager.h"
@@ -40,6 +40,8 @@ const std::string TrapDoorName = "DoorWooden";
 const std::string TrapDoorNameDisplay = "Wooden door";
 const TrapType TrapDoor::mTrapType = TrapType::doorWooden;
 
+static TrapConfigParam<int32_t> WoodenDoorCostPerTile("WoodenDoorCostPerTile");
+
 namespace
 {
 class TrapDoorFactory : public TrapFactory
@@ -54,7 +56,7 @@ class TrapDoorFactory : public TrapFactory
     { return TrapDoorNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("WoodenDoorCostPerTile"); }
+    { return WoodenDoorCostPerTile.get(); }
 
     const std::string& getMeshName() const override
     {
@@ -277,8 +279,8 @@ class TrapDoorFactory : public TrapFactory
 static TrapRegister reg(new TrapDoorFactory);
 }
 
-const std::string TrapDoor::ANIMATION_OPEN = "Open";
-const std::string TrapDoor::ANIMATION_CLOSE = "Close";
+const Symbol TrapDoor::ANIMATION_OPEN("Open");
+const Symbol TrapDoor::ANIMATION_CLOSE("Close");
 
 TrapDoor::TrapDoor(GameMap* gameMap) :
     Trap(gameMap),
@@ -20,6 +20,7 @@
 
 #include "Trap.h"
 #include "traps/TrapType.h"
+#include "utils/Symbol.h"
 
 class DoorEntity;
 
@@ -28,8 +29,8 @@ class TrapDoor : public Trap
 public:
     TrapDoor(GameMap* gameMap);
 
-    static const std::string ANIMATION_OPEN;
-    static const std::string ANIMATION_CLOSE;
+    static const Symbol ANIMATION_OPEN;
+    static const Symbol ANIMATION_CLOSE;
 
     const TrapType getType() const override
     { return TrapType::doorWooden; }
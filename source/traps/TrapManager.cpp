@@ -30,12 +30,17 @@
 #include "network/ServerNotification.h"
 #include "traps/Trap.h"
 #include "traps/TrapType.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
 static const std::string EMPTY_STRING;
 
+static TrapConfigParam<int32_t> CannonWorkshopPointsPerTile("CannonWorkshopPointsPerTile");
+static TrapConfigParam<int32_t> SpikeWorkshopPointsPerTile("SpikeWorkshopPointsPerTile");
+static TrapConfigParam<int32_t> BoulderWorkshopPointsPerTile("BoulderWorkshopPointsPerTile");
+static TrapConfigParam<int32_t> WoodenDoorPointsPerTile("WoodenDoorPointsPerTile");
+
 namespace
 {
     static std::vector<const TrapFactory*>& getFactories()
@@ -784,13 +789,13 @@ int32_t TrapManager::getNeededWorkshopPointsPerTrap(TrapType trapType)
         case TrapType::nullTrapType:
             return 0;
         case TrapType::cannon:
-            return ConfigManager::getSingleton().getTrapConfigInt32("CannonWorkshopPointsPerTile");
+            return CannonWorkshopPointsPerTile.get();
         case TrapType::spike:
-            return ConfigManager::getSingleton().getTrapConfigInt32("SpikeWorkshopPointsPerTile");
+            return SpikeWorkshopPointsPerTile.get();
         case TrapType::boulder:
-            return ConfigManager::getSingleton().getTrapConfigInt32("BoulderWorkshopPointsPerTile");
+            return BoulderWorkshopPointsPerTile.get();
         case TrapType::doorWooden:
-            return ConfigManager::getSingleton().getTrapConfigInt32("WoodenDoorPointsPerTile");
+            return WoodenDoorPointsPerTile.get();
         default:
             OD_LOG_ERR("Asked for wrong trap type=" + getTrapNameFromTrapType(trapType));
             break;
@@ -23,7 +23,7 @@
 #include "game/Player.h"
 #include "gamemap/GameMap.h"
 #include "traps/TrapManager.h"
-#include "utils/ConfigManager.h"
+#include "utils/ConfigParam.h"
 #include "utils/Random.h"
 #include "utils/LogManager.h"
 
@@ -31,6 +31,12 @@ const std::string TrapSpikeName = "Spike";
 const std::string TrapSpikeNameDisplay = "Spike trap";
 const TrapType TrapSpike::mTrapType = TrapType::spike;
 
+static TrapConfigParam<int32_t> SpikeCostPerTile("SpikeCostPerTile");
+static TrapConfigParam<uint32_t> SpikeReloadTurns("SpikeReloadTurns");
+static TrapConfigParam<double> SpikeDamagePerHitMin("SpikeDamagePerHitMin");
+static TrapConfigParam<double> SpikeDamagePerHitMax("SpikeDamagePerHitMax");
+static TrapConfigParam<uint32_t> SpikeNbShootsBeforeDeactivation("SpikeNbShootsBeforeDeactivation");
+
 namespace
 {
 class TrapSpikeFactory : public TrapFactory
@@ -45,7 +51,7 @@ class TrapSpikeFactory : public TrapFactory
     { return TrapSpikeNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("SpikeCostPerTile"); }
+    { return SpikeCostPerTile.get(); }
 
     const std::string& getMeshName() const override
     {
@@ -113,10 +119,10 @@ static TrapRegister reg(new TrapSpikeFactory);
 TrapSpike::TrapSpike(GameMap* gameMap) :
     Trap(gameMap)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("SpikeReloadTurns");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("SpikeDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("SpikeDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("SpikeNbShootsBeforeDeactivation");
+    mReloadTime = SpikeReloadTurns.get();
+    mMinDamage = SpikeDamagePerHitMin.get();
+    mMaxDamage = SpikeDamagePerHitMax.get();
+    mNbShootsBeforeDeactivation = SpikeNbShootsBeforeDeactivation.get();
     setMeshName("");
 }
 
@@ -129,7 +135,7 @@ bool TrapSpike::shoot(Tile* tile)
         return false;
 
     RenderedMovableEntity* spike = getBuildingObjectFromTile(tile);
-    spike->setAnimationState("Triggered", false);
+    spike->setAnimationState(EntityAnimation::triggered_anim, false);
 
     // We damage every creature standing on the trap
     for(GameEntity* target : enemyCreatures)
@@ -30,6 +30,13 @@ public:
     { return TrapType::spike; }
 
     virtual bool shoot(Tile* tile) override;
+
+    //! \brief Spikes only hit the creatures standing on the trap tile
+    virtual bool computeTriggerZone(Tile* tile, std::vector<Tile*>& zone) override
+    {
+        zone.push_back(tile);
+        return true;
+    }
     virtual bool isAttackable(Tile* tile, Seat* seat) const override
     {
         return false;
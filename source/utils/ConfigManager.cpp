@@ -23,6 +23,7 @@
 #include "game/Skill.h"
 #include "gamemap/TileSet.h"
 #include "spawnconditions/SpawnCondition.h"
+#include "utils/ConfigParam.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
@@ -65,7 +66,9 @@ ConfigManager::ConfigManager(const std::string& configPath, const std::string& u
     mNbTurnsKoCreatureAttacked(10),
     mCreatureDefinitionDefaultWorker(nullptr),
     mNbWorkersDigSameFaceTile(2),
-    mNbWorkersClaimSameTile(1)
+    mNbWorkersClaimSameTile(1),
+    mNbTurnsAutosave(420),
+    mIsLoaded(false)
 {
     // TODO: it might be better to go through the creature definitions and try to pickup the first worker we can find
     mCreatureDefinitionDefaultWorker = new CreatureDefinition(DefaultWorkerCreatureDefinition,
@@ -75,72 +78,46 @@ ConfigManager::ConfigManager(const std::string& configPath, const std::string& u
         OD_LOG_ERR("Couldn't read loadCreatureDefinitions");
         exit(1);
     }
-    std::string fileName = configPath + mFilenameCreatureDefinition;
-    if(!loadCreatureDefinitions(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadCreatureDefinitions");
-        exit(1);
-    }
-    fileName = configPath + mFilenameEquipmentDefinition;
-    if(!loadEquipements(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadEquipements");
-        exit(1);
-    }
-    fileName = configPath + mFilenameSpawnConditions;
-    if(!loadSpawnConditions(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadSpawnConditions");
-        exit(1);
-    }
-    fileName = configPath + mFilenameFactions;
-    if(!loadFactions(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadFactions");
-        exit(1);
-    }
-    fileName = configPath + mFilenameRooms;
-    if(!loadRooms(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadRooms");
-        exit(1);
-    }
-    fileName = configPath + mFilenameTraps;
-    if(!loadTraps(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadTraps");
-        exit(1);
-    }
-    fileName = configPath + mFilenameSpells;
-    if(!loadSpellConfig(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadSpellConfig");
-        exit(1);
-    }
-    fileName = configPath + mFilenameSkills;
-    if(!loadSkills(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadSkills");
-        exit(1);
-    }
-    fileName = configPath + mFilenameTilesets;
-    if(!loadTilesets(fileName))
-    {
-        OD_LOG_ERR("Couldn't read loadTilesets");
-        exit(1);
-    }
+    // The definition files are independent (except spawn conditions and factions that refer to the
+    // creature definitions). They are read in the background while the caller initializes the
+    // rendering. waitLoading should be called before using them
+    uint32_t creatures = mLoadingTasks.addTask("creatures", [this, configPath]()
+        { return loadCreatureDefinitions(configPath + mFilenameCreatureDefinition); });
+    mLoadingTasks.addTask("equipments", [this, configPath]()
+        { return loadEquipements(configPath + mFilenameEquipmentDefinition); });
+    mLoadingTasks.addTask("spawnConditions", [this, configPath]()
+        { return loadSpawnConditions(configPath + mFilenameSpawnConditions); }, { creatures });
+    mLoadingTasks.addTask("factions", [this, configPath]()
+        { return loadFactions(configPath + mFilenameFactions); }, { creatures });
+    mLoadingTasks.addTask("rooms", [this, configPath]()
+        { return loadRooms(configPath + mFilenameRooms); });
+    mLoadingTasks.addTask("traps", [this, configPath]()
+        { return loadTraps(configPath + mFilenameTraps); });
+    mLoadingTasks.addTask("spells", [this, configPath]()
+        { return loadSpellConfig(configPath + mFilenameSpells); });
+    mLoadingTasks.addTask("skills", [this, configPath]()
+        { return loadSkills(configPath + mFilenameSkills); });
+    mLoadingTasks.addTask("tilesets", [this, configPath]()
+        { return loadTilesets(configPath + mFilenameTilesets); });
+    mLoadingTasks.addTask("keeperVoices", [this, soundPath]()
+        {
+            loadKeeperVoices(soundPath);
+            return true;
+        });
+    mLoadingTasks.start();
 
     // Reserve space in any case.
     mUserConfig.resize(Config::Ctg::TOTAL);
 
     if (!userConfigPath.empty())
         loadUserConfig(userConfigPath);
-
-    loadKeeperVoices(soundPath);
 }
 
 ConfigManager::~ConfigManager()
 {
+    // If the game stops before the loading is over, we wait for the tasks using the members
+    mLoadingTasks.wait();
+
     for(auto pair : mCreatureDefs)
     {
         delete pair.second;
@@ -171,6 +148,20 @@ ConfigManager::~ConfigManager()
     mTileSets.clear();
 }
 
+void ConfigManager::waitLoading()
+{
+    if(mIsLoaded)
+        return;
+
+    if(!mLoadingTasks.wait())
+    {
+        OD_LOG_ERR("Couldn't read the configuration files");
+        exit(1);
+    }
+
+    mIsLoaded = true;
+}
+
 bool ConfigManager::loadGlobalConfig(const std::string& configPath)
 {
     std::stringstream configFile;
@@ -584,6 +575,13 @@ bool ConfigManager::loadGlobalGameConfig(std::stringstream& configFile)
             // Not mandatory
         }
 
+        if(nextParam == "NbTurnsAutosave")
+        {
+            configFile >> nextParam;
+            mNbTurnsAutosave = Helper::toUInt32(nextParam);
+            // Not mandatory
+        }
+
         if(nextParam == "NbTurnsKoCreatureAttacked")
         {
             configFile >> nextParam;
@@ -927,6 +925,7 @@ bool ConfigManager::loadRooms(const std::string& fileName)
         return false;
     }
 
+    std::map<std::string, std::string> values;
     std::string nextParam;
     // Read in the creature class descriptions
     defFile >> nextParam;
@@ -944,10 +943,10 @@ bool ConfigManager::loadRooms(const std::string& fileName)
         if (nextParam == "[/Rooms]")
             break;
 
-        defFile >> mRoomsConfig[nextParam];
+        defFile >> values[nextParam];
     }
 
-    return true;
+    return ConfigParamBase::resolveSection(ConfigSection::rooms, values, fileName);
 }
 
 bool ConfigManager::loadTraps(const std::string& fileName)
@@ -960,6 +959,7 @@ bool ConfigManager::loadTraps(const std::string& fileName)
         return false;
     }
 
+    std::map<std::string, std::string> values;
     std::string nextParam;
     // Read in the creature class descriptions
     defFile >> nextParam;
@@ -977,10 +977,10 @@ bool ConfigManager::loadTraps(const std::string& fileName)
         if (nextParam == "[/Traps]")
             break;
 
-        defFile >> mTrapsConfig[nextParam];
+        defFile >> values[nextParam];
     }
 
-    return true;
+    return ConfigParamBase::resolveSection(ConfigSection::traps, values, fileName);
 }
 
 bool ConfigManager::loadSpellConfig(const std::string& fileName)
@@ -993,6 +993,7 @@ bool ConfigManager::loadSpellConfig(const std::string& fileName)
         return false;
     }
 
+    std::map<std::string, std::string> values;
     std::string nextParam;
     // Read in the creature class descriptions
     defFile >> nextParam;
@@ -1010,10 +1011,10 @@ bool ConfigManager::loadSpellConfig(const std::string& fileName)
         if (nextParam == "[/Spells]")
             break;
 
-        defFile >> mSpellConfig[nextParam];
+        defFile >> values[nextParam];
     }
 
-    return true;
+    return ConfigParamBase::resolveSection(ConfigSection::spells, values, fileName);
 }
 
 bool ConfigManager::loadSkills(const std::string& fileName)
@@ -1372,150 +1373,6 @@ const std::string ConfigManager::getUserValue(Config::Ctg category,
     return it->second;
 }
 
-const std::string& ConfigManager::getRoomConfigString(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
-}
-
-uint32_t ConfigManager::getRoomConfigUInt32(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getRoomConfigInt32(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getRoomConfigDouble(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
-}
-
-const std::string& ConfigManager::getTrapConfigString(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
-}
-
-uint32_t ConfigManager::getTrapConfigUInt32(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getTrapConfigInt32(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getTrapConfigDouble(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
-}
-
-const std::string& ConfigManager::getSpellConfigString(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
-}
-
-uint32_t ConfigManager::getSpellConfigUInt32(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getSpellConfigInt32(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getSpellConfigDouble(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
-}
-
 int32_t ConfigManager::getSkillPoints(const std::string& res) const
 {
     auto it = mSkillPoints.find(res);
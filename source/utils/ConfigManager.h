@@ -18,6 +18,8 @@
 #ifndef CONFIGMANAGER_H
 #define CONFIGMANAGER_H
 
+#include "utils/TaskGraph.h"
+
 #include <OgreSingleton.h>
 #include <OgreColourValue.h>
 
@@ -74,10 +76,19 @@ public:
     //! \param userConfigPath The user profile config path or empty if not used.
     //! \note In server mode, the configuration doesn't load the user config and thus,
     //! doesn't set the userConfigPath.
+    //! \note Only the global and the user configurations are available when the constructor
+    //! returns. The other files are read in the background until waitLoading is called.
     ConfigManager(const std::string& configPath, const std::string& userConfigPath,
         const std::string& soundPath);
     ~ConfigManager();
 
+    //! \brief Waits until every configuration file is read. Exits if a file could not be read
+    void waitLoading();
+
+    //! \brief Returns the time spent reading each configuration file. Should be called after waitLoading
+    inline std::string getLoadingTimings() const
+    { return mLoadingTasks.getTimings(); }
+
     static const std::string DefaultWorkerCreatureDefinition;
     static const std::string DEFAULT_TILESET_NAME;
     static const std::string DEFAULT_KEEPER_VOICE;
@@ -174,24 +185,6 @@ public:
     inline const std::vector<std::string>& getFactions() const
     { return mFactions; }
 
-    //! Rooms configuration
-    const std::string& getRoomConfigString(const std::string& param) const;
-    uint32_t getRoomConfigUInt32(const std::string& param) const;
-    int32_t getRoomConfigInt32(const std::string& param) const;
-    double getRoomConfigDouble(const std::string& param) const;
-
-    //! Traps configuration
-    const std::string& getTrapConfigString(const std::string& param) const;
-    uint32_t getTrapConfigUInt32(const std::string& param) const;
-    int32_t getTrapConfigInt32(const std::string& param) const;
-    double getTrapConfigDouble(const std::string& param) const;
-
-    //! Spells configuration
-    const std::string& getSpellConfigString(const std::string& param) const;
-    uint32_t getSpellConfigUInt32(const std::string& param) const;
-    int32_t getSpellConfigInt32(const std::string& param) const;
-    double getSpellConfigDouble(const std::string& param) const;
-
     int32_t getSkillPoints(const std::string& res) const;
 
     inline const CreatureDefinition* getCreatureDefinitionDefaultWorker() const
@@ -203,6 +196,10 @@ public:
     inline uint32_t getNbWorkersClaimSameTile() const
     { return mNbWorkersClaimSameTile; }
 
+    //! \brief Number of turns between 2 autosaves of the server. 0 if autosave is disabled
+    inline uint32_t getNbTurnsAutosave() const
+    { return mNbTurnsAutosave; }
+
     //! Returns the tileset for the given name. If the tileset is not found, returns the default tileset
     const TileSet* getTileSet(const std::string& tileSetName) const;
 
@@ -317,9 +314,6 @@ private:
     std::map<const std::string, std::string> mFactionDefaultWorkerClass;
 
     std::vector<std::string> mFactions;
-    std::map<const std::string, std::string> mRoomsConfig;
-    std::map<const std::string, std::string> mTrapsConfig;
-    std::map<const std::string, std::string> mSpellConfig;
     std::map<const std::string, int32_t> mSkillPoints;
 
     //! \brief Default definition for the editor. At map loading, it will spawn a creature from
@@ -328,6 +322,11 @@ private:
 
     uint32_t mNbWorkersDigSameFaceTile;
     uint32_t mNbWorkersClaimSameTile;
+    uint32_t mNbTurnsAutosave;
+
+    //! \brief Reads the definition files in the background. Set to true once waitLoading is called
+    TaskGraph mLoadingTasks;
+    bool mIsLoaded;
 
     //! \brief Allowed tilesets
     std::map<std::string, const TileSet*> mTileSets;
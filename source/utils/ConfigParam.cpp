@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ConfigParam.h"
+
+#include "utils/LogManager.h"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace
+{
+//! \brief The parameters are static objects. We use a function static variable to make sure
+//! the registry is constructed before the first parameter registers itself
+std::vector<ConfigParamBase*>& getRegistry()
+{
+    static std::vector<ConfigParamBase*> registry;
+    return registry;
+}
+}
+
+ConfigParamBase::ConfigParamBase(ConfigSection section, const char* key) :
+    mSection(section),
+    mKey(key)
+{
+    getRegistry().push_back(this);
+}
+
+ConfigParamBase::~ConfigParamBase()
+{
+    std::vector<ConfigParamBase*>& registry = getRegistry();
+    registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+}
+
+bool ConfigParamBase::resolveSection(ConfigSection section, const std::map<std::string, std::string>& values,
+    const std::string& fileName)
+{
+    bool isValid = true;
+    std::set<std::string> usedKeys;
+    for(ConfigParamBase* param : getRegistry())
+    {
+        if(param->mSection != section)
+            continue;
+
+        usedKeys.insert(param->mKey);
+        auto it = values.find(param->mKey);
+        if(it == values.end())
+        {
+            OD_LOG_ERR("Missing parameter " + std::string(param->mKey) + " in " + fileName);
+            isValid = false;
+            continue;
+        }
+
+        if(!param->parse(it->second))
+        {
+            OD_LOG_ERR("Invalid value for parameter " + std::string(param->mKey) + "=" + it->second + " in " + fileName);
+            isValid = false;
+        }
+    }
+
+    for(const std::pair<const std::string, std::string>& value : values)
+    {
+        if(usedKeys.count(value.first) == 0)
+            OD_LOG_WRN("Unused parameter " + value.first + " in " + fileName + ". It might be misspelled");
+    }
+
+    return isValid;
+}
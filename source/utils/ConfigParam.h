@@ -0,0 +1,119 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONFIGPARAM_H
+#define CONFIGPARAM_H
+
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+
+//! \brief Configuration files containing parameters read through ConfigParam
+enum class ConfigSection
+{
+    rooms,
+    traps,
+    spells
+};
+
+/*! \brief Base class of the configuration parameters. Each parameter registers itself when it is
+ * constructed (they are meant to be static objects in the file using them). When ConfigManager loads
+ * a configuration file, it resolves the registered parameters of the matching section: each value is
+ * parsed once and stored in the parameter. Reading a parameter is then a simple member access.
+ */
+class ConfigParamBase
+{
+public:
+    ConfigParamBase(ConfigSection section, const char* key);
+    virtual ~ConfigParamBase();
+
+    //! \brief Sets the value of every parameter registered for the given section. Returns false if
+    //! a parameter is missing from the given values or cannot be parsed. The values that are not used
+    //! by any parameter are reported as they are most likely misspelled
+    static bool resolveSection(ConfigSection section, const std::map<std::string, std::string>& values,
+        const std::string& fileName);
+
+protected:
+    //! \brief Parses the given value. Returns false if it is not valid for the parameter type
+    virtual bool parse(const std::string& value) = 0;
+
+private:
+    ConfigSection mSection;
+    const char* mKey;
+};
+
+template<ConfigSection Section, typename T>
+class ConfigParam : public ConfigParamBase
+{
+public:
+    ConfigParam(const char* key) :
+        ConfigParamBase(Section, key),
+        mValue()
+    {}
+
+    inline const T& get() const
+    { return mValue; }
+
+protected:
+    bool parse(const std::string& value) override
+    {
+        std::stringstream ss(value);
+        T parsedValue;
+        if(!(ss >> parsedValue) || !ss.eof())
+            return false;
+
+        mValue = parsedValue;
+        return true;
+    }
+
+private:
+    T mValue;
+};
+
+template<ConfigSection Section>
+class ConfigParam<Section, std::string> : public ConfigParamBase
+{
+public:
+    ConfigParam(const char* key) :
+        ConfigParamBase(Section, key)
+    {}
+
+    inline const std::string& get() const
+    { return mValue; }
+
+protected:
+    bool parse(const std::string& value) override
+    {
+        mValue = value;
+        return true;
+    }
+
+private:
+    std::string mValue;
+};
+
+template<typename T>
+using RoomConfigParam = ConfigParam<ConfigSection::rooms, T>;
+
+template<typename T>
+using TrapConfigParam = ConfigParam<ConfigSection::traps, T>;
+
+template<typename T>
+using SpellConfigParam = ConfigParam<ConfigSection::spells, T>;
+
+#endif // CONFIGPARAM_H
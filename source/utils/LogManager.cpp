@@ -17,88 +17,279 @@
 
 #include "utils/LogManager.h"
 
-#include <boost/filesystem.hpp>
-
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iomanip>
+#include <sstream>
 
 template<> LogManager* Ogre::Singleton<LogManager>::msSingleton = nullptr;
 
 //! \brief Log filename used when OD Application throws errors without using Ogre default logger.
 const std::string LogManager::GAMELOG_NAME = "gameLog";
 
-LogManager::LogManager()
-    : mLevel(LogMessageLevel::NORMAL)
+const uint32_t LogManager::RING_BUFFER_SIZE;
+const std::size_t LogLocation::NOT_FOUND;
+
+namespace
 {
+std::atomic<uint64_t> nextInstanceId(0);
 
+//! \brief Time the sink thread waits for new messages when it is not asked to flush
+const std::chrono::milliseconds SINK_THREAD_PERIOD(10);
 }
 
-LogManager::~LogManager()
+LogLocation LogLocation::fromRuntimePath(const char* path, int line)
+{
+    const char* fileName = path;
+    for(const char* c = path; *c != '\0'; ++c)
+    {
+        if(isSeparator(*c))
+            fileName = c + 1;
+    }
+
+    const char* dot = std::strrchr(fileName, '.');
+    std::size_t length = (dot != nullptr) ? static_cast<std::size_t>(dot - fileName) : std::strlen(fileName);
+    return LogLocation{ fileName, length, line };
+}
+
+struct LogManager::ThreadBufferHolder
+{
+    ThreadBufferHolder() :
+        mInstanceId(0)
+    {}
+
+    ~ThreadBufferHolder()
+    {
+        if(mBuffer)
+            mBuffer->mIsThreadFinished.store(true, std::memory_order_release);
+    }
+
+    std::shared_ptr<ThreadBuffer> mBuffer;
+    uint64_t mInstanceId;
+};
+
+LogManager::ThreadBuffer::ThreadBuffer() :
+    mEntries(RING_BUFFER_SIZE),
+    mHead(0),
+    mTail(0),
+    mIsThreadFinished(false)
+{
+}
+
+LogManager::LogManager() :
+    mInstanceId(++nextInstanceId),
+    mLevel(LogMessageLevel::NORMAL),
+    mHasModuleLevel(false),
+    mNextSequence(0),
+    mFlushRequested(0),
+    mFlushDone(0),
+    mIsStopping(false)
 {
+    mSinkThread = std::thread(&LogManager::sinkThread, this);
+}
 
+LogManager::~LogManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSinkThreadMutex);
+        mIsStopping = true;
+    }
+    mSinkThreadCondition.notify_all();
+    mSinkThread.join();
 }
 
 void LogManager::addSink(std::unique_ptr<LogSink> sink)
 {
+    std::lock_guard<std::mutex> lock(mSinksMutex);
     mSinks.push_back(std::move(sink));
 }
 
 void LogManager::setLevel(LogMessageLevel level)
 {
-    mLevel = level;
+    mLevel.store(level, std::memory_order_relaxed);
 }
 
 void LogManager::setModuleLevel(const char* module, LogMessageLevel level)
 {
+    std::lock_guard<std::mutex> lock(mModuleLevelMutex);
     mModuleLevel[module] = level;
+    mHasModuleLevel.store(true, std::memory_order_relaxed);
+}
+
+bool LogManager::isModuleLogged(LogMessageLevel level, const LogLocation& location)
+{
+    std::lock_guard<std::mutex> lock(mModuleLevelMutex);
+    auto found = mModuleLevel.find(std::string(location.mFileName, location.mModuleLength));
+    return (found != mModuleLevel.end()) && (found->second <= level);
+}
+
+void LogManager::logMessage(LogMessageLevel level, const LogLocation& location, const std::string& message)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    uint32_t head = buffer.mHead.load(std::memory_order_relaxed);
+    // If the buffer is full, we wait for the sink thread to make room
+    while(head - buffer.mTail.load(std::memory_order_acquire) >= RING_BUFFER_SIZE)
+    {
+        // The sink thread cannot wait for itself. Its buffer is only filled by sinks logging while
+        // they write (with mSinksMutex locked) so the message cannot be written directly either
+        if(std::this_thread::get_id() == mSinkThread.get_id())
+            return;
+
+        std::this_thread::yield();
+    }
+
+    LogEntry& entry = buffer.mEntries[head % RING_BUFFER_SIZE];
+    entry.mSequence = mNextSequence.fetch_add(1, std::memory_order_relaxed);
+    entry.mLevel = level;
+    entry.mLocation = location;
+    entry.mTime = std::time(nullptr);
+    entry.mMessage = message;
+    buffer.mHead.store(head + 1, std::memory_order_release);
+
+    if(level == LogMessageLevel::CRITICAL)
+        flush();
 }
 
 void LogManager::logMessage(LogMessageLevel level, const char* filepath, int line, const std::string& message)
 {
-    sf::Lock locked(mLock);
+    LogLocation location = LogLocation::fromRuntimePath(filepath, line);
+    if(!isLogged(level, location))
+        return;
 
-    // module
+    logMessage(level, location, message);
+}
 
-    const boost::filesystem::path strippedPath(filepath);
-    std::string module = strippedPath.stem().string();
+void LogManager::flush()
+{
+    // The sinks could log something. In this case, the message will be written with the next ones
+    if(std::this_thread::get_id() == mSinkThread.get_id())
+        return;
 
-    // Check if the message fails the global threshold.
+    std::unique_lock<std::mutex> lock(mSinkThreadMutex);
+    if(mIsStopping)
+        return;
+
+    uint64_t request = ++mFlushRequested;
+    mSinkThreadCondition.notify_all();
+    mFlushCondition.wait(lock, [this, request]() { return mFlushDone >= request; });
+}
 
-    if (mLevel > level)
+LogManager::ThreadBuffer& LogManager::getThreadBuffer()
+{
+    static thread_local ThreadBufferHolder holder;
+    if(holder.mBuffer && (holder.mInstanceId == mInstanceId))
+        return *holder.mBuffer;
+
+    // The buffer may have been created by a previous LogManager (in the tests for example)
+    if(holder.mBuffer)
+        holder.mBuffer->mIsThreadFinished.store(true, std::memory_order_release);
+
+    std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
     {
-        // Allow per-module overrides of the global logging level.
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        mBuffers.push_back(buffer);
+    }
+    holder.mBuffer = buffer;
+    holder.mInstanceId = mInstanceId;
+    return *buffer;
+}
 
-        if (mModuleLevel.empty())
+void LogManager::sinkThread()
+{
+    std::vector<LogEntry> entries;
+    while(true)
+    {
+        // The flush request is read before the messages so that every message logged before
+        // the request is written when it is acknowledged
+        uint64_t flushRequested;
+        bool isStopping;
         {
-            return;
+            std::lock_guard<std::mutex> lock(mSinkThreadMutex);
+            flushRequested = mFlushRequested;
+            isStopping = mIsStopping;
         }
 
-        auto found = mModuleLevel.find(module);
-        if (found == mModuleLevel.end() ||
-            found->second > level)
-        {
+        popEntries(entries);
+        writeEntries(entries);
+        entries.clear();
+
+        std::unique_lock<std::mutex> lock(mSinkThreadMutex);
+        mFlushDone = flushRequested;
+        mFlushCondition.notify_all();
+        if(isStopping)
             return;
-        }
+
+        mSinkThreadCondition.wait_for(lock, SINK_THREAD_PERIOD, [this, flushRequested]()
+            { return mIsStopping || (mFlushRequested != flushRequested); });
     }
+}
 
-    // filename
+void LogManager::popEntries(std::vector<LogEntry>& entries)
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        buffers = mBuffers;
+    }
 
-    std::string filename = strippedPath.filename().string();
+    bool hasFinishedBuffer = false;
+    for(const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+    {
+        // A finished thread does not push anymore so its buffer can be released once it is read
+        if(buffer->mIsThreadFinished.load(std::memory_order_acquire))
+            hasFinishedBuffer = true;
 
-    // timestamp
+        uint32_t tail = buffer->mTail.load(std::memory_order_relaxed);
+        uint32_t head = buffer->mHead.load(std::memory_order_acquire);
+        for(uint32_t i = tail; i != head; ++i)
+            entries.push_back(std::move(buffer->mEntries[i % RING_BUFFER_SIZE]));
 
-    time_t current_time = ::time(0);
-    struct tm* now = ::localtime(&current_time);
+        buffer->mTail.store(head, std::memory_order_release);
+    }
 
-    mTimestampStream.str("");
-    mTimestampStream
-        << std::setfill('0') << std::setw(2) << now->tm_hour << ':'
-        << std::setfill('0') << std::setw(2) << now->tm_min << ':'
-        << std::setfill('0') << std::setw(2) << now->tm_sec;
+    if(!hasFinishedBuffer)
+        return;
 
-    std::string timestamp = mTimestampStream.str();
+    std::lock_guard<std::mutex> lock(mBuffersMutex);
+    mBuffers.erase(std::remove_if(mBuffers.begin(), mBuffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer)
+        {
+            return buffer->mIsThreadFinished.load(std::memory_order_acquire) &&
+                (buffer->mHead.load(std::memory_order_acquire) == buffer->mTail.load(std::memory_order_relaxed));
+        }), mBuffers.end());
+}
 
-    for (const auto& sink : mSinks)
+void LogManager::writeEntries(std::vector<LogEntry>& entries)
+{
+    if(entries.empty())
+        return;
+
+    // Each thread has its own buffer. We sort the messages to write them in the order they were logged
+    std::sort(entries.begin(), entries.end(), [](const LogEntry& e1, const LogEntry& e2)
+        {
+            return e1.mSequence < e2.mSequence;
+        });
+
+    std::stringstream timestampStream;
+    std::lock_guard<std::mutex> lock(mSinksMutex);
+    for(const LogEntry& entry : entries)
     {
-        sink->write(level, module, timestamp, filename, line, message);
+        std::string module(entry.mLocation.mFileName, entry.mLocation.mModuleLength);
+        std::string filename(entry.mLocation.mFileName);
+
+        // localtime is only called by the sink thread
+        struct tm* now = std::localtime(&entry.mTime);
+        timestampStream.str("");
+        timestampStream
+            << std::setfill('0') << std::setw(2) << now->tm_hour << ':'
+            << std::setfill('0') << std::setw(2) << now->tm_min << ':'
+            << std::setfill('0') << std::setw(2) << now->tm_sec;
+
+        std::string timestamp = timestampStream.str();
+
+        for (const auto& sink : mSinks)
+        {
+            sink->write(entry.mLevel, module, timestamp, filename, entry.mLocation.mLine, entry.mMessage);
+        }
     }
 }
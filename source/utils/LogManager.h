@@ -18,8 +18,16 @@
 #ifndef LOGMANAGER_H
 #define LOGMANAGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <ctime>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <SFML/System.hpp>
 
@@ -29,19 +37,93 @@
 #include "utils/LogMessageLevel.h"
 #include "utils/LogSink.h"
 
-#define OD_LOG_ERR(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_WRN(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::WARNING, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_INF(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::NORMAL, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_DBG(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::TRIVIAL, __FILE__, __LINE__, (std::string("") + _message))
+//! \brief The level is checked before the message is built so that filtered messages cost nothing.
+//! The module name is computed at compile time from the file name
+#define OD_LOG_IMPL(_level, _message) \
+    do \
+    { \
+        constexpr LogLocation odLogLocation = LogLocation::fromPath(__FILE__, __LINE__); \
+        if (LogManager::getSingleton().isLogged(_level, odLogLocation)) \
+            LogManager::getSingleton().logMessage(_level, odLogLocation, (std::string("") + _message)); \
+    } while(0)
 
-#define OD_ASSERT_TRUE(_condition)                if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, std::string(#_condition))
-#define OD_ASSERT_TRUE_MSG(_condition, _message)  if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, (std::string("") + _message))
+#define OD_LOG_ERR(_message)                      OD_LOG_IMPL(LogMessageLevel::CRITICAL, _message)
+#define OD_LOG_WRN(_message)                      OD_LOG_IMPL(LogMessageLevel::WARNING, _message)
+#define OD_LOG_INF(_message)                      OD_LOG_IMPL(LogMessageLevel::NORMAL, _message)
+#define OD_LOG_DBG(_message)                      OD_LOG_IMPL(LogMessageLevel::TRIVIAL, _message)
 
-//! \brief Helper/wrapper class to provide thread-safe logging when ogre is compiled without threads.
+#define OD_ASSERT_TRUE(_condition)                if (!(_condition)) OD_LOG_IMPL(LogMessageLevel::CRITICAL, #_condition)
+#define OD_ASSERT_TRUE_MSG(_condition, _message)  if (!(_condition)) OD_LOG_IMPL(LogMessageLevel::CRITICAL, _message)
+
+//! \brief Source file and line of a log call. The file name and the module (the file name without
+//! its extension) point into __FILE__ so that nothing is computed when logging.
+struct LogLocation
+{
+    const char* mFileName;
+    std::size_t mModuleLength;
+    int mLine;
+
+    //! \brief Computes the location from __FILE__. N is the size of the string literal. The searches
+    //! split the path in halves to keep the constexpr recursion depth low for long paths
+    template<std::size_t N>
+    static constexpr LogLocation fromPath(const char (&path)[N], int line)
+    { return fromSeparator(path, N - 1, lastSeparator(path, 0, N - 1), line); }
+
+    //! \brief Used when the path is only known at runtime
+    static LogLocation fromRuntimePath(const char* path, int line);
+
+private:
+    static const std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+    static constexpr bool isSeparator(char c)
+    { return (c == '/') || (c == '\\'); }
+
+    static constexpr std::size_t pickLast(std::size_t right, std::size_t left)
+    { return (right != NOT_FOUND) ? right : left; }
+
+    //! \brief Returns the index of the last separator in [begin, end) or NOT_FOUND
+    static constexpr std::size_t lastSeparator(const char* path, std::size_t begin, std::size_t end)
+    {
+        return (end <= begin) ? NOT_FOUND
+            : (end - begin == 1) ? (isSeparator(path[begin]) ? begin : NOT_FOUND)
+            : pickLast(lastSeparator(path, begin + (end - begin) / 2, end),
+                lastSeparator(path, begin, begin + (end - begin) / 2));
+    }
+
+    //! \brief Returns the index of the last dot in [begin, end) or NOT_FOUND
+    static constexpr std::size_t lastDot(const char* fileName, std::size_t begin, std::size_t end)
+    {
+        return (end <= begin) ? NOT_FOUND
+            : (end - begin == 1) ? ((fileName[begin] == '.') ? begin : NOT_FOUND)
+            : pickLast(lastDot(fileName, begin + (end - begin) / 2, end),
+                lastDot(fileName, begin, begin + (end - begin) / 2));
+    }
+
+    //! \brief If there is no separator, NOT_FOUND + 1 is 0 which is the start of the file name
+    static constexpr LogLocation fromSeparator(const char* path, std::size_t length, std::size_t separator, int line)
+    { return fromFileName(path + separator + 1, length - separator - 1, line); }
+
+    static constexpr LogLocation fromFileName(const char* fileName, std::size_t length, int line)
+    { return fromDot(fileName, length, lastDot(fileName, 0, length), line); }
+
+    static constexpr LogLocation fromDot(const char* fileName, std::size_t length, std::size_t dot, int line)
+    { return LogLocation{ fileName, (dot == NOT_FOUND) ? length : dot, line }; }
+};
+
+/*! \brief Thread-safe logging. Each thread pushes its messages in its own ring buffer without
+ * locking and a background thread writes them to the sinks. The timestamp and the other strings
+ * are formatted by the background thread. Critical messages are flushed before logMessage returns
+ * so that they are not lost if the game exits right after.
+ */
 class LogManager : public Ogre::Singleton<LogManager>
 {
 public:
+    //! \brief Number of messages each thread can push before waiting for the sink thread. Messages
+    //! logged by the sinks once the buffer of the sink thread is full are dropped
+    static const uint32_t RING_BUFFER_SIZE = 4096;
+
     LogManager();
+    //! \brief Writes the pending messages and stops the sink thread
     ~LogManager();
 
     //! \brief Add a sink for log messages.
@@ -53,19 +135,93 @@ public:
     //! \brief Set the minimum logging level per module.
     void setModuleLevel(const char* module, LogMessageLevel level);
 
-    //! \brief Log a message to the sinks.
+    //! \brief Returns true if a message with the given level logged from the given location should be written
+    inline bool isLogged(LogMessageLevel level, const LogLocation& location)
+    {
+        if (level >= mLevel.load(std::memory_order_relaxed))
+            return true;
+
+        // Allow per-module overrides of the global logging level.
+        if (!mHasModuleLevel.load(std::memory_order_relaxed))
+            return false;
+
+        return isModuleLogged(level, location);
+    }
+
+    //! \brief Log a message to the sinks. The level should have been checked with isLogged
+    void logMessage(LogMessageLevel level, const LogLocation& location, const std::string& message);
+
+    //! \brief Log a message to the sinks. Used when the location is only known at runtime (the level is checked)
     void logMessage(LogMessageLevel level, const char* filepath, int line, const std::string& message);
 
+    //! \brief Waits until every message logged before the call is written to the sinks
+    void flush();
+
     static const std::string GAMELOG_NAME;
 private:
+    struct LogEntry
+    {
+        uint64_t mSequence;
+        LogMessageLevel mLevel;
+        LogLocation mLocation;
+        std::time_t mTime;
+        std::string mMessage;
+    };
+
+    //! \brief Messages logged by one thread. Only this thread writes mHead and only the sink
+    //! thread writes mTail
+    struct ThreadBuffer
+    {
+        ThreadBuffer();
+
+        std::vector<LogEntry> mEntries;
+        std::atomic<uint32_t> mHead;
+        std::atomic<uint32_t> mTail;
+        //! \brief Set when the thread ends. The buffer is released once it is empty
+        std::atomic<bool> mIsThreadFinished;
+    };
+
+    //! \brief Thread local reference to the buffer of a thread. Marks the buffer as finished when the thread ends
+    struct ThreadBufferHolder;
+
     LogManager(const LogManager&) = delete;
     LogManager& operator=(const LogManager&) = delete;
 
-    LogMessageLevel mLevel;
+    //! \brief Used to know if the buffer of a thread was created by this instance
+    uint64_t mInstanceId;
+
+    std::atomic<LogMessageLevel> mLevel;
+    std::atomic<bool> mHasModuleLevel;
+    std::mutex mModuleLevelMutex;
     std::map<std::string, LogMessageLevel> mModuleLevel;
-    sf::Mutex mLock;
+
+    std::mutex mSinksMutex;
     std::vector<std::unique_ptr<LogSink>> mSinks;
-    std::stringstream mTimestampStream;
+
+    std::atomic<uint64_t> mNextSequence;
+    std::mutex mBuffersMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+
+    //! \brief Protects the flush counters and mIsStopping
+    std::mutex mSinkThreadMutex;
+    std::condition_variable mSinkThreadCondition;
+    std::condition_variable mFlushCondition;
+    uint64_t mFlushRequested;
+    uint64_t mFlushDone;
+    bool mIsStopping;
+    std::thread mSinkThread;
+
+    bool isModuleLogged(LogMessageLevel level, const LogLocation& location);
+
+    ThreadBuffer& getThreadBuffer();
+
+    void sinkThread();
+
+    //! \brief Moves the pending messages of every thread to entries. Called by the sink thread
+    void popEntries(std::vector<LogEntry>& entries);
+
+    //! \brief Writes the given entries to the sinks in the order they were logged
+    void writeEntries(std::vector<LogEntry>& entries);
 };
 
 #endif // LOGMANAGER_H
@@ -0,0 +1,123 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ObjectPool.h"
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+namespace
+{
+std::mutex poolsMutex;
+
+//! \brief Every created pool. Pools are never deleted
+std::vector<ObjectPool*>& getPools()
+{
+    static std::vector<ObjectPool*>* pools = new std::vector<ObjectPool*>;
+    return *pools;
+}
+}
+
+const std::size_t ObjectPool::GRANULARITY;
+const std::size_t ObjectPool::MAX_BLOCK_SIZE;
+const std::size_t ObjectPool::NB_SIZE_CLASSES;
+const std::size_t ObjectPool::CHUNK_SIZE;
+
+ObjectPool::ObjectPool(const std::string& name) :
+    mNameAllocations(name + " allocations"),
+    mNameHeapAllocations(name + " heap allocations"),
+    mNbAllocations(0),
+    mNbHeapAllocations(0)
+{
+    std::fill(mFreeLists, mFreeLists + NB_SIZE_CLASSES, nullptr);
+
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    getPools().push_back(this);
+}
+
+void* ObjectPool::allocate(std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mNbAllocations;
+    if((size == 0) || (size > MAX_BLOCK_SIZE))
+    {
+        ++mNbHeapAllocations;
+        return ::operator new(size);
+    }
+
+    std::size_t sizeClass = (size - 1) / GRANULARITY;
+    FreeBlock* block = mFreeLists[sizeClass];
+    if(block == nullptr)
+    {
+        // We take a new chunk and split it in blocks of the size class
+        std::size_t blockSize = (sizeClass + 1) * GRANULARITY;
+        std::size_t nbBlocks = std::max<std::size_t>(8, CHUNK_SIZE / blockSize);
+        char* chunk = static_cast<char*>(::operator new(blockSize * nbBlocks));
+        ++mNbHeapAllocations;
+        for(std::size_t i = 0; i < nbBlocks; ++i)
+        {
+            FreeBlock* newBlock = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+            newBlock->mNext = block;
+            block = newBlock;
+        }
+    }
+
+    mFreeLists[sizeClass] = block->mNext;
+    return block;
+}
+
+void ObjectPool::deallocate(void* ptr, std::size_t size)
+{
+    if(ptr == nullptr)
+        return;
+
+    if((size == 0) || (size > MAX_BLOCK_SIZE))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    std::size_t sizeClass = (size - 1) / GRANULARITY;
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    std::lock_guard<std::mutex> lock(mMutex);
+    block->mNext = mFreeLists[sizeClass];
+    mFreeLists[sizeClass] = block;
+}
+
+void ObjectPool::reportCounts(const AllocationCounterReporter& reporter)
+{
+    uint64_t nbAllocations;
+    uint64_t nbHeapAllocations;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        nbAllocations = mNbAllocations;
+        nbHeapAllocations = mNbHeapAllocations;
+        mNbAllocations = 0;
+        mNbHeapAllocations = 0;
+    }
+    // Pools are never deleted so the names stay valid
+    reporter(mNameAllocations.c_str(), nbAllocations);
+    reporter(mNameHeapAllocations.c_str(), nbHeapAllocations);
+}
+
+void ObjectPool::reportTurnCounts(const AllocationCounterReporter& reporter)
+{
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    for(ObjectPool* pool : getPools())
+        pool->reportCounts(reporter);
+}
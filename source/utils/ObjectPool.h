@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+//! \brief Receives the allocation counters of the pools and arenas (see ObjectPool::reportTurnCounts). The name
+//! stays valid as long as the program runs
+typedef std::function<void(const char* name, uint64_t value)> AllocationCounterReporter;
+
+/*! \brief Free list allocator for objects that are often created and deleted (missiles, creature actions, ...).
+ * A class uses a pool by defining its own operator new and operator delete forwarding to allocate/deallocate.
+ * As operator delete receives the size of the deleted object, a pool can be shared by a class and its
+ * subclasses: blocks are sorted in size classes and each size class has its own free list.
+ * The memory is taken from the heap by chunks of several blocks and is never given back: a freed block
+ * is kept in the free list of its size class to be used by the next allocation of the same size.
+ * Objects bigger than MAX_BLOCK_SIZE are allocated on the heap.
+ * Pools can be used by the server and the client threads so they are protected by a mutex. They should be
+ * created with new and never deleted so that objects can still be freed during static destruction.
+ */
+class ObjectPool
+{
+public:
+    //! \brief The name is used to report the counters
+    explicit ObjectPool(const std::string& name);
+
+    void* allocate(std::size_t size);
+    void deallocate(void* ptr, std::size_t size);
+
+    //! \brief Gives the counters of every pool to the reporter and resets them. Should be called once per turn
+    static void reportTurnCounts(const AllocationCounterReporter& reporter);
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* mNext;
+    };
+
+    static const std::size_t GRANULARITY = 16;
+    static const std::size_t MAX_BLOCK_SIZE = 2048;
+    static const std::size_t NB_SIZE_CLASSES = MAX_BLOCK_SIZE / GRANULARITY;
+    //! \brief Minimum size of the chunks taken from the heap
+    static const std::size_t CHUNK_SIZE = 16384;
+
+    std::mutex mMutex;
+    FreeBlock* mFreeLists[NB_SIZE_CLASSES];
+
+    //! \brief Names of the counters
+    const std::string mNameAllocations;
+    const std::string mNameHeapAllocations;
+
+    //! \brief Number of objects allocated since the last report
+    uint64_t mNbAllocations;
+    //! \brief Number of allocations done on the heap (chunks and big objects) since the last report
+    uint64_t mNbHeapAllocations;
+
+    void reportCounts(const AllocationCounterReporter& reporter);
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+};
+
+#endif // OBJECTPOOL_H
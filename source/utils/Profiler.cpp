@@ -0,0 +1,330 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/Profiler.h"
+
+#include "utils/Helper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+struct ProfilerSample
+{
+    const char* mName;
+    int64_t mTurn;
+    uint64_t mStartUs;
+    uint64_t mDurationUs;
+    uint32_t mDepth;
+};
+
+//! \brief Samples recorded by one thread. The mutex is only contended when the samples are read
+struct ThreadBuffer
+{
+    ThreadBuffer(uint32_t threadId) :
+        mThreadId(threadId),
+        mSamples(Profiler::RING_BUFFER_SIZE),
+        mNext(0),
+        mNbSamples(0),
+        mDepth(0)
+    {}
+
+    uint32_t mThreadId;
+    std::mutex mMutex;
+    std::vector<ProfilerSample> mSamples;
+    uint32_t mNext;
+    uint32_t mNbSamples;
+    uint32_t mDepth;
+};
+
+std::mutex buffersMutex;
+//! \brief Buffers are kept after their thread ends so that their samples can still be dumped
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+struct CounterValue
+{
+    int64_t mTurn;
+    uint64_t mTimeUs;
+    uint64_t mValue;
+};
+
+std::mutex countersMutex;
+std::map<const char*, std::deque<CounterValue>> counters;
+
+std::mutex namesMutex;
+std::unordered_set<std::string> internedNames;
+
+std::atomic<int64_t> currentTurn(-1);
+const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+thread_local ThreadBuffer* threadBuffer = nullptr;
+
+ThreadBuffer& getThreadBuffer()
+{
+    if(threadBuffer != nullptr)
+        return *threadBuffer;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.push_back(std::make_shared<ThreadBuffer>(static_cast<uint32_t>(buffers.size())));
+    threadBuffer = buffers.back().get();
+    return *threadBuffer;
+}
+
+//! \brief Copies the samples of every thread with the id of the thread that recorded them
+void copySamples(std::vector<std::pair<uint32_t, ProfilerSample>>& samples)
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for(const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+    {
+        std::lock_guard<std::mutex> lockBuffer(buffer->mMutex);
+        uint32_t first = (buffer->mNext + Profiler::RING_BUFFER_SIZE - buffer->mNbSamples) % Profiler::RING_BUFFER_SIZE;
+        for(uint32_t i = 0; i < buffer->mNbSamples; ++i)
+        {
+            const ProfilerSample& sample = buffer->mSamples[(first + i) % Profiler::RING_BUFFER_SIZE];
+            samples.push_back(std::make_pair(buffer->mThreadId, sample));
+        }
+    }
+}
+
+//! \brief Returns the value at the given percentile from the sorted values
+uint64_t percentile(const std::vector<uint64_t>& sortedValues, uint32_t percent)
+{
+    if(sortedValues.empty())
+        return 0;
+
+    std::size_t index = (sortedValues.size() - 1) * percent / 100;
+    return sortedValues[index];
+}
+
+std::string escapeJson(const char* str)
+{
+    std::string ret;
+    for(; *str != '\0'; ++str)
+    {
+        if((*str == '"') || (*str == '\\'))
+            ret += '\\';
+        ret += *str;
+    }
+    return ret;
+}
+}
+
+namespace Profiler
+{
+
+void setTurn(int64_t turn)
+{
+    currentTurn.store(turn, std::memory_order_relaxed);
+}
+
+uint32_t pushScope()
+{
+    return getThreadBuffer().mDepth++;
+}
+
+void popScope()
+{
+    --getThreadBuffer().mDepth;
+}
+
+void addSample(const char* name, uint64_t startUs, uint64_t durationUs, uint32_t depth)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mMutex);
+    ProfilerSample& sample = buffer.mSamples[buffer.mNext];
+    sample.mName = name;
+    sample.mTurn = currentTurn.load(std::memory_order_relaxed);
+    sample.mStartUs = startUs;
+    sample.mDurationUs = durationUs;
+    sample.mDepth = depth;
+    buffer.mNext = (buffer.mNext + 1) % RING_BUFFER_SIZE;
+    if(buffer.mNbSamples < RING_BUFFER_SIZE)
+        ++buffer.mNbSamples;
+}
+
+void addCounter(const char* name, uint64_t value)
+{
+    CounterValue counterValue;
+    counterValue.mTurn = currentTurn.load(std::memory_order_relaxed);
+    counterValue.mTimeUs = nowUs();
+    counterValue.mValue = value;
+
+    std::lock_guard<std::mutex> lock(countersMutex);
+    std::deque<CounterValue>& values = counters[name];
+    values.push_back(counterValue);
+    if(values.size() > RING_BUFFER_SIZE)
+        values.pop_front();
+}
+
+const char* internName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(namesMutex);
+    // Elements of an unordered_set are never moved so the pointer stays valid
+    return internedNames.insert(name).first->c_str();
+}
+
+uint64_t nowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count());
+}
+
+void clear()
+{
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for(const std::shared_ptr<ThreadBuffer>& buffer : buffers)
+    {
+        std::lock_guard<std::mutex> lockBuffer(buffer->mMutex);
+        buffer->mNext = 0;
+        buffer->mNbSamples = 0;
+    }
+
+    std::lock_guard<std::mutex> lockCounters(countersMutex);
+    counters.clear();
+}
+
+std::string getTurnStats()
+{
+    std::vector<std::pair<uint32_t, ProfilerSample>> samples;
+    copySamples(samples);
+
+    // For each scope, we sum the time spent during each turn
+    std::map<std::string, std::map<int64_t, uint64_t>> timePerTurn;
+    std::map<std::string, uint64_t> nbCalls;
+    for(const std::pair<uint32_t, ProfilerSample>& p : samples)
+    {
+        const ProfilerSample& sample = p.second;
+        timePerTurn[sample.mName][sample.mTurn] += sample.mDurationUs;
+        ++nbCalls[sample.mName];
+    }
+
+    std::stringstream ss;
+    ss << "Time spent per turn in us (scope: turns, calls/turn, p50, p90, p99, max)";
+    for(const std::pair<const std::string, std::map<int64_t, uint64_t>>& scope : timePerTurn)
+    {
+        std::vector<uint64_t> values;
+        for(const std::pair<const int64_t, uint64_t>& turn : scope.second)
+            values.push_back(turn.second);
+
+        std::sort(values.begin(), values.end());
+        double callsPerTurn = static_cast<double>(nbCalls[scope.first]) / static_cast<double>(values.size());
+        ss << "\n" << scope.first << ": " << values.size()
+            << ", " << Helper::toString(callsPerTurn, 2)
+            << ", " << percentile(values, 50)
+            << ", " << percentile(values, 90)
+            << ", " << percentile(values, 99)
+            << ", " << values.back();
+    }
+
+    // Counters are sorted by name so that the output does not depend on the pointers
+    std::map<std::string, std::vector<uint64_t>> counterValues;
+    {
+        std::lock_guard<std::mutex> lock(countersMutex);
+        for(const std::pair<const char* const, std::deque<CounterValue>>& counter : counters)
+        {
+            std::vector<uint64_t>& values = counterValues[counter.first];
+            for(const CounterValue& counterValue : counter.second)
+                values.push_back(counterValue.mValue);
+        }
+    }
+
+    if(counterValues.empty())
+        return ss.str();
+
+    ss << "\nCount per turn (counter: turns, p50, p90, p99, max)";
+    for(std::pair<const std::string, std::vector<uint64_t>>& counter : counterValues)
+    {
+        std::vector<uint64_t>& values = counter.second;
+        std::sort(values.begin(), values.end());
+        ss << "\n" << counter.first << ": " << values.size()
+            << ", " << percentile(values, 50)
+            << ", " << percentile(values, 90)
+            << ", " << percentile(values, 99)
+            << ", " << values.back();
+    }
+    return ss.str();
+}
+
+bool writeChromeTrace(const std::string& filename)
+{
+    std::ofstream file(filename.c_str(), std::ios_base::out | std::ios_base::trunc);
+    if(!file.is_open())
+        return false;
+
+    std::vector<std::pair<uint32_t, ProfilerSample>> samples;
+    copySamples(samples);
+
+    file << "{\"traceEvents\":[";
+    bool isFirst = true;
+    for(const std::pair<uint32_t, ProfilerSample>& p : samples)
+    {
+        const ProfilerSample& sample = p.second;
+        if(!isFirst)
+            file << ",";
+        isFirst = false;
+
+        file << "\n{\"name\":\"" << escapeJson(sample.mName) << "\",\"ph\":\"X\",\"pid\":0"
+            << ",\"tid\":" << p.first
+            << ",\"ts\":" << sample.mStartUs
+            << ",\"dur\":" << sample.mDurationUs
+            << ",\"args\":{\"turn\":" << sample.mTurn << ",\"depth\":" << sample.mDepth << "}}";
+    }
+
+    // Counters are displayed as graphs by the trace viewer
+    std::lock_guard<std::mutex> lock(countersMutex);
+    for(const std::pair<const char* const, std::deque<CounterValue>>& counter : counters)
+    {
+        for(const CounterValue& counterValue : counter.second)
+        {
+            if(!isFirst)
+                file << ",";
+            isFirst = false;
+
+            file << "\n{\"name\":\"" << escapeJson(counter.first) << "\",\"ph\":\"C\",\"pid\":0"
+                << ",\"ts\":" << counterValue.mTimeUs
+                << ",\"args\":{\"value\":" << counterValue.mValue << "}}";
+        }
+    }
+    file << "\n]}\n";
+
+    return file.good();
+}
+
+} // namespace Profiler
+
+ProfilerScope::ProfilerScope(const char* name) :
+    mName(name),
+    mStartUs(Profiler::nowUs()),
+    mDepth(Profiler::pushScope())
+{
+}
+
+ProfilerScope::~ProfilerScope()
+{
+    Profiler::addSample(mName, mStartUs, Profiler::nowUs() - mStartUs, mDepth);
+    Profiler::popScope();
+}
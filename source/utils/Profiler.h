@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <string>
+
+/*! \brief Scoped timers used to measure how long the different phases of a turn take.
+ * Each thread records its samples in its own ring buffer so that recording a sample
+ * does not need any global lock. When the buffer is full, the oldest samples are overwritten.
+ * The macros below should be used instead of the class directly so that the profiler can be
+ * removed at compile time by disabling OD_ENABLE_PROFILER.
+ */
+namespace Profiler
+{
+    //! \brief Number of samples kept per thread
+    const uint32_t RING_BUFFER_SIZE = 65536;
+
+    //! \brief Sets the turn number that will be associated with the next samples
+    void setTurn(int64_t turn);
+
+    //! \brief Called when a scope is entered/left on the current thread. pushScope returns the depth of the scope
+    uint32_t pushScope();
+    void popScope();
+
+    //! \brief Records a sample. name should be a string literal or a name returned by internName
+    void addSample(const char* name, uint64_t startUs, uint64_t durationUs, uint32_t depth);
+
+    //! \brief Records the value of a counter (number of allocations, ...) for the current turn. name should
+    //! be a string literal, a name returned by internName or any string never freed. The last RING_BUFFER_SIZE
+    //! values of each counter are kept
+    void addCounter(const char* name, uint64_t value);
+
+    //! \brief Returns a pointer with static lifetime that can be used as a sample name
+    const char* internName(const std::string& name);
+
+    //! \brief Returns the time in microseconds since the profiler was started
+    uint64_t nowUs();
+
+    //! \brief Removes every recorded sample
+    void clear();
+
+    //! \brief Returns, for each scope name, the percentiles of the time spent per turn and, for
+    //! each counter, the percentiles of its values
+    std::string getTurnStats();
+
+    //! \brief Writes the recorded samples in the Chrome trace_event JSON format. This file
+    //! can be opened with chrome://tracing. Returns false if the file could not be written
+    bool writeChromeTrace(const std::string& filename);
+}
+
+//! \brief Measures the time spent between its construction and its destruction
+class ProfilerScope
+{
+public:
+    explicit ProfilerScope(const char* name);
+    ~ProfilerScope();
+
+private:
+    const char* mName;
+    uint64_t mStartUs;
+    uint32_t mDepth;
+
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+};
+
+#ifdef OD_ENABLE_PROFILER
+
+#define OD_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OD_PROFILE_CONCAT(a, b) OD_PROFILE_CONCAT_IMPL(a, b)
+
+//! \brief Profiles the enclosing scope with the given name (should be a string literal)
+#define OD_PROFILE_SCOPE(name) ProfilerScope OD_PROFILE_CONCAT(odProfilerScope, __LINE__)(name)
+//! \brief Sets the turn associated with the next samples
+#define OD_PROFILE_TURN(turn) Profiler::setTurn(turn)
+//! \brief Records the value of a counter for the current turn
+#define OD_PROFILE_COUNTER(name, value) Profiler::addCounter(name, value)
+
+#else // OD_ENABLE_PROFILER
+
+#define OD_PROFILE_SCOPE(name) do {} while(0)
+#define OD_PROFILE_TURN(turn) do {} while(0)
+#define OD_PROFILE_COUNTER(name, value) do {} while(0)
+
+#endif // OD_ENABLE_PROFILER
+
+#endif // PROFILER_H
@@ -27,79 +27,165 @@
 #include <cmath>
 #include <ctime>
 
-unsigned long myRandomSeed;
-const unsigned long MAX = 32768;
-
-static unsigned long randgen()
+//! \brief splitmix64 step. Used to expand seeds into generator states
+static uint64_t splitMix64(uint64_t& x)
 {
-    myRandomSeed = myRandomSeed * 1103515245 + 12345;
-    //TODO: What is the purpose of the cast?
-    unsigned long returnVal = static_cast<unsigned int>(myRandomSeed / 65536) % MAX;
-
-    return returnVal;
+    x += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = x;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
 
-//! \brief uniformly distributed number [0;1)
-static double uniform()
+static inline uint64_t rotl(uint64_t x, int k)
 {
-    return randgen() * 1.0 / static_cast<double>(MAX);
+    return (x << k) | (x >> (64 - k));
 }
 
-//! \brief uniformly distributed number [lo;hi)
-static double uniform(double lo, double hi)
+RandomStream::RandomStream(uint64_t seed)
 {
-    return uniform() * (hi - lo) + lo;
+    for(uint64_t& state : mState)
+        state = splitMix64(seed);
 }
 
-//! \brief random integer [lo;hi]
-static int randint(int lo, int hi)
+RandomStream::RandomStream(uint64_t seed, uint64_t streamId)
 {
-    return static_cast<int>(uniform() * (hi - lo + 1) + lo);
+    // We mix the stream id before combining it so that close ids give unrelated seeds
+    uint64_t mixedId = streamId;
+    uint64_t streamSeed = seed ^ splitMix64(mixedId);
+    for(uint64_t& state : mState)
+        state = splitMix64(streamSeed);
 }
 
-//! \brief random unsigned integer [lo;hi]
-static unsigned int randuint(unsigned int lo, unsigned int hi)
+uint64_t RandomStream::next()
 {
-    return static_cast<unsigned int>(uniform() * (hi - lo + 1) + lo);
+    const uint64_t result = rotl(mState[1] * 5, 7) * 9;
+    const uint64_t t = mState[1] << 17;
+
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+    mState[2] ^= t;
+    mState[3] = rotl(mState[3], 45);
+
+    return result;
 }
 
+uint64_t RandomStream::bounded(uint64_t range)
+{
+    if(range == 0)
+        return next();
 
-namespace Random
+    // We reject the values from the last incomplete interval to avoid modulo bias
+    const uint64_t threshold = (0 - range) % range;
+    while(true)
+    {
+        uint64_t value = next();
+        if(value >= threshold)
+            return value % range;
+    }
+}
+
+double RandomStream::uniform()
 {
+    // 53 bits of precision is what a double can hold
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+}
 
-void initialize()
+double RandomStream::Double(double min, double max)
 {
-    myRandomSeed = static_cast<unsigned long>(std::time(0));
+    if (min > max)
+        std::swap(min, max);
+
+    return uniform() * (max - min) + min;
 }
 
-double Double(double min, double max)
+int RandomStream::Int(int min, int max)
 {
     if (min > max)
-    {
         std::swap(min, max);
-    }
 
-    return uniform(min, max);
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - static_cast<int64_t>(min)) + 1;
+    return static_cast<int>(static_cast<int64_t>(min) + static_cast<int64_t>(bounded(range)));
 }
 
-int Int(int min, int max)
+unsigned int RandomStream::Uint(unsigned int min, unsigned int max)
 {
     if (min > max)
-    {
         std::swap(min, max);
+
+    uint64_t range = static_cast<uint64_t>(max - min) + 1;
+    return min + static_cast<unsigned int>(bounded(range));
+}
+
+void RandomStream::fillUint32(uint32_t* values, uint32_t nb)
+{
+    uint32_t index = 0;
+    // Each draw gives 2 values
+    for(; index + 1 < nb; index += 2)
+    {
+        uint64_t value = next();
+        values[index] = static_cast<uint32_t>(value >> 32);
+        values[index + 1] = static_cast<uint32_t>(value);
     }
 
-    return randint(min, max);
+    if(index < nb)
+        values[index] = static_cast<uint32_t>(next() >> 32);
 }
 
-unsigned int Uint(unsigned int min, unsigned int max)
+void RandomStream::fillDouble(double* values, uint32_t nb, double min, double max)
 {
     if (min > max)
-    {
         std::swap(min, max);
-    }
 
-    return randuint(min, max);
+    double range = max - min;
+    for(uint32_t index = 0; index < nb; ++index)
+        values[index] = uniform() * range + min;
+}
+
+static uint64_t matchSeed = 0;
+static RandomStream globalStream(0);
+
+namespace Random
+{
+
+void initialize()
+{
+    initialize(static_cast<uint64_t>(std::time(0)));
+}
+
+void initialize(uint64_t seed)
+{
+    matchSeed = seed;
+    globalStream = makeStream(RandomStreamType::global, 0);
+}
+
+uint64_t getMatchSeed()
+{
+    return matchSeed;
+}
+
+RandomStream makeStream(RandomStreamType type, uint64_t id)
+{
+    // The stream type is stored in the highest bits so that ids from different types never collide
+    uint64_t streamId = (static_cast<uint64_t>(type) << 56) ^ id;
+    return RandomStream(matchSeed, streamId);
+}
+
+double Double(double min, double max)
+{
+    return globalStream.Double(min, max);
+}
+
+int Int(int min, int max)
+{
+    return globalStream.Int(min, max);
+}
+
+unsigned int Uint(unsigned int min, unsigned int max)
+{
+    return globalStream.Uint(min, max);
 }
 
 double gaussianRandomDouble()
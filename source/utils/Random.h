@@ -23,11 +23,76 @@
 #ifndef RANDOM_H_
 #define RANDOM_H_
 
+#include <cstdint>
+
+//! \brief Kind of stream that can be derived from the match seed. Streams of different kinds
+//! with the same id are independent
+enum class RandomStreamType
+{
+    global,
+    seat,
+    entity,
+    job
+};
+
+/*! \brief Deterministic random number generator (xoshiro256**).
+ * Each stream has its own state so that independent parts of the simulation can draw
+ * numbers without depending on the order in which the others are processed. Two streams
+ * built with the same seed will give the same sequence.
+ */
+class RandomStream
+{
+public:
+    explicit RandomStream(uint64_t seed);
+
+    //! \brief Builds the stream with the given id derived from the given seed
+    RandomStream(uint64_t seed, uint64_t streamId);
+
+    //! \brief Returns the next 64 bits value of the stream
+    uint64_t next();
+
+    //! \brief Returns a double in [min;max)
+    double Double(double min, double max);
+
+    //! \brief Returns an integer in [min;max]. min and max can be given in any order
+    int Int(int min, int max);
+
+    //! \brief Returns an unsigned integer in [min;max]. min and max can be given in any order
+    unsigned int Uint(unsigned int min, unsigned int max);
+
+    //! \brief Fills the given array with nb uniformly distributed 32 bits values
+    void fillUint32(uint32_t* values, uint32_t nb);
+
+    //! \brief Fills the given array with nb doubles in [min;max)
+    void fillDouble(double* values, uint32_t nb, double min, double max);
+
+private:
+    uint64_t mState[4];
+
+    //! \brief Returns a value uniformly distributed in [0;range). If range is 0, the full
+    //! 64 bits range is used
+    uint64_t bounded(uint64_t range);
+
+    //! \brief Returns a double in [0;1)
+    double uniform();
+};
+
 namespace Random
 {
-    //! \brief initializes the semaphore and seeds the generator
+    //! \brief Seeds the global stream with a seed computed from the current time
     void initialize();
 
+    //! \brief Seeds the global stream with the given match seed. Every stream built
+    //! with makeStream after this call is derived from this seed
+    void initialize(uint64_t matchSeed);
+
+    //! \brief Returns the seed given at initialization
+    uint64_t getMatchSeed();
+
+    //! \brief Returns a new stream derived from the match seed. Calling it twice with the same
+    //! parameters gives streams with the same sequence
+    RandomStream makeStream(RandomStreamType type, uint64_t id);
+
     /*! \brief generate a random double
      *
      *  \param min, max One or both can be negative
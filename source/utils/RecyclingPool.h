@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECYCLINGPOOL_H
+#define RECYCLINGPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*! \brief Keeps the objects given back so that they can be used again instead of being deleted. It is
+ * meant for objects owning a buffer that keeps its capacity when cleared (like ODPacket): reusing the
+ * object also reuses its buffer. T should define clear() and getDataSize().
+ * The heap allocations are counted so that they can be reported with the other allocation counters (see
+ * TurnArena::countHeapAllocations). Creating an object counts for one allocation. As the capacity of a
+ * buffer is not known, an object given back bigger than it has ever been is counted as one reallocation.
+ * Like ObjectPool, it is protected by a mutex and should be created with new and never deleted.
+ */
+template<typename T>
+class RecyclingPool
+{
+public:
+    struct Item
+    {
+        Item() :
+            mMaxDataSize(0)
+        {}
+
+        T mObject;
+        //! \brief Biggest size of the object data since it was created
+        std::size_t mMaxDataSize;
+    };
+
+    //! \brief At most maxFreeItems are kept. Items bigger than maxDataSize are deleted instead of being
+    //! kept so that a big message does not hold its memory forever
+    RecyclingPool(std::size_t maxFreeItems, std::size_t maxDataSize) :
+        mMaxFreeItems(maxFreeItems),
+        mMaxDataSize(maxDataSize)
+    {
+        mFreeItems.reserve(mMaxFreeItems);
+    }
+
+    //! \brief Returns a cleared object. nbHeapAllocations is set to the number of heap allocations done
+    Item* acquire(uint32_t& nbHeapAllocations)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if(!mFreeItems.empty())
+            {
+                Item* item = mFreeItems.back();
+                mFreeItems.pop_back();
+                nbHeapAllocations = 0;
+                return item;
+            }
+        }
+
+        nbHeapAllocations = 1;
+        return new Item;
+    }
+
+    //! \brief Gives back an item returned by acquire. Returns the number of heap allocations the
+    //! object did since it was acquired
+    uint32_t release(Item* item)
+    {
+        uint32_t nbHeapAllocations = 0;
+        std::size_t dataSize = item->mObject.getDataSize();
+        if(dataSize > item->mMaxDataSize)
+        {
+            ++nbHeapAllocations;
+            item->mMaxDataSize = dataSize;
+        }
+
+        if(item->mMaxDataSize > mMaxDataSize)
+        {
+            delete item;
+            return nbHeapAllocations;
+        }
+
+        item->mObject.clear();
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(mFreeItems.size() >= mMaxFreeItems)
+        {
+            delete item;
+            return nbHeapAllocations;
+        }
+
+        mFreeItems.push_back(item);
+        return nbHeapAllocations;
+    }
+
+private:
+    std::mutex mMutex;
+    std::vector<Item*> mFreeItems;
+    std::size_t mMaxFreeItems;
+    std::size_t mMaxDataSize;
+
+    RecyclingPool(const RecyclingPool&) = delete;
+    RecyclingPool& operator=(const RecyclingPool&) = delete;
+};
+
+#endif // RECYCLINGPOOL_H
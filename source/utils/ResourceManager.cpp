@@ -71,6 +71,7 @@ const std::string ResourceManager::SHADERCACHESUBPATH = "shaderCache/";
 const std::string ResourceManager::LOGFILENAME = "opendungeons.log";
 const std::string ResourceManager::CEGUILOGFILENAME = "CEGUI.log";
 const std::string ResourceManager::USERCFGFILENAME = "config.cfg";
+const std::string ResourceManager::LEVELINFOCACHEFILENAME = "levelinfo.cache";
 
 const std::string ResourceManager::RESOURCEGROUPMUSIC = "Music";
 const std::string ResourceManager::RESOURCEGROUPSOUND = "Sound";
@@ -85,6 +86,7 @@ const std::string ResourceManager::RESOURCEGROUPSOUND = "Sound";
 ResourceManager::ResourceManager(boost::program_options::variables_map& options) :
         mServerMode(false),
         mForcedNetworkPort(-1),
+        mProfileStartup(false),
         mLogLevel(LogMessageLevel::NORMAL),
         mGameDataPath("./"),
         mUserDataPath("./"),
@@ -433,9 +435,25 @@ void ResourceManager::setupUserDataFolders(boost::program_options::variables_map
     if(itOption != options.end())
         mLogLevel = static_cast<LogMessageLevel>(itOption->second.as<int32_t>());
 
+    mProfileStartup = (options.count("profile-startup") > 0);
+
+    itOption = options.find("convertlevel");
+    if(itOption != options.end())
+    {
+        const std::vector<std::string>& files = itOption->second.as<std::vector<std::string>>();
+        if(files.size() != 2)
+        {
+            std::cerr << "convertlevel expects an input and an output file" << std::endl;
+            exit(1);
+        }
+        mLevelConversionSource = files[0];
+        mLevelConversionDestination = files[1];
+    }
+
     mUserConfigFile = mUserConfigPath + USERCFGFILENAME;
     mCeguiLogFile = mUserDataPath + CEGUILOGFILENAME;
     mShaderCachePath = mUserDataPath + SHADERCACHESUBPATH;
+    mLevelInfoCacheFile = mUserDataPath + LEVELINFOCACHEFILENAME;
 
     // Backup the Ogre log files from the previous three instances
     try
@@ -578,6 +596,8 @@ void ResourceManager::buildCommandOptions(boost::program_options::options_descri
         ("mscreator", boost::program_options::value<std::string>(), "Sets the creator for this map to connect to the master server. server/servercustom/serversave option needs to be on")
         ("port", boost::program_options::value<int32_t>(), "Sets the port used. Note that the port is used for both single and multi player")
         ("loglevel", boost::program_options::value<int32_t>(), "Sets the log level (between 0=Trivial and 3=Critical)")
+        ("profile-startup", "Logs the time spent in each step of the startup")
+        ("convertlevel", boost::program_options::value<std::vector<std::string>>()->multitoken(), "Converts the given level from the text format to the binary format (or conversely) and exits. Expects the input and output files")
     ;
 }
 
@@ -129,6 +129,9 @@ public:
     inline const std::string& getCeguiLogFile() const
     { return mCeguiLogFile; }
 
+    inline const std::string& getLevelInfoCacheFile() const
+    { return mLevelInfoCacheFile; }
+
     std::string getGameLevelPathSkirmish() const;
     std::string getUserLevelPathSkirmish() const
     { return mUserSkirmishLevelsPath; }
@@ -151,6 +154,19 @@ public:
     inline LogMessageLevel getLogLevel() const
     { return mLogLevel; }
 
+    inline bool isProfileStartup() const
+    { return mProfileStartup; }
+
+    //! \brief Returns true if the game has been launched to convert a level between the text and binary formats
+    inline bool isLevelConversionMode() const
+    { return !mLevelConversionSource.empty(); }
+
+    inline const std::string& getLevelConversionSource() const
+    { return mLevelConversionSource; }
+
+    inline const std::string& getLevelConversionDestination() const
+    { return mLevelConversionDestination; }
+
 private:
     //! \brief used when the executable is launched in server mode
     bool mServerMode;
@@ -160,9 +176,16 @@ private:
     //! \brief used when the network port is forced
     int32_t mForcedNetworkPort;
 
+    //! \brief true if the time spent in each startup step should be logged
+    bool mProfileStartup;
+
     //! \brief The log level
     LogMessageLevel mLogLevel;
 
+    //! \brief used when the executable is launched to convert a level
+    std::string mLevelConversionSource;
+    std::string mLevelConversionDestination;
+
     //! \brief The application data path
     //! \example "/usr/share/game/opendungeons" on linux
     //! \example "C:/opendungeons" on windows
@@ -186,6 +209,7 @@ private:
     std::string mOgreLogFile;
     std::string mCeguiLogFile;
     std::string mShaderCachePath;
+    std::string mLevelInfoCacheFile;
 
     //! \brief Specific data sub-paths.
     std::string mConfigPath;
@@ -210,6 +234,7 @@ private:
     static const std::string LOGFILENAME;
     static const std::string CEGUILOGFILENAME;
     static const std::string USERCFGFILENAME;
+    static const std::string LEVELINFOCACHEFILENAME;
 
     static const std::string RESOURCEGROUPMUSIC;
     static const std::string RESOURCEGROUPSOUND;
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/Symbol.h"
+
+#include "network/ODPacket.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+//! \brief Interned names. Names are stored in a deque so that references returned by
+//! getName stay valid when new names are added
+struct SymbolTable
+{
+    SymbolTable()
+    {
+        mNames.push_back(std::string());
+        mIds[std::string()] = 0;
+    }
+
+    std::mutex mMutex;
+    std::deque<std::string> mNames;
+    std::unordered_map<std::string, uint32_t> mIds;
+
+    //! \brief Local ids of the server symbols (indexed by server id)
+    std::vector<uint32_t> mServerIds;
+
+    uint32_t intern(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mIds.find(name);
+        if(it != mIds.end())
+            return it->second;
+
+        uint32_t id = static_cast<uint32_t>(mNames.size());
+        mNames.push_back(name);
+        mIds[name] = id;
+        return id;
+    }
+};
+
+// Constructed on first use so that symbols can be created by static initializers
+SymbolTable& getTable()
+{
+    static SymbolTable table;
+    return table;
+}
+}
+
+Symbol::Symbol(const std::string& name) :
+    mId(getTable().intern(name))
+{
+}
+
+Symbol::Symbol(const char* name) :
+    mId(getTable().intern(std::string(name)))
+{
+}
+
+const std::string& Symbol::getName() const
+{
+    SymbolTable& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mMutex);
+    return table.mNames[mId];
+}
+
+uint32_t Symbol::getNbSymbols()
+{
+    SymbolTable& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mMutex);
+    return static_cast<uint32_t>(table.mNames.size());
+}
+
+void Symbol::getNames(uint32_t firstId, std::vector<std::string>& names)
+{
+    SymbolTable& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mMutex);
+    for(uint32_t id = firstId; id < table.mNames.size(); ++id)
+        names.push_back(table.mNames[id]);
+}
+
+void Symbol::setServerSymbol(uint32_t serverId, const std::string& name)
+{
+    uint32_t localId = getTable().intern(name);
+    SymbolTable& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mMutex);
+    if(serverId >= table.mServerIds.size())
+        table.mServerIds.resize(serverId + 1, 0);
+
+    table.mServerIds[serverId] = localId;
+}
+
+void Symbol::clearServerSymbols()
+{
+    SymbolTable& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mMutex);
+    table.mServerIds.clear();
+}
+
+Symbol Symbol::fromServerId(uint32_t serverId)
+{
+    SymbolTable& table = getTable();
+    std::lock_guard<std::mutex> lock(table.mMutex);
+    Symbol symbol;
+    if(serverId < table.mServerIds.size())
+        symbol.mId = table.mServerIds[serverId];
+
+    return symbol;
+}
+
+ODPacket& operator<<(ODPacket& os, const Symbol& symbol)
+{
+    os << symbol.getId();
+    return os;
+}
+
+ODPacket& operator>>(ODPacket& is, Symbol& symbol)
+{
+    uint32_t serverId;
+    if(is >> serverId)
+        symbol = Symbol::fromServerId(serverId);
+
+    return is;
+}
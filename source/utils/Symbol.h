@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ODPacket;
+
+/*! \brief Name interned in a global table (animation names, sound families, ...). A symbol is only
+ * an id so copying and comparing it does not touch any string. The name is only needed when talking
+ * to Ogre or to the sound manager.
+ * Symbols should be created once (when loading or as static constants) and not in hot paths as
+ * creating a symbol from a name looks for it in the table.
+ *
+ * The ids depend on the order the names were interned in each process so they cannot be sent as is
+ * to a remote client. The server sends the names it interned to each client before the packets using
+ * them (see ODServer) and the client registers them with setServerSymbol. Symbols read from a packet
+ * are translated from the server ids.
+ */
+class Symbol
+{
+public:
+    //! \brief Empty symbol (empty name)
+    Symbol() :
+        mId(0)
+    {}
+
+    explicit Symbol(const std::string& name);
+    explicit Symbol(const char* name);
+
+    inline uint32_t getId() const
+    { return mId; }
+
+    const std::string& getName() const;
+
+    inline bool empty() const
+    { return mId == 0; }
+
+    inline bool operator==(const Symbol& other) const
+    { return mId == other.mId; }
+
+    inline bool operator!=(const Symbol& other) const
+    { return mId != other.mId; }
+
+    inline bool operator<(const Symbol& other) const
+    { return mId < other.mId; }
+
+    //! \brief Returns the number of interned names (including the empty one which has id 0)
+    static uint32_t getNbSymbols();
+
+    //! \brief Returns the names of the symbols with ids in [firstId, getNbSymbols()[
+    static void getNames(uint32_t firstId, std::vector<std::string>& names);
+
+    //! \brief Registers the name of the symbol having the given id on the server (client side)
+    static void setServerSymbol(uint32_t serverId, const std::string& name);
+
+    //! \brief Forgets the server symbols. Should be called when disconnecting from a server
+    static void clearServerSymbols();
+
+    //! \brief Returns the local symbol corresponding to the given server id (empty if unknown)
+    static Symbol fromServerId(uint32_t serverId);
+
+private:
+    uint32_t mId;
+};
+
+//! \brief Writes the local id of the symbol. Reading translates the id from the server ids
+ODPacket& operator<<(ODPacket& os, const Symbol& symbol);
+ODPacket& operator>>(ODPacket& is, Symbol& symbol);
+
+#endif // SYMBOL_H
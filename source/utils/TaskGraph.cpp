@@ -0,0 +1,206 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/TaskGraph.h"
+
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+uint32_t toMs(std::chrono::steady_clock::duration duration)
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+}
+}
+
+TaskGraph::TaskGraph() :
+    mIsStarted(false)
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+    for(std::thread& thread : mThreads)
+    {
+        if(thread.joinable())
+            thread.join();
+    }
+}
+
+uint32_t TaskGraph::addTask(const std::string& name, std::function<bool()> func,
+    const std::vector<uint32_t>& dependencies)
+{
+    uint32_t index = static_cast<uint32_t>(mTasks.size());
+    if(mIsStarted)
+    {
+        OD_LOG_ERR("Cannot add task " + name + " to a started graph");
+        return index;
+    }
+
+    Task task;
+    task.mName = name;
+    task.mFunc = func;
+    task.mState = TaskState::waiting;
+    // Dependencies can only refer to tasks already added so that there cannot be any cycle
+    for(uint32_t dependency : dependencies)
+    {
+        if(dependency >= index)
+        {
+            OD_LOG_ERR("Invalid dependency=" + Helper::toString(dependency) + " for task " + name);
+            continue;
+        }
+        task.mDependencies.push_back(dependency);
+    }
+    mTasks.push_back(task);
+    return index;
+}
+
+void TaskGraph::start()
+{
+    if(mIsStarted)
+        return;
+
+    mIsStarted = true;
+    mStart = std::chrono::steady_clock::now();
+    uint32_t nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    nbThreads = std::min(nbThreads, static_cast<uint32_t>(mTasks.size()));
+    for(uint32_t i = 0; i < nbThreads; ++i)
+        mThreads.push_back(std::thread(&TaskGraph::workerThread, this));
+}
+
+bool TaskGraph::wait()
+{
+    start();
+    for(std::thread& thread : mThreads)
+    {
+        if(thread.joinable())
+            thread.join();
+    }
+
+    for(const Task& task : mTasks)
+    {
+        if(task.mState != TaskState::succeeded)
+            return false;
+    }
+    return true;
+}
+
+std::string TaskGraph::getTimings() const
+{
+    std::vector<const Task*> tasks;
+    for(const Task& task : mTasks)
+    {
+        if((task.mState == TaskState::succeeded) || (task.mState == TaskState::failed))
+            tasks.push_back(&task);
+    }
+    std::sort(tasks.begin(), tasks.end(), [](const Task* t1, const Task* t2)
+    {
+        return t1->mStart < t2->mStart;
+    });
+
+    std::stringstream ss;
+    for(const Task* task : tasks)
+    {
+        // A task that was not run because of a failed dependency has no time
+        if(task->mStart < mStart)
+            continue;
+
+        ss << task->mName << ": " << toMs(task->mEnd - task->mStart) << " ms (started at "
+            << toMs(task->mStart - mStart) << " ms)\n";
+    }
+    return ss.str();
+}
+
+void TaskGraph::workerThread()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while(true)
+    {
+        bool isFinished;
+        uint32_t index = findReadyTask(isFinished);
+        if(isFinished)
+        {
+            mCondition.notify_all();
+            return;
+        }
+
+        if(index >= mTasks.size())
+        {
+            mCondition.wait(lock);
+            continue;
+        }
+
+        // mTasks is not resized once the graph is started so we can keep a reference to the task
+        Task& task = mTasks[index];
+        task.mState = TaskState::running;
+        task.mStart = std::chrono::steady_clock::now();
+        lock.unlock();
+
+        bool result = task.mFunc();
+
+        lock.lock();
+        task.mEnd = std::chrono::steady_clock::now();
+        task.mState = result ? TaskState::succeeded : TaskState::failed;
+        if(!result)
+            OD_LOG_ERR("Task failed: " + task.mName);
+
+        mCondition.notify_all();
+    }
+}
+
+uint32_t TaskGraph::findReadyTask(bool& isFinished)
+{
+    isFinished = true;
+    for(uint32_t i = 0; i < mTasks.size(); ++i)
+    {
+        Task& task = mTasks[i];
+        if(task.mState == TaskState::running)
+            isFinished = false;
+
+        if(task.mState != TaskState::waiting)
+            continue;
+
+        // The dependencies are always before the task. A task depending on a failed one is
+        // marked as failed before the tasks depending on it are checked
+        bool isReady = true;
+        bool hasFailedDependency = false;
+        for(uint32_t dependency : task.mDependencies)
+        {
+            TaskState state = mTasks[dependency].mState;
+            if(state == TaskState::failed)
+                hasFailedDependency = true;
+            else if(state != TaskState::succeeded)
+                isReady = false;
+        }
+
+        if(hasFailedDependency)
+        {
+            task.mState = TaskState::failed;
+            continue;
+        }
+
+        isFinished = false;
+        if(isReady)
+            return i;
+    }
+
+    return static_cast<uint32_t>(mTasks.size());
+}
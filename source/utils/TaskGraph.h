@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*! \brief Runs a set of tasks on worker threads. A task is started once all the tasks it depends on
+ * are finished. If a task fails, the tasks depending on it are not run.
+ * It is used at startup to read the independent configuration files concurrently while the main
+ * thread initializes Ogre.
+ */
+class TaskGraph
+{
+public:
+    TaskGraph();
+
+    //! \brief Waits for the running tasks
+    ~TaskGraph();
+
+    //! \brief Adds a task that will be run after the given tasks. func should return false if it fails.
+    //! Returns the task id. Tasks cannot be added once the graph is started
+    uint32_t addTask(const std::string& name, std::function<bool()> func,
+        const std::vector<uint32_t>& dependencies = std::vector<uint32_t>());
+
+    //! \brief Starts running the tasks in the background
+    void start();
+
+    //! \brief Waits for every task to be finished. Returns false if a task failed or was not run
+    //! because one of its dependencies failed
+    bool wait();
+
+    //! \brief Returns, for each task, the time it took and when it started. Should be called after wait
+    std::string getTimings() const;
+
+private:
+    enum class TaskState
+    {
+        waiting,
+        running,
+        succeeded,
+        failed
+    };
+
+    struct Task
+    {
+        std::string mName;
+        std::function<bool()> mFunc;
+        std::vector<uint32_t> mDependencies;
+        TaskState mState;
+        std::chrono::steady_clock::time_point mStart;
+        std::chrono::steady_clock::time_point mEnd;
+    };
+
+    std::vector<Task> mTasks;
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::chrono::steady_clock::time_point mStart;
+    bool mIsStarted;
+
+    void workerThread();
+
+    //! \brief Returns the index of a task that can be run or mTasks.size() if there is none.
+    //! Tasks depending on a failed task are marked as failed. mMutex should be locked
+    uint32_t findReadyTask(bool& isFinished);
+};
+
+#endif // TASKGRAPH_H
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/TurnArena.h"
+
+#include <new>
+#include <vector>
+
+namespace
+{
+std::mutex arenasMutex;
+
+//! \brief Every created arena. Arenas are never deleted
+std::vector<TurnArena*>& getArenas()
+{
+    static std::vector<TurnArena*>* arenas = new std::vector<TurnArena*>;
+    return *arenas;
+}
+}
+
+const std::size_t TurnArena::ALIGNMENT;
+
+TurnArena::TurnArena(const std::string& name, std::size_t capacity) :
+    mBuffer(new char[capacity]),
+    mCapacity(capacity),
+    mOffset(0),
+    mNbLiveObjects(0),
+    mNameAllocations(name + " allocations"),
+    mNameHeapAllocations(name + " heap allocations"),
+    mNbAllocations(0),
+    mNbHeapAllocations(0)
+{
+    std::lock_guard<std::mutex> lock(arenasMutex);
+    getArenas().push_back(this);
+}
+
+void* TurnArena::allocate(std::size_t size)
+{
+    std::size_t alignedSize = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mNbAllocations;
+    if(mOffset + alignedSize > mCapacity)
+    {
+        ++mNbHeapAllocations;
+        return ::operator new(size);
+    }
+
+    void* ptr = mBuffer.get() + mOffset;
+    mOffset += alignedSize;
+    ++mNbLiveObjects;
+    return ptr;
+}
+
+void TurnArena::deallocate(void* ptr)
+{
+    if(ptr == nullptr)
+        return;
+
+    char* bytes = static_cast<char*>(ptr);
+    std::lock_guard<std::mutex> lock(mMutex);
+    if((bytes < mBuffer.get()) || (bytes >= mBuffer.get() + mCapacity))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    --mNbLiveObjects;
+    if(mNbLiveObjects == 0)
+        mOffset = 0;
+}
+
+void TurnArena::countHeapAllocations(uint32_t nbHeapAllocations)
+{
+    if(nbHeapAllocations == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mNbHeapAllocations += nbHeapAllocations;
+}
+
+void TurnArena::reportCounts(const AllocationCounterReporter& reporter)
+{
+    uint64_t nbAllocations;
+    uint64_t nbHeapAllocations;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        nbAllocations = mNbAllocations;
+        nbHeapAllocations = mNbHeapAllocations;
+        mNbAllocations = 0;
+        mNbHeapAllocations = 0;
+    }
+    // Arenas are never deleted so the names stay valid
+    reporter(mNameAllocations.c_str(), nbAllocations);
+    reporter(mNameHeapAllocations.c_str(), nbHeapAllocations);
+}
+
+void TurnArena::reportTurnCounts(const AllocationCounterReporter& reporter)
+{
+    std::lock_guard<std::mutex> lock(arenasMutex);
+    for(TurnArena* arena : getArenas())
+        arena->reportCounts(reporter);
+}
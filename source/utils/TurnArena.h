@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TURNARENA_H
+#define TURNARENA_H
+
+#include "utils/ObjectPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/*! \brief Bump allocator for transient objects that are all freed at the end of each turn (like the
+ * server notifications). Allocating only moves an offset in a fixed buffer. Freeing does not give the
+ * memory back but, when every object allocated from the arena has been freed, the whole buffer can be
+ * used again. If the buffer is full, objects are allocated on the heap.
+ * Like ObjectPool, arenas should be created with new and never deleted.
+ */
+class TurnArena
+{
+public:
+    //! \brief The name is used to report the counters
+    TurnArena(const std::string& name, std::size_t capacity);
+
+    void* allocate(std::size_t size);
+    void deallocate(void* ptr);
+
+    //! \brief Counts heap allocations done for the objects of the arena outside of it (like the buffers
+    //! they own) so that they are part of the reported heap allocations
+    void countHeapAllocations(uint32_t nbHeapAllocations);
+
+    //! \brief Gives the counters of every arena to the reporter and resets them. Should be called once per turn
+    static void reportTurnCounts(const AllocationCounterReporter& reporter);
+
+private:
+    static const std::size_t ALIGNMENT = 16;
+
+    std::mutex mMutex;
+    std::unique_ptr<char[]> mBuffer;
+    std::size_t mCapacity;
+    std::size_t mOffset;
+    //! \brief Number of objects allocated in the buffer and not freed yet
+    uint32_t mNbLiveObjects;
+
+    //! \brief Names of the counters
+    const std::string mNameAllocations;
+    const std::string mNameHeapAllocations;
+
+    uint64_t mNbAllocations;
+    uint64_t mNbHeapAllocations;
+
+    void reportCounts(const AllocationCounterReporter& reporter);
+
+    TurnArena(const TurnArena&) = delete;
+    TurnArena& operator=(const TurnArena&) = delete;
+};
+
+#endif // TURNARENA_H